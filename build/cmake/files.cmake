@@ -427,7 +427,10 @@ set(BASE_CMN_SRC
     src/common/languageinfo.cpp
     src/common/list.cpp
     src/common/log.cpp
+    src/common/logasync.cpp
     src/common/longlong.cpp
+    src/common/mappedfile.cpp
+    src/common/mappedzip.cpp
     src/common/memory.cpp
     src/common/mimecmn.cpp
     src/common/module.cpp
@@ -454,6 +457,7 @@ set(BASE_CMN_SRC
     src/common/textbuf.cpp
     src/common/textfile.cpp
     src/common/threadinfo.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -558,6 +562,7 @@ set(BASE_CMN_HDR
     wx/list.h
     wx/listimpl.cpp
     wx/log.h
+    wx/logasync.h
     wx/longlong.h
     wx/math.h
     wx/memconf.h
@@ -604,6 +609,7 @@ set(BASE_CMN_HDR
     wx/textbuf.h
     wx/textfile.h
     wx/thread.h
+    wx/threadpool.h
     wx/thrimpl.cpp
     wx/time.h
     wx/timer.h
@@ -277,6 +277,10 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // return true if Compare() is not overridden, allowing the control to
+    // sort the items by their values, which is much faster
+    virtual bool CanSortByValue() const { return false; }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -32,6 +32,8 @@ enum wxDirFlags
     wxDIR_HIDDEN    = 0x0004,       // include hidden files
     wxDIR_DOTDOT    = 0x0008,       // include '.' and '..'
     wxDIR_NO_FOLLOW = 0x0010,       // don't dereference any symlink
+    wxDIR_PARALLEL  = 0x0020,       // Traverse() only: use several threads
+    wxDIR_UNORDERED = 0x0040,       // with wxDIR_PARALLEL: don't keep order
 
     // by default, enumerate everything except '.' and '..'
     wxDIR_DEFAULT   = wxDIR_FILES | wxDIR_DIRS | wxDIR_HIDDEN
@@ -73,6 +73,8 @@ class WXDLLIMPEXP_FWD_BASE wxEventFilter;
 
 class WXDLLIMPEXP_FWD_BASE wxMSVC_FWD_MULTIPLE_BASES wxEvtHandler;
 class wxEventConnectionRef;
+class wxDynamicEventTable;
+class wxPendingEventQueue;
 
 // ----------------------------------------------------------------------------
 // Event types
@@ -3983,10 +3985,11 @@ protected:
     wxEvtHandler*       m_nextHandler;
     wxEvtHandler*       m_previousHandler;
 
-    typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
-    DynamicEvents* m_dynamicEvents;
+    // handlers connected using Bind(), allocated on demand
+    wxDynamicEventTable* m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
+    // queue of the events added by QueueEvent(), allocated on demand
+    wxPendingEventQueue* m_pendingEvents;
 
 #if wxUSE_THREADS
     // critical section protecting m_pendingEvents
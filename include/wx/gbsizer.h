@@ -325,6 +325,10 @@ public:
 
 
 protected:
+    // Items positions and spans can change without notifying us, so don't
+    // cache the min size computed from them.
+    virtual bool CanCacheMinSize() const wxOVERRIDE { return false; }
+
     wxGBPosition FindEmptyCell();
     void AdjustForOverflow();
 
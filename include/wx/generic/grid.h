@@ -1947,12 +1947,26 @@ public:
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
 
-    // the grid can cache attributes for the recently used cells (currently it
-    // only caches one attribute for the most recently used one) and might
-    // notice that its value in the attribute provider has changed -- if this
-    // happens, call this function to force it
+    // the grid caches attributes for the recently used cells (typically all
+    // the currently visible ones) and might not notice that their value in the
+    // attribute provider has changed -- if this happens, call this function to
+    // force it
     void RefreshAttr(int row, int col);
 
+    // same as RefreshAttr() but for all cells: this must be called if the
+    // attributes returned by the table may have changed for many of them
+    void RefreshAttrs() { ClearAttrCache(); }
+
+    // return the number of attribute lookups satisfied from the cache and the
+    // number of those which had to query the table since the grid creation
+    void GetAttrCacheStatistics(size_t *hits, size_t *misses) const
+    {
+        if ( hits )
+            *hits = m_attrCacheHits;
+        if ( misses )
+            *misses = m_attrCacheMisses;
+    }
+
     // returns the attribute we may modify in place: a new one if this cell
     // doesn't have any yet or the existing one if it does
     //
@@ -2662,17 +2676,34 @@ protected:
     // do we have some place to store attributes in?
     bool CanHaveAttributes() const;
 
-    // cell attribute cache (currently we only cache 1, may be will do
-    // more/better later)
+    // cell attribute cache: this is a direct-mapped cache, i.e. each cell can
+    // be stored only in the slot determined by its coordinates, big enough to
+    // hold the attributes of all the cells drawn during a repaint
     struct CachedAttr
     {
         int             row, col;
         wxGridCellAttr *attr;
-    } m_attrCache;
+    };
+
+    mutable wxVector<CachedAttr> m_attrCache;
+
+    // statistics about the cache efficiency, see GetAttrCacheStatistics()
+    mutable size_t m_attrCacheHits,
+                   m_attrCacheMisses;
+
+    // returns the cache slot to use for the given cell
+    CachedAttr& GetAttrCacheSlot(int row, int col) const;
+
+    // enlarges the cache if necessary to hold at least this many attributes
+    void ReserveAttrCache(size_t count);
 
     // invalidates the attribute cache
     void ClearAttrCache();
 
+    // invalidates the cached attributes of all cells of the given row or
+    // column, use -1 for the other parameter
+    void ClearAttrCache(int row, int col);
+
     // adds an attribute to cache
     void CacheAttr(int row, int col, wxGridCellAttr *attr) const;
 
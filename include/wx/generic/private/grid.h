@@ -74,6 +74,40 @@ struct wxGridCellWithAttr
 WX_DECLARE_OBJARRAY_WITH_DECL(wxGridCellWithAttr, wxGridCellWithAttrArray,
                               class WXDLLIMPEXP_ADV);
 
+// hash and equality functors allowing to use wxGridCellCoords as hash map key
+struct wxGridCellCoordsHash
+{
+    wxGridCellCoordsHash() { }
+
+    size_t operator()(const wxGridCellCoords& coords) const
+    {
+        // combine the row and column using the usual multiplicative hashing,
+        // this gives a good distribution for the typical case of rectangular
+        // blocks of attributed cells
+        const size_t row = static_cast<unsigned>(coords.GetRow());
+        const size_t col = static_cast<unsigned>(coords.GetCol());
+
+        return row * 2654435761U ^ col;
+    }
+};
+
+struct wxGridCellCoordsEqual
+{
+    wxGridCellCoordsEqual() { }
+
+    bool operator()(const wxGridCellCoords& a, const wxGridCellCoords& b) const
+    {
+        return a == b;
+    }
+};
+
+// maps cell coordinates to the index of the corresponding wxGridCellWithAttr
+// in wxGridCellWithAttrArray
+WX_DECLARE_HASH_MAP_WITH_DECL(wxGridCellCoords, size_t,
+                              wxGridCellCoordsHash, wxGridCellCoordsEqual,
+                              wxGridCellCoordsToIndexHashMap,
+                              class WXDLLIMPEXP_ADV);
+
 
 // ----------------------------------------------------------------------------
 // private classes
@@ -465,6 +499,10 @@ private:
 // ----------------------------------------------------------------------------
 
 // this class stores attributes set for cells
+//
+// The attributes are kept in an array, which is convenient for updating them
+// when rows or columns are inserted or deleted, but they are also indexed by
+// their coordinates to make looking them up independent of their number.
 class WXDLLIMPEXP_ADV wxGridCellAttrData
 {
 public:
@@ -477,7 +515,11 @@ private:
     // searches for the attr for given cell, returns wxNOT_FOUND if not found
     int FindIndex(int row, int col) const;
 
+    // recreate m_index from scratch after modifying m_attrs in bulk
+    void RebuildIndex();
+
     wxGridCellWithAttrArray m_attrs;
+    wxGridCellCoordsToIndexHashMap m_index;
 };
 
 // this class stores attributes set for rows or columns
@@ -16,6 +16,7 @@
 #include "wx/brush.h"
 #include "wx/pen.h"
 #include "wx/scrolwin.h"
+#include "wx/vector.h"
 
 // -----------------------------------------------------------------------------
 // forward declaration
@@ -241,6 +242,10 @@ protected:
                         *m_key_current,
                         // A hint to select a parent item after deleting a child
                         *m_select_me;
+    // all the items currently shown in the control, i.e. all of them except
+    // the hidden root and the descendants of the collapsed items, in the
+    // order in which they are displayed
+    wxVector<wxGenericTreeItem *> m_rows;
     unsigned short       m_indent;
     int                  m_lineHeight;
     wxPen                m_dottedPen;
@@ -248,6 +253,8 @@ protected:
                          m_hilightUnfocusedBrush;
     bool                 m_hasFocus;
     bool                 m_dirty;
+    bool                 m_rowsDirty;  // m_rows must be rebuilt from scratch
+    bool                 m_positionsDirty; // rows positions must be updated
     bool                 m_ownsImageListButtons;
     bool                 m_isDragging; // true between BEGIN/END drag events
     bool                 m_lastOnSame;  // last click on the same item as prev
@@ -321,11 +328,33 @@ protected:
 
     void CalculateLineHeight();
     int  GetLineHeight(wxGenericTreeItem *item) const;
-    void PaintLevel( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
+    void PaintRow( wxGenericTreeItem *item, wxDC& dc );
     void PaintItem( wxGenericTreeItem *item, wxDC& dc);
-
-    void CalculateLevel( wxGenericTreeItem *item, wxDC &dc, int level, int &y );
-    void CalculatePositions();
+    void PaintChildrenLine( wxGenericTreeItem *item, wxDC& dc );
+
+    // calculate the sizes and positions of all rows using the given DC, which
+    // must use m_normalFont, or a wxClientDC if it's NULL
+    void CalculatePositions(wxDC *dc = NULL);
+
+    // m_rows helpers: the functions updating it incrementally must be called
+    // after adding the item to, or before removing it from, the tree
+    bool AreChildrenShown(wxGenericTreeItem *item) const;
+    bool ShouldUpdateRows();
+    void InsertRows(size_t pos, const wxVector<wxGenericTreeItem *>& rows);
+    void RemoveRows(size_t first, size_t last);
+    void AddItemRows(wxGenericTreeItem *item);
+    void RemoveItemRows(wxGenericTreeItem *item);
+    void AddChildrenRows(wxGenericTreeItem *item);
+    void RemoveChildrenRows(wxGenericTreeItem *item);
+    void InvalidateRows();
+    void UpdateRows();
+
+    // return the index of the first row whose bottom is below the given
+    // (unscrolled) y coordinate or the number of rows if there is none
+    size_t GetRowAtY(int y) const;
+
+    // return the row at the given (unscrolled) point, if any
+    wxGenericTreeItem *HitTestRows(const wxPoint& point, int& flags) const;
 
     void RefreshSubtree( wxGenericTreeItem *item );
     void RefreshLine( wxGenericTreeItem *item );
@@ -22,6 +22,7 @@
 #include "wx/html/htmlfilt.h"
 #include "wx/filename.h"
 #include "wx/bitmap.h"
+#include "wx/vector.h"
 
 class wxHtmlProcessor;
 class wxHtmlWinModule;
@@ -267,6 +268,17 @@ public:
     // Append to current page
     bool AppendToPage(const wxString& source);
 
+    // If enabled, AppendToPage() parses and lays out only the new fragment
+    // instead of the entire page.
+    void EnableIncrementalAppend(bool enable = true)
+        { m_incrementalAppend = enable; }
+    bool IsIncrementalAppendEnabled() const { return m_incrementalAppend; }
+
+    // Sets the maximal number of fragments kept when using incremental
+    // append, the oldest ones are dropped when it is exceeded. 0 = no limit.
+    void SetMaxAppendedFragments(size_t count);
+    size_t GetMaxAppendedFragments() const { return m_maxAppendedFragments; }
+
     // Load HTML page from given location. Location can be either
     // a) /usr/wxGTK2/docs/html/wx.htm
     // b) http://www.somewhere.uk/document.htm
@@ -518,6 +530,24 @@ private:
     // don't have any background image
     void DoEraseBackground(wxDC& dc);
 
+    // pass HTML source through all the registered processors
+    wxString ApplyProcessors(const wxString& source) const;
+
+    // parse the already processed HTML source and return the top cell
+    wxHtmlContainerCell *ParseSource(const wxString& source);
+
+    // returns the source of the entire page, including appended fragments
+    wxString GetPageSource() const;
+
+    // parse the page again, e.g. after changing the fonts
+    void ReparsePage();
+
+    // parse the fragment and add its cells to the end of m_Cell
+    void DoAppendFragment(const wxString& source);
+
+    // delete the cells of the oldest appended fragment
+    void DropOldestFragment();
+
     // window content for double buffered rendering, may be invalid until it is
     // really initialized in OnPaint()
     wxBitmap m_backBuffer;
@@ -542,6 +572,18 @@ private:
     wxHtmlProcessorList *m_Processors;
     static wxHtmlProcessorList *m_GlobalProcessors;
 
+    // true if AppendToPage() only parses the new fragment
+    bool m_incrementalAppend;
+    // maximal number of appended fragments or 0 if unlimited
+    size_t m_maxAppendedFragments;
+    // source of the page, after applying the processors to it, without the
+    // incrementally appended fragments
+    wxString m_pageSource;
+    // processed sources of the incrementally appended fragments and the first
+    // cell of each of them in m_Cell
+    wxArrayString m_appendedSources;
+    wxVector<wxHtmlCell*> m_appendedCells;
+
     // browser history
     wxHtmlHistoryArray *m_History;
     int m_HistoryPos;
@@ -375,6 +375,9 @@ public:
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // approximate gaussian blur with the given standard deviation
+    wxImage BlurGaussian(double sigma) const;
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
     // rescales the image in place
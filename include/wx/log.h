@@ -587,6 +587,12 @@ public:
 #endif // WXWIN_COMPATIBILITY_2_8
 
 protected:
+    // return true if this target can be used from any thread: in this case
+    // the messages logged from the threads other than main are passed to it
+    // immediately instead of being buffered until the main thread flushes
+    // them, but repetition counting is not done for them
+    virtual bool IsThreadSafe() const { return false; }
+
     // the logging functions that can be overridden: DoLogRecord() is called
     // for every "record", i.e. a unit of log output, to be logged and by
     // default formats the message and passes it to DoLogTextAtLevel() which in
@@ -669,6 +675,12 @@ private:
                       const wxString& msg,
                       const wxLogRecordInfo& info);
 
+    // called by CallDoLogNow() after handling repetition counting and from
+    // OnLog() directly for the thread-safe targets
+    void CallDoLogRecord(wxLogLevel level,
+                         const wxString& msg,
+                         const wxLogRecordInfo& info);
+
 
     // variables
     // ----------------
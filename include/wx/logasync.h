@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     wxLogAsync class writing log messages from a separate thread
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGASYNC_H_
+#define _WX_LOGASYNC_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include "wx/msgout.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+class wxLogAsyncBuffer;
+class wxLogAsyncWriterThread;
+
+// what to do when the buffer of the thread logging a message is full
+enum wxLogOverflowPolicy
+{
+    wxLOG_OVERFLOW_BLOCK,       // wait until the writer thread empties it
+    wxLOG_OVERFLOW_DROP_NEW,    // discard the new message
+    wxLOG_OVERFLOW_DROP_OLDEST  // discard the oldest message in the buffer
+};
+
+// ----------------------------------------------------------------------------
+// wxLogAsync: log target writing messages to a file from a dedicated thread
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog,
+                                    protected wxMessageOutputWithConv
+{
+public:
+    // write the messages to the given FILE, stderr by default
+    wxLogAsync(FILE *fp = NULL, const wxMBConv& conv = wxConvWhateverWorks);
+
+    // append the messages to the file with the given name, check IsOk() to
+    // see if it could be opened
+    wxLogAsync(const wxString& filename,
+               const wxMBConv& conv = wxConvWhateverWorks);
+
+    virtual ~wxLogAsync();
+
+    bool IsOk() const { return m_fp != NULL; }
+
+
+    // the maximal number of messages buffered for each thread
+    void SetBufferCapacity(size_t capacity);
+    size_t GetBufferCapacity() const;
+
+    void SetOverflowPolicy(wxLogOverflowPolicy policy);
+    wxLogOverflowPolicy GetOverflowPolicy() const;
+
+    // the maximal time, in milliseconds, between logging a message and
+    // writing it out
+    void SetFlushInterval(unsigned long ms);
+    unsigned long GetFlushInterval() const;
+
+    // return the number of messages discarded because of overflow so far
+    size_t GetDroppedCount() const;
+
+
+    // write out all the messages logged so far, from any thread, and return
+    // only once they have been written
+    virtual void Flush() wxOVERRIDE;
+
+protected:
+    virtual bool IsThreadSafe() const wxOVERRIDE { return true; }
+
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) wxOVERRIDE;
+    virtual void DoLogTextAtLevel(wxLogLevel level,
+                                  const wxString& msg) wxOVERRIDE;
+    virtual void DoLogText(const wxString& msg) wxOVERRIDE;
+
+private:
+    typedef wxVector<wxLogRecord> Records;
+    typedef wxVector<wxLogAsyncBuffer*> Buffers;
+
+    void Init();
+
+    // return the buffer for the current thread, creating it if necessary,
+    // don't use the buffer cached for this thread if lookup is true
+    wxLogAsyncBuffer& GetThreadBuffer(bool lookup = false);
+
+    // copy the capacity and policy to all the buffers, must be called with
+    // m_buffersCS locked
+    void UpdateBuffers();
+
+    // called by the writer thread until Stop() is called
+    void RunWriter();
+
+    // write out all the messages currently in the buffers, this is called by
+    // the writer thread periodically and by Flush()
+    void WriteBuffered();
+
+    // the file we write to and whether we need to close it
+    FILE *m_fp;
+    bool m_ownsFile;
+
+    // the values used by all the buffers, protected by m_buffersCS
+    size_t m_capacity;
+    wxLogOverflowPolicy m_policy;
+
+    // unique identifier of this object used to find the buffer of the current
+    // thread without locking in the common case
+    unsigned long m_serial;
+
+    // all the per-thread buffers, the buffers reclaimed from the threads
+    // which haven't logged anything for some time and can be reused and the
+    // number of messages dropped by the latter, all protected by m_buffersCS
+    Buffers m_buffers;
+    Buffers m_freeBuffers;
+    size_t m_droppedFreed;
+    mutable wxCriticalSection m_buffersCS;
+
+    // the data used by WriteBuffered(), protected by m_writeCS which also
+    // serializes the writes done by the writer thread and Flush()
+    wxVector<Records> m_taken;
+    wxVector<const wxLogRecord*> m_sorted;
+    wxString m_text;
+    wxCriticalSection m_writeCS;
+
+    // the writer thread waits on m_wakeCondition for at most m_flushInterval
+    // until it's time to write the buffered messages or m_stop is set, both
+    // of these fields are protected by m_wakeMutex
+    mutable wxMutex m_wakeMutex;
+    wxCondition m_wakeCondition;
+    unsigned long m_flushInterval;
+    bool m_stop;
+
+    // the threads blocked because their buffer is full wait on this condition
+    // which is signalled whenever the buffers are emptied
+    wxMutex m_writtenMutex;
+    wxCondition m_writtenCondition;
+
+    wxLogAsyncWriterThread *m_writer;
+
+    friend class wxLogAsyncWriterThread;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_LOG && wxUSE_THREADS
+
+#endif // _WX_LOGASYNC_H_
@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/mappedfile.h
+// Purpose:     wxMappedFile class for read-only memory mapping of files
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_MAPPEDFILE_H_
+#define _WX_PRIVATE_MAPPEDFILE_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_FILE
+
+class WXDLLIMPEXP_FWD_BASE wxString;
+
+// ----------------------------------------------------------------------------
+// Maps the entire contents of a file in memory for reading.
+//
+// Mapping may be unsupported on the current platform or fail for a particular
+// file (e.g. because it is empty or is not a regular file), so the callers
+// must always be prepared to fall back to reading the file in this case.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxMappedFile
+{
+public:
+    wxMappedFile() : m_data(NULL), m_size(0) { }
+    ~wxMappedFile() { Close(); }
+
+    // Map the given file, closing the previously mapped one, if any. Returns
+    // false, without logging any errors, if the file couldn't be mapped.
+    bool Open(const wxString& filename);
+
+    // Unmap the file, does nothing if it is not mapped.
+    void Close();
+
+    bool IsOpened() const { return m_data != NULL; }
+
+    // The data is only valid while the file remains mapped. Notice that it is
+    // not NUL-terminated.
+    const char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedFile);
+};
+
+#endif // wxUSE_FILE
+
+#endif // _WX_PRIVATE_MAPPEDFILE_H_
@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/mappedzip.h
+// Purpose:     wxMappedZipFile class for random access to zip archives
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_MAPPEDZIP_H_
+#define _WX_PRIVATE_MAPPEDZIP_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+
+#include "wx/object.h"
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+#include "wx/private/mappedfile.h"
+
+class WXDLLIMPEXP_FWD_BASE wxInputStream;
+class WXDLLIMPEXP_FWD_BASE wxMBConv;
+class WXDLLIMPEXP_FWD_BASE wxZipEntry;
+
+// ----------------------------------------------------------------------------
+// Provides random access to the entries of a zip archive file.
+//
+// The archive is mapped in memory and its central directory is read once
+// when opening it, so that finding an entry by name doesn't require reading
+// the archive. The streams returned by OpenEntry() read the stored entries
+// directly from the mapping and inflate the deflated ones from it without
+// any intermediate copies.
+//
+// Objects of this class are reference counted, as the streams created by
+// them keep a reference to them, and so must be allocated on the heap.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxMappedZipFile : public wxRefCounter
+{
+public:
+    wxMappedZipFile() : m_fileSize(0), m_fileTime(0) { }
+
+    // Map the archive and read its central directory. Returns false, without
+    // logging any errors, if the file couldn't be mapped or is not a valid zip
+    // archive. The conversion is used for the names of the entries not using
+    // UTF-8.
+    bool Open(const wxString& filename, const wxMBConv& conv);
+
+    // Return true if the file was modified, replaced or removed since it was
+    // opened, as determined by its size and modification time, in which case
+    // this object shouldn't be used for opening any more entries as the
+    // mapping may not correspond to the file any longer.
+    bool IsModified() const;
+
+    size_t GetCount() const { return m_entries.size(); }
+
+    // Return the index of the first entry with the given name or wxNOT_FOUND.
+    int Find(const wxString& name) const;
+
+    // The name is the same as returned by wxZipEntry::GetName(wxPATH_UNIX),
+    // i.e. it ends with a slash for the directories.
+    const wxString& GetName(size_t n) const { return m_entries[n].name; }
+    wxFileOffset GetSize(size_t n) const { return m_entries[n].size; }
+
+    // Create a new wxZipEntry object with the meta data of the given entry.
+    wxZipEntry* NewEntry(size_t n) const;
+
+    // Return a new stream for reading the given entry or NULL if it uses an
+    // unsupported compression method or is encrypted.
+    wxInputStream* OpenEntry(size_t n);
+
+private:
+    // Entry data from the central directory.
+    struct Entry
+    {
+        wxString name;
+        wxUint64 localOffset;
+        wxUint64 compressedSize;
+        wxUint64 size;
+        wxUint32 crc;
+        wxUint32 dosTime;
+        wxUint32 externalAttributes;
+        wxUint16 method;
+        wxUint16 flags;
+    };
+
+    WX_DECLARE_STRING_HASH_MAP(size_t, IndexMap);
+
+    // Find the end of central directory record and get the position, size
+    // and the number of entries of the central directory from it, as well as
+    // the offset to add to all offsets in the archive.
+    bool ReadEndRecord(wxUint64& cdPos, wxUint64& cdSize,
+                       wxUint64& count, wxUint64& adjustment) const;
+
+    // Read the central directory, filling m_entries and m_index.
+    bool ReadCentralDirectory(wxUint64 cdPos, wxUint64 cdSize,
+                              wxUint64 count, wxUint64 adjustment,
+                              const wxMBConv& conv);
+
+    wxMappedFile m_file;
+
+    // The file name and its size and modification time when it was opened.
+    wxString m_filename;
+    wxInt64 m_fileSize;
+    wxInt64 m_fileTime;
+
+    wxVector<Entry> m_entries;
+    IndexMap m_index;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedZipFile);
+};
+
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
+#endif // _WX_PRIVATE_MAPPEDZIP_H_
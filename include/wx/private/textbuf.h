@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/textbuf.h
+// Purpose:     wxTextBufferLazyLines class used by wxTextBuffer
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_TEXTBUF_H_
+#define _WX_PRIVATE_TEXTBUF_H_
+
+#include "wx/textbuf.h"
+
+#if wxUSE_TEXTBUFFER
+
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+
+// ----------------------------------------------------------------------------
+// Provides the lines of wxTextBuffer on demand.
+//
+// This is used instead of storing all the lines in memory for the big buffers
+// and allows to access the first lines without reading the entire buffer.
+// Notice that the lines are numbered from 0 and GetCount() may need to examine
+// the entire buffer, so it's preferable to use HasLine() for iterating over
+// them.
+// ----------------------------------------------------------------------------
+
+// A line returned by GetModifiableLine(): as long as it's not known to have
+// been modified, its original contents is kept to check if it was.
+struct wxTextBufferModifiableLine
+{
+    wxString line;
+    wxString original;
+};
+
+WX_DECLARE_HASH_MAP(size_t, wxTextBufferModifiableLine,
+                    wxIntegerHash, wxIntegerEqual,
+                    wxTextBufferModifiableLines);
+
+class wxTextBufferLazyLines
+{
+public:
+    wxTextBufferLazyLines() { }
+    virtual ~wxTextBufferLazyLines() { }
+
+    // Return true if the line with the given index exists.
+    virtual bool HasLine(size_t n) = 0;
+
+    // Return the total number of lines.
+    virtual size_t GetCount() = 0;
+
+    // Return the line with the given index, which must be valid, taking into
+    // account any changes done to it via GetModifiableLine().
+    const wxString& GetLine(size_t n);
+
+    // Return the line with the given index for modifying it. Only this line
+    // is decoded and the changes made to it are preserved, but the returned
+    // reference, as the one returned by GetLine(), only remains valid while
+    // MODIFIABLE_LINES_KEPT other lines are retrieved.
+    wxString& GetModifiableLine(size_t n);
+
+    // Return the type of the terminator of the given line.
+    virtual wxTextFileType GetLineType(size_t n) = 0;
+
+    // The minimal number of lines for which the references returned by
+    // GetModifiableLine() remain valid.
+    static const size_t MODIFIABLE_LINES_KEPT = 256;
+
+protected:
+    // Return the original line with the given index, which must be valid. The
+    // returned reference must remain valid while MODIFIABLE_LINES_KEPT other
+    // lines are retrieved, as the callers may use the references to more
+    // than one line at once.
+    virtual const wxString& DoGetLine(size_t n) = 0;
+
+private:
+    // Forget about the oldest lines returned by GetModifiableLine() if they
+    // were not modified.
+    void ForgetUnmodifiedLines();
+
+    // The lines returned by GetModifiableLine() and the indices of those of
+    // them which may be unmodified, in the order of their retrieval.
+    wxTextBufferModifiableLines m_modifiableLines;
+    wxVector<size_t> m_maybeUnmodified;
+
+    wxDECLARE_NO_COPY_CLASS(wxTextBufferLazyLines);
+};
+
+#endif // wxUSE_TEXTBUFFER
+
+#endif // _WX_PRIVATE_TEXTBUF_H_
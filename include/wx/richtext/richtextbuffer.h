@@ -66,6 +66,7 @@
 #include "wx/txtstrm.h"
 #include "wx/variant.h"
 #include "wx/position.h"
+#include "wx/vector.h"
 
 #if wxUSE_DATAOBJ
 #include "wx/dataobj.h"
@@ -3210,6 +3211,14 @@ public:
     */
     virtual void Move(const wxPoint& pt) wxOVERRIDE;
 
+    /**
+        Called when children are added, removed or replaced. This is done by
+        all the functions of this class modifying the children, but must be
+        called explicitly after modifying the list returned by GetChildren()
+        directly.
+    */
+    virtual void OnChildrenChanged() { }
+
 protected:
     wxRichTextObjectList    m_children;
 };
@@ -3245,10 +3254,14 @@ public:
 
     virtual bool GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position = wxPoint(0,0), const wxSize& parentSize = wxDefaultSize, wxArrayInt* partialExtents = NULL) const wxOVERRIDE;
 
+    virtual void CalculateRange(long start, long& end) wxOVERRIDE;
+
     virtual bool DeleteRange(const wxRichTextRange& range) wxOVERRIDE;
 
     virtual wxString GetTextForRange(const wxRichTextRange& range) const wxOVERRIDE;
 
+    virtual void OnChildrenChanged() wxOVERRIDE { InvalidateChildIndex(); }
+
 #if wxUSE_XML
     virtual bool ImportFromXML(wxRichTextBuffer* buffer, wxXmlNode* node, wxRichTextXMLHandler* handler, bool* recurse) wxOVERRIDE;
 #endif
@@ -3400,6 +3413,14 @@ public:
     */
     virtual wxRichTextParagraph* GetParagraphAtPosition(long pos, bool caretPosition = false) const;
 
+    /**
+        Updates the index used for finding the children by position after
+        replacing the data of the list node of @a oldChild with @a newChild,
+        which must have the same range. This must be called before deleting
+        @a oldChild.
+    */
+    void ReplaceChildInIndex(wxRichTextObject* oldChild, wxRichTextObject* newChild);
+
     /**
         Returns the line size at the given position.
     */
@@ -3806,6 +3827,21 @@ public:
     bool GetFloatingObjects(wxRichTextObjectList& objects) const;
 
 protected:
+    /**
+        Returns the child whose range contains the given position, or NULL.
+
+        This uses binary search on the index of the children, which is
+        rebuilt if necessary, and so is much faster than iterating over all
+        of them for big buffers.
+    */
+    wxRichTextObject* FindChildAtPosition(long pos) const;
+
+    /**
+        Forces the index of the children to be rebuilt on the next position
+        lookup. This is called when the children or their ranges change.
+    */
+    void InvalidateChildIndex() { m_childIndex.clear(); }
+
     wxRichTextCtrl* m_ctrl;
     wxRichTextAttr  m_defaultAttributes;
 
@@ -3817,6 +3853,10 @@ protected:
 
     // The floating layout state
     wxRichTextFloatCollector* m_floatCollector;
+
+    // The children in the same order as in m_children, and hence sorted by
+    // position, or empty if it needs to be rebuilt
+    mutable wxVector<wxRichTextObject*> m_childIndex;
 };
 
 /**
@@ -73,9 +73,9 @@ public:
     virtual bool StopAdvise(const wxString& item) wxOVERRIDE;
     virtual bool Disconnect() wxOVERRIDE;
 
-    // Will be used in the future to enable the compression but does nothing
-    // for now.
-    void Compress(bool on);
+    // enable or disable the compression of the data sent in both directions,
+    // return false if the other side doesn't support it
+    bool Compress(bool on);
 
 
 protected:
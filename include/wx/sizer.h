@@ -333,6 +333,10 @@ public:
     // Enable deleting the SizerItem without destroying the contained sizer.
     void DetachSizer() { m_sizer = NULL; }
 
+    // for wxSizer use only: set or get the sizer this item belongs to
+    void SetContainingSizer(wxSizer *sizer);
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
     // Enable deleting the SizerItem without resetting the sizer in the
     // contained window.
     void DetachWindow() { m_window = NULL; m_kind = Item_None; }
@@ -354,6 +358,8 @@ public:
         if ( IsWindow() )
             m_window->SetMinSize(size);
         m_minSize = size;
+
+        InvalidateContainingSizer();
     }
     void SetMinSize( int x, int y )
         { SetMinSize(wxSize(x, y)); }
@@ -383,15 +389,15 @@ public:
     bool IsSpacer() const { return m_kind == Item_Spacer; }
 
     void SetProportion( int proportion )
-        { m_proportion = proportion; }
+        { m_proportion = proportion; InvalidateContainingSizer(); }
     int GetProportion() const
         { return m_proportion; }
     void SetFlag( int flag )
-        { m_flag = flag; }
+        { m_flag = flag; InvalidateContainingSizer(); }
     int GetFlag() const
         { return m_flag; }
     void SetBorder( int border )
-        { m_border = border; }
+        { m_border = border; InvalidateContainingSizer(); }
     int GetBorder() const
         { return m_border; }
 
@@ -428,18 +434,21 @@ public:
     {
         Free();
         DoSetWindow(window);
+        InvalidateContainingSizer();
     }
 
     void AssignSizer(wxSizer *sizer)
     {
         Free();
         DoSetSizer(sizer);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(const wxSize& size)
     {
         Free();
         DoSetSpacer(size);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(int w, int h) { AssignSpacer(wxSize(w, h)); }
@@ -455,7 +464,12 @@ public:
 
 protected:
     // common part of several ctors
-    void Init() { m_userData = NULL; m_kind = Item_None; }
+    void Init()
+    {
+        m_userData = NULL;
+        m_containingSizer = NULL;
+        m_kind = Item_None;
+    }
 
     // common part of ctors taking wxSizerFlags
     void Init(const wxSizerFlags& flags);
@@ -472,6 +486,10 @@ protected:
     // if it's != wxDefaultSize, just return wxDefaultSize otherwise.
     wxSize AddBorderToSize(const wxSize& size) const;
 
+    // Invalidate the minimal size cached by the sizer containing this item,
+    // must be called whenever anything affecting our min size changes.
+    void InvalidateContainingSizer();
+
     // discriminated union: depending on m_kind one of the fields is valid
     enum
     {
@@ -505,6 +523,9 @@ protected:
 
     wxObject    *m_userData;
 
+    // the sizer this item belongs to, may be NULL
+    wxSizer     *m_containingSizer;
+
 private:
     wxDECLARE_CLASS(wxSizerItem);
     wxDECLARE_NO_COPY_CLASS(wxSizerItem);
@@ -520,7 +541,13 @@ WX_DECLARE_EXPORTED_LIST( wxSizerItem, wxSizerItemList );
 class WXDLLIMPEXP_CORE wxSizer: public wxObject, public wxClientDataContainer
 {
 public:
-    wxSizer() { m_containingWindow = NULL; }
+    wxSizer()
+    {
+        m_containingWindow = NULL;
+        m_containingSizer = NULL;
+        m_cachedMinSizeValid = false;
+    }
+
     virtual ~wxSizer();
 
     // methods for adding elements to the sizer: there are Add/Insert/Prepend
@@ -616,6 +643,11 @@ public:
     void SetContainingWindow(wxWindow *window);
     wxWindow *GetContainingWindow() const { return m_containingWindow; }
 
+    // get the sizer containing this one or NULL for the top level sizer, the
+    // setter is used by wxSizerItem only
+    void SetContainingSizer(wxSizer *sizer) { m_containingSizer = sizer; }
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
     virtual bool Remove( wxSizer *sizer );
     virtual bool Remove( int index );
 
@@ -669,6 +701,12 @@ public:
     // Calculate the minimal size or return m_minSize if bigger.
     wxSize GetMinSize();
 
+    // Invalidate the minimal size cached by this sizer and by all the sizers
+    // containing it. This is done automatically when the sizer items change,
+    // but must be called by the derived classes if their CalcMin() result
+    // changes for any other reason.
+    void InvalidateMinSize();
+
     // These virtual functions are used by the layout algorithm: first
     // CalcMin() is called to calculate the minimal size of the sizer and
     // prepare for laying it out and then RepositionChildren() is called with
@@ -766,6 +804,26 @@ protected:
     // the window this sizer is used in, can be NULL
     wxWindow *m_containingWindow;
 
+    // the sizer this one is an item of, NULL for the top level sizer
+    wxSizer *m_containingSizer;
+
+    // the last value returned by CalcMin(), only valid if the flag is set
+    wxSize m_cachedMinSize;
+    bool m_cachedMinSizeValid;
+
+    // Return true if CalcMin() result only depends on the sizer items and on
+    // the parameters whose changes result in InvalidateMinSize() call and so
+    // can be cached until it is called.
+    //
+    // This is false by default for compatibility with the existing sizers
+    // which may have CalcMin() depending on some external state. The standard
+    // sizers return true only if they're not used as base class, so the
+    // derived classes must override this function explicitly to opt in too.
+    virtual bool CanCacheMinSize() const { return false; }
+
+    // Return the cached minimal size if it's still valid or call CalcMin().
+    wxSize CalcMinIfNeeded();
+
     wxSize GetMaxClientSize( wxWindow *window ) const;
     wxSize GetMinClientSize( wxWindow *window );
     wxSize VirtualFitSize( wxWindow *window );
@@ -806,16 +864,18 @@ public:
     {
         wxASSERT_MSG( cols >= 0, "Number of columns must be non-negative");
         m_cols = cols;
+        InvalidateMinSize();
     }
 
     void SetRows( int rows )
     {
         wxASSERT_MSG( rows >= 0, "Number of rows must be non-negative");
         m_rows = rows;
+        InvalidateMinSize();
     }
 
-    void SetVGap( int gap )     { m_vgap = gap; }
-    void SetHGap( int gap )     { m_hgap = gap; }
+    void SetVGap( int gap )     { m_vgap = gap; InvalidateMinSize(); }
+    void SetHGap( int gap )     { m_hgap = gap; InvalidateMinSize(); }
     int GetCols() const         { return m_cols; }
     int GetRows() const         { return m_rows; }
     int GetVGap() const         { return m_vgap; }
@@ -840,6 +900,8 @@ protected:
 
     virtual wxSizerItem *DoInsert(size_t index, wxSizerItem *item) wxOVERRIDE;
 
+    virtual bool CanCacheMinSize() const wxOVERRIDE;
+
     void SetItemBounds( wxSizerItem *item, int x, int y, int w, int h );
 
     // returns the number of columns/rows needed for the current total number
@@ -917,7 +979,8 @@ public:
     // grow in one direction but not the other
 
     // the direction may be wxVERTICAL, wxHORIZONTAL or wxBOTH (default)
-    void SetFlexibleDirection(int direction) { m_flexDirection = direction; }
+    void SetFlexibleDirection(int direction)
+        { m_flexDirection = direction; InvalidateMinSize(); }
     int GetFlexibleDirection() const { return m_flexDirection; }
 
     // note that the grow mode only applies to the direction which is not
@@ -982,7 +1045,7 @@ public:
 
     bool IsVertical() const { return m_orient == wxVERTICAL; }
 
-    void SetOrientation(int orient) { m_orient = orient; }
+    void SetOrientation(int orient) { m_orient = orient; InvalidateMinSize(); }
 
     // implementation of our resizing logic
     virtual wxSize CalcMin() wxOVERRIDE;
@@ -996,6 +1059,8 @@ protected:
     // Only overridden to perform extra debugging checks.
     virtual wxSizerItem *DoInsert(size_t index, wxSizerItem *item) wxOVERRIDE;
 
+    virtual bool CanCacheMinSize() const wxOVERRIDE;
+
     // helpers for our code: this returns the component of the given wxSize in
     // the direction of the sizer and in the other direction, respectively
     int GetSizeInMajorDir(const wxSize& sz) const
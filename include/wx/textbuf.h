@@ -44,6 +44,9 @@ WX_DEFINE_USER_EXPORTED_ARRAY_INT(wxTextFileType,
                                   wxArrayLinesType,
                                   class WXDLLIMPEXP_BASE);
 
+// defined in wx/private/textbuf.h
+class wxTextBufferLazyLines;
+
 #endif // wxUSE_TEXTBUFFER
 
 class WXDLLIMPEXP_BASE wxTextBuffer
@@ -96,37 +99,43 @@ public:
     // ---------
 
     // get the number of lines in the buffer
-    size_t GetLineCount() const { return m_aLines.size(); }
+    size_t GetLineCount() const
+        { return m_lazyLines ? GetLazyLineCount() : m_aLines.size(); }
 
     // the returned line may be modified (but don't add CR/LF at the end!)
-          wxString& GetLine(size_t n)          { return m_aLines[n]; }
-    const wxString& GetLine(size_t n)    const { return m_aLines[n]; }
-          wxString& operator[](size_t n)       { return m_aLines[n]; }
-    const wxString& operator[](size_t n) const { return m_aLines[n]; }
+          wxString& GetLine(size_t n)
+        { return m_lazyLines ? GetModifiableLazyLine(n) : m_aLines[n]; }
+    const wxString& GetLine(size_t n)    const
+        { return m_lazyLines ? GetLazyLine(n) : m_aLines[n]; }
+          wxString& operator[](size_t n)       { return GetLine(n); }
+    const wxString& operator[](size_t n) const { return GetLine(n); }
 
     // the current line has meaning only when you're using
     // GetFirstLine()/GetNextLine() functions, it doesn't get updated when
     // you're using "direct access" i.e. GetLine()
     size_t GetCurrentLine() const { return m_nCurLine; }
     void GoToLine(size_t n) { m_nCurLine = n; }
-    bool Eof() const { return m_nCurLine == m_aLines.size(); }
+    bool Eof() const { return !HasLine(m_nCurLine); }
 
     // these methods allow more "iterator-like" traversal of the list of
     // lines, i.e. you may write something like:
     //  for ( str = GetFirstLine(); !Eof(); str = GetNextLine() ) { ... }
 
     wxString& GetFirstLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = 0]; }
+        { return !HasLine(0) ? ms_eof : GetLine(m_nCurLine = 0); }
     wxString& GetNextLine()
-        { return ++m_nCurLine == m_aLines.size() ? ms_eof
-                                                 : m_aLines[m_nCurLine]; }
+        { return !HasLine(++m_nCurLine) ? ms_eof : GetLine(m_nCurLine); }
     wxString& GetPrevLine()
-        { wxASSERT(m_nCurLine > 0); return m_aLines[--m_nCurLine]; }
+        { wxASSERT(m_nCurLine > 0); return GetLine(--m_nCurLine); }
     wxString& GetLastLine()
-        { return m_aLines.empty() ? ms_eof : m_aLines[m_nCurLine = m_aLines.size() - 1]; }
+    {
+        const size_t count = GetLineCount();
+        return count ? GetLine(m_nCurLine = count - 1) : ms_eof;
+    }
 
     // get the type of the line (see also GetEOL)
-    wxTextFileType GetLineType(size_t n) const { return m_aTypes[n]; }
+    wxTextFileType GetLineType(size_t n) const
+        { return m_lazyLines ? GetLazyLineType(n) : m_aTypes[n]; }
 
     // guess the type of buffer
     wxTextFileType GuessType() const;
@@ -139,12 +148,21 @@ public:
 
     // add a line to the end
     void AddLine(const wxString& str, wxTextFileType type = typeDefault)
-        { m_aLines.push_back(str); m_aTypes.push_back(type); }
+    {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
+        m_aLines.push_back(str);
+        m_aTypes.push_back(type);
+    }
     // insert a line before the line number n
     void InsertLine(const wxString& str,
                   size_t n,
                   wxTextFileType type = typeDefault)
     {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
         m_aLines.insert(m_aLines.begin() + n, str);
         m_aTypes.insert(m_aTypes.begin()+n, type);
     }
@@ -152,12 +170,15 @@ public:
     // delete one line
     void RemoveLine(size_t n)
     {
+        if ( m_lazyLines )
+            LoadLazyLines();
+
         m_aLines.erase(m_aLines.begin() + n);
         m_aTypes.erase(m_aTypes.begin() + n);
     }
 
     // remove all lines
-    void Clear() { m_aLines.clear(); m_aTypes.clear(); m_nCurLine = 0; }
+    void Clear() { SetLazyLines(NULL); }
 
     // change the buffer (default argument means "don't change type")
     // possibly in another format
@@ -172,7 +193,7 @@ protected:
     // -----
 
     // default ctor, use Open(string)
-    wxTextBuffer() { m_nCurLine = 0; m_isOpened = false; }
+    wxTextBuffer() { m_nCurLine = 0; m_isOpened = false; m_lazyLines = NULL; }
 
     // ctor from filename
     wxTextBuffer(const wxString& strBufferName);
@@ -187,13 +208,35 @@ protected:
     virtual bool OnRead(const wxMBConv& conv) = 0;
     virtual bool OnWrite(wxTextFileType typeNew, const wxMBConv& conv) = 0;
 
+    // Use the given object for retrieving the lines on demand instead of
+    // storing them in this buffer, this can be done by OnRead() in the derived
+    // classes. The buffer takes ownership of the object, which is deleted and
+    // replaced by the normal lines storage as soon as the buffer is modified.
+    // Passing NULL simply clears the buffer.
+    void SetLazyLines(wxTextBufferLazyLines *lazyLines);
+
     static wxString ms_eof;     // dummy string returned at EOF
     wxString m_strBufferName;   // name of the buffer
 
 private:
+    // helpers used when the lines are retrieved on demand
+    bool HasLine(size_t n) const
+        { return m_lazyLines ? HasLazyLine(n) : n < m_aLines.size(); }
+    bool HasLazyLine(size_t n) const;
+    size_t GetLazyLineCount() const;
+    const wxString& GetLazyLine(size_t n) const;
+    wxString& GetModifiableLazyLine(size_t n);
+    wxTextFileType GetLazyLineType(size_t n) const;
+
+    // load all the lines from m_lazyLines into m_aLines and delete it
+    void LoadLazyLines();
+
     wxArrayLinesType m_aTypes;   // type of each line
     wxArrayString    m_aLines;   // lines of file
 
+    // if non-NULL, used instead of m_aTypes and m_aLines which are empty
+    wxTextBufferLazyLines *m_lazyLines;
+
     size_t        m_nCurLine; // number of current line in the buffer
 
     bool          m_isOpened; // was the buffer successfully opened the last time?
@@ -29,9 +29,15 @@ class WXDLLIMPEXP_BASE wxTextFile : public wxTextBuffer
 {
 public:
     // constructors
-    wxTextFile() { }
+    wxTextFile() { m_openMapped = false; }
     wxTextFile(const wxString& strFileName);
 
+    // open the file without loading it in memory: it is mapped instead and
+    // the lines are only decoded when they're accessed, which makes this much
+    // faster and less memory-hungry than Open() for the huge files
+    bool OpenMapped(const wxString& strFileName,
+                    const wxMBConv& conv = wxConvAuto());
+
 protected:
     // implement the base class pure virtuals
     virtual bool OnExists() const wxOVERRIDE;
@@ -45,6 +51,9 @@ private:
 
     wxFile m_file;
 
+    // true only while OpenMapped() is executing
+    bool m_openMapped;
+
     wxDECLARE_NO_COPY_CLASS(wxTextFile);
 };
 
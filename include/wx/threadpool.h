@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool and wxFuture classes for executing tasks
+//              asynchronously in a pool of worker threads
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/thread.h"
+
+#if wxUSE_THREADS
+
+#include "wx/atomic.h"
+#include "wx/event.h"
+#include "wx/vector.h"
+
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+class wxThreadPoolImpl;
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask: a unit of work executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPoolTask
+{
+public:
+    wxThreadPoolTask() { }
+
+    // The task is deleted by the pool after it is executed (or if it couldn't
+    // be executed at all).
+    virtual ~wxThreadPoolTask() { }
+
+    // This function is called in one of the pool threads.
+    virtual void Run() = 0;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolTask);
+};
+
+// Task simply calling the given functor.
+template <typename T>
+class wxThreadPoolFunctorTask : public wxThreadPoolTask
+{
+public:
+    explicit wxThreadPoolFunctorTask(const T& fn)
+        : m_fn(fn)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_fn();
+    }
+
+private:
+    T m_fn;
+};
+
+// ----------------------------------------------------------------------------
+// Private helpers used by wxFuture
+// ----------------------------------------------------------------------------
+
+// Non-template part of the state shared by wxFuture objects and the task
+// computing their value.
+class WXDLLIMPEXP_BASE wxFutureStateBase
+{
+public:
+    explicit wxFutureStateBase(wxThreadPool& pool);
+
+    void IncRef() { wxAtomicInc(m_refCount); }
+    void DecRef() { if ( !wxAtomicDec(m_refCount) ) delete this; }
+
+    bool IsReady() const;
+    void Wait() const;
+    bool WaitTimeout(unsigned long milliseconds) const;
+
+    // Mark the value as available, waking up all the waiting threads and
+    // submitting the continuations to the pool. Does nothing if the state is
+    // already ready.
+    void MakeReady();
+
+    // Submit the given task to the pool once the state becomes ready (or
+    // immediately if it already is). Takes ownership of the task.
+    void AddContinuation(wxThreadPoolTask* task);
+
+protected:
+    virtual ~wxFutureStateBase();
+
+private:
+    wxThreadPool& m_pool;
+
+    wxAtomicInt m_refCount;
+
+    mutable wxMutex m_mutex;
+    mutable wxCondition m_condReady;
+
+    bool m_ready;
+
+    // Tasks to run once the state becomes ready, protected by m_mutex.
+    wxVector<wxThreadPoolTask*> m_continuations;
+
+    wxDECLARE_NO_COPY_CLASS(wxFutureStateBase);
+};
+
+template <typename R>
+class wxFutureState : public wxFutureStateBase
+{
+public:
+    explicit wxFutureState(wxThreadPool& pool)
+        : wxFutureStateBase(pool),
+          m_value()
+    {
+    }
+
+    // Only written to by the task before calling MakeReady() and only read
+    // after the state becomes ready, so doesn't need any locking.
+    R m_value;
+};
+
+// Task computing the value of the future by calling the given functor.
+//
+// Notice that the state is made ready from the dtor and not from Run() to
+// ensure that it happens even if the functor throws or the task is deleted
+// without being executed.
+template <typename R, typename T>
+class wxFutureTask : public wxThreadPoolTask
+{
+public:
+    wxFutureTask(wxFutureState<R>* state, const T& fn)
+        : m_state(state),
+          m_fn(fn)
+    {
+        m_state->IncRef();
+    }
+
+    virtual ~wxFutureTask()
+    {
+        m_state->MakeReady();
+        m_state->DecRef();
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_state->m_value = m_fn();
+    }
+
+private:
+    wxFutureState<R>* const m_state;
+    T m_fn;
+};
+
+// Functor calling the given function with the value of the future.
+template <typename R, typename T>
+class wxFutureValueCall
+{
+public:
+    wxFutureValueCall(wxFutureState<R>* state, const T& fn)
+        : m_state(state),
+          m_fn(fn)
+    {
+        m_state->IncRef();
+    }
+
+    wxFutureValueCall(const wxFutureValueCall& other)
+        : m_state(other.m_state),
+          m_fn(other.m_fn)
+    {
+        m_state->IncRef();
+    }
+
+    ~wxFutureValueCall()
+    {
+        m_state->DecRef();
+    }
+
+    void operator()()
+    {
+        m_fn(m_state->m_value);
+    }
+
+private:
+    wxFutureState<R>* const m_state;
+    T m_fn;
+
+    wxDECLARE_NO_ASSIGN_CLASS(wxFutureValueCall);
+};
+
+#ifdef wxHAS_CALL_AFTER
+
+// Task passing the value of the future to the functor called in the thread
+// of the given event handler.
+template <typename R, typename T>
+class wxFutureCallAfterTask : public wxThreadPoolTask
+{
+public:
+    wxFutureCallAfterTask(wxEvtHandler* handler,
+                          wxFutureState<R>* state,
+                          const T& fn)
+        : m_handler(handler),
+          m_call(state, fn)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_handler->CallAfter(m_call);
+    }
+
+private:
+    wxEvtHandler* const m_handler;
+    const wxFutureValueCall<R, T> m_call;
+};
+
+#endif // wxHAS_CALL_AFTER
+
+// ----------------------------------------------------------------------------
+// wxFuture: the result of a task executed asynchronously by wxThreadPool
+// ----------------------------------------------------------------------------
+
+// R must be default constructible and assignable.
+template <typename R>
+class wxFuture
+{
+public:
+    // Default ctor creates an invalid future, use wxThreadPool::Async() to
+    // create the valid ones.
+    wxFuture() : m_state(NULL) { }
+
+    wxFuture(const wxFuture& other)
+        : m_state(other.m_state)
+    {
+        if ( m_state )
+            m_state->IncRef();
+    }
+
+    wxFuture& operator=(const wxFuture& other)
+    {
+        if ( other.m_state )
+            other.m_state->IncRef();
+        if ( m_state )
+            m_state->DecRef();
+        m_state = other.m_state;
+
+        return *this;
+    }
+
+    ~wxFuture()
+    {
+        if ( m_state )
+            m_state->DecRef();
+    }
+
+    bool IsOk() const { return m_state != NULL; }
+
+    // Return true if the value is already available.
+    bool IsReady() const
+    {
+        wxCHECK_MSG( m_state, false, "invalid future" );
+
+        return m_state->IsReady();
+    }
+
+    // Block until the value becomes available, must not be called from the
+    // pool thread unless IsReady() returns true.
+    void Wait() const
+    {
+        wxCHECK_RET( m_state, "invalid future" );
+
+        m_state->Wait();
+    }
+
+    // Block until the value becomes available or the timeout expires, return
+    // true if the value is available.
+    bool WaitTimeout(unsigned long milliseconds) const
+    {
+        wxCHECK_MSG( m_state, false, "invalid future" );
+
+        return m_state->WaitTimeout(milliseconds);
+    }
+
+    // Return the value, blocking until it becomes available if necessary.
+    const R& Get() const
+    {
+        Wait();
+
+        return m_state->m_value;
+    }
+
+    // Call the given functor taking "const R&" with the value in one of the
+    // pool threads once it becomes available.
+    template <typename T>
+    void Then(const T& fn) const
+    {
+        wxCHECK_RET( m_state, "invalid future" );
+
+        m_state->AddContinuation(
+            new wxThreadPoolFunctorTask< wxFutureValueCall<R, T> >(
+                wxFutureValueCall<R, T>(m_state, fn))
+        );
+    }
+
+#ifdef wxHAS_CALL_AFTER
+    // Call the given functor taking "const R&" with the value once it becomes
+    // available, using wxEvtHandler::CallAfter() on the given handler, i.e.
+    // typically in the main thread. The handler must remain alive until then.
+    template <typename T>
+    void CallAfter(wxEvtHandler* handler, const T& fn) const
+    {
+        wxCHECK_RET( m_state, "invalid future" );
+        wxCHECK_RET( handler, "NULL handler" );
+
+        m_state->AddContinuation(
+            new wxFutureCallAfterTask<R, T>(handler, m_state, fn)
+        );
+    }
+#endif // wxHAS_CALL_AFTER
+
+private:
+    // Takes ownership of the state reference.
+    explicit wxFuture(wxFutureState<R>* state) : m_state(state) { }
+
+    wxFutureState<R>* m_state;
+
+    friend class wxThreadPool;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: a fixed number of worker threads executing submitted tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of threads, the default value of
+    // 0 means to use as many threads as there are CPUs.
+    explicit wxThreadPool(int numThreads = 0);
+
+    // Waits until all the submitted tasks finish executing.
+    ~wxThreadPool();
+
+    // Return the shared pool object, creating it on first use. It is
+    // destroyed when the library is cleaned up.
+    static wxThreadPool& Get();
+
+    int GetThreadCount() const;
+
+    // Return true if called from one of the threads of this pool.
+    bool IsPoolThread() const;
+
+    // Submit the task for execution in one of the pool threads, the pool takes
+    // ownership of it. Returns false, and deletes the task, if it can't be
+    // executed because the pool has no threads.
+    bool SubmitTask(wxThreadPoolTask* task);
+
+    // Submit the given functor for execution.
+    template <typename T>
+    bool Submit(const T& fn)
+    {
+        return SubmitTask(new wxThreadPoolFunctorTask<T>(fn));
+    }
+
+    // Submit the given functor returning R for execution and return the
+    // future allowing to retrieve its result, e.g. Async<int>(fn).
+    template <typename R, typename T>
+    wxFuture<R> Async(const T& fn)
+    {
+        wxFutureState<R>* const state = new wxFutureState<R>(*this);
+        SubmitTask(new wxFutureTask<R, T>(state, fn));
+
+        return wxFuture<R>(state);
+    }
+
+    // Block until all the submitted tasks finish executing. Must not be called
+    // from one of the pool threads.
+    void WaitIdle();
+
+private:
+    wxThreadPoolImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
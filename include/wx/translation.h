@@ -72,6 +72,23 @@ class WXDLLIMPEXP_FWD_BASE wxLocale;
 class wxPluralFormsCalculator;
 wxDECLARE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
 
+class wxMsgCatalogFile;
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// flags for wxMsgCatalog::CreateFromFile() and CreateFromData()
+enum wxMsgCatalogFlags
+{
+    wxMSGCATALOG_DEFAULT = 0,
+
+    // don't convert all the strings when loading the catalog but look them up
+    // in the catalog data itself (memory-mapping the file if possible) and
+    // only convert the strings which are actually used
+    wxMSGCATALOG_LAZY = 1
+};
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalog corresponds to one loaded message catalog.
 // ----------------------------------------------------------------------------
@@ -81,17 +98,17 @@ class WXDLLIMPEXP_BASE wxMsgCatalog
 public:
     // Ctor is protected, because CreateFromXXX functions must be used,
     // but destruction should be unrestricted
-#if !wxUSE_UNICODE
     ~wxMsgCatalog();
-#endif
 
     // load the catalog from disk or from data; caller is responsible for
     // deleting them if not NULL
     static wxMsgCatalog *CreateFromFile(const wxString& filename,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = wxMSGCATALOG_DEFAULT);
 
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = wxMSGCATALOG_DEFAULT);
 
     // get name of the catalog
     wxString GetDomain() const { return m_domain; }
@@ -101,13 +118,17 @@ public:
 
 protected:
     wxMsgCatalog(const wxString& domain)
-        : m_pNext(NULL), m_domain(domain)
+        : m_pNext(NULL), m_domain(domain), m_file(NULL)
 #if !wxUSE_UNICODE
         , m_conv(NULL)
 #endif
     {}
 
 private:
+    // use the messages from the given file, which is deleted by this function
+    // on failure and by this object itself otherwise
+    bool InitFromFile(wxMsgCatalogFile *file, int flags);
+
     // variable pointing to the next element in a linked list (or NULL)
     wxMsgCatalog *m_pNext;
     friend class wxTranslations;
@@ -115,6 +136,10 @@ private:
     wxStringToStringHashMap m_messages; // all messages in the catalog
     wxString                m_domain;   // name of the domain
 
+    // the file used to look up the messages if it's loaded lazily, in which
+    // case m_messages is unused, or NULL
+    wxMsgCatalogFile       *m_file;
+
 #if !wxUSE_UNICODE
     // the conversion corresponding to this catalog charset if we installed it
     // as the global one
@@ -231,12 +256,21 @@ class WXDLLIMPEXP_BASE wxFileTranslationsLoader
     : public wxTranslationsLoader
 {
 public:
+    // flags are passed to wxMsgCatalog::CreateFromFile()
+    explicit wxFileTranslationsLoader(int flags = wxMSGCATALOG_DEFAULT)
+        : m_flags(flags)
+    {
+    }
+
     static void AddCatalogLookupPathPrefix(const wxString& prefix);
 
     virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
                                       const wxString& lang) wxOVERRIDE;
 
     virtual wxArrayString GetAvailableTranslations(const wxString& domain) const wxOVERRIDE;
+
+private:
+    const int m_flags;
 };
 
 
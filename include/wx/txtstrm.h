@@ -59,6 +59,13 @@ public:
     double   ReadDouble();
     wxString ReadLine();
     wxString ReadWord();
+
+    // Read the next line into the provided string, reusing its buffer, and
+    // return true or return false if there are no more lines. Unlike the
+    // other functions, this one reads and decodes the input in big blocks,
+    // so the underlying stream shouldn't be used directly after calling it.
+    bool ReadLine(wxString& line);
+
     wxChar   GetChar();
 
     wxString GetStringSeparators() const { return m_separators; }
@@ -114,10 +121,41 @@ protected:
 #endif // SIZEOF_WCHAR_T == 2
 #endif // wxUSE_UNICODE
 
+    // Buffer used by ReadLine(wxString&) to decode the input in blocks rather
+    // than character by character: the characters [m_decodedPos, m_decodedLen)
+    // of m_decoded were already read from the stream and decoded but not
+    // returned to the caller yet. The buffer is allocated on first use only.
+    wxChar *m_decoded;
+    size_t m_decodedPos,
+           m_decodedLen;
+
+#if wxUSE_UNICODE
+    // Bytes read from the stream by ReadLine(wxString&) but not decoded yet
+    // because they may contain an incomplete character at the end of block.
+    char *m_raw;
+    size_t m_rawLen;
+
+    // The size of the encoding code units, or 0 if it's not known yet.
+    size_t m_rawUnit;
+
+    // Set to false if decoding a block failed, the input is decoded one
+    // character at a time after this to find exactly where the error is.
+    bool m_decodeInBlocks;
+#endif // wxUSE_UNICODE
+
     bool   EatEOL(const wxChar &c);
     void   UngetLast(); // should be used instead of wxInputStream::Ungetch() because of Unicode issues
     wxChar NextNonSeparators();
 
+    // Fill m_decoded with the next block of characters, return false if
+    // there are no more of them.
+    bool   FillBuffer();
+
+    bool   HasDecodedChars() const { return m_decodedPos < m_decodedLen; }
+
+    // Return true if we have either buffered characters or can read more.
+    bool   IsInputOk() const { return HasDecodedChars() || m_input.IsOk(); }
+
     wxDECLARE_NO_COPY_CLASS(wxTextInputStream);
 };
 
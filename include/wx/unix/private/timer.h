@@ -13,6 +13,7 @@
 #if wxUSE_TIMER
 
 #include "wx/private/timer.h"
+#include "wx/vector.h"
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -43,8 +44,14 @@ public:
         m_isRunning = false;
     }
 
+    // for wxTimerScheduler only: the position of the timer in its heap
+    size_t GetSchedulerIndex() const { return m_schedulerIndex; }
+    void SetSchedulerIndex(size_t index) { m_schedulerIndex = index; }
+
 private:
     bool m_isRunning;
+
+    size_t m_schedulerIndex;
 };
 
 // ----------------------------------------------------------------------------
@@ -53,21 +60,35 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    unsigned long order)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_order(order)
     {
     }
 
+    // return true if this timer must be notified before the other one
+    bool IsBefore(const wxTimerSchedule& other) const
+    {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        // notify the timers expiring at the same time in the order in which
+        // they were added
+        return m_order < other.m_order;
+    }
+
     // the timer itself (we don't own this pointer)
     wxUnixTimerImpl *m_timer;
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-WX_DECLARE_LIST(wxTimerSchedule, wxTimerList);
+    // the number of the timers added before this one
+    unsigned long m_order;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -118,17 +139,29 @@ public:
 private:
     // ctor and dtor are private, this is a singleton class only created by
     // Get() and destroyed by Shutdown()
-    wxTimerScheduler() { }
+    wxTimerScheduler() { m_nextOrder = 0; }
     ~wxTimerScheduler();
 
-    // add the given timer schedule to the list in the right place
-    //
-    // we take ownership of the pointer "s" which must be heap-allocated
-    void DoAddTimer(wxTimerSchedule *s);
+    // helpers for maintaining the heap property of m_timers
+    void SetAt(size_t n, const wxTimerSchedule& s)
+    {
+        m_timers[n] = s;
+        s.m_timer->SetSchedulerIndex(n);
+    }
+
+    void MoveUp(size_t n);
+    void MoveDown(size_t n);
+
+    // remove the timer at the given position from the heap
+    void RemoveAt(size_t n);
+
 
+    // binary min-heap of all currently active timers ordered by expiration,
+    // so that the next timer to expire is always the first one
+    wxVector<wxTimerSchedule> m_timers;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the order of the next timer to be added
+    unsigned long m_nextOrder;
 
     static wxTimerScheduler *ms_instance;
 };
@@ -43,6 +43,9 @@ public:
                                       int availableOtherDir) wxOVERRIDE;
 
 protected:
+    // Our min size depends on the layout, so it can't be cached.
+    virtual bool CanCacheMinSize() const wxOVERRIDE { return false; }
+
     // This method is called to decide if an item represents empty space or
     // not. We do this to avoid having space-only items first or last on a
     // wrapped line (left alignment).
@@ -361,6 +361,87 @@ private:
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
+
+// Types of the items returned by wxXmlReader.
+enum wxXmlReaderEvent
+{
+    wxXML_EVENT_EOF,            // end of document or parsing error
+    wxXML_EVENT_START_ELEMENT,
+    wxXML_EVENT_END_ELEMENT,
+    wxXML_EVENT_TEXT,
+    wxXML_EVENT_CDATA,
+    wxXML_EVENT_COMMENT,
+    wxXML_EVENT_PI
+};
+
+class wxXmlReaderImpl;
+
+// Pull parser allowing to process XML documents sequentially, without loading
+// them entirely in memory as wxXmlDocument does.
+
+class WXDLLIMPEXP_XML wxXmlReader
+{
+public:
+    // The stream must remain valid for the lifetime of the reader. The only
+    // supported flag is wxXMLDOC_KEEP_WHITESPACE_NODES.
+    wxXmlReader(wxInputStream& stream,
+                int flags = wxXMLDOC_NONE,
+                const wxString& encoding = wxT("UTF-8"));
+    ~wxXmlReader();
+
+    // Advances to the next item and returns its type, wxXML_EVENT_EOF is
+    // returned at the end of the document or if an error occurred.
+    wxXmlReaderEvent Next();
+
+    // Returns the type of the current item.
+    wxXmlReaderEvent GetEvent() const;
+
+    // Returns true if the document is not well-formed.
+    bool HasError() const;
+
+    // Name of the element or the target of the processing instruction.
+    const wxString& GetName() const;
+
+    // Contents of the text, CDATA section, comment or processing instruction.
+    const wxString& GetContent() const;
+
+    // Attributes of the current element.
+    size_t GetAttributesCount() const;
+    const wxString& GetAttributeName(size_t n) const;
+    const wxString& GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    // Depth of the current item: the root element has depth 1, its children
+    // 2 and so on. Text and other non-element items have the depth of their
+    // parent element.
+    int GetDepth() const;
+
+    int GetLineNumber() const;
+
+    // Skips the contents of the current element, which must be the start of
+    // the element, positioning the reader at its end.
+    bool SkipElement();
+
+    // Reads the current element, which must be the start of the element, and
+    // all its children into a new wxXmlNode which must be deleted by the
+    // caller, positioning the reader at its end. Returns NULL on error.
+    wxXmlNode *ReadElement();
+
+    // Advances to the start of the next element with the given path, e.g.
+    // "root/items/item", skipping all the other elements. "*" may be used to
+    // match an element with any name. Returns false if there are no more
+    // elements with this path.
+    bool FindElement(const wxString& path);
+
+private:
+    wxXmlReaderImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReader);
+};
+
 #endif // wxUSE_XML
 
 #endif // _WX_XML_H_
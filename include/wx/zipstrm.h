@@ -16,6 +16,10 @@
 #include "wx/archive.h"
 #include "wx/filename.h"
 
+#if wxUSE_THREADS
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+#endif // wxUSE_THREADS
+
 // some methods from wxZipInputStream and wxZipOutputStream stream do not get
 // exported/imported when compiled with Mingw versions before 3.4.2. So they
 // are imported/exported individually as a workaround
@@ -279,6 +283,7 @@ private:
 
     friend class wxZipInputStream;
     friend class wxZipOutputStream;
+    friend class wxMappedZipFile;
 
     wxDECLARE_DYNAMIC_CLASS(wxZipEntry);
 };
@@ -324,6 +329,14 @@ public:
     void SetFormat(wxZipArchiveFormat format)   { m_format = format; }
     wxZipArchiveFormat GetFormat() const        { return m_format; }
 
+    // Compress the entries in several threads, must be called before
+    // creating the first entry.
+    bool WXZIPFIX EnableParallelCompression(int numThreads = 0);
+#if wxUSE_THREADS
+    bool WXZIPFIX EnableParallelCompression(wxThreadPool& pool);
+#endif // wxUSE_THREADS
+    bool IsParallelCompressionEnabled() const   { return m_parallel != NULL; }
+
 protected:
     virtual size_t WXZIPFIX OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
     virtual wxFileOffset OnSysTell() const wxOVERRIDE      { return m_entrySize; }
@@ -351,6 +364,13 @@ private:
     void CreatePendingEntry(const void *buffer, size_t size);
     void CreatePendingEntry();
 
+#if wxUSE_THREADS
+    bool DoEnableParallelCompression(wxThreadPool& pool, wxThreadPool *ownedPool);
+    void QueueParallelEntry(wxZipEntry *entry);
+    bool WriteParallelEntries(size_t maxPending);
+#endif // wxUSE_THREADS
+    bool FlushParallelEntries();
+
     class wxStoredOutputStream *m_store;
     class wxZlibOutputStream2 *m_deflate;
     class wxZipStreamLink *m_backlink;
@@ -369,6 +389,7 @@ private:
     wxString m_Comment;
     bool m_endrecWritten;
     wxZipArchiveFormat m_format;
+    class wxZipParallelQueue *m_parallel;
 
     wxDECLARE_NO_COPY_CLASS(wxZipOutputStream);
 };
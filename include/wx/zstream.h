@@ -17,6 +17,12 @@
 #include "wx/stream.h"
 #include "wx/versioninfo.h"
 
+#if wxUSE_THREADS
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+#endif // wxUSE_THREADS
+
+class wxZlibParallelDeflater;
+
 // Compression level
 enum wxZlibCompressionLevels {
     wxZ_DEFAULT_COMPRESSION = -1,
@@ -78,6 +84,14 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
   bool SetDictionary(const char *data, size_t datalen);
   bool SetDictionary(const wxMemoryBuffer &buf);
 
+  // Compress the data in independent blocks in several threads, must be
+  // called before writing any data.
+  bool EnableParallelCompression(int numThreads = 0);
+#if wxUSE_THREADS
+  bool EnableParallelCompression(wxThreadPool& pool);
+#endif // wxUSE_THREADS
+  bool IsParallelCompressionEnabled() const { return m_parallel != NULL; }
+
  protected:
   size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
   wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
@@ -86,6 +100,13 @@ class WXDLLIMPEXP_BASE wxZlibOutputStream: public wxFilterOutputStream {
 
  private:
   void Init(int level, int flags);
+#if wxUSE_THREADS
+  bool DoEnableParallelCompression(wxThreadPool& pool, wxThreadPool *ownedPool);
+#endif // wxUSE_THREADS
+
+  int m_level;
+  int m_flags;
+  wxZlibParallelDeflater *m_parallel;
 
  protected:
   size_t m_z_size;
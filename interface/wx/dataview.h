@@ -198,6 +198,26 @@ public:
                         unsigned int column,
                         bool ascending) const;
 
+    /**
+        Override this to indicate that the items can be sorted by their
+        values directly.
+
+        This function should return @true only if the model doesn't override
+        Compare(), i.e. if sorting the items by the values returned by
+        GetValue() results in the same order as calling Compare() would.
+        In this case, the control can retrieve the value of each item only
+        once, instead of doing it twice for every comparison, which is much
+        faster when sorting many items. The values of unknown types, i.e. for
+        which DoCompareValues() would be used, are still compared using
+        Compare().
+
+        The base class version returns @false. Note that this function is
+        currently only used by the generic implementation of wxDataViewCtrl.
+
+        @since 3.1.5
+    */
+    virtual bool CanSortByValue() const;
+
     /**
         Override this to indicate that the item has special font attributes.
         This only affects the wxDataViewTextRendererText renderer.
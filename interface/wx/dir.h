@@ -122,6 +122,46 @@ enum wxDirFlags
      */
     wxDIR_NO_FOLLOW = 0x0010,
 
+    /**
+        Read the directories in parallel during the traversal.
+
+        This flag is only used by wxDir::Traverse() and the functions using
+        it, such as wxDir::GetAllFiles(), and is ignored by GetFirst() and
+        GetNext(). When it is specified, the subdirectories are read using
+        several threads of the shared wxThreadPool, which can make traversing
+        big directory trees much faster. All wxDirTraverser methods are still
+        called from the thread calling Traverse() and in the same order as
+        without this flag, unless wxDIR_UNORDERED is specified too.
+
+        Notice that some subdirectories may be read even if
+        wxDirTraverser::OnDir() returns ::wxDIR_IGNORE for them in this mode,
+        however their own subdirectories are not read in this case. Also
+        notice that ::wxDIR_STOP always stops the traversal entirely when this
+        flag is used.
+
+        This flag is ignored if ::wxUSE_THREADS is 0 or if Traverse() is
+        called from one of the thread pool threads.
+
+        @since 3.1.5
+     */
+    wxDIR_PARALLEL  = 0x0020,
+
+    /**
+        Don't preserve the order of the items during parallel traversal.
+
+        This flag is only meaningful in combination with wxDIR_PARALLEL and
+        allows wxDir::Traverse() to return the contents of each directory as
+        soon as it is read, instead of returning them in the same order as
+        the sequential traversal does. This is more efficient and never reads
+        any directories for which wxDirTraverser::OnDir() returns
+        ::wxDIR_IGNORE, but the items of different directories are returned
+        in unspecified order and a directory contents may be returned after
+        the contents of the other directories at the same level.
+
+        @since 3.1.5
+     */
+    wxDIR_UNORDERED = 0x0040,
+
     /**
         Default directory traversal flags include both files and directories,
         even hidden.
@@ -10,6 +10,15 @@
     @class wxArchiveFSHandler
 
     A file system handler for accessing files inside of archives.
+
+    The catalog of each archive is read only once and cached by the handler.
+    Zip archives which are local files are memory mapped instead of being
+    read sequentially, so that opening any entry only requires reading their
+    central directory and the entry itself. Such archives are mapped again
+    if their size or modification time changes, but the streams opened
+    before keep using the old mapping, so the archive files should be
+    replaced, e.g. by renaming the new file over the old one, rather than
+    being modified in place while they are being read. Since wxWidgets 3.1.5.
 */
 class wxArchiveFSHandler : public wxFileSystemHandler
 {
@@ -484,6 +484,16 @@ public:
         that of the new context as the context copies its contents back to the
         image when it is destroyed.
 
+        The image should not be modified directly while the context exists.
+        Notice that, since wxWidgets 3.1.5, the Cairo-based context only
+        copies back the pixels drawn on since the last Flush(), so that any
+        changes done to the other pixels of the image are preserved, while
+        they were overwritten by the previous versions and still are by the
+        other implementations. The entire image is still overwritten if its
+        format differs from the format of the context, e.g. if the image has a
+        mask, or if the native context returned by GetNativeContext() was
+        used for drawing.
+
         @since 2.9.3
      */
     static wxGraphicsContext* Create(wxImage& image);
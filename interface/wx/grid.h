@@ -5572,6 +5572,9 @@ public:
         Causes immediate repainting of the grid.
 
         Use this instead of the usual wxWindow::Refresh().
+
+        Notice that this function also invalidates the cached cell attributes,
+        see RefreshAttrs().
     */
     void ForceRefresh();
 
@@ -5698,9 +5701,9 @@ public:
     /**
         Invalidates the cached attribute for the given cell.
 
-        For efficiency reasons, wxGrid may cache the recently used attributes
-        (currently it caches only the single most recently used one, in fact)
-        which can result in the cell appearance not being refreshed even when
+        For efficiency reasons, wxGrid caches the recently used attributes
+        (typically the attributes of all the currently visible cells) which
+        can result in the cell appearance not being refreshed even when
         the attribute returned by your custom wxGridCellAttrProvider-derived
         class has changed. To force the grid to refresh the cell attribute,
         this function may be used. Notice that calling it will not result in
@@ -5720,6 +5723,43 @@ public:
      */
     void RefreshAttr(int row, int col);
 
+    /**
+        Invalidates the cached attributes of all cells.
+
+        This is similar to RefreshAttr() but affects all the cells and should
+        be used if the attributes returned by a custom attributes provider or
+        by overridden wxGridTableBase::GetAttr() may have changed for many of
+        them. Notice that the grid caches the absence of an attribute for a
+        cell too, so this function also needs to be called if a cell which
+        didn't have any attribute before may have one now.
+
+        The cache is also invalidated by ForceRefresh(), when the table sends
+        a message to the grid using ProcessTableMessage() and when a new
+        attributes provider is set with wxGridTableBase::SetAttrProvider(), so
+        it isn't necessary to call this function in these cases.
+
+        @since 3.1.5
+     */
+    void RefreshAttrs();
+
+    /**
+        Returns the statistics about the attribute cache usage.
+
+        This function can be used to check how efficient is the cache of the
+        cell attributes (see RefreshAttr()) for the given grid, which may be
+        useful when implementing a custom wxGridCellAttrProvider.
+
+        @param hits
+            If non-@NULL, receives the number of the attribute lookups which
+            were satisfied from the cache since the grid creation.
+        @param misses
+            If non-@NULL, receives the number of the attribute lookups which
+            had to query the grid table since the grid creation.
+
+        @since 3.1.5
+     */
+    void GetAttrCacheStatistics(size_t *hits, size_t *misses) const;
+
     /**
         Draws part or all of a wxGrid on a wxDC for printing or display.
 
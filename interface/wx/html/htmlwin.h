@@ -187,6 +187,10 @@ public:
     /**
         Appends HTML fragment to currently displayed text and refreshes the window.
 
+        By default, the entire page, including the new fragment, is parsed
+        again, which becomes slow when appending many fragments to the same
+        page. Use EnableIncrementalAppend() to avoid this.
+
         @param source
             HTML code fragment
 
@@ -194,6 +198,31 @@ public:
     */
     bool AppendToPage(const wxString& source);
 
+    /**
+        Enables or disables incremental mode of AppendToPage().
+
+        In this mode, AppendToPage() parses only the new fragment and adds the
+        resulting cells to the end of the existing page, without parsing or
+        laying out the already displayed contents again. This makes appending
+        fast even to very long pages, e.g. when using wxHtmlWindow for showing
+        a log or a chat.
+
+        Notice that each fragment is parsed independently in this mode, i.e.
+        it starts with the default colours and fonts and the tags opened in
+        it must be also closed in it, unlike in the default mode in which
+        the fragment is parsed as part of the entire page. Also notice that
+        the source of the parser returned by GetParser() only contains the last
+        appended fragment, and not the entire page, after AppendToPage() is
+        called in this mode.
+
+        Incremental mode is disabled by default.
+
+        @see SetMaxAppendedFragments()
+
+        @since 3.1.5
+    */
+    void EnableIncrementalAppend(bool enable = true);
+
     /**
         Returns pointer to the top-level container.
 
@@ -201,6 +230,16 @@ public:
     */
     wxHtmlContainerCell* GetInternalRepresentation() const;
 
+    /**
+        Returns the maximal number of fragments kept by AppendToPage() in
+        incremental mode.
+
+        @see SetMaxAppendedFragments()
+
+        @since 3.1.5
+    */
+    size_t GetMaxAppendedFragments() const;
+
     /**
         Returns anchor within currently opened page (see wxHtmlWindow::GetOpenedPage).
         If no page is opened or if the displayed page wasn't produced by call to
@@ -260,6 +299,15 @@ public:
     */
     bool HistoryForward();
 
+    /**
+        Returns @true if incremental mode of AppendToPage() is enabled.
+
+        @see EnableIncrementalAppend()
+
+        @since 3.1.5
+    */
+    bool IsIncrementalAppendEnabled() const;
+
     /**
         Loads an HTML page from a file and displays it.
 
@@ -397,6 +445,23 @@ public:
     void SetFonts(const wxString& normal_face, const wxString& fixed_face,
                   const int* sizes = NULL);
 
+    /**
+        Sets the maximal number of fragments kept by AppendToPage() in
+        incremental mode.
+
+        When appending a fragment results in having more than the given
+        number of them, the oldest appended fragments are removed from the
+        page. The contents set by SetPage() is never removed.
+
+        The default value of 0 means that the number of fragments is not
+        limited.
+
+        @see EnableIncrementalAppend()
+
+        @since 3.1.5
+    */
+    void SetMaxAppendedFragments(size_t count);
+
     /**
         Sets default font sizes and/or default font size.
         See wxHtmlDCRenderer::SetStandardFonts for detailed description.
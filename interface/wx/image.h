@@ -790,7 +790,7 @@ public:
         specified pixel @a blurRadius. This should not be used when using
         a single mask colour for transparency.
 
-        @see BlurHorizontal(), BlurVertical()
+        @see BlurHorizontal(), BlurVertical(), BlurGaussian()
     */
     wxImage Blur(int blurRadius) const;
 
@@ -810,6 +810,23 @@ public:
     */
     wxImage BlurVertical(int blurRadius) const;
 
+    /**
+        Applies approximate gaussian blur to the image.
+
+        The blur is approximated by applying the box blur, as done by Blur(),
+        several times, with the radii chosen to obtain the specified standard
+        deviation @a sigma, in pixels. The time taken by this function, as
+        well as by Blur(), doesn't depend on the blur radius.
+
+        This should not be used when using a single mask colour for
+        transparency.
+
+        @see Blur()
+
+        @since 3.1.5
+    */
+    wxImage BlurGaussian(double sigma) const;
+
     /**
         Returns a mirrored copy of the image.
         The parameter @a horizontally indicates the orientation.
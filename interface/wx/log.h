@@ -306,6 +306,12 @@ public:
         active log target is set to @NULL a new default log target will be
         created when logging occurs.
 
+        If the previous target is thread-safe, i.e. its IsThreadSafe() returns
+        @true, this function waits until all the other threads currently
+        logging to it are done, so that it can be safely deleted once this
+        function returns. Because of this, it must not be called from the
+        DoLogRecord() or other functions of such target.
+
         @see SetThreadActiveTarget()
     */
     static wxLog* SetActiveTarget(wxLog* logtarget);
@@ -633,6 +639,28 @@ protected:
     */
     virtual void DoLogText(const wxString& msg);
 
+    /**
+        Return true if this log target can be used from any thread.
+
+        By default, the messages logged from the threads other than the main
+        one are buffered and only passed to the active log target when
+        Flush() is called from the main thread. If this function returns
+        true, they are passed to DoLogRecord() immediately, in the thread
+        which logged them, instead. Notice that the repeated messages are
+        never counted in this case, even if SetRepetitionCounting() was used.
+
+        The base class version returns @false, override it if DoLogRecord()
+        of the derived class can be safely called from multiple threads at
+        once. Such target can still be replaced by calling SetActiveTarget()
+        at any moment, as this function waits until the target is not used by
+        any thread before returning it.
+
+        @see wxLogAsync
+
+        @since 3.1.5
+    */
+    virtual bool IsThreadSafe() const;
+
     //@}
 };
 
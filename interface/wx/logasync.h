@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     interface of wxLogAsync
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Policy used by wxLogAsync when the buffer of the thread logging a message
+    is full.
+
+    @see wxLogAsync::SetOverflowPolicy()
+
+    @since 3.1.5
+*/
+enum wxLogOverflowPolicy
+{
+    /// Wait until the writer thread writes out the buffered messages.
+    wxLOG_OVERFLOW_BLOCK,
+
+    /// Discard the message being logged.
+    wxLOG_OVERFLOW_DROP_NEW,
+
+    /// Discard the oldest message in the buffer to make space for the new one.
+    wxLOG_OVERFLOW_DROP_OLDEST
+};
+
+/**
+    @class wxLogAsync
+
+    Log target writing the messages to a C file stream from a separate thread.
+
+    Unlike wxLogStderr, this class doesn't format nor write the messages in
+    the thread logging them: they are only stored in a buffer, and a
+    dedicated writer thread periodically takes all the buffered messages,
+    formats them using the current wxLogFormatter and writes them out at
+    once. This makes logging much cheaper for the calling thread.
+
+    The messages logged from the threads other than the main one are also
+    handled in the same way, instead of being buffered until the main thread
+    flushes them, so this target can be used to log many messages from
+    worker threads without blocking the main one. Each thread uses its own
+    buffer, so the threads logging messages don't contend with each other.
+    Notice that logging is not lock-free however: each buffer is protected by
+    its own critical section, which is only contended when the writer thread
+    takes the messages from it. The buffers of the threads which haven't
+    logged anything for some time, e.g. because they have exited, are freed.
+
+    The time stamps of the messages are the times when they were logged and
+    not when they are written, and the messages logged by the different
+    threads are written in the order of their time stamps.
+
+    Notice that, unlike wxLogStderr, this target writes the debug and trace
+    messages to the same file as all the other ones. Also notice that, as the
+    formatter is used by the writer thread, SetFormatter() must be called
+    before logging anything.
+
+    Example of use:
+    @code
+    wxLogAsync* log = new wxLogAsync("app.log");
+    if ( log->IsOk() )
+    {
+        log->SetOverflowPolicy(wxLOG_OVERFLOW_DROP_OLDEST);
+        delete wxLog::SetActiveTarget(log);
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLogStderr
+
+    @since 3.1.5
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Constructs a log target writing the messages to the given @c FILE.
+
+        If @a fp is @NULL, the messages are written to @c stderr. The file
+        is not closed by this object.
+
+        The messages are written in the encoding specified by @a conv.
+    */
+    wxLogAsync(FILE* fp = NULL, const wxMBConv& conv = wxConvWhateverWorks);
+
+    /**
+        Constructs a log target appending the messages to the file with the
+        given name.
+
+        Use IsOk() to check whether the file could be opened.
+    */
+    wxLogAsync(const wxString& filename,
+               const wxMBConv& conv = wxConvWhateverWorks);
+
+    /**
+        Destructor writes out all the remaining messages and stops the writer
+        thread.
+
+        This object must not be the active log target any more when it is
+        destroyed.
+    */
+    virtual ~wxLogAsync();
+
+    /**
+        Return true if the log file was successfully opened.
+
+        If this function returns @false, all the messages are discarded.
+    */
+    bool IsOk() const;
+
+    /**
+        Set the maximal number of messages buffered for each thread.
+
+        When a thread logs a message and its buffer already contains this
+        number of messages, the overflow policy determines what happens.
+
+        The default capacity is 8192 messages. This function may be called at
+        any time, even while other threads are logging messages.
+    */
+    void SetBufferCapacity(size_t capacity);
+
+    /**
+        Return the maximal number of messages buffered for each thread.
+    */
+    size_t GetBufferCapacity() const;
+
+    /**
+        Set the policy used when the buffer of a thread is full.
+
+        The default policy is wxLOG_OVERFLOW_BLOCK, which never loses any
+        messages. This function may be called at any time, even while other
+        threads are logging messages.
+    */
+    void SetOverflowPolicy(wxLogOverflowPolicy policy);
+
+    /**
+        Return the policy used when the buffer of a thread is full.
+    */
+    wxLogOverflowPolicy GetOverflowPolicy() const;
+
+    /**
+        Set the maximal time between logging a message and writing it out.
+
+        The writer thread writes out the buffered messages at least this
+        often, and also sooner if the buffer of any thread becomes half full.
+
+        The default interval is 50ms. This function may be called at any
+        time, the new interval is taken into account immediately.
+
+        @param ms
+            The interval in milliseconds, must be positive.
+    */
+    void SetFlushInterval(unsigned long ms);
+
+    /**
+        Return the maximal time between logging a message and writing it out.
+
+        @see SetFlushInterval()
+    */
+    unsigned long GetFlushInterval() const;
+
+    /**
+        Return the number of messages discarded due to buffer overflow.
+
+        This is always 0 when using wxLOG_OVERFLOW_BLOCK policy.
+    */
+    size_t GetDroppedCount() const;
+
+    /**
+        Write out all the messages logged so far.
+
+        Unlike the writes done by the writer thread, this function writes
+        the messages in the calling thread and only returns once they have
+        all been written.
+    */
+    virtual void Flush();
+};
@@ -81,6 +81,14 @@ enum
     It is possible to use the other if preferred by selecting it when building
     the wxWidgets.
 
+    Since wxWidgets 3.1.5, the compiled regular expressions are cached, so
+    creating a wxRegEx object for a pattern which had been already used by
+    another object, which doesn't exist any more, is cheap. Also, when the
+    pattern contains a literal string which must be present in any text
+    matching it, Matches() and Replace() check for it before running the
+    regular expression engine, making them much faster for the text which
+    doesn't match the pattern.
+
     @library{wxbase}
     @category{data}
 
@@ -3052,6 +3052,16 @@ public:
     */
     virtual void Move(const wxPoint& pt);
 
+    /**
+        Called when children are added, removed or replaced. This is done by
+        all the functions of this class modifying the children, but must be
+        called explicitly after modifying the list returned by GetChildren()
+        directly.
+
+        @since 3.1.5
+    */
+    virtual void OnChildrenChanged();
+
 protected:
     wxRichTextObjectList    m_children;
 };
@@ -3240,6 +3250,16 @@ public:
     */
     virtual wxRichTextParagraph* GetParagraphAtPosition(long pos, bool caretPosition = false) const;
 
+    /**
+        Updates the index used for finding the children by position after
+        replacing the data of the list node of @a oldChild with @a newChild,
+        which must have the same range. This must be called before deleting
+        @a oldChild.
+
+        @since 3.1.5
+    */
+    void ReplaceChildInIndex(wxRichTextObject* oldChild, wxRichTextObject* newChild);
+
     /**
         Returns the line size at the given position.
     */
@@ -209,6 +209,29 @@ public:
     bool Advise(const wxString& item, const wxString data);
     //@}
 
+    /**
+        Enables or disables the compression of the data exchanged over this
+        connection.
+
+        The compression is negotiated with the other side of the connection
+        and, once enabled, applies to the data sent in both directions, i.e.
+        calling this function on either side is enough. The data of all the
+        messages, such as the data passed to Poke() or Advise(), is compressed
+        using zlib if it is big enough for this to be worthwhile.
+
+        This function can only be called once the connection is established
+        and it waits for the reply of the other side, so it must not be called
+        while the other side could be sending other data, e.g. advise
+        notifications.
+
+        Returns @true if successful or @false if the other side doesn't
+        support compression, e.g. because it uses an older version of
+        wxWidgets, or if wxWidgets was built without zlib support.
+
+        @since 3.1.5
+    */
+    bool Compress(bool on);
+
     /**
         Called by the client or server application to disconnect from the other
         program; it causes the OnDisconnect() message to be sent to the
@@ -461,6 +461,14 @@ public:
     */
     void SetContainingWindow(wxWindow *window);
 
+    /**
+        Returns the sizer containing this one as an item or @NULL if this is a
+        top level sizer.
+
+        @since 3.1.5
+    */
+    wxSizer* GetContainingSizer() const;
+
     /**
        Returns the number of items in the sizer.
 
@@ -509,9 +517,31 @@ public:
         In particular, if you use the value to set toplevel window's minimal or
         actual size, use wxWindow::SetMinClientSize() or wxWindow::SetClientSize(),
         not wxWindow::SetMinSize() or wxWindow::SetSize().
+
+        Notice that the standard sizers cache the value returned by CalcMin()
+        and only compute it again after something affecting it changes, see
+        InvalidateMinSize().
     */
     wxSize GetMinSize();
 
+    /**
+        Invalidates the minimal size cached by this sizer and all the sizers
+        containing it, directly or via a window using this sizer.
+
+        The standard sizers (wxBoxSizer, wxStaticBoxSizer, wxGridSizer and
+        wxFlexGridSizer) don't recompute their minimal size during each
+        layout but only when any of their items changes, i.e. is added,
+        removed, shown or hidden, or has its minimal size, flags, border or
+        proportion changed, or when the best size of any window in the sizer
+        is invalidated using wxWindow::InvalidateBestSize(). This is done
+        automatically, but if a class deriving from one of these sizers
+        overrides CalcMin() in a way depending on anything else, it must call
+        this function when it changes.
+
+        @since 3.1.5
+    */
+    void InvalidateMinSize();
+
     /**
         Returns the current position of the sizer.
     */
@@ -1214,6 +1244,14 @@ public:
     */
     wxSizer* GetSizer() const;
 
+    /**
+        Return the sizer this item belongs to or @NULL if it wasn't added to
+        any sizer yet.
+
+        @since 3.1.5
+    */
+    wxSizer* GetContainingSizer() const;
+
     /**
         If this item is tracking a spacer, return its size.
     */
@@ -34,7 +34,8 @@ enum wxTextFileType
     not work in this way with large files (as an estimation, anything over 1 Megabyte
     is surely too big for this class). On the other hand, it is not a serious
     limitation for small files like configuration files or program sources
-    which are well handled by wxTextFile.
+    which are well handled by wxTextFile. And big files can still be handled
+    efficiently if they are opened using OpenMapped() instead of Open().
 
     The typical things you may do with wxTextFile in order are:
 
@@ -270,6 +271,36 @@ public:
     */
     bool Open(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
 
+    /**
+        Opens the file with the given name without loading it in memory.
+
+        This function maps the file in memory instead and only decodes its
+        lines when they are accessed, which allows to get the first lines of
+        even a huge file almost immediately while using a small, constant
+        amount of memory for the decoded lines. Notice that GetLineCount() still
+        needs to find all the lines in the file, which is done using several
+        threads for the big files, but doesn't decode them.
+
+        The references returned by GetLine() and the other functions returning
+        the lines remain valid only until 255 other lines are accessed. The
+        lines may still be modified using them and the changes are preserved,
+        as only the modified lines are kept in memory in addition to the most
+        recently accessed ones. Any function adding or removing lines, such as
+        AddLine(), InsertLine() or RemoveLine(), and Write() load all the
+        lines in memory, exactly as if Open() had been used.
+
+        The file must not be modified by another process while it is mapped,
+        i.e. until Close() is called.
+
+        If the file can't be mapped or its encoding uses line terminators which
+        can't be found without decoding it, this function falls back to simply
+        calling Open().
+
+        @since 3.1.5
+    */
+    bool OpenMapped(const wxString& strFile,
+                    const wxMBConv& conv = wxConvAuto());
+
     /**
         Delete line number @a n from the file.
     */
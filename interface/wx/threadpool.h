@@ -0,0 +1,254 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool, wxThreadPoolTask and wxFuture<R>
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Base class for the tasks executed by wxThreadPool.
+
+    Derive from this class and override Run() to define a task which can be
+    passed to wxThreadPool::SubmitTask(). Notice that it is usually simpler to
+    use wxThreadPool::Submit() with a functor instead.
+
+    @since 3.1.5
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxThreadPoolTask
+{
+public:
+    /**
+        Default constructor.
+    */
+    wxThreadPoolTask();
+
+    /**
+        Destructor is called by the pool after executing the task.
+
+        It is also called if the task couldn't be executed at all.
+    */
+    virtual ~wxThreadPoolTask();
+
+    /**
+        Execute the task.
+
+        This function is called in one of the pool threads and so must not
+        use any GUI functions.
+    */
+    virtual void Run() = 0;
+};
+
+/**
+    The result of a task executed asynchronously by wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Async() and allow to
+    wait for the result of the task, retrieve it or register a continuation to
+    be called with it once it becomes available. They can be freely copied,
+    all copies referring to the same result.
+
+    @tparam R
+        The type of the result, it must be default constructible and
+        assignable.
+
+    @since 3.1.5
+
+    @nolibrary
+    @category{threading}
+
+    @see wxThreadPool
+*/
+template <typename R>
+class wxFuture<R>
+{
+public:
+    /**
+        Default constructor creates an invalid future.
+
+        Use wxThreadPool::Async() to create the valid ones.
+    */
+    wxFuture();
+
+    /**
+        Returns @true if this object refers to the result of a task.
+
+        None of the other methods may be called if this function returns
+        @false.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns @true if the result is already available.
+    */
+    bool IsReady() const;
+
+    /**
+        Blocks until the result becomes available.
+
+        This function must not be called from one of the pool threads unless
+        the result is already available, as this could result in a deadlock
+        if all the other pool threads were blocked too. Use Then() to process
+        the result in a pool thread instead.
+    */
+    void Wait() const;
+
+    /**
+        Blocks until the result becomes available or the given timeout
+        expires.
+
+        Returns @true if the result is available.
+    */
+    bool WaitTimeout(unsigned long milliseconds) const;
+
+    /**
+        Returns the result, blocking until it becomes available if necessary.
+
+        If the task function threw an exception, the default-constructed
+        value of @c R is returned.
+
+        Just as Wait(), this function must not be called from one of the pool
+        threads unless the result is already available.
+    */
+    const R& Get() const;
+
+    /**
+        Calls the given functor with the result in one of the pool threads once
+        it becomes available.
+
+        The functor must be callable with a single @c "const R&" argument.
+        If the result is already available, the functor is submitted to the
+        pool immediately.
+    */
+    template <typename T>
+    void Then(const T& fn) const;
+
+    /**
+        Calls the given functor with the result using
+        wxEvtHandler::CallAfter() on the given handler once it becomes
+        available.
+
+        This is typically used to pass the result of the task to the main
+        thread, e.g. to update the GUI. The functor must be callable with a
+        single @c "const R&" argument and the handler must not be destroyed
+        before it is called.
+    */
+    template <typename T>
+    void CallAfter(wxEvtHandler* handler, const T& fn) const;
+};
+
+/**
+    Thread pool executing tasks in a fixed number of worker threads.
+
+    By default, the pool uses as many threads as there are CPUs in the system.
+    Instead of creating a new pool, the shared one returned by Get() can, and
+    usually should, be used to avoid creating more threads than necessary.
+
+    Each worker thread has its own queue of tasks: the tasks submitted from
+    outside of the pool are distributed among these queues while the tasks
+    submitted from inside a pool thread are added to its own queue. Worker
+    threads without any tasks of their own take them from the queues of the
+    other threads.
+
+    Example of computing a value in the background and showing it in the GUI:
+    @code
+    struct ComputeSum
+    {
+        int operator()() const { ... compute the sum ... }
+    };
+
+    struct ShowSum
+    {
+        explicit ShowSum(wxStaticText* label) : m_label(label) { }
+
+        void operator()(const int& sum) const
+        {
+            m_label->SetLabel(wxString::Format("Sum is %d", sum));
+        }
+
+        wxStaticText* const m_label;
+    };
+
+    wxThreadPool::Get().Async<int>(ComputeSum()).CallAfter(this, ShowSum(label));
+    @endcode
+
+    @since 3.1.5
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThread, wxFuture
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Creates a pool with the given number of threads.
+
+        The default value of 0 means to use the number of CPUs as returned by
+        wxThread::GetCPUCount().
+    */
+    explicit wxThreadPool(int numThreads = 0);
+
+    /**
+        Destroys the pool after waiting until all the tasks submitted to it
+        finish executing.
+    */
+    ~wxThreadPool();
+
+    /**
+        Returns the shared pool object, creating it if necessary.
+
+        The shared pool is destroyed during the library cleanup.
+    */
+    static wxThreadPool& Get();
+
+    /**
+        Returns the number of worker threads of the pool.
+    */
+    int GetThreadCount() const;
+
+    /**
+        Returns @true if called from one of the threads of this pool.
+    */
+    bool IsPoolThread() const;
+
+    /**
+        Submits the task for execution in one of the pool threads.
+
+        The pool takes ownership of the task and deletes it after executing
+        it. If the pool doesn't have any threads, the task is deleted
+        immediately and @false is returned.
+
+        This function can be called from any thread.
+    */
+    bool SubmitTask(wxThreadPoolTask* task);
+
+    /**
+        Submits a functor for execution in one of the pool threads.
+
+        The functor must be callable without arguments and is copied.
+    */
+    template <typename T>
+    bool Submit(const T& fn);
+
+    /**
+        Submits a functor returning a value of type @c R for execution and
+        returns the future which can be used to retrieve this value.
+
+        Notice that the type @c R must be specified explicitly, e.g.
+        @code
+        wxFuture<int> future = pool.Async<int>(fn);
+        @endcode
+    */
+    template <typename R, typename T>
+    wxFuture<R> Async(const T& fn);
+
+    /**
+        Blocks until all the tasks submitted to the pool finish executing.
+
+        This function must not be called from one of the pool threads.
+    */
+    void WaitIdle();
+};
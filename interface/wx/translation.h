@@ -342,6 +342,22 @@ public:
 class wxFileTranslationsLoader : public wxTranslationsLoader
 {
 public:
+    /**
+        Constructor.
+
+        @param flags
+            Flags passed to wxMsgCatalog::CreateFromFile() when loading the
+            catalogs. Use ::wxMSGCATALOG_LAZY to make loading the catalogs
+            faster and less memory-consuming, e.g.
+            @code
+            wxTranslations::Get()->SetLoader(
+                new wxFileTranslationsLoader(wxMSGCATALOG_LAZY));
+            @endcode
+
+        @since 3.1.5
+    */
+    explicit wxFileTranslationsLoader(int flags = wxMSGCATALOG_DEFAULT);
+
     /**
         Add a prefix to the catalog lookup path: the message catalog files will
         be looked up under prefix/lang/LC_MESSAGES and prefix/lang directories
@@ -400,6 +416,31 @@ protected:
 };
 
 
+/**
+    Flags for wxMsgCatalog::CreateFromFile() and wxMsgCatalog::CreateFromData().
+
+    @since 3.1.5
+ */
+enum wxMsgCatalogFlags
+{
+    /// Default behaviour: all strings are converted when loading the catalog.
+    wxMSGCATALOG_DEFAULT = 0,
+
+    /**
+        Don't convert the strings when loading the catalog.
+
+        With this flag, the catalog file is memory-mapped, if possible, and
+        the strings are looked up using the hash table stored in it and
+        converted to wxString only when they are used for the first time.
+        This makes loading big catalogs much faster and uses less memory if
+        only a small part of their strings is used, at the price of making
+        the first lookup of each string slightly slower.
+
+        This flag is ignored in non-Unicode build.
+     */
+    wxMSGCATALOG_LAZY = 1
+};
+
 /**
     Represents a loaded translations message catalog.
 
@@ -417,23 +458,31 @@ public:
         @param filename  Path to the MO file to load.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
+        @param flags     Combination of ::wxMsgCatalogFlags values, this
+                         parameter is new since wxWidgets 3.1.5.
 
         @return Successfully loaded catalog or NULL on failure.
      */
     static wxMsgCatalog *CreateFromFile(const wxString& filename,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = wxMSGCATALOG_DEFAULT);
 
     /**
         Creates catalog from MO file data in memory buffer.
 
-        @param data      Data in MO file format.
+        @param data      Data in MO file format. If ::wxMSGCATALOG_LAZY is
+                         used and the buffer doesn't own its data, the data
+                         must remain valid for the lifetime of the catalog.
         @param domain    Catalog's domain. This typically matches
                          the @a filename.
+        @param flags     Combination of ::wxMsgCatalogFlags values, this
+                         parameter is new since wxWidgets 3.1.5.
 
         @return Successfully loaded catalog or NULL on failure.
      */
     static wxMsgCatalog *CreateFromData(const wxScopedCharBuffer& data,
-                                        const wxString& domain);
+                                        const wxString& domain,
+                                        int flags = wxMSGCATALOG_DEFAULT);
 };
 
 
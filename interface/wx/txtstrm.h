@@ -162,6 +162,40 @@ public:
     */
     wxString ReadLine();
 
+    /**
+        Reads the next line from the input stream into the provided string.
+
+        The line is stored in @a line without the end of line character(s)
+        and any previous contents of the string is discarded, but its buffer
+        is reused, so calling this function in a loop with the same string is
+        more efficient than calling ReadLine() returning a new string:
+        @code
+        wxString line;
+        while ( text.ReadLine(line) )
+        {
+            ... process the line ...
+        }
+        @endcode
+
+        Unlike all the other functions of this class, this one reads the data
+        from the stream and decodes it in big blocks instead of doing it one
+        character at a time, which makes it much faster for reading big
+        amounts of text. Because of this, it may read more data from the
+        underlying stream than it returns and so the stream shouldn't be used
+        directly after calling it, in particular its Eof() method can't be
+        used to check whether there are more lines, use the return value of
+        this function instead. Mixing this function with the other methods of
+        this class is fine, however.
+
+        @return @true if a line was read, possibly an empty one, or @false if
+            there are no more lines. @false is also returned if the input
+            couldn't be decoded, the underlying stream is put into the
+            wxSTREAM_READ_ERROR state in this case.
+
+        @since 3.1.5
+    */
+    bool ReadLine(wxString& line);
+
     /**
         @deprecated Use ReadLine() or ReadWord() instead.
 
@@ -934,3 +934,237 @@ public:
     */
     static wxVersionInfo GetLibraryVersionInfo();
 };
+
+
+/**
+    Types of the items returned by wxXmlReader::Next().
+
+    @since 3.1.5
+*/
+enum wxXmlReaderEvent
+{
+    /// End of the document was reached or a parsing error occurred.
+    wxXML_EVENT_EOF,
+
+    /// Start of an element, its name and attributes are available.
+    wxXML_EVENT_START_ELEMENT,
+
+    /// End of an element, only its name is available.
+    wxXML_EVENT_END_ELEMENT,
+
+    /// Text, possibly spanning several lines.
+    wxXML_EVENT_TEXT,
+
+    /// Contents of a CDATA section.
+    wxXML_EVENT_CDATA,
+
+    /// Comment.
+    wxXML_EVENT_COMMENT,
+
+    /// Processing instruction, its name is the target of the instruction.
+    wxXML_EVENT_PI
+};
+
+/**
+    @class wxXmlReader
+
+    Pull parser allowing to process XML documents sequentially.
+
+    Unlike wxXmlDocument, this class doesn't load the entire document in
+    memory but returns its contents item by item, so that the amount of memory
+    needed to process the document doesn't depend on its size. This makes it
+    suitable for the processing of big documents or of the documents in which
+    only a small part of the data is needed.
+
+    Elements which are not needed can be skipped using SkipElement(), which is
+    much faster than iterating over all their contents, and the elements which
+    are needed can be loaded as a whole using ReadElement(). FindElement()
+    combines these functions to allow loading only the elements with the
+    given path:
+
+    @code
+    wxFileInputStream stream("catalog.xml");
+    wxXmlReader reader(stream);
+    while ( reader.FindElement("catalog/items/item") )
+    {
+        if ( reader.GetAttribute("type") != "book" )
+            continue;
+
+        wxXmlDocument doc;
+        doc.SetRoot(reader.ReadElement());
+
+        ... process the document containing just this item ...
+    }
+
+    if ( reader.HasError() )
+        ... the document is malformed ...
+    @endcode
+
+    Note that the text items are merged together, i.e. a single
+    wxXML_EVENT_TEXT is returned for the text between two tags, and that the
+    text items consisting of whitespace only are not returned by default, as
+    with wxXmlDocument.
+
+    @since 3.1.5
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlDocument
+*/
+class wxXmlReader
+{
+public:
+    /**
+        Creates the reader for the given stream.
+
+        The stream is read on demand and must remain valid for the entire
+        lifetime of the reader.
+
+        @param stream
+            The stream containing XML data.
+        @param flags
+            Either wxXMLDOC_NONE or wxXMLDOC_KEEP_WHITESPACE_NODES to return
+            the text items consisting of whitespace only too.
+        @param encoding
+            Only used in ANSI build, the encoding of the returned strings.
+    */
+    wxXmlReader(wxInputStream& stream,
+                int flags = wxXMLDOC_NONE,
+                const wxString& encoding = "UTF-8");
+
+    /**
+        Destroys the reader.
+    */
+    ~wxXmlReader();
+
+    /**
+        Advances to the next item and returns its type.
+
+        This function must be called to get the first item of the document
+        after creating the reader.
+
+        If wxXML_EVENT_EOF is returned, HasError() can be used to check if
+        the end of a well-formed document was reached.
+    */
+    wxXmlReaderEvent Next();
+
+    /**
+        Returns the type of the current item, i.e. the last value returned by
+        Next().
+    */
+    wxXmlReaderEvent GetEvent() const;
+
+    /**
+        Returns @true if a parsing error occurred.
+
+        The error is also logged using wxLogError().
+    */
+    bool HasError() const;
+
+    /**
+        Returns the name of the current element or the target of the current
+        processing instruction.
+
+        For the other items, this returns the name of the corresponding
+        wxXmlNode, e.g. "text" or "comment".
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the contents of the current text, CDATA, comment or processing
+        instruction item.
+    */
+    const wxString& GetContent() const;
+
+    /**
+        Returns the number of attributes of the current element.
+
+        This is 0 for any item other than wxXML_EVENT_START_ELEMENT.
+    */
+    size_t GetAttributesCount() const;
+
+    /**
+        Returns the name of the attribute with the given index.
+    */
+    const wxString& GetAttributeName(size_t n) const;
+
+    /**
+        Returns the value of the attribute with the given index.
+    */
+    const wxString& GetAttributeValue(size_t n) const;
+
+    /**
+        Returns @true if the current element has the attribute with the given
+        name and copies its value to @a value if it's non-@NULL.
+    */
+    bool GetAttribute(const wxString& attrName, wxString* value) const;
+
+    /**
+        Returns the value of the attribute with the given name or
+        @a defaultVal if the current element doesn't have it.
+    */
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+
+    /**
+        Returns @true if the current element has the attribute with the given
+        name.
+    */
+    bool HasAttribute(const wxString& attrName) const;
+
+    /**
+        Returns the depth of the current item.
+
+        The root element has depth 1, its children have depth 2 and so on.
+        The items other than elements have the depth of the element containing
+        them, i.e. 0 for the items outside of the root element.
+    */
+    int GetDepth() const;
+
+    /**
+        Returns the line number of the current item in the input.
+    */
+    int GetLineNumber() const;
+
+    /**
+        Skips the contents of the current element.
+
+        This function must be called when the current item is
+        wxXML_EVENT_START_ELEMENT and positions the reader at the matching
+        wxXML_EVENT_END_ELEMENT.
+
+        Returns @false if the end of the element couldn't be found because of
+        a parsing error.
+    */
+    bool SkipElement();
+
+    /**
+        Reads the current element with all its contents.
+
+        This function must be called when the current item is
+        wxXML_EVENT_START_ELEMENT and positions the reader at the matching
+        wxXML_EVENT_END_ELEMENT.
+
+        Returns the new node which must be deleted by the caller, e.g. by
+        passing it to wxXmlDocument::SetRoot(), or @NULL if a parsing error
+        occurred.
+    */
+    wxXmlNode* ReadElement();
+
+    /**
+        Advances to the start of the next element with the given path.
+
+        The path consists of the names of the elements separated by slashes,
+        starting with the root element, e.g. @c "root/items/item". The
+        special name @c "*" matches elements with any names.
+
+        All the elements not matching the path are skipped, as with
+        SkipElement(). Notice that if the current item is the start of an
+        element, its contents are searched too.
+
+        Returns @true if the element was found or @false if the end of the
+        document was reached.
+    */
+    bool FindElement(const wxString& path);
+};
@@ -619,5 +619,48 @@ public:
         @since 3.1.1
     */
     wxZipArchiveFormat GetFormat() const;
+
+    //@{
+    /**
+        Compresses the entries using several threads.
+
+        When this mode is enabled, the entries smaller than 1MiB are buffered
+        in memory and compressed concurrently by the threads of a
+        wxThreadPool while the following entries are being added, and the
+        bigger entries are compressed in blocks in parallel, as described in
+        wxZlibOutputStream::EnableParallelCompression(). The entries are
+        still written in the order in which they are added, and only the
+        compressed data may differ from that produced without this mode.
+
+        Notice that, as the small entries are written later, the parent
+        stream may not contain all the entries added so far until the next
+        big entry is created or Close() is called.
+
+        This function must be called before creating the first entry.
+
+        @param numThreads
+            If 0, the default, the shared thread pool returned by
+            wxThreadPool::Get() is used. Otherwise a new pool with the given
+            number of threads is created and used by this stream only.
+        @param pool
+            The pool to use, it must exist for as long as this stream does.
+
+        @return
+            @true if parallel compression was enabled or @false if it is not
+            available, e.g. because ::wxUSE_THREADS is 0 or this function is
+            called from one of the pool threads.
+
+        @since 3.1.5
+    */
+    bool EnableParallelCompression(int numThreads = 0);
+    bool EnableParallelCompression(wxThreadPool& pool);
+    //@}
+
+    /**
+        Returns @true if EnableParallelCompression() was successfully called.
+
+        @since 3.1.5
+    */
+    bool IsParallelCompressionEnabled() const;
 };
 
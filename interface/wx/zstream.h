@@ -88,6 +88,51 @@ public:
     bool SetDictionary(const char *data, size_t datalen);
     bool SetDictionary(const wxMemoryBuffer &buf);
     //@}
+
+    //@{
+    /**
+        Compresses the data using several threads.
+
+        In this mode the data is split in blocks of 128KiB which are
+        compressed independently by the threads of a wxThreadPool, using the
+        last 32KiB of the preceding data as the dictionary for each block, so
+        that the compression ratio is almost the same as when compressing the
+        data sequentially. The output is still a single stream in the format
+        specified when creating this object and can be decompressed by any
+        zlib or gzip implementation.
+
+        This is only worth doing when compressing big amounts of data, as the
+        data is buffered until a whole block is available. Notice that calling
+        Sync() also flushes the current block, so calling it often makes the
+        compression less efficient.
+
+        This function must be called before writing any data to the stream.
+
+        @param numThreads
+            If 0, the default, the shared thread pool returned by
+            wxThreadPool::Get() is used. Otherwise a new pool with the given
+            number of threads is created and used by this stream only.
+        @param pool
+            The pool to use, it must exist for as long as this stream does.
+
+        @return
+            @true if parallel compression was enabled or @false if it is not
+            available, e.g. because ::wxUSE_THREADS is 0 or this function is
+            called from one of the pool threads, in which case the data will
+            be compressed sequentially.
+
+        @since 3.1.5
+    */
+    bool EnableParallelCompression(int numThreads = 0);
+    bool EnableParallelCompression(wxThreadPool& pool);
+    //@}
+
+    /**
+        Returns @true if EnableParallelCompression() was successfully called.
+
+        @since 3.1.5
+    */
+    bool IsParallelCompressionEnabled() const;
 };
 
 
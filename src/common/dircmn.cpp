@@ -31,6 +31,12 @@
 #include "wx/dir.h"
 #include "wx/filename.h"
 
+#if wxUSE_THREADS
+    #include "wx/sharedptr.h"
+    #include "wx/threadpool.h"
+    #include "wx/vector.h"
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -90,6 +96,451 @@ wxString wxDir::GetNameWithSep() const
     return name;
 }
 
+// ----------------------------------------------------------------------------
+// helpers for parallel wxDir::Traverse()
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Allows to cancel reading the directories which are not needed any more:
+// reading is cancelled if this token or any of its parents is cancelled.
+class wxDirCancelToken
+{
+public:
+    explicit wxDirCancelToken(const wxSharedPtr<wxDirCancelToken>& parent)
+        : m_parent(parent),
+          m_cancelled(0)
+    {
+    }
+
+    void Cancel() { wxAtomicInc(m_cancelled); }
+
+    bool IsCancelled() const
+    {
+        for ( const wxDirCancelToken* token = this;
+              token;
+              token = token->m_parent.get() )
+        {
+            if ( token->m_cancelled )
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    const wxSharedPtr<wxDirCancelToken> m_parent;
+    wxAtomicInt m_cancelled;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirCancelToken);
+};
+
+typedef wxSharedPtr<wxDirCancelToken> wxDirCancelTokenPtr;
+
+class wxDirListQueue;
+
+// The contents of a single directory, read in one of the pool threads.
+class wxDirListing
+{
+public:
+    wxDirListing(const wxString& name, const wxDirCancelTokenPtr& parentToken)
+        : m_name(name),
+          m_token(new wxDirCancelToken(parentToken)),
+          m_ok(false)
+    {
+    }
+
+    // Read the names of the files and subdirectories in the same way as the
+    // sequential wxDir::Traverse() does, without logging any errors.
+    void Read(const wxString& filespec, int flags);
+
+    // Start reading all the subdirectories in the pool threads, but not their
+    // own subdirectories: this is only done when the traversal reaches them,
+    // to avoid reading the entire tree in advance.
+    void ReadSubdirsAsync(const wxString& filespec, int flags);
+
+    // Wait until the given subdirectory is read and return it.
+    wxDirListing& GetSubdir(size_t n) const
+    {
+        m_subdirsRead[n].Wait();
+        return *m_subdirs[n];
+    }
+
+    // Avoid reading the given subdirectory if it's not being read yet.
+    void CancelSubdir(size_t n) const
+    {
+        m_subdirs[n]->m_token->Cancel();
+    }
+
+    // Free the given subdirectory once it's not needed any more, it must not
+    // be used after calling this.
+    void ReleaseSubdir(size_t n)
+    {
+        m_subdirs[n].reset();
+        m_subdirsRead[n] = wxFuture<bool>();
+    }
+
+    const wxString m_name;
+    const wxDirCancelTokenPtr m_token;
+
+    bool m_ok;
+    wxVector<wxString> m_dirs,
+                       m_files;
+
+private:
+    // Only used by ReadSubdirsAsync(): the listings of m_dirs, which can only
+    // be used once the corresponding future becomes ready.
+    wxVector< wxSharedPtr<wxDirListing> > m_subdirs;
+    wxVector< wxFuture<bool> > m_subdirsRead;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirListing);
+};
+
+typedef wxSharedPtr<wxDirListing> wxDirListingPtr;
+
+// Queue of the directories which have been read, used for the unordered
+// traversal.
+class wxDirListQueue
+{
+public:
+    wxDirListQueue() : m_cond(m_mutex) { }
+
+    void Post(const wxDirListingPtr& listing)
+    {
+        wxMutexLocker lock(m_mutex);
+        m_listings.push_back(listing);
+        m_cond.Signal();
+    }
+
+    // Wait until at least one directory is read and return it. Return the
+    // most recently read one to traverse the tree in depth first order as
+    // much as possible, as this limits the number of directories in memory.
+    wxDirListingPtr Wait()
+    {
+        wxMutexLocker lock(m_mutex);
+        while ( m_listings.empty() )
+            m_cond.Wait();
+
+        const wxDirListingPtr listing = m_listings.back();
+        m_listings.pop_back();
+        return listing;
+    }
+
+private:
+    wxMutex m_mutex;
+    wxCondition m_cond;
+    wxVector<wxDirListingPtr> m_listings;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirListQueue);
+};
+
+// Task reading a directory and, for the unordered traversal, posting it to
+// the queue.
+class wxDirReadFunctor
+{
+public:
+    wxDirReadFunctor(const wxDirListingPtr& listing,
+                     const wxString& filespec,
+                     int flags,
+                     wxDirListQueue* queue)
+        : m_listing(listing),
+          m_filespec(filespec.Clone()),
+          m_flags(flags),
+          m_queue(queue)
+    {
+    }
+
+    bool operator()() const
+    {
+        if ( !m_listing->m_token->IsCancelled() )
+            m_listing->Read(m_filespec, m_flags);
+
+        if ( m_queue )
+            m_queue->Post(m_listing);
+
+        return true;
+    }
+
+private:
+    const wxDirListingPtr m_listing;
+    const wxString m_filespec;
+    const int m_flags;
+    wxDirListQueue* const m_queue;
+
+    wxDECLARE_NO_ASSIGN_CLASS(wxDirReadFunctor);
+};
+
+void wxDirListing::Read(const wxString& filespec, int flags)
+{
+    wxLogNull noLog;
+
+    wxDir dir;
+    m_ok = dir.Open(m_name);
+    if ( !m_ok )
+        return;
+
+    const wxString prefix = dir.GetNameWithSep();
+
+    wxString filename;
+    for ( bool cont = dir.GetFirst(&filename, wxEmptyString,
+                                   (flags & ~(wxDIR_FILES | wxDIR_DOTDOT))
+                                   | wxDIR_DIRS);
+          cont;
+          cont = dir.GetNext(&filename) )
+    {
+        m_dirs.push_back(prefix + filename);
+    }
+
+    if ( flags & wxDIR_FILES )
+    {
+        for ( bool cont = dir.GetFirst(&filename, filespec, flags & ~wxDIR_DIRS);
+              cont;
+              cont = dir.GetNext(&filename) )
+        {
+            m_files.push_back(prefix + filename);
+        }
+    }
+}
+
+void wxDirListing::ReadSubdirsAsync(const wxString& filespec, int flags)
+{
+    wxThreadPool& pool = wxThreadPool::Get();
+
+    const size_t count = m_dirs.size();
+    m_subdirs.reserve(count);
+    m_subdirsRead.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxDirListingPtr subdir(new wxDirListing(m_dirs[n].Clone(), m_token));
+        m_subdirs.push_back(subdir);
+        m_subdirsRead.push_back(
+            pool.Async<bool>(wxDirReadFunctor(subdir, filespec, flags, NULL)));
+    }
+}
+
+// Implements wxDir::Traverse() with wxDIR_PARALLEL: the directories are read
+// in the pool threads while all the sink functions are called from the thread
+// calling Traverse().
+class wxDirParallelTraverser
+{
+public:
+    wxDirParallelTraverser(wxDirTraverser& sink,
+                           const wxString& filespec,
+                           int flags)
+        : m_sink(sink),
+          m_filespec(filespec),
+          m_flags(flags),
+          m_nFiles(0),
+          m_pending(0)
+    {
+    }
+
+    // Return the number of files found.
+    size_t Traverse(const wxString& dirname);
+
+private:
+    // All the functions below return false if the traversal must be stopped.
+
+    // Call OnOpenError() for the directory which couldn't be read and read it
+    // again if requested, synchronously.
+    bool HandleOpenError(wxDirListing& listing);
+
+    bool ProcessFiles(const wxDirListing& listing);
+
+    // Process the given directory and all its subdirectories in the same
+    // order as the sequential traversal. Only the subdirectories of the
+    // directories being processed are read in advance and each of them is
+    // freed as soon as it has been processed.
+    bool ProcessOrdered(wxDirListing& listing);
+
+    // Process just this directory, starting to read the subdirectories which
+    // should be traversed.
+    bool ProcessUnordered(wxDirListing& listing);
+
+
+    wxDirTraverser& m_sink;
+    const wxString m_filespec;
+    const int m_flags;
+
+    size_t m_nFiles;
+
+    // Only used for the unordered traversal: the queue of the directories
+    // which have been read and the number of those still being read.
+    wxDirListQueue m_queue;
+    size_t m_pending;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirParallelTraverser);
+};
+
+bool wxDirParallelTraverser::HandleOpenError(wxDirListing& listing)
+{
+    while ( !listing.m_ok )
+    {
+        switch ( m_sink.OnOpenError(listing.m_name) )
+        {
+            default:
+                wxFAIL_MSG(wxT("unexpected OnOpenError() return value") );
+                wxFALLTHROUGH;
+
+            case wxDIR_STOP:
+                return false;
+
+            case wxDIR_IGNORE:
+                return true;
+
+            case wxDIR_CONTINUE:
+                listing.Read(m_filespec, m_flags);
+                break;
+        }
+    }
+
+    return true;
+}
+
+bool wxDirParallelTraverser::ProcessFiles(const wxDirListing& listing)
+{
+    const size_t count = listing.m_files.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxDirTraverseResult res = m_sink.OnFile(listing.m_files[n]);
+        if ( res == wxDIR_STOP )
+            return false;
+
+        wxASSERT_MSG( res == wxDIR_CONTINUE,
+                      wxT("unexpected OnFile() return value") );
+
+        m_nFiles++;
+    }
+
+    return true;
+}
+
+bool wxDirParallelTraverser::ProcessOrdered(wxDirListing& listing)
+{
+    listing.ReadSubdirsAsync(m_filespec, m_flags);
+
+    const size_t count = listing.m_dirs.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        switch ( m_sink.OnDir(listing.m_dirs[n]) )
+        {
+            default:
+                wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                wxFALLTHROUGH;
+
+            case wxDIR_STOP:
+                return false;
+
+            case wxDIR_CONTINUE:
+                {
+                    wxDirListing& subdir = listing.GetSubdir(n);
+                    if ( !HandleOpenError(subdir) )
+                        return false;
+
+                    if ( subdir.m_ok && !ProcessOrdered(subdir) )
+                        return false;
+                }
+                break;
+
+            case wxDIR_IGNORE:
+                // the subdirectory may be still waiting to be read
+                listing.CancelSubdir(n);
+                break;
+        }
+
+        listing.ReleaseSubdir(n);
+    }
+
+    return ProcessFiles(listing);
+}
+
+bool wxDirParallelTraverser::ProcessUnordered(wxDirListing& listing)
+{
+    if ( !listing.m_ok && !HandleOpenError(listing) )
+        return false;
+
+    const size_t count = listing.m_dirs.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxString& dirname = listing.m_dirs[n];
+
+        switch ( m_sink.OnDir(dirname) )
+        {
+            default:
+                wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                wxFALLTHROUGH;
+
+            case wxDIR_STOP:
+                return false;
+
+            case wxDIR_CONTINUE:
+                {
+                    const wxDirListingPtr
+                        subdir(new wxDirListing(dirname.Clone(), listing.m_token));
+
+                    m_pending++;
+                    wxThreadPool::Get().Submit(
+                        wxDirReadFunctor(subdir, m_filespec, m_flags, &m_queue));
+                }
+                break;
+
+            case wxDIR_IGNORE:
+                break;
+        }
+    }
+
+    return ProcessFiles(listing);
+}
+
+size_t wxDirParallelTraverser::Traverse(const wxString& dirname)
+{
+    const wxDirListingPtr root(new wxDirListing(dirname, wxDirCancelTokenPtr()));
+    root->Read(m_filespec, m_flags);
+
+    if ( m_flags & wxDIR_UNORDERED )
+    {
+        bool cont = ProcessUnordered(*root);
+        if ( !cont )
+            root->m_token->Cancel();
+
+        // we must wait for all the directories being read, even if we don't
+        // need them any more, as they use m_queue
+        for ( ; m_pending; m_pending-- )
+        {
+            const wxDirListingPtr listing = m_queue.Wait();
+            if ( cont && !ProcessUnordered(*listing) )
+            {
+                cont = false;
+                root->m_token->Cancel();
+            }
+        }
+    }
+    else // ordered
+    {
+        // handle the error reading the root directory in the same way as
+        // ProcessUnordered() does
+        bool cont = HandleOpenError(*root);
+        if ( cont && root->m_ok )
+            cont = ProcessOrdered(*root);
+
+        if ( !cont )
+        {
+            // there is no need to wait for the subdirectories being read in
+            // this case, just avoid reading any more of them
+            root->m_token->Cancel();
+        }
+    }
+
+    return m_nFiles;
+}
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
 // ----------------------------------------------------------------------------
 // wxDir::Traverse()
 // ----------------------------------------------------------------------------
@@ -101,6 +552,22 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
     wxCHECK_MSG( IsOpened(), (size_t)-1,
                  wxT("dir must be opened before traversing it") );
 
+#if wxUSE_THREADS
+    // parallel traversal only makes sense if we recurse into subdirectories,
+    // notice that even a single pool thread is useful as reading directories
+    // is IO-bound, but we must not wait for the pool threads if we're running
+    // in one of them ourselves
+    if ( (flags & wxDIR_PARALLEL) && (flags & wxDIR_DIRS) )
+    {
+        wxThreadPool& pool = wxThreadPool::Get();
+        if ( pool.GetThreadCount() > 0 && !pool.IsPoolThread() )
+        {
+            wxDirParallelTraverser traverser(sink, filespec, flags);
+            return traverser.Traverse(GetName());
+        }
+    }
+#endif // wxUSE_THREADS
+
     // the total number of files found
     size_t nFiles = 0;
 
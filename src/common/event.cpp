@@ -46,6 +46,8 @@
 
 #if wxUSE_BASE
     #include "wx/scopedptr.h"
+    #include "wx/vector.h"
+    #include "wx/weakref.h"
 
     wxDECLARE_SCOPED_PTR(wxEvent, wxEventPtr)
     wxDEFINE_SCOPED_PTR(wxEvent, wxEventPtr)
@@ -1134,6 +1136,299 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxDynamicEventTable
+// ----------------------------------------------------------------------------
+
+// This class stores the entries corresponding to the dynamically bound event
+// handlers of wxEvtHandler.
+//
+// The entries are kept in the order of their binding, as this is needed for
+// iterating over all of them, but are also indexed by their event type, so
+// that finding the handlers for the given event doesn't require examining all
+// the entries, as windows can easily have hundreds of them.
+//
+// Unbound entries are replaced by NULL pointers until they're pruned, this
+// allows to unbind the handlers while the table is being iterated over. They
+// are pruned when the last dispatch using the table finishes or when they
+// make up a big part of the table.
+//
+// The table is reference counted to allow the code dispatching the events to
+// keep using it even if the wxEvtHandler owning it is deleted by a handler.
+class wxDynamicEventTable : public wxRefCounter
+{
+public:
+    // indices of the entries with the same event type
+    typedef wxVector<size_t> Positions;
+
+    wxDynamicEventTable() : m_removed(0), m_dispatching(0) { }
+
+    size_t size() const { return m_entries.size(); }
+
+    wxDynamicEventTableEntry* operator[](size_t n) const
+    {
+        return m_entries[n];
+    }
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        DoFindPositions(entry->m_eventType, true)->push_back(m_entries.size());
+        m_entries.push_back(entry);
+    }
+
+    // mark the entry at the given index as unbound
+    void Remove(size_t n)
+    {
+        m_entries[n] = NULL;
+        m_removed++;
+    }
+
+    // must be called before and after iterating over the entries positions
+    void BeginDispatch() { m_dispatching++; }
+    void EndDispatch()
+    {
+        if ( --m_dispatching == 0 && m_removed )
+            Prune();
+    }
+
+    // prune the unbound entries if there are many of them and if it's safe
+    void PruneIfNeeded()
+    {
+        if ( !m_dispatching && m_removed > m_entries.size() / 2 )
+            Prune();
+    }
+
+    // return the indices of all entries with the given event type in the
+    // order of their binding or NULL if there are none
+    //
+    // the returned pointer remains valid for the lifetime of this object, but
+    // the positions themselves change after calling Prune()
+    const Positions* FindPositions(wxEventType eventType) const
+    {
+        return const_cast<wxDynamicEventTable*>(this)->
+                    DoFindPositions(eventType, false);
+    }
+
+protected:
+    virtual ~wxDynamicEventTable()
+    {
+        for ( size_t n = 0; n < m_types.size(); n++ )
+            delete m_types[n].positions;
+    }
+
+private:
+    // really remove all the entries previously passed to Remove()
+    void Prune()
+    {
+        m_removed = 0;
+
+        size_t nNew = 0;
+        for ( size_t n = 0; n != m_entries.size(); n++ )
+        {
+            if ( m_entries[n] )
+                m_entries[nNew++] = m_entries[n];
+        }
+
+        m_entries.resize(nNew);
+
+        // Notice that we preserve the existing Positions objects, even if
+        // they become empty, as pointers to them may be still in use.
+        for ( size_t n = 0; n < m_types.size(); n++ )
+            m_types[n].positions->clear();
+
+        for ( size_t n = 0; n < m_entries.size(); n++ )
+            DoFindPositions(m_entries[n]->m_eventType, false)->push_back(n);
+    }
+
+    struct TypeInfo
+    {
+        wxEventType eventType;
+        Positions* positions;
+    };
+
+    Positions* DoFindPositions(wxEventType eventType, bool create)
+    {
+        // m_types is sorted by event type, so use binary search in it
+        size_t lo = 0,
+               hi = m_types.size();
+        while ( lo < hi )
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if ( m_types[mid].eventType < eventType )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if ( lo < m_types.size() && m_types[lo].eventType == eventType )
+            return m_types[lo].positions;
+
+        if ( !create )
+            return NULL;
+
+        TypeInfo info;
+        info.eventType = eventType;
+        info.positions = new Positions;
+        m_types.insert(m_types.begin() + lo, info);
+
+        return info.positions;
+    }
+
+    // all the entries in the order of their binding
+    wxVector<wxDynamicEventTableEntry*> m_entries;
+
+    // the event types of all the entries, sorted by type
+    wxVector<TypeInfo> m_types;
+
+    // the number of unbound entries not pruned yet
+    size_t m_removed;
+
+    // the number of SearchDynamicEventTable() calls using this table
+    int m_dispatching;
+
+    wxDECLARE_NO_COPY_CLASS(wxDynamicEventTable);
+};
+
+namespace
+{
+
+// Keeps the table alive and prevents it from being pruned while dispatching.
+class wxDynamicEventTableDispatcher
+{
+public:
+    explicit wxDynamicEventTableDispatcher(wxDynamicEventTable& table)
+        : m_table(table)
+    {
+        m_table.IncRef();
+        m_table.BeginDispatch();
+    }
+
+    ~wxDynamicEventTableDispatcher()
+    {
+        m_table.EndDispatch();
+        m_table.DecRef();
+    }
+
+private:
+    wxDynamicEventTable& m_table;
+
+    wxDECLARE_NO_COPY_CLASS(wxDynamicEventTableDispatcher);
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxPendingEventQueue
+// ----------------------------------------------------------------------------
+
+// This is a FIFO queue of events used by wxEvtHandler for storing its pending
+// events: it uses a circular buffer to avoid allocating memory for each event
+// when many of them are queued, e.g. by worker threads.
+//
+// It is not thread-safe on its own, wxEvtHandler::m_pendingEventsLock must be
+// used to protect it.
+class wxPendingEventQueue
+{
+public:
+    wxPendingEventQueue()
+    {
+        m_first =
+        m_count = 0;
+        m_delayed = false;
+    }
+
+    ~wxPendingEventQueue()
+    {
+        DeleteAll();
+    }
+
+    bool IsEmpty() const { return m_count == 0; }
+    size_t GetCount() const { return m_count; }
+
+    // get the event at the given position, 0 corresponding to the oldest one
+    wxEvent* Get(size_t n) const
+    {
+        return m_events[(m_first + n) & (m_events.size() - 1)];
+    }
+
+    // add the event to the end of the queue, taking ownership of it
+    void Push(wxEvent* event)
+    {
+        if ( m_count == m_events.size() )
+            Grow();
+
+        m_events[(m_first + m_count) & (m_events.size() - 1)] = event;
+        m_count++;
+    }
+
+    // remove the event at the given position from the queue and return it,
+    // the caller becomes responsible for deleting it
+    //
+    // this is efficient for n == 0, which is the only common case
+    wxEvent* Extract(size_t n)
+    {
+        const size_t mask = m_events.size() - 1;
+
+        wxEvent* const event = Get(n);
+        if ( n == 0 )
+        {
+            m_first = (m_first + 1) & mask;
+        }
+        else // Extracting an event from the middle of the queue.
+        {
+            for ( size_t i = n + 1; i < m_count; i++ )
+                m_events[(m_first + i - 1) & mask] = Get(i);
+        }
+
+        if ( !--m_count )
+        {
+            m_first = 0;
+
+            // Don't keep a huge buffer around after a burst of events.
+            if ( m_events.size() > INITIAL_SIZE*64 )
+                wxVector<wxEvent*>(INITIAL_SIZE).swap(m_events);
+        }
+
+        return event;
+    }
+
+    // delete all the events in the queue
+    void DeleteAll()
+    {
+        while ( !IsEmpty() )
+            delete Extract(0);
+    }
+
+    // true if the processing of our events was postponed by
+    // wxAppConsoleBase::DelayPendingEventHandler()
+    bool m_delayed;
+
+private:
+    enum { INITIAL_SIZE = 8 };
+
+    void Grow()
+    {
+        // The buffer size must always be a power of 2 to allow computing the
+        // indices using a simple mask.
+        const size_t size = m_events.empty() ? static_cast<size_t>(INITIAL_SIZE)
+                                             : 2*m_events.size();
+
+        wxVector<wxEvent*> events(size);
+        for ( size_t n = 0; n < m_count; n++ )
+            events[n] = Get(n);
+
+        m_events.swap(events);
+        m_first = 0;
+    }
+
+    // the buffer containing m_count events starting at m_first
+    wxVector<wxEvent*> m_events;
+    size_t m_first,
+           m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventQueue);
+};
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1178,8 +1473,12 @@ wxEvtHandler::~wxEvtHandler()
 
             delete entry->m_callbackUserData;
             delete entry;
+
+            // The table may be still used if we're being deleted from an
+            // event handler, so ensure it doesn't refer to the entry.
+            m_dynamicEvents->Remove(cookie);
         }
-        delete m_dynamicEvents;
+        m_dynamicEvents->DecRef();
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1287,14 +1586,21 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
     if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+        m_pendingEvents = new wxPendingEventQueue;
 
-    m_pendingEvents->Append(event);
+    const bool wasEmpty = m_pendingEvents->IsEmpty();
+
+    m_pendingEvents->Push(event);
 
     // 2) Add this event handler to list of event handlers that
     //    have pending events.
-
-    wxTheApp->AppendPendingEventHandler(this);
+    //
+    //    This is only necessary if we didn't have any pending events yet or
+    //    if their processing had been delayed, as otherwise we must be
+    //    already present in this list.
+    const bool mustAppend = wasEmpty || m_pendingEvents->m_delayed;
+    if ( mustAppend )
+        wxTheApp->AppendPendingEventHandler(this);
 
     // only release m_pendingEventsLock now because otherwise there is a race
     // condition as described in the ticket #9093: we could process the event
@@ -1306,13 +1612,16 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
 
     // 3) Inform the system that new pending events are somewhere,
     //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    //
+    //    Again, this was already done when the previous pending event was
+    //    queued if we had any and, as all of them are processed together, it
+    //    is unnecessary to do it again (and it may be relatively expensive).
+    if ( mustAppend )
+        wxWakeUpIdle();
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
     wxDELETE(m_pendingEvents);
 }
 
@@ -1326,65 +1635,82 @@ void wxEvtHandler::ProcessPendingEvents()
         return;
     }
 
-    // we need to process only a single pending event in this call because
-    // each call to ProcessEvent() could result in the destruction of this
-    // same event handler (see the comment at the end of this function)
+    // we process all our pending events in this call, but each call to
+    // ProcessEvent() could result in the destruction of this same event
+    // handler, so we need to check if it's still alive after each of them
+    wxWeakRef<wxEvtHandler> self(this);
 
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    for ( bool first = true; ; first = false )
+    {
+        wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+        if ( !m_pendingEvents || m_pendingEvents->IsEmpty() )
+        {
+            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+            // this method is only called by wxApp if this handler does have
+            // pending events, but they could have been already processed or
+            // deleted during the processing of the previous one, e.g. from a
+            // nested event loop
+            wxASSERT_MSG( !first, "should have pending events if called" );
 
-    // find the first event which can be processed now:
-    wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
-    if (evtLoop && evtLoop->IsYielding())
-    {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
-        {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : NULL;
+            break;
         }
 
-        if (!node)
+        // we're being called by wxApp, so we can't be delayed any more
+        m_pendingEvents->m_delayed = false;
+
+        // find the first event which can be processed now:
+        size_t n = 0;
+        wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
+        if (evtLoop && evtLoop->IsYielding())
         {
-            // all our events are NOT processable now... signal this:
-            wxTheApp->DelayPendingEventHandler(this);
+            const size_t count = m_pendingEvents->GetCount();
+            while ( n < count &&
+                    !evtLoop->IsEventAllowedInsideYield(
+                        m_pendingEvents->Get(n)->GetEventCategory()) )
+            {
+                n++;
+            }
 
-            // see the comment at the beginning of evtloop.h header for the
-            // logic behind YieldFor() and behind DelayPendingEventHandler()
+            if ( n == count )
+            {
+                // all our events are NOT processable now... signal this:
+                wxTheApp->DelayPendingEventHandler(this);
+                m_pendingEvents->m_delayed = true;
 
-            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+                // see the comment at the beginning of evtloop.h header for the
+                // logic behind YieldFor() and behind DelayPendingEventHandler()
 
-            return;
+                wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+
+                break;
+            }
         }
-    }
 
-    wxEventPtr event(pEvent);
+        // it's important we remove event from list before processing it, else a
+        // nested event loop, for example from a modal dialog, might process the
+        // same event again.
+        wxEventPtr event(m_pendingEvents->Extract(n));
 
-    // it's important we remove event from list before processing it, else a
-    // nested event loop, for example from a modal dialog, might process the
-    // same event again.
-    m_pendingEvents->Erase(node);
+        const bool isLast = m_pendingEvents->IsEmpty();
+        if ( isLast )
+        {
+            // if there are no more pending events left, we don't need to
+            // stay in this list
+            wxTheApp->RemovePendingEventHandler(this);
+        }
 
-    if ( m_pendingEvents->IsEmpty() )
-    {
-        // if there are no more pending events left, we don't need to
-        // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
-    }
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+        ProcessEvent(*event);
 
-    ProcessEvent(*event);
-
-    // careful: this object could have been deleted by the event handler
-    // executed by the above ProcessEvent() call, so we can't access any fields
-    // of this object any more
+        // careful: this object could have been deleted by the event handler
+        // executed by the above ProcessEvent() call, so we can't access any
+        // fields of this object any more if this happened
+        if ( isLast || !self )
+            break;
+    }
 }
 
 /* static */
@@ -1758,12 +2084,12 @@ void wxEvtHandler::DoBind(int id,
     }
 
     if (!m_dynamicEvents)
-        m_dynamicEvents = new DynamicEvents;
+        m_dynamicEvents = new wxDynamicEventTable;
 
-    // We prefer to push back the entry here and then iterate over the vector
-    // in reverse direction in GetNextDynamicEntry() as it's more efficient
-    // than inserting the element at the front.
-    m_dynamicEvents->push_back(entry);
+    // We prefer to append the entry here and then iterate over the table in
+    // reverse direction in GetNextDynamicEntry() as it's more efficient than
+    // inserting the element at the front.
+    m_dynamicEvents->Add(entry);
 
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
@@ -1817,9 +2143,14 @@ wxEvtHandler::DoUnbind(int id,
             // Notice that we rely on "cookie" being just the index into the
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
-            (*m_dynamicEvents)[cookie] = NULL;
+            m_dynamicEvents->Remove(cookie);
 
             delete entry;
+
+            // Don't let the unbound entries accumulate if no events are
+            // processed by this handler any more.
+            m_dynamicEvents->PruneIfNeeded();
+
             return true;
         }
     }
@@ -1846,7 +2177,7 @@ wxEvtHandler::GetNextDynamicEntry(size_t& cookie) const
     {
         // Otherwise return the element at the previous index, skipping any
         // null elements which indicate removed entries.
-        wxDynamicEventTableEntry* const entry = m_dynamicEvents->at(--cookie);
+        wxDynamicEventTableEntry* const entry = (*m_dynamicEvents)[--cookie];
         if ( entry )
             return entry;
     }
@@ -1859,63 +2190,47 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     wxCHECK_MSG( m_dynamicEvents, false,
                  wxT("caller should check that we have dynamic events") );
 
-    DynamicEvents& dynamicEvents = *m_dynamicEvents;
+    wxDynamicEventTable& dynamicEvents = *m_dynamicEvents;
 
-    bool needToPruneDeleted = false;
+    // Only the entries with the same event type can match, so don't waste
+    // time on checking all the other ones.
+    const wxDynamicEventTable::Positions* const
+        positions = dynamicEvents.FindPositions(event.GetEventType());
+    if ( !positions )
+        return false;
+
+    // The unbound entries are pruned when we're done with the table, which
+    // may outlive this object if it's deleted by one of the handlers.
+    wxDynamicEventTableDispatcher dispatcher(dynamicEvents);
 
     // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
     // but not yet pruned entries from the caller, but here we do want to know
     // about them, so iterate directly. Remember to do it in the reverse order
     // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
+    //
+    // Also notice that more handlers can be bound from the event handlers
+    // called from here, so don't keep any iterators, just use the indices.
+    for ( size_t n = positions->size(); n; n-- )
     {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
+        wxDynamicEventTableEntry* const entry = dynamicEvents[(*positions)[n - 1]];
 
         if ( !entry )
         {
             // This entry must have been unbound at some time in the past, so
-            // skip it now and really remove it from the vector below, once we
+            // skip it now, it will be really removed from the table once we
             // finish iterating.
-            needToPruneDeleted = true;
             continue;
         }
 
-        if ( event.GetEventType() == entry->m_eventType )
-        {
-            wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
-            if ( !handler )
-               handler = this;
-            if ( ProcessEventIfMatchesId(*entry, handler, event) )
-            {
-                // It's important to skip pruning of the unbound event entries
-                // below because this object itself could have been deleted by
-                // the event handler making m_dynamicEvents a dangling pointer
-                // which can't be accessed any longer in the code below.
-                //
-                // In practice, it hopefully shouldn't be a problem to wait
-                // until we get an event that we don't handle before pruning
-                // because this should happen soon enough and even if it
-                // doesn't the worst possible outcome is slightly increased
-                // memory consumption while not skipping pruning can result in
-                // hard to reproduce (because they require the disconnection
-                // and deletion happen at the same time which is not always the
-                // case) crashes.
-                return true;
-            }
-        }
-    }
-
-    if ( needToPruneDeleted )
-    {
-        size_t nNew = 0;
-        for ( size_t n = 0; n != dynamicEvents.size(); n++ )
+        wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
+        if ( !handler )
+           handler = this;
+        if ( ProcessEventIfMatchesId(*entry, handler, event) )
         {
-            if ( dynamicEvents[n] )
-                dynamicEvents[nNew++] = dynamicEvents[n];
+            // Notice that this object itself could have been deleted by the
+            // event handler, so don't access any of its members any more.
+            return true;
         }
-
-        wxASSERT( nNew != dynamicEvents.size() );
-        dynamicEvents.resize(nNew);
     }
 
     return false;
@@ -1996,9 +2311,11 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
 
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
-            (*m_dynamicEvents)[cookie] = NULL;
+            m_dynamicEvents->Remove(cookie);
         }
     }
+
+    m_dynamicEvents->PruneIfNeeded();
 }
 
 #endif // wxUSE_BASE
@@ -18,7 +18,9 @@
 #endif
 
 #include "wx/archive.h"
+#include "wx/zipstrm.h"
 #include "wx/private/fileback.h"
+#include "wx/private/mappedzip.h"
 
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheDataImpl
@@ -26,6 +28,12 @@
 // Holds the catalog of an archive file, and if it is being read from a
 // non-seekable stream, a copy of its backing file.
 //
+// Local zip files are memory mapped instead of being read using the archive
+// stream, which allows finding their entries without reading the entire
+// archive and reading the entries directly from memory. As the file could be
+// changed after mapping it, IsStale() must be checked before using the cached
+// data for it.
+//
 // This class is actually the reference counted implementation for the
 // wxArchiveFSCacheData class below. It was done that way to allow sharing
 // between instances of wxFileSystem, though that's a feature not used in this
@@ -47,6 +55,9 @@ public:
                              const wxBackingFile& backer);
     wxArchiveFSCacheDataImpl(const wxArchiveClassFactory& factory,
                              wxInputStream *stream);
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    wxArchiveFSCacheDataImpl(wxMappedZipFile *zip);
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
 
     ~wxArchiveFSCacheDataImpl();
 
@@ -55,11 +66,14 @@ public:
 
     wxArchiveEntry *Get(const wxString& name);
     wxInputStream *NewStream() const;
+    wxInputStream *NewMappedStream(const wxString& name) const;
+    bool IsStale() const;
 
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
 
 private:
     wxArchiveFSEntry *AddToCache(wxArchiveEntry *entry);
+    wxArchiveFSEntry *AddToList(wxArchiveEntry *entry);
     void CloseStreams();
 
     int m_refcount;
@@ -71,6 +85,16 @@ private:
     wxBackingFile m_backer;
     wxInputStream *m_stream;
     wxArchiveInputStream *m_archive;
+
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    wxArchiveEntry *GetMappedEntry(size_t n);
+
+    // the mapped archive, if any, its entries created on demand and the index
+    // of the next entry to be added to the list by GetNext()
+    wxObjectDataPtr<wxMappedZipFile> m_zip;
+    wxVector<wxArchiveEntry*> m_zipEntries;
+    size_t m_zipNext;
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
 };
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -83,6 +107,9 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
     m_stream(new wxBackedInputStream(backer)),
     m_archive(factory.NewStream(*m_stream))
 {
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    m_zipNext = 0;
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
 }
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -94,12 +121,44 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
     m_stream(stream),
     m_archive(factory.NewStream(*m_stream))
 {
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    m_zipNext = 0;
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+}
+
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+
+wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(wxMappedZipFile *zip)
+ :  m_refcount(1),
+    m_begin(NULL),
+    m_endptr(&m_begin),
+    m_stream(NULL),
+    m_archive(NULL),
+    m_zip(zip),
+    m_zipEntries(zip->GetCount()),
+    m_zipNext(0)
+{
+}
+
+wxArchiveEntry *wxArchiveFSCacheDataImpl::GetMappedEntry(size_t n)
+{
+    if (!m_zipEntries[n])
+        m_zipEntries[n] = m_zip->NewEntry(n);
+
+    return m_zipEntries[n];
 }
 
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
 wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
 {
     WX_CLEAR_HASH_MAP(wxArchiveFSEntryHash, m_hash);
 
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    for (size_t n = 0; n < m_zipEntries.size(); n++)
+        delete m_zipEntries[n];
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
     wxArchiveFSEntry *entry = m_begin;
 
     while (entry)
@@ -115,6 +174,11 @@ wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
 wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToCache(wxArchiveEntry *entry)
 {
     m_hash[entry->GetName(wxPATH_UNIX)] = entry;
+    return AddToList(entry);
+}
+
+wxArchiveFSEntry *wxArchiveFSCacheDataImpl::AddToList(wxArchiveEntry *entry)
+{
     wxArchiveFSEntry *fse = new wxArchiveFSEntry;
     *m_endptr = fse;
     (*m_endptr)->entry = entry;
@@ -131,6 +195,14 @@ void wxArchiveFSCacheDataImpl::CloseStreams()
 
 wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
 {
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    if (m_zip)
+    {
+        int n = m_zip->Find(name);
+        return n == wxNOT_FOUND ? NULL : GetMappedEntry(n);
+    }
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
     wxArchiveFSEntryHash::iterator it = m_hash.find(name);
 
     if (it != m_hash.end())
@@ -162,10 +234,42 @@ wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
         return NULL;
 }
 
+wxInputStream*
+wxArchiveFSCacheDataImpl::NewMappedStream(const wxString& name) const
+{
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    if (m_zip)
+    {
+        int n = m_zip->Find(name);
+        if (n != wxNOT_FOUND)
+            return m_zip->OpenEntry(n);
+    }
+#else
+    wxUnusedVar(name);
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
+    return NULL;
+}
+
+bool wxArchiveFSCacheDataImpl::IsStale() const
+{
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    if (m_zip)
+        return m_zip->IsModified();
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
+    return false;
+}
+
 wxArchiveFSEntry *wxArchiveFSCacheDataImpl::GetNext(wxArchiveFSEntry *fse)
 {
     wxArchiveFSEntry *next = fse ? fse->next : m_begin;
 
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    if (!next && m_zip && m_zipNext < m_zip->GetCount())
+        next = AddToList(GetMappedEntry(m_zipNext++));
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
     if (!next && m_archive)
     {
         wxArchiveEntry *entry = m_archive->GetNextEntry();
@@ -195,6 +299,9 @@ public:
                          const wxBackingFile& backer);
     wxArchiveFSCacheData(const wxArchiveClassFactory& factory,
                          wxInputStream *stream);
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    wxArchiveFSCacheData(wxMappedZipFile *zip);
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
 
     wxArchiveFSCacheData(const wxArchiveFSCacheData& data);
     wxArchiveFSCacheData& operator=(const wxArchiveFSCacheData& data);
@@ -203,6 +310,9 @@ public:
 
     wxArchiveEntry *Get(const wxString& name) { return m_impl->Get(name); }
     wxInputStream *NewStream() const { return m_impl->NewStream(); }
+    wxInputStream *NewMappedStream(const wxString& name) const
+        { return m_impl->NewMappedStream(name); }
+    bool IsStale() const { return m_impl->IsStale(); }
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
         { return m_impl->GetNext(fse); }
 
@@ -224,6 +334,13 @@ wxArchiveFSCacheData::wxArchiveFSCacheData(
 {
 }
 
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+wxArchiveFSCacheData::wxArchiveFSCacheData(wxMappedZipFile *zip)
+  : m_impl(new wxArchiveFSCacheDataImpl(zip))
+{
+}
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
 wxArchiveFSCacheData::wxArchiveFSCacheData(const wxArchiveFSCacheData& data)
   : m_impl(data.m_impl ? data.m_impl->AddRef() : NULL)
 {
@@ -264,9 +381,10 @@ public:
 
     wxArchiveFSCacheData* Add(const wxString& name,
                               const wxArchiveClassFactory& factory,
-                              wxInputStream *stream);
+                              wxFSFile *file);
 
     wxArchiveFSCacheData *Get(const wxString& name);
+    void Remove(const wxString& name) { m_hash.erase(name); }
 
 private:
     wxArchiveFSCacheDataHash m_hash;
@@ -275,10 +393,31 @@ private:
 wxArchiveFSCacheData* wxArchiveFSCache::Add(
         const wxString& name,
         const wxArchiveClassFactory& factory,
-        wxInputStream *stream)
+        wxFSFile *file)
 {
     wxArchiveFSCacheData& data = m_hash[name];
 
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+    // map local zip files instead of reading them
+    if (wxDynamicCast(&factory, wxZipClassFactory) &&
+            file->GetLocation().StartsWith(wxT("file:")))
+    {
+        wxString path = wxFileSystem::URLToFileName(file->GetLocation())
+                            .GetFullPath();
+        wxObjectDataPtr<wxMappedZipFile> zip(new wxMappedZipFile);
+        if (zip->Open(path, factory.GetConv()))
+        {
+            delete file;
+            zip->IncRef();
+            data = wxArchiveFSCacheData(zip.get());
+            return &data;
+        }
+    }
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
+
+    wxInputStream *stream = file->DetachStream();
+    delete file;
+
     if (stream->IsSeekable())
         data = wxArchiveFSCacheData(factory, stream);
     else
@@ -358,19 +497,44 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
         return NULL;
 
     wxArchiveFSCacheData *cached = m_cache->Get(key);
+    if (cached && cached->IsStale())
+    {
+        // the mapped archive file was changed, so map it again, the streams
+        // already opened keep the old mapping alive
+        if (cached == m_Archive)
+        {
+            m_Archive = NULL;
+            m_FindEntry = NULL;
+        }
+        m_cache->Remove(key);
+        cached = NULL;
+    }
+
     if (!cached)
     {
         wxFSFile *leftFile = m_fs.OpenFile(left);
         if (!leftFile)
             return NULL;
-        cached = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
+        cached = m_cache->Add(key, *factory, leftFile);
     }
 
     wxArchiveEntry *entry = cached->Get(right);
     if (!entry)
         return NULL;
 
+    wxInputStream *mapped = cached->NewMappedStream(right);
+    if (mapped)
+    {
+        return new wxFSFile(mapped,
+                            key + right,
+                            wxEmptyString,
+                            GetAnchor(location)
+#if wxUSE_DATETIME
+                            , entry->GetDateTime()
+#endif // wxUSE_DATETIME
+                            );
+    }
+
     wxInputStream *leftStream = cached->NewStream();
     if (!leftStream)
     {
@@ -421,13 +585,18 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
         return wxEmptyString;
 
     m_Archive = m_cache->Get(key);
+    if (m_Archive && m_Archive->IsStale())
+    {
+        m_cache->Remove(key);
+        m_Archive = NULL;
+    }
+
     if (!m_Archive)
     {
         wxFSFile *leftFile = m_fs.OpenFile(left);
         if (!leftFile)
             return wxEmptyString;
-        m_Archive = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
+        m_Archive = m_cache->Add(key, *factory, leftFile);
     }
 
     m_FindEntry = NULL;
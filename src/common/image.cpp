@@ -25,6 +25,7 @@
     #include "wx/colour.h"
 #endif
 
+#include "wx/threadpool.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
@@ -563,6 +564,527 @@ wxImage wxImage::ResampleNearest(int width, int height) const
 namespace
 {
 
+// ----------------------------------------------------------------------------
+// Parallel processing helpers
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS
+
+// Task calling the given functor for a band of rows or columns in a pool
+// thread.
+template <typename T>
+class ProcessBandTask
+{
+public:
+    ProcessBandTask(const T& fn, int start, int end)
+        : m_fn(fn),
+          m_start(start),
+          m_end(end)
+    {
+    }
+
+    bool operator()() const
+    {
+        m_fn(m_start, m_end);
+
+        return true;
+    }
+
+private:
+    const T& m_fn;
+    const int m_start;
+    const int m_end;
+
+    wxDECLARE_NO_ASSIGN_CLASS(ProcessBandTask);
+};
+
+#endif // wxUSE_THREADS
+
+// Call the given functor, taking the start and the end of the band, for all
+// the bands covering the range [0, count). The work, which is roughly the
+// number of the arithmetic operations needed for the whole range, is used to
+// decide whether it's worth doing it in parallel.
+template <typename T>
+void ProcessInBands(const T& fn, int count, double work)
+{
+#if wxUSE_THREADS
+    // Small images are processed fast enough, so don't bother with using the
+    // threads for them, but split the big ones into bands processed in
+    // parallel. Notice that we can't wait for the other pool threads if we're
+    // running in one of them as this could deadlock.
+    static const double MIN_WORK_FOR_THREADS = 1 << 20;
+    static const int MIN_BAND_SIZE = 16;
+
+    if ( work >= MIN_WORK_FOR_THREADS && count >= 2*MIN_BAND_SIZE )
+    {
+        wxThreadPool& pool = wxThreadPool::Get();
+        const int numThreads = pool.GetThreadCount();
+        if ( numThreads > 1 && !pool.IsPoolThread() )
+        {
+            // Use a few bands per thread for better load balancing.
+            const int numBands = wxMin(4*numThreads, count / MIN_BAND_SIZE);
+
+            wxVector< wxFuture<bool> > futures;
+            futures.reserve(numBands - 1);
+
+            // Process the first band in this thread while the pool threads
+            // are busy with the other ones.
+            for ( int band = 1; band < numBands; band++ )
+            {
+                futures.push_back(pool.Async<bool>(
+                    ProcessBandTask<T>(fn,
+                                       (band*count) / numBands,
+                                       ((band + 1)*count) / numBands)
+                ));
+            }
+
+            fn(0, count / numBands);
+
+            for ( size_t n = 0; n < futures.size(); n++ )
+                futures[n].Wait();
+
+            return;
+        }
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(work);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    fn(0, count);
+}
+
+// ----------------------------------------------------------------------------
+// Separable resampling helpers
+// ----------------------------------------------------------------------------
+
+// All the resampling methods below (except for the nearest neighbour one)
+// compute each pixel of the new image as a weighted sum of the pixels of the
+// original one, with the weights being a product of the weights along each
+// axis. This allows to resample the image in two passes: first horizontally,
+// for each of the source rows, and then vertically, combining the rows
+// resampled during the first pass, which is much faster than computing the
+// weighted sums over the 2D neighbourhood of each pixel for the methods using
+// many source pixels.
+//
+// Big images are also resampled in parallel, by splitting them in bands of
+// rows computed by wxThreadPool threads.
+
+// The weights used along one axis: the new pixel at position "dst" is the
+// weighted sum of the old pixels at positions indices[n] with the weights
+// weights[n] for n in [first[dst], first[dst + 1]).
+struct ResampleAxis
+{
+    ResampleAxis() { first.push_back(0); }
+
+    void AddTap(int index, double weight)
+    {
+        indices.push_back(index);
+        weights.push_back(weight);
+    }
+
+    void EndPixel() { first.push_back(indices.size()); }
+
+    int GetTapsCount(int dst) const { return first[dst + 1] - first[dst]; }
+
+    wxVector<int> first;
+    wxVector<int> indices;
+    wxVector<double> weights;
+};
+
+enum ResampleMethod
+{
+    Resample_Bilinear,
+    Resample_Bicubic,
+    Resample_Box
+};
+
+// All the parameters of the resampling operation.
+struct ResampleJob
+{
+    ResampleMethod method;
+
+    const unsigned char* srcData;
+    const unsigned char* srcAlpha;
+    int srcWidth;
+
+    unsigned char* dstData;
+    unsigned char* dstAlpha;
+    int dstWidth;
+
+    ResampleAxis horz,
+                 vert;
+};
+
+// Initialize the image-related fields of the job, creating the alpha channel
+// of the destination image if necessary.
+void InitResampleJob(ResampleJob& job, const wxImage& src, wxImage& dst)
+{
+    job.srcData = src.GetData();
+    job.srcAlpha = src.GetAlpha();
+    job.srcWidth = src.GetWidth();
+
+    if ( job.srcAlpha )
+        dst.SetAlpha();
+
+    job.dstData = dst.GetData();
+    job.dstAlpha = dst.GetAlpha();
+    job.dstWidth = dst.GetWidth();
+}
+
+// Resample the given RGB row horizontally using the bicubic method, which
+// always uses 4 taps per pixel.
+void ResampleRowBicubicRGB(const ResampleAxis& axis,
+                           const unsigned char* src,
+                           int dstWidth,
+                           double* out)
+{
+    const int* const indices = &axis.indices[0];
+    const double* const weights = &axis.weights[0];
+
+    for ( int x = 0; x < dstWidth; x++ )
+    {
+        const int nStart = 4*x,
+                  nEnd = nStart + 4;
+
+        double r = 0, g = 0, b = 0;
+        for ( int n = nStart; n < nEnd; n++ )
+        {
+            const unsigned char* const p = src + 3*indices[n];
+            const double w = weights[n];
+            r += w*p[0];
+            g += w*p[1];
+            b += w*p[2];
+        }
+
+        *out++ = r;
+        *out++ = g;
+        *out++ = b;
+    }
+}
+
+// Sum the pixels in the boxes of the given RGB row: as all the pixels have
+// the same weight for the box method, this can be done using integer
+// arithmetic, which is both faster and exact.
+void SumRowBoxRGB(const ResampleAxis& axis,
+                  const unsigned char* src,
+                  int dstWidth,
+                  double* out)
+{
+    const int* const first = &axis.first[0];
+    const int* const indices = &axis.indices[0];
+
+    for ( int x = 0; x < dstWidth; x++ )
+    {
+        const int nStart = first[x],
+                  nEnd = first[x + 1];
+
+        // The box is contiguous, so we only need its first pixel.
+        const unsigned char* p = src + 3*indices[nStart];
+
+        wxUint64 r = 0, g = 0, b = 0;
+        for ( int n = nStart; n < nEnd; n++, p += 3 )
+        {
+            r += p[0];
+            g += p[1];
+            b += p[2];
+        }
+
+        *out++ = static_cast<double>(r);
+        *out++ = static_cast<double>(g);
+        *out++ = static_cast<double>(b);
+    }
+}
+
+// Resample the given source row horizontally, storing dstWidth pixels with
+// 3 or 4 (if there is alpha) channels in the output buffer.
+void ResampleRowHorz(const ResampleJob& job, int srcY, double* out)
+{
+    const unsigned char* const src = job.srcData + 3*srcY*job.srcWidth;
+    const int dstWidth = job.dstWidth;
+
+    if ( !job.srcAlpha )
+    {
+        if ( job.method == Resample_Box )
+            SumRowBoxRGB(job.horz, src, dstWidth, out);
+        else
+            ResampleRowBicubicRGB(job.horz, src, dstWidth, out);
+
+        return;
+    }
+
+    const int* const first = &job.horz.first[0];
+    const int* const indices = &job.horz.indices[0];
+    const double* const weights = &job.horz.weights[0];
+
+    // The colours are weighted by alpha.
+    const unsigned char* const srcAlpha = job.srcAlpha + srcY*job.srcWidth;
+    for ( int x = 0; x < dstWidth; x++ )
+    {
+        double r = 0, g = 0, b = 0, a = 0;
+        for ( int n = first[x]; n < first[x + 1]; n++ )
+        {
+            const int i = indices[n];
+            const unsigned char* const p = src + 3*i;
+            const double w = weights[n]*srcAlpha[i];
+            r += w*p[0];
+            g += w*p[1];
+            b += w*p[2];
+            a += w;
+        }
+
+        *out++ = r;
+        *out++ = g;
+        *out++ = b;
+        *out++ = a;
+    }
+}
+
+// Store the pixels of the given destination row computed from the vertically
+// combined rows.
+void StoreResampledRow(const ResampleJob& job, int dstY, const double* in)
+{
+    unsigned char* dst = job.dstData + 3*dstY*job.dstWidth;
+
+    // This is only used for the box resampling which doesn't use weights but
+    // just averages all the pixels in the box.
+    const int countVert = job.vert.GetTapsCount(dstY);
+
+    if ( !job.srcAlpha )
+    {
+        if ( job.method == Resample_Box )
+        {
+            for ( int x = 0; x < job.dstWidth; x++ )
+            {
+                const int count = countVert*job.horz.GetTapsCount(x);
+                *dst++ = (unsigned char)(*in++ / count);
+                *dst++ = (unsigned char)(*in++ / count);
+                *dst++ = (unsigned char)(*in++ / count);
+            }
+        }
+        else
+        {
+            for ( int i = 0; i < 3*job.dstWidth; i++ )
+                dst[i] = (unsigned char)(in[i] + 0.5);
+        }
+
+        return;
+    }
+
+    unsigned char* dstAlpha = job.dstAlpha + dstY*job.dstWidth;
+    for ( int x = 0; x < job.dstWidth; x++, in += 4, dst += 3 )
+    {
+        const double a = in[3];
+
+        if ( !a )
+        {
+            // Completely transparent pixel.
+            dst[0] =
+            dst[1] =
+            dst[2] = 0;
+        }
+        else if ( job.method == Resample_Box )
+        {
+            dst[0] = (unsigned char)(in[0] / a);
+            dst[1] = (unsigned char)(in[1] / a);
+            dst[2] = (unsigned char)(in[2] / a);
+        }
+        else
+        {
+            dst[0] = (unsigned char)(in[0] / a + 0.5);
+            dst[1] = (unsigned char)(in[1] / a + 0.5);
+            dst[2] = (unsigned char)(in[2] / a + 0.5);
+        }
+
+        *dstAlpha++ = job.method == Resample_Box
+                        ? (unsigned char)(a / (countVert*job.horz.GetTapsCount(x)))
+                        : (unsigned char)a;
+    }
+}
+
+// Compute the rows of the new image in [dstYStart, dstYEnd) range using the
+// bilinear method.
+//
+// As this method uses just 2 taps along each axis, it's faster to compute
+// each pixel directly from the 4 source pixels than to do it in two passes.
+void ResampleRowsBilinear(const ResampleJob& job, int dstYStart, int dstYEnd)
+{
+    const unsigned char* const src_data = job.srcData;
+    const unsigned char* const src_alpha = job.srcAlpha;
+    const int srcWidth = job.srcWidth;
+
+    const int* const hIndices = &job.horz.indices[0];
+    const double* const hWeights = &job.horz.weights[0];
+
+    // initialize alpha values to avoid g++ warnings about possibly
+    // uninitialized variables
+    double r1, g1, b1, a1 = 0;
+    double r2, g2, b2, a2 = 0;
+
+    for ( int dsty = dstYStart; dsty < dstYEnd; dsty++ )
+    {
+        unsigned char* dst_data = job.dstData + 3*dsty*job.dstWidth;
+        unsigned char* dst_alpha = src_alpha ? job.dstAlpha + dsty*job.dstWidth
+                                             : NULL;
+
+        // The source rows to interpolate from - Y-axis
+        const int y_offset1 = job.vert.indices[2*dsty];
+        const int y_offset2 = job.vert.indices[2*dsty + 1];
+        const double dy1 = job.vert.weights[2*dsty];
+        const double dy = job.vert.weights[2*dsty + 1];
+
+        for ( int dstx = 0; dstx < job.dstWidth; dstx++ )
+        {
+            // X-axis of pixel to interpolate from
+            const int x_offset1 = hIndices[2*dstx];
+            const int x_offset2 = hIndices[2*dstx + 1];
+            const double dx1 = hWeights[2*dstx];
+            const double dx = hWeights[2*dstx + 1];
+
+            int src_pixel_index00 = y_offset1 * srcWidth + x_offset1;
+            int src_pixel_index01 = y_offset1 * srcWidth + x_offset2;
+            int src_pixel_index10 = y_offset2 * srcWidth + x_offset1;
+            int src_pixel_index11 = y_offset2 * srcWidth + x_offset2;
+
+            // first line
+            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
+            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
+            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
+            if ( src_alpha )
+                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+
+            // second line
+            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
+            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
+            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
+            if ( src_alpha )
+                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+
+            // result lines
+
+            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
+            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
+            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
+            dst_data += 3;
+
+            if ( src_alpha )
+                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+        }
+    }
+}
+
+// Compute the rows of the new image in [dstYStart, dstYEnd) range.
+void ResampleRows(const ResampleJob& job, int dstYStart, int dstYEnd)
+{
+    if ( job.method == Resample_Bilinear )
+    {
+        ResampleRowsBilinear(job, dstYStart, dstYEnd);
+        return;
+    }
+
+    const ResampleAxis& vert = job.vert;
+
+    // The rows resampled horizontally are kept in a ring buffer big enough to
+    // hold all the rows needed for any single destination row. As the ranges
+    // of the source rows needed for the consecutive destination rows overlap,
+    // this avoids resampling the same source row more than once.
+    int ringSize = 1;
+    for ( int dstY = dstYStart; dstY < dstYEnd; dstY++ )
+    {
+        int srcYMin = INT_MAX,
+            srcYMax = INT_MIN;
+        for ( int n = vert.first[dstY]; n < vert.first[dstY + 1]; n++ )
+        {
+            srcYMin = wxMin(srcYMin, vert.indices[n]);
+            srcYMax = wxMax(srcYMax, vert.indices[n]);
+        }
+
+        ringSize = wxMax(ringSize, srcYMax - srcYMin + 1);
+    }
+
+    const size_t rowLen = job.dstWidth*(job.srcAlpha ? 4 : 3);
+
+    wxVector<double> ring(ringSize*rowLen);
+    wxVector<double> sum(rowLen);
+    double* const out = &sum[0];
+
+    // The ring contains the resampled rows in [validStart, validEnd) range.
+    int validStart = 0,
+        validEnd = 0;
+
+    for ( int dstY = dstYStart; dstY < dstYEnd; dstY++ )
+    {
+        const int nStart = vert.first[dstY],
+                  nEnd = vert.first[dstY + 1];
+
+        int srcYMin = INT_MAX,
+            srcYMax = INT_MIN;
+        for ( int n = nStart; n < nEnd; n++ )
+        {
+            srcYMin = wxMin(srcYMin, vert.indices[n]);
+            srcYMax = wxMax(srcYMax, vert.indices[n]);
+        }
+
+        // First pass: resample horizontally the rows not in the ring yet.
+        if ( srcYMin >= validStart && srcYMin <= validEnd )
+        {
+            for ( int srcY = validEnd; srcY <= srcYMax; srcY++ )
+                ResampleRowHorz(job, srcY, &ring[(srcY % ringSize)*rowLen]);
+
+            validEnd = wxMax(validEnd, srcYMax + 1);
+            validStart = wxMax(validStart, validEnd - ringSize);
+        }
+        else // Not contiguous with the rows in the ring, start anew.
+        {
+            for ( int srcY = srcYMin; srcY <= srcYMax; srcY++ )
+                ResampleRowHorz(job, srcY, &ring[(srcY % ringSize)*rowLen]);
+
+            validStart = srcYMin;
+            validEnd = srcYMax + 1;
+        }
+
+        // Second pass: combine them vertically.
+        for ( size_t i = 0; i < rowLen; i++ )
+            out[i] = 0;
+
+        for ( int n = nStart; n < nEnd; n++ )
+        {
+            const double w = vert.weights[n];
+            const double* const
+                in = &ring[(vert.indices[n] % ringSize)*rowLen];
+            for ( size_t i = 0; i < rowLen; i++ )
+                out[i] += w*in[i];
+        }
+
+        StoreResampledRow(job, dstY, out);
+    }
+}
+
+// Functor computing a band of rows of the new image.
+class ResampleRowsFunc
+{
+public:
+    explicit ResampleRowsFunc(const ResampleJob& job) : m_job(job) { }
+
+    void operator()(int dstYStart, int dstYEnd) const
+    {
+        ResampleRows(m_job, dstYStart, dstYEnd);
+    }
+
+private:
+    const ResampleJob& m_job;
+
+    wxDECLARE_NO_ASSIGN_CLASS(ResampleRowsFunc);
+};
+
+// Perform the resampling for the image of the given height.
+void DoResample(const ResampleJob& job, int dstHeight)
+{
+    const double work = (double)dstHeight*job.horz.indices.size() +
+                        (double)job.dstWidth*job.vert.indices.size();
+
+    ProcessInBands(ResampleRowsFunc(job), dstHeight, work);
+}
+
 struct BoxPrecalc
 {
     int boxStart;
@@ -612,6 +1134,18 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
     }
 }
 
+void SetBoxAxis(ResampleAxis& axis, const wxVector<BoxPrecalc>& precalcs)
+{
+    for ( size_t n = 0; n < precalcs.size(); n++ )
+    {
+        const BoxPrecalc& precalc = precalcs[n];
+        for ( int i = precalc.boxStart; i <= precalc.boxEnd; i++ )
+            axis.AddTap(i, 1.0);
+
+        axis.EndPixel();
+    }
+}
+
 } // anonymous namespace
 
 wxImage wxImage::ResampleBox(int width, int height) const
@@ -629,86 +1163,16 @@ wxImage wxImage::ResampleBox(int width, int height) const
     ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
+    ResampleJob job;
+    job.method = Resample_Box;
+    InitResampleJob(job, *this, ret_image);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
-
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
-
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
-    {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
-
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
-        {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
-
-            // Box of pixels to average
-            averaged_pixels = 0;
-            sum_r = sum_g = sum_b = sum_a = 0.0;
-
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
-            {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
-                {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
-
-                    if (src_alpha)
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
-                    }
-
-                    averaged_pixels++;
-                }
-            }
+    // All pixels in the box have the same weight, the sums are divided by
+    // their number when storing the result.
+    SetBoxAxis(job.vert, vPrecalcs);
+    SetBoxAxis(job.horz, hPrecalcs);
 
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
-            {
-                if (sum_a)
-                {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
-                }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
-            }
-            dst_data += 3;
-        }
-    }
+    DoResample(job, height);
 
     return ret_image;
 }
@@ -771,83 +1235,38 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
     }
 }
 
+void
+SetBilinearAxis(ResampleAxis& axis, const wxVector<BilinearPrecalc>& precalcs)
+{
+    for ( size_t n = 0; n < precalcs.size(); n++ )
+    {
+        const BilinearPrecalc& precalc = precalcs[n];
+        axis.AddTap(precalc.offset1, precalc.dd1);
+        axis.AddTap(precalc.offset2, precalc.dd);
+        axis.EndPixel();
+    }
+}
+
 } // anonymous namespace
 
 wxImage wxImage::ResampleBilinear(int width, int height) const
 {
     // This function implements a Bilinear algorithm for resampling.
     wxImage ret_image(width, height, false);
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
-
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
 
     wxVector<BilinearPrecalc> vPrecalcs(height);
     wxVector<BilinearPrecalc> hPrecalcs(width);
     ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
-
-    for ( int dsty = 0; dsty < height; dsty++ )
-    {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
-
-
-        for ( int dstx = 0; dstx < width; dstx++ )
-        {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
-
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
-
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
-
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
-
-            // result lines
+    ResampleJob job;
+    job.method = Resample_Bilinear;
+    InitResampleJob(job, *this, ret_image);
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+    SetBilinearAxis(job.vert, vPrecalcs);
+    SetBilinearAxis(job.horz, hPrecalcs);
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
-        }
-    }
+    DoResample(job, height);
 
     return ret_image;
 }
@@ -921,6 +1340,19 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
+void
+SetBicubicAxis(ResampleAxis& axis, const wxVector<BicubicPrecalc>& precalcs)
+{
+    for ( size_t n = 0; n < precalcs.size(); n++ )
+    {
+        const BicubicPrecalc& precalc = precalcs[n];
+        for ( int k = 0; k < 4; k++ )
+            axis.AddTap(precalc.offset[k], precalc.weight[k]);
+
+        axis.EndPixel();
+    }
+}
+
 } // anonymous namespace
 
 // This is the bicubic resampling algorithm
@@ -956,17 +1388,6 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
 
     ret_image.Create(width, height, false);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
-
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
     // Precalculate weights
     wxVector<BicubicPrecalc> vPrecalcs(height);
     wxVector<BicubicPrecalc> hPrecalcs(width);
@@ -974,293 +1395,241 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    ResampleJob job;
+    job.method = Resample_Bicubic;
+    InitResampleJob(job, *this, ret_image);
+
+    SetBicubicAxis(job.vert, vPrecalcs);
+    SetBicubicAxis(job.horz, hPrecalcs);
+
+    DoResample(job, height);
+
+    return ret_image;
+}
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// Box blur helpers
+// ----------------------------------------------------------------------------
+
+// The box blur replaces each pixel with the average of 2*radius + 1 pixels
+// around it in the same row or column, the pixels beyond the edges of the
+// image being replaced with the edge pixel. The sums of the pixels in the
+// window are updated when it slides along the row or column, so the time
+// needed doesn't depend on the radius.
+
+// Return sum/(2*radius + 1), rounded down, given the scale equal to the
+// inverse of the divisor. Adding 0.5 to the sum ensures that the result is
+// exactly the same as with the integer division, which is much slower.
+inline unsigned char BlurAverage(wxUint32 sum, double scale)
+{
+    return static_cast<unsigned char>((sum + 0.5)*scale);
+}
+
+// Blur the row of the given number of pixels, N bytes each.
+template <int N>
+void BlurRow(const unsigned char* src,
+             unsigned char* dst,
+             int count,
+             int radius,
+             double scale)
+{
+    const int last = count - 1;
+    const int inside = wxMin(radius, last);
+
+    wxUint32 sums[N];
+    for ( int c = 0; c < N; c++ )
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        sums[c] = (radius + 1)*src[c] + (radius - inside)*src[last*N + c];
+        for ( int k = 1; k <= inside; k++ )
+            sums[c] += src[k*N + c];
+    }
+
+    for ( int x = 0; x < count; x++ )
+    {
+        const unsigned char* const added = src + wxMin(x + radius + 1, last)*N;
+        const unsigned char* const removed = src + wxMax(x - radius, 0)*N;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int c = 0; c < N; c++ )
         {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+            *dst++ = BlurAverage(sums[c], scale);
+            sums[c] += added[c] - removed[c];
+        }
+    }
+}
 
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+// Blur the bytes in the range [start, end) of all rows, of the given size in
+// bytes, vertically. This is done row by row, and not column by column, to
+// access the memory sequentially.
+void BlurColumns(const unsigned char* src,
+                 unsigned char* dst,
+                 int rowSize,
+                 int height,
+                 int start,
+                 int end,
+                 int radius,
+                 double scale)
+{
+    const int last = height - 1;
+    const int inside = wxMin(radius, last);
+    const int count = end - start;
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
-            {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+    src += start;
+    dst += start;
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
-                {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
-
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
-
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
-
-                    // Create a sum of all velues for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
-                    }
-                }
-            }
+    wxVector<wxUint32> sums(count);
+    const unsigned char* const srcFirst = src;
+    const unsigned char* const srcLast = src + (size_t)last*rowSize;
+    for ( int i = 0; i < count; i++ )
+        sums[i] = (radius + 1)*srcFirst[i] + (radius - inside)*srcLast[i];
 
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
-            {
-                if ( sum_a )
-                {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
-                }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)sum_a;
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
-            }
-            dst_data += 3;
-        }
+    for ( int k = 1; k <= inside; k++ )
+    {
+        const unsigned char* const srcRow = src + (size_t)k*rowSize;
+        for ( int i = 0; i < count; i++ )
+            sums[i] += srcRow[i];
     }
 
-    return ret_image;
+    for ( int y = 0; y < height; y++ )
+    {
+        const unsigned char* const
+            added = src + (size_t)wxMin(y + radius + 1, last)*rowSize;
+        const unsigned char* const
+            removed = src + (size_t)wxMax(y - radius, 0)*rowSize;
+        unsigned char* const dstRow = dst + (size_t)y*rowSize;
+
+        for ( int i = 0; i < count; i++ )
+        {
+            dstRow[i] = BlurAverage(sums[i], scale);
+            sums[i] += added[i] - removed[i];
+        }
+    }
 }
 
-// Blur in the horizontal direction
-wxImage wxImage::BlurHorizontal(int blurRadius) const
+// Parameters of a single blur pass.
+struct BlurJob
 {
-    wxImage ret_image(MakeEmptyClone());
+    BlurJob(const wxImage& src, wxImage& dst, int radius_)
+        : srcData(src.GetData()),
+          srcAlpha(src.GetAlpha()),
+          dstData(dst.GetData()),
+          dstAlpha(dst.GetAlpha()),
+          width(src.GetWidth()),
+          height(src.GetHeight()),
+          radius(radius_),
+          scale(1.0 / (2.0*radius_ + 1))
+    {
+    }
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+    const unsigned char* const srcData;
+    const unsigned char* const srcAlpha;
+    unsigned char* const dstData;
+    unsigned char* const dstAlpha;
+    const int width;
+    const int height;
+    const int radius;
+    const double scale;
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
-
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
-    // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+    wxDECLARE_NO_ASSIGN_CLASS(BlurJob);
+};
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+// Functor blurring a band of rows horizontally.
+class BlurRowsFunc
+{
+public:
+    explicit BlurRowsFunc(const BlurJob& job) : m_job(job) { }
+
+    void operator()(int yStart, int yEnd) const
+    {
+        const BlurJob& job = m_job;
+        for ( int y = yStart; y < yEnd; y++ )
+        {
+            const size_t offset = (size_t)y*job.width;
+
+            BlurRow<3>(job.srcData + offset*3, job.dstData + offset*3,
+                       job.width, job.radius, job.scale);
+
+            if ( job.srcAlpha )
+            {
+                BlurRow<1>(job.srcAlpha + offset, job.dstAlpha + offset,
+                           job.width, job.radius, job.scale);
+            }
         }
+    }
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+private:
+    const BlurJob& m_job;
 
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
-        {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+    wxDECLARE_NO_ASSIGN_CLASS(BlurRowsFunc);
+};
 
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+// Functor blurring a band of columns vertically.
+class BlurColumnsFunc
+{
+public:
+    explicit BlurColumnsFunc(const BlurJob& job) : m_job(job) { }
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    void operator()(int xStart, int xEnd) const
+    {
+        const BlurJob& job = m_job;
 
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+        BlurColumns(job.srcData, job.dstData, job.width*3, job.height,
+                    xStart*3, xEnd*3, job.radius, job.scale);
+
+        if ( job.srcAlpha )
+        {
+            BlurColumns(job.srcAlpha, job.dstAlpha, job.width, job.height,
+                        xStart, xEnd, job.radius, job.scale);
         }
     }
 
-    return ret_image;
+private:
+    const BlurJob& m_job;
+
+    wxDECLARE_NO_ASSIGN_CLASS(BlurColumnsFunc);
+};
+
+// Blur the source image into the destination one, which must be of the same
+// size and have alpha if the source one does.
+void DoBlur(const wxImage& src, wxImage& dst, int radius, wxOrientation dir)
+{
+    const BlurJob job(src, dst, radius);
+
+    const double work = 4.0*job.width*job.height;
+    if ( dir == wxHORIZONTAL )
+        ProcessInBands(BlurRowsFunc(job), job.height, work);
+    else
+        ProcessInBands(BlurColumnsFunc(job), job.width, work);
 }
 
-// Blur in the vertical direction
-wxImage wxImage::BlurVertical(int blurRadius) const
+} // anonymous namespace
+
+// Blur in the horizontal direction
+wxImage wxImage::BlurHorizontal(int blurRadius) const
 {
+    wxCHECK_MSG( blurRadius >= 0, wxNullImage, "invalid blur radius" );
+
     wxImage ret_image(MakeEmptyClone());
 
     wxCHECK( ret_image.IsOk(), ret_image );
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
-
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
-
-    // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
-
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
-
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
-
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    DoBlur(*this, ret_image, blurRadius, wxHORIZONTAL);
 
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
-
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
-        {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+    return ret_image;
+}
 
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+// Blur in the vertical direction
+wxImage wxImage::BlurVertical(int blurRadius) const
+{
+    wxCHECK_MSG( blurRadius >= 0, wxNullImage, "invalid blur radius" );
 
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+    wxImage ret_image(MakeEmptyClone());
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
-    }
+    DoBlur(*this, ret_image, blurRadius, wxVERTICAL);
 
     return ret_image;
 }
@@ -1268,12 +1637,45 @@ wxImage wxImage::BlurVertical(int blurRadius) const
 // The new blur function
 wxImage wxImage::Blur(int blurRadius) const
 {
-    wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
-
     // Blur the image in each direction
-    ret_image = BlurHorizontal(blurRadius);
-    ret_image = ret_image.BlurVertical(blurRadius);
+    return BlurHorizontal(blurRadius).BlurVertical(blurRadius);
+}
+
+wxImage wxImage::BlurGaussian(double sigma) const
+{
+    wxCHECK_MSG( sigma >= 0, wxNullImage, "invalid standard deviation" );
+
+    // Applying box blur several times approximates the gaussian blur, with
+    // the error decreasing with the number of passes, and 3 passes are
+    // usually good enough. The sizes of the boxes are chosen to make the
+    // variance of the result equal to sigma^2, see "Fast Almost-Gaussian
+    // Filtering" by W. Jarosz or "Fast Gaussian Blur" by P. Kovesi: we use m
+    // boxes of width w and the remaining ones of width w + 2.
+    static const int NUM_PASSES = 3;
+
+    const double variance12 = 12*sigma*sigma;
+    int w = static_cast<int>(sqrt(variance12/NUM_PASSES + 1));
+    if ( w % 2 == 0 )
+        w--;
+
+    const int m = wxRound((variance12 - NUM_PASSES*(w*w + 4*w + 3)) /
+                            (-4*w - 4));
+
+    wxImage ret_image(MakeEmptyClone());
+    wxImage tmp_image(MakeEmptyClone());
+
+    wxCHECK( ret_image.IsOk() && tmp_image.IsOk(), wxNullImage );
+
+    const wxImage* src = this;
+    for ( int pass = 0; pass < NUM_PASSES; pass++ )
+    {
+        const int radius = (pass < m ? w - 1 : w + 1) / 2;
+
+        DoBlur(*src, tmp_image, radius, wxHORIZONTAL);
+        DoBlur(tmp_image, ret_image, radius, wxVERTICAL);
+
+        src = &ret_image;
+    }
 
     return ret_image;
 }
@@ -38,6 +38,7 @@
 #include "wx/msgout.h"
 #include "wx/textfile.h"
 #include "wx/thread.h"
+#include "wx/atomic.h"
 #include "wx/private/threadinfo.h"
 #include "wx/crt.h"
 #include "wx/vector.h"
@@ -98,6 +99,107 @@ WX_DEFINE_LOG_CS(TraceMask);
 // and this one is used for GetComponentLevels()
 WX_DEFINE_LOG_CS(Levels);
 
+// this struct keeps track of the threads other than main using the global log
+// target directly, which is only done if it is thread-safe, and is used by
+// SetActiveTarget() to avoid returning the old target, which may be deleted
+// by the caller then, while it is still being used by any of them
+//
+// the threads using the target only perform atomic operations, which are also
+// full memory barriers, and never lock anything: they increment the counter
+// corresponding to the current generation parity before reading the target
+// and decrement it when they're done with it, while SetActiveTarget() changes
+// the target, increments the generation and waits until the counter of the
+// previous one drops to 0
+struct ActiveTargetUsers
+{
+    ActiveTargetUsers()
+    {
+        count[0] =
+        count[1] = 0;
+        generation = 0;
+    }
+
+    // must be called before reading wxLog::ms_pLogger, the returned value
+    // must be passed to Release() when the target is not used any more
+    unsigned Acquire()
+    {
+        for ( ;; )
+        {
+            const unsigned acquiredGeneration = generation;
+            wxAtomicInc(count[acquiredGeneration & 1]);
+
+            // if the generation didn't change, SetActiveTarget() will wait
+            // for us if it changes the target now, otherwise we could have
+            // been counted as user of the target older than the current one,
+            // so try again
+            if ( generation == acquiredGeneration )
+                return acquiredGeneration;
+
+            wxAtomicDec(count[acquiredGeneration & 1]);
+        }
+    }
+
+    void Release(unsigned acquiredGeneration)
+    {
+        wxAtomicDec(count[acquiredGeneration & 1]);
+    }
+
+    // must be called with the mutex locked after changing the active target,
+    // waits until the threads using the old one stop doing it
+    void WaitForOldTarget()
+    {
+        wxAtomicInt& old = count[generation & 1];
+
+        // the new target must be visible to the other threads before they
+        // can see the new generation, and atomic operations are barriers
+        wxAtomicInc(old);
+
+        generation++;
+
+        // this is only used when changing the active target, which is rare,
+        // so just poll the counter instead of using a condition which would
+        // require locking in Release()
+        while ( wxAtomicDec(old) != 0 )
+        {
+            wxAtomicInc(old);
+            wxMilliSleep(1);
+        }
+    }
+
+    // serializes the changes to wxLog::ms_pLogger, it is not used when
+    // reading it
+    wxMutex mutex;
+
+    // the number of threads which may be using the target of the current
+    // generation and of the previous one, indexed by the generation parity
+    wxAtomicInt count[2];
+
+    // incremented whenever the active target changes
+    volatile unsigned generation;
+};
+
+WX_DEFINE_GLOBAL_VAR(ActiveTargetUsers, ActiveTargetUsers);
+
+// releases the active target acquired by the current thread on scope exit
+class ActiveTargetUseReleaser
+{
+public:
+    ActiveTargetUseReleaser()
+        : m_generation(GetActiveTargetUsers().Acquire())
+    {
+    }
+
+    ~ActiveTargetUseReleaser()
+    {
+        GetActiveTargetUsers().Release(m_generation);
+    }
+
+private:
+    const unsigned m_generation;
+
+    wxDECLARE_NO_COPY_CLASS(ActiveTargetUseReleaser);
+};
+
 } // anonymous namespace
 
 #endif // wxUSE_THREADS
@@ -376,7 +478,17 @@ wxLog::OnLog(wxLogLevel level,
         logger = wxThreadInfo.logger;
         if ( !logger )
         {
-            if ( ms_pLogger )
+            // the active target can be used from this thread directly if it
+            // is thread-safe and SetActiveTarget() doesn't return it until
+            // we're done with it
+            ActiveTargetUseReleaser release;
+
+            logger = ms_pLogger;
+            if ( logger && logger->IsThreadSafe() )
+            {
+                logger->CallDoLogRecord(level, msg, info);
+            }
+            else if ( logger )
             {
                 // buffer the messages until they can be shown from the main
                 // thread
@@ -430,6 +542,14 @@ wxLog::CallDoLogNow(wxLogLevel level,
         gs_prevLog.info = info;
     }
 
+    CallDoLogRecord(level, msg, info);
+}
+
+void
+wxLog::CallDoLogRecord(wxLogLevel level,
+                       const wxString& msg,
+                       const wxLogRecordInfo& info)
+{
     // handle extra data which may be passed to us by wxLogXXX()
     wxString prefix, suffix;
     wxUIntPtr num = 0;
@@ -543,10 +663,14 @@ wxLog *wxLog::GetMainThreadActiveTarget()
             s_bInGetActiveTarget = true;
 
             // ask the application to create a log target for us
-            if ( wxTheApp != NULL )
-                ms_pLogger = wxTheApp->GetTraits()->CreateLogTarget();
-            else
-                ms_pLogger = new wxLogOutputBest;
+            wxLog* const logger = wxTheApp != NULL
+                                    ? wxTheApp->GetTraits()->CreateLogTarget()
+                                    : new wxLogOutputBest;
+
+#if wxUSE_THREADS
+            wxMutexLocker lock(GetActiveTargetUsers().mutex);
+#endif // wxUSE_THREADS
+            ms_pLogger = logger;
 
             s_bInGetActiveTarget = false;
 
@@ -565,9 +689,20 @@ wxLog *wxLog::SetActiveTarget(wxLog *pLogger)
         ms_pLogger->Flush();
     }
 
+#if wxUSE_THREADS
+    ActiveTargetUsers& users = GetActiveTargetUsers();
+    wxMutexLocker lock(users.mutex);
+#endif // wxUSE_THREADS
+
     wxLog *pOldLogger = ms_pLogger;
     ms_pLogger = pLogger;
 
+#if wxUSE_THREADS
+    // the old target may be deleted by the caller as soon as we return, so
+    // wait until the other threads logging to it directly are done with it
+    users.WaitForOldTarget();
+#endif // wxUSE_THREADS
+
     return pOldLogger;
 }
 
@@ -0,0 +1,644 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logasync.cpp
+// Purpose:     wxLogAsync implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_LOG && wxUSE_THREADS
+
+#include "wx/logasync.h"
+
+#include "wx/tls.h"
+
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// the default capacity of the per-thread buffers
+const size_t wxLOG_ASYNC_DEFAULT_CAPACITY = 8192;
+
+// the default maximal time between the moment a message is logged and the
+// moment it is written if nothing else wakes up the writer thread, in ms
+const unsigned long wxLOG_ASYNC_WRITE_INTERVAL = 50;
+
+// the number of consecutive writes during which the buffer of a thread must
+// remain empty before it is reclaimed, i.e. about 1s by default
+const unsigned wxLOG_ASYNC_IDLE_WRITES = 20;
+
+// the time during which a thread blocked because its buffer is full waits
+// before checking it again, just in case it missed the notification
+const unsigned long wxLOG_ASYNC_BLOCK_INTERVAL = 10;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncBuffer: messages logged by a single thread
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncBuffer
+{
+public:
+    wxLogAsyncBuffer()
+    {
+        m_threadId = 0;
+        m_freed = true;
+        m_capacity = 0;
+        m_policy = wxLOG_OVERFLOW_BLOCK;
+        m_first = 0;
+        m_dropped = 0;
+        m_writerWoken = false;
+        m_idleWrites = 0;
+    }
+
+    // start using this buffer, which must be currently free, for the given
+    // thread
+    void Use(wxThreadIdType threadId)
+    {
+        m_threadId = threadId;
+        m_freed = false;
+        m_idleWrites = 0;
+    }
+
+    // stop using this buffer, which must be empty, and free its memory
+    void Free()
+    {
+        m_freed = true;
+        m_first = 0;
+        m_dropped = 0;
+        m_writerWoken = false;
+        wxVector<wxLogRecord>().swap(m_records);
+    }
+
+    bool IsUsedBy(wxThreadIdType threadId) const
+    {
+        return !m_freed && m_threadId == threadId;
+    }
+
+    // this critical section protects all the fields below and is only
+    // contended when the writer thread takes the records from this buffer,
+    // which happens rarely: notice that it means that, contrary to what the
+    // name of this class may suggest, logging is not lock-free, but logging
+    // threads never contend with each other
+    wxCriticalSection m_cs;
+
+    // the thread using this buffer, the buffer may still be used by the
+    // thread which used it before it was freed and possibly reused for
+    // another thread, so each thread must check that it's still its buffer
+    // after locking m_cs
+    wxThreadIdType m_threadId;
+    bool m_freed;
+
+    // copies of wxLogAsync fields to avoid locking its m_buffersCS
+    size_t m_capacity;
+    wxLogOverflowPolicy m_policy;
+
+    // the buffered records: when the buffer overflows and the oldest records
+    // are dropped, it is used as a ring buffer starting at m_first
+    wxVector<wxLogRecord> m_records;
+    size_t m_first;
+
+    // the number of records dropped because the buffer was full
+    size_t m_dropped;
+
+    // true if the writer thread had been already woken up to empty this
+    // buffer when it became half full
+    bool m_writerWoken;
+
+    // the number of consecutive writes which found this buffer empty
+    unsigned m_idleWrites;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncBuffer);
+};
+
+namespace
+{
+
+// cache of the last buffer used by the current thread, this allows to avoid
+// locking wxLogAsync::m_buffersCS for every message
+struct wxLogAsyncThreadCache
+{
+    unsigned long serial;
+    wxLogAsyncBuffer *buffer;
+};
+
+inline wxTLS_TYPE_REF(wxLogAsyncThreadCache) GetThreadCache()
+{
+    static wxTLS_TYPE(wxLogAsyncThreadCache) s_threadCache;
+    return s_threadCache;
+}
+
+// the serial number of the last created wxLogAsync object, we can't use the
+// object pointers themselves for identifying them in the thread cache as a
+// new object could be allocated at the same address as a deleted one
+wxCriticalSection gs_serialCS;
+unsigned long gs_lastSerial = 0;
+
+bool IsLoggedBefore(const wxLogRecord* r1, const wxLogRecord* r2)
+{
+    return r1->info.timestampMS < r2->info.timestampMS;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsyncWriterThread: writes out the buffered messages
+// ----------------------------------------------------------------------------
+
+class wxLogAsyncWriterThread : public wxThread
+{
+public:
+    explicit wxLogAsyncWriterThread(wxLogAsync& log)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_log(log)
+    {
+    }
+
+protected:
+    virtual void* Entry() wxOVERRIDE
+    {
+        m_log.RunWriter();
+
+        return NULL;
+    }
+
+private:
+    wxLogAsync& m_log;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsyncWriterThread);
+};
+
+// ============================================================================
+// wxLogAsync implementation
+// ============================================================================
+
+wxLogAsync::wxLogAsync(FILE *fp, const wxMBConv& conv)
+          : wxMessageOutputWithConv(conv),
+            m_wakeCondition(m_wakeMutex),
+            m_writtenCondition(m_writtenMutex)
+{
+    m_fp = fp ? fp : stderr;
+    m_ownsFile = false;
+
+    Init();
+}
+
+wxLogAsync::wxLogAsync(const wxString& filename, const wxMBConv& conv)
+          : wxMessageOutputWithConv(conv),
+            m_wakeCondition(m_wakeMutex),
+            m_writtenCondition(m_writtenMutex)
+{
+    m_fp = wxFopen(filename, wxS("a"));
+    m_ownsFile = true;
+
+    Init();
+}
+
+void wxLogAsync::Init()
+{
+    m_capacity = wxLOG_ASYNC_DEFAULT_CAPACITY;
+    m_policy = wxLOG_OVERFLOW_BLOCK;
+    m_droppedFreed = 0;
+    m_flushInterval = wxLOG_ASYNC_WRITE_INTERVAL;
+    m_stop = false;
+
+    {
+        wxCriticalSectionLocker lock(gs_serialCS);
+        m_serial = ++gs_lastSerial;
+    }
+
+    m_writer = NULL;
+    if ( !m_fp )
+        return;
+
+    m_writer = new wxLogAsyncWriterThread(*this);
+    if ( m_writer->Run() != wxTHREAD_NO_ERROR )
+    {
+        // we can still work without the writer thread, only Flush() will
+        // write the messages then
+        delete m_writer;
+        m_writer = NULL;
+    }
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    if ( m_writer )
+    {
+        {
+            wxMutexLocker lock(m_wakeMutex);
+            m_stop = true;
+        }
+
+        m_wakeCondition.Signal();
+        m_writer->Wait();
+        delete m_writer;
+    }
+
+    // write out anything logged since the writer thread stopped
+    WriteBuffered();
+
+    for ( Buffers::const_iterator it = m_buffers.begin();
+          it != m_buffers.end();
+          ++it )
+    {
+        delete *it;
+    }
+
+    for ( Buffers::const_iterator it = m_freeBuffers.begin();
+          it != m_freeBuffers.end();
+          ++it )
+    {
+        delete *it;
+    }
+
+    if ( m_ownsFile && m_fp )
+        fclose(m_fp);
+}
+
+void wxLogAsync::UpdateBuffers()
+{
+    for ( Buffers::const_iterator it = m_buffers.begin();
+          it != m_buffers.end();
+          ++it )
+    {
+        wxLogAsyncBuffer& buffer = **it;
+
+        wxCriticalSectionLocker lockBuffer(buffer.m_cs);
+        buffer.m_capacity = m_capacity;
+        buffer.m_policy = m_policy;
+
+        // the new records are appended to the end of the buffer if it's not
+        // full any more, so it can't be used as a ring buffer after this
+        if ( buffer.m_first )
+        {
+            std::rotate(buffer.m_records.begin(),
+                        buffer.m_records.begin() + buffer.m_first,
+                        buffer.m_records.end());
+            buffer.m_first = 0;
+        }
+    }
+}
+
+void wxLogAsync::SetBufferCapacity(size_t capacity)
+{
+    wxCHECK_RET( capacity > 0, "buffer capacity must be positive" );
+
+    wxCriticalSectionLocker lock(m_buffersCS);
+    m_capacity = capacity;
+    UpdateBuffers();
+}
+
+size_t wxLogAsync::GetBufferCapacity() const
+{
+    wxCriticalSectionLocker lock(m_buffersCS);
+    return m_capacity;
+}
+
+void wxLogAsync::SetOverflowPolicy(wxLogOverflowPolicy policy)
+{
+    wxCriticalSectionLocker lock(m_buffersCS);
+    m_policy = policy;
+    UpdateBuffers();
+}
+
+wxLogOverflowPolicy wxLogAsync::GetOverflowPolicy() const
+{
+    wxCriticalSectionLocker lock(m_buffersCS);
+    return m_policy;
+}
+
+void wxLogAsync::SetFlushInterval(unsigned long ms)
+{
+    wxCHECK_RET( ms > 0, "flush interval must be positive" );
+
+    {
+        wxMutexLocker lock(m_wakeMutex);
+        m_flushInterval = ms;
+    }
+
+    // wake up the writer thread to make it use the new interval immediately
+    m_wakeCondition.Signal();
+}
+
+unsigned long wxLogAsync::GetFlushInterval() const
+{
+    wxMutexLocker lock(m_wakeMutex);
+    return m_flushInterval;
+}
+
+size_t wxLogAsync::GetDroppedCount() const
+{
+    wxCriticalSectionLocker lock(m_buffersCS);
+
+    size_t dropped = m_droppedFreed;
+    for ( Buffers::const_iterator it = m_buffers.begin();
+          it != m_buffers.end();
+          ++it )
+    {
+        wxCriticalSectionLocker lockBuffer((*it)->m_cs);
+        dropped += (*it)->m_dropped;
+    }
+
+    return dropped;
+}
+
+wxLogAsyncBuffer& wxLogAsync::GetThreadBuffer(bool lookup)
+{
+    wxLogAsyncThreadCache& cache = wxTLS_VALUE(GetThreadCache());
+    if ( !lookup && cache.serial == m_serial )
+        return *cache.buffer;
+
+    // this thread hasn't used this log target yet or has used another one
+    // after it or its buffer was freed, so find its buffer, creating it if
+    // necessary
+    const wxThreadIdType threadId = wxThread::GetCurrentId();
+
+    wxLogAsyncBuffer* buffer = NULL;
+
+    wxCriticalSectionLocker lock(m_buffersCS);
+    for ( Buffers::const_iterator it = m_buffers.begin();
+          it != m_buffers.end();
+          ++it )
+    {
+        if ( (*it)->IsUsedBy(threadId) )
+        {
+            buffer = *it;
+            break;
+        }
+    }
+
+    if ( !buffer )
+    {
+        if ( m_freeBuffers.empty() )
+        {
+            buffer = new wxLogAsyncBuffer;
+        }
+        else
+        {
+            buffer = m_freeBuffers.back();
+            m_freeBuffers.pop_back();
+        }
+
+        {
+            wxCriticalSectionLocker lockBuffer(buffer->m_cs);
+            buffer->Use(threadId);
+            buffer->m_capacity = m_capacity;
+            buffer->m_policy = m_policy;
+        }
+
+        m_buffers.push_back(buffer);
+    }
+
+    cache.serial = m_serial;
+    cache.buffer = buffer;
+
+    return *buffer;
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    if ( !m_fp )
+        return;
+
+    // just store the record in the buffer of this thread: notice that the
+    // time stamp was already filled in when the message was logged, so it
+    // remains accurate even though the message is formatted much later
+    wxLogAsyncBuffer* buffer = &GetThreadBuffer();
+    const wxThreadIdType threadId = wxThread::GetCurrentId();
+
+    for ( ;; )
+    {
+        {
+            wxCriticalSectionLocker lock(buffer->m_cs);
+
+            if ( !buffer->IsUsedBy(threadId) )
+            {
+                // the buffer was freed because this thread didn't log anything
+                // for a long time, get a new one
+                buffer = NULL;
+            }
+            else
+            {
+                wxVector<wxLogRecord>& records = buffer->m_records;
+                const size_t capacity = buffer->m_capacity;
+                if ( records.size() < capacity )
+                {
+                    records.push_back(wxLogRecord(level, msg, info));
+
+                    // don't wake up the writer thread for every message, it
+                    // will write them out soon anyhow, but do it if the
+                    // buffer risks overflowing
+                    if ( buffer->m_writerWoken || records.size() < capacity / 2 )
+                        return;
+
+                    buffer->m_writerWoken = true;
+                    break;
+                }
+
+                switch ( buffer->m_policy )
+                {
+                    case wxLOG_OVERFLOW_DROP_NEW:
+                        buffer->m_dropped++;
+                        return;
+
+                    case wxLOG_OVERFLOW_DROP_OLDEST:
+                        records[buffer->m_first] = wxLogRecord(level, msg, info);
+                        buffer->m_first = (buffer->m_first + 1) % records.size();
+                        buffer->m_dropped++;
+                        return;
+
+                    case wxLOG_OVERFLOW_BLOCK:
+                        break;
+                }
+            }
+        }
+
+        if ( !buffer )
+        {
+            buffer = &GetThreadBuffer(true);
+            continue;
+        }
+
+        if ( !m_writer || threadId == m_writer->GetId() )
+        {
+            // there is nobody to wait for, so write the messages ourselves
+            WriteBuffered();
+            continue;
+        }
+
+        // wait until the writer thread empties the buffer
+        wxMutexLocker lock(m_writtenMutex);
+        m_wakeCondition.Signal();
+        m_writtenCondition.WaitTimeout(wxLOG_ASYNC_BLOCK_INTERVAL);
+    }
+
+    m_wakeCondition.Signal();
+}
+
+void wxLogAsync::DoLogTextAtLevel(wxLogLevel WXUNUSED(level),
+                                  const wxString& msg)
+{
+    // unlike the base class version, write the debug messages to the same
+    // file as all the other ones
+    DoLogText(msg);
+}
+
+void wxLogAsync::DoLogText(const wxString& msg)
+{
+    // this is only called from WriteBuffered(), so we just accumulate the
+    // text to write it all at once there
+    m_text += msg;
+    m_text += wxS('\n');
+}
+
+void wxLogAsync::Flush()
+{
+    // this may log the last repeated message
+    wxLog::Flush();
+
+    WriteBuffered();
+}
+
+void wxLogAsync::RunWriter()
+{
+    for ( ;; )
+    {
+        bool stop;
+        {
+            wxMutexLocker lock(m_wakeMutex);
+            if ( !m_stop )
+                m_wakeCondition.WaitTimeout(m_flushInterval);
+
+            stop = m_stop;
+        }
+
+        WriteBuffered();
+
+        if ( stop )
+            break;
+    }
+}
+
+void wxLogAsync::WriteBuffered()
+{
+    wxCriticalSectionLocker lockWrite(m_writeCS);
+
+    // take all the buffered records, holding the lock of each buffer only
+    // for as long as it takes to swap its contents with an empty vector
+    // (which will typically have been already allocated before, so that
+    // after the first few swaps no more allocations happen)
+    size_t count = 0;
+    size_t numBuffers;
+    {
+        wxCriticalSectionLocker lock(m_buffersCS);
+
+        if ( m_taken.size() < m_buffers.size() )
+            m_taken.resize(m_buffers.size());
+
+        for ( size_t n = 0; n < m_buffers.size(); )
+        {
+            wxLogAsyncBuffer& buffer = *m_buffers[n];
+            Records& taken = m_taken[n];
+
+            size_t first;
+            {
+                wxCriticalSectionLocker lockBuffer(buffer.m_cs);
+
+                if ( buffer.m_records.empty() )
+                {
+                    // free the buffers of the threads which haven't logged
+                    // anything for some time, they are probably not running
+                    // any more and we'd leak their buffers otherwise
+                    if ( ++buffer.m_idleWrites < wxLOG_ASYNC_IDLE_WRITES )
+                    {
+                        n++;
+                        continue;
+                    }
+
+                    m_droppedFreed += buffer.m_dropped;
+                    buffer.Free();
+
+                    m_buffers.erase(m_buffers.begin() + n);
+                    m_freeBuffers.push_back(&buffer);
+                    continue;
+                }
+
+                buffer.m_idleWrites = 0;
+
+                taken.swap(buffer.m_records);
+                first = buffer.m_first;
+                buffer.m_first = 0;
+                buffer.m_writerWoken = false;
+            }
+
+            const size_t size = taken.size();
+            for ( size_t i = 0; i < size; i++ )
+                m_sorted.push_back(&taken[(first + i) % size]);
+
+            count += size;
+            n++;
+        }
+
+        numBuffers = m_buffers.size();
+    }
+
+    if ( count )
+    {
+        // the records of each thread are already in order, but merge the
+        // records of different threads in the order in which they were logged
+        std::stable_sort(m_sorted.begin(), m_sorted.end(), IsLoggedBefore);
+
+        for ( size_t n = 0; n < count; n++ )
+        {
+            const wxLogRecord& record = *m_sorted[n];
+
+            // this formats the message and calls our DoLogText()
+            wxLog::DoLogRecord(record.level, record.msg, record.info);
+        }
+
+        // don't use clear() here as it would free the memory too
+        m_sorted.erase(m_sorted.begin(), m_sorted.end());
+        for ( size_t n = 0; n < m_taken.size(); n++ )
+            m_taken[n].erase(m_taken[n].begin(), m_taken[n].end());
+
+        if ( !m_text.empty() )
+        {
+            const wxCharBuffer buf = PrepareForOutput(m_text);
+            fwrite(buf, buf.length(), 1, m_fp);
+            fflush(m_fp);
+
+            m_text.clear();
+        }
+    }
+
+    // don't keep the memory used for the buffers which were freed
+    if ( m_taken.size() > numBuffers )
+        m_taken.resize(numBuffers);
+
+    // let the threads waiting for space in their buffers know they have it now
+    wxMutexLocker lock(m_writtenMutex);
+    m_writtenCondition.Broadcast();
+}
+
+#endif // wxUSE_LOG && wxUSE_THREADS
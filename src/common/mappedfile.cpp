@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/mappedfile.cpp
+// Purpose:     wxMappedFile implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/private/mappedfile.h"
+
+#if wxUSE_FILE
+
+#ifndef WX_PRECOMP
+    #include "wx/string.h"
+#endif // WX_PRECOMP
+
+#if defined(__WINDOWS__)
+    #include "wx/msw/wrapwin.h"
+#elif defined(__UNIX__)
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// ============================================================================
+// wxMappedFile implementation
+// ============================================================================
+
+#if defined(__WINDOWS__)
+
+bool wxMappedFile::Open(const wxString& filename)
+{
+    Close();
+
+    HANDLE hFile = ::CreateFile(filename.t_str(), GENERIC_READ,
+                                FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE hMapping = NULL;
+    if ( ::GetFileSizeEx(hFile, &size) && size.QuadPart > 0 &&
+            static_cast<ULONGLONG>(size.QuadPart) <= (size_t)-1 )
+    {
+        hMapping = ::CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+
+    // The view keeps a reference to the mapping object which, in turn, keeps
+    // the file open, so we don't need to keep these handles.
+    ::CloseHandle(hFile);
+
+    if ( !hMapping )
+        return false;
+
+    const void* const
+        data = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+
+    ::CloseHandle(hMapping);
+
+    if ( !data )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    return true;
+}
+
+void wxMappedFile::Close()
+{
+    if ( m_data )
+    {
+        ::UnmapViewOfFile(m_data);
+
+        m_data = NULL;
+        m_size = 0;
+    }
+}
+
+#elif defined(__UNIX__)
+
+bool wxMappedFile::Open(const wxString& filename)
+{
+    Close();
+
+    const int fd = open(filename.fn_str(), O_RDONLY);
+    if ( fd == -1 )
+        return false;
+
+    void* data = MAP_FAILED;
+
+    struct stat st;
+    if ( fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+            static_cast<wxULongLong_t>(st.st_size) <= (size_t)-1 )
+    {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping remains valid after closing the descriptor.
+    close(fd);
+
+    if ( data == MAP_FAILED )
+        return false;
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+
+    return true;
+}
+
+void wxMappedFile::Close()
+{
+    if ( m_data )
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+
+        m_data = NULL;
+        m_size = 0;
+    }
+}
+
+#else // !__WINDOWS__ && !__UNIX__
+
+bool wxMappedFile::Open(const wxString& WXUNUSED(filename))
+{
+    // Memory mapping is not supported, the callers must read the file.
+    return false;
+}
+
+void wxMappedFile::Close()
+{
+}
+
+#endif // platform
+
+#endif // wxUSE_FILE
@@ -0,0 +1,645 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/mappedzip.cpp
+// Purpose:     wxMappedZipFile implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/private/mappedzip.h"
+
+#if wxUSE_ZIPSTREAM && wxUSE_FILE
+
+#ifndef WX_PRECOMP
+    #include "wx/string.h"
+#endif // WX_PRECOMP
+
+#include "wx/filefn.h"
+#include "wx/mstream.h"
+#include "wx/zipstrm.h"
+
+// see the comment in zstream.cpp
+#if defined(__WINDOWS__) && !defined(__WX_SETUP_H__) && !defined(wxUSE_ZLIB_H_IN_PATH)
+    #include "../zlib/zlib.h"
+#else
+    #include "zlib.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+enum
+{
+    LOCAL_MAGIC          = 0x04034b50,
+    CENTRAL_MAGIC        = 0x02014b50,
+    END_MAGIC            = 0x06054b50,
+    Z64_END_MAGIC        = 0x06064b50,
+    Z64_LOC_MAGIC        = 0x07064b50
+};
+
+enum
+{
+    LOCAL_SIZE           = 30,
+    CENTRAL_SIZE         = 46,
+    END_SIZE             = 22,
+    Z64_END_SIZE         = 56,
+    Z64_LOC_SIZE         = 20,
+    MAX_COMMENT_SIZE     = 0xffff
+};
+
+enum
+{
+    FLAG_ENCRYPTED       = 0x0001,
+    FLAG_UTF8            = 0x0800
+};
+
+enum
+{
+    Z64_EXTRA_TAG        = 0x0001
+};
+
+// ----------------------------------------------------------------------------
+// helper functions
+// ----------------------------------------------------------------------------
+
+inline wxUint16 Get16(const char* p)
+{
+    const unsigned char* const u = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<wxUint16>(u[0] | (u[1] << 8));
+}
+
+inline wxUint32 Get32(const char* p)
+{
+    return Get16(p) | (static_cast<wxUint32>(Get16(p + 2)) << 16);
+}
+
+inline wxUint64 Get64(const char* p)
+{
+    return Get32(p) | (static_cast<wxUint64>(Get32(p + 4)) << 32);
+}
+
+// ----------------------------------------------------------------------------
+// wxMappedZipStoredStream: stream reading a stored entry from the mapping
+// ----------------------------------------------------------------------------
+
+class wxMappedZipStoredStream : public wxMemoryInputStream
+{
+public:
+    wxMappedZipStoredStream(wxMappedZipFile* zip,
+                            const char* data,
+                            size_t len,
+                            wxUint32 crc)
+        : wxMemoryInputStream(data, len),
+          m_data(data),
+          m_crc(crc),
+          m_crcActual(crc32(0, Z_NULL, 0)),
+          m_crcPos(0)
+    {
+        zip->IncRef();
+        m_zip.reset(zip);
+    }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE;
+
+private:
+    // Keeps the mapping alive while this stream exists.
+    wxObjectDataPtr<wxMappedZipFile> m_zip;
+
+    const char* const m_data;
+
+    // Expected and actual checksums of the data. As this stream is seekable,
+    // the actual checksum is computed over the data from the start and up to
+    // m_crcPos, which only grows when the data beyond it is read.
+    const wxUint32 m_crc;
+    uLong m_crcActual;
+    size_t m_crcPos;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedZipStoredStream);
+};
+
+size_t wxMappedZipStoredStream::OnSysRead(void *buffer, size_t size)
+{
+    const size_t pos = static_cast<size_t>(OnSysTell());
+    const size_t read = wxMemoryInputStream::OnSysRead(buffer, size);
+
+    if ( pos <= m_crcPos && pos + read > m_crcPos )
+    {
+        // Only checksum the part of the data which wasn't checksummed yet,
+        // taking it from the mapping, and by parts, as crc32() only takes
+        // 32 bit lengths.
+        const size_t end = pos + read;
+        while ( m_crcPos < end )
+        {
+            const uInt len = end - m_crcPos > 0x40000000u
+                                ? 0x40000000u
+                                : static_cast<uInt>(end - m_crcPos);
+
+            m_crcActual = crc32(m_crcActual,
+                                reinterpret_cast<const Bytef*>(m_data + m_crcPos),
+                                len);
+            m_crcPos += len;
+        }
+
+        if ( m_crcPos == GetSize() && m_crcActual != m_crc )
+            m_lasterror = wxSTREAM_READ_ERROR;
+    }
+
+    return read;
+}
+
+// ----------------------------------------------------------------------------
+// wxMappedZipInflateStream: stream inflating an entry from the mapping
+// ----------------------------------------------------------------------------
+
+class wxMappedZipInflateStream : public wxInputStream
+{
+public:
+    wxMappedZipInflateStream(wxMappedZipFile* zip,
+                             const char* data,
+                             wxUint64 compressedSize,
+                             wxUint64 size,
+                             wxUint32 crc);
+    virtual ~wxMappedZipInflateStream();
+
+    bool IsInitOk() const { return m_initOk; }
+
+    virtual wxFileOffset GetLength() const wxOVERRIDE { return m_size; }
+    virtual bool IsSeekable() const wxOVERRIDE { return false; }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE;
+    virtual wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
+
+private:
+    // Give the next part of the compressed data to zlib if it consumed the
+    // previous one.
+    void FeedInput();
+
+    wxObjectDataPtr<wxMappedZipFile> m_zip;
+
+    z_stream m_z;
+    bool m_initOk;
+
+    // The compressed data not given to zlib yet.
+    const char* m_next;
+    wxUint64 m_remaining;
+
+    const wxUint64 m_size;
+    wxUint64 m_pos;
+
+    // Expected and actual checksums of the uncompressed data.
+    const wxUint32 m_crc;
+    uLong m_crcActual;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedZipInflateStream);
+};
+
+wxMappedZipInflateStream::wxMappedZipInflateStream(wxMappedZipFile* zip,
+                                                   const char* data,
+                                                   wxUint64 compressedSize,
+                                                   wxUint64 size,
+                                                   wxUint32 crc)
+    : m_next(data),
+      m_remaining(compressedSize),
+      m_size(size),
+      m_pos(0),
+      m_crc(crc),
+      m_crcActual(crc32(0, Z_NULL, 0))
+{
+    zip->IncRef();
+    m_zip.reset(zip);
+
+    memset(&m_z, 0, sizeof(m_z));
+
+    // Negative window bits mean raw deflate data, without zlib header.
+    m_initOk = inflateInit2(&m_z, -MAX_WBITS) == Z_OK;
+}
+
+wxMappedZipInflateStream::~wxMappedZipInflateStream()
+{
+    if ( m_initOk )
+        inflateEnd(&m_z);
+}
+
+void wxMappedZipInflateStream::FeedInput()
+{
+    if ( m_z.avail_in || !m_remaining )
+        return;
+
+    // avail_in is only 32 bits, so huge entries are given to zlib by parts.
+    const uInt len = m_remaining > 0x40000000u
+                        ? 0x40000000u
+                        : static_cast<uInt>(m_remaining);
+
+    // zlib doesn't modify the input, but its API is not const-correct.
+    m_z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_next));
+    m_z.avail_in = len;
+
+    m_next += len;
+    m_remaining -= len;
+}
+
+size_t wxMappedZipInflateStream::OnSysRead(void *buffer, size_t size)
+{
+    if ( !m_initOk )
+    {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return 0;
+    }
+
+    if ( m_pos == m_size )
+    {
+        m_lasterror = wxSTREAM_EOF;
+        return 0;
+    }
+
+    // Don't read beyond the declared size of the entry and also not more
+    // than fits into avail_out at once.
+    if ( size > m_size - m_pos )
+        size = static_cast<size_t>(m_size - m_pos);
+    if ( size > 0x40000000u )
+        size = 0x40000000u;
+
+    const uInt toRead = static_cast<uInt>(size);
+
+    m_z.next_out = static_cast<Bytef*>(buffer);
+    m_z.avail_out = toRead;
+
+    while ( m_z.avail_out )
+    {
+        FeedInput();
+
+        const int rc = inflate(&m_z, Z_NO_FLUSH);
+        if ( rc == Z_STREAM_END )
+            break;
+
+        if ( rc != Z_OK || (!m_z.avail_in && !m_remaining && m_z.avail_out) )
+        {
+            m_lasterror = wxSTREAM_READ_ERROR;
+            break;
+        }
+    }
+
+    const size_t read = toRead - m_z.avail_out;
+    m_crcActual = crc32(m_crcActual, static_cast<Bytef*>(buffer),
+                        static_cast<uInt>(read));
+    m_pos += read;
+
+    if ( m_lasterror == wxSTREAM_NO_ERROR && read < toRead )
+    {
+        // The compressed data ended before the declared size was reached.
+        m_lasterror = wxSTREAM_READ_ERROR;
+    }
+
+    if ( m_pos == m_size && m_crcActual != m_crc )
+        m_lasterror = wxSTREAM_READ_ERROR;
+
+    return read;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxMappedZipFile implementation
+// ============================================================================
+
+bool wxMappedZipFile::Open(const wxString& filename, const wxMBConv& conv)
+{
+    m_entries.clear();
+    m_index.clear();
+
+    // Get the file size and time before mapping it and check that the size
+    // of the mapping is the same to avoid missing the changes done to the
+    // file between these two calls.
+    wxStructStat st;
+    if ( wxStat(filename, &st) != 0 || !m_file.Open(filename) )
+        return false;
+
+    if ( static_cast<wxInt64>(m_file.GetSize()) != st.st_size )
+    {
+        m_file.Close();
+        return false;
+    }
+
+    m_filename = filename;
+    m_fileSize = st.st_size;
+    m_fileTime = st.st_mtime;
+
+    wxUint64 cdPos, cdSize, count, adjustment;
+    if ( !ReadEndRecord(cdPos, cdSize, count, adjustment) ||
+            !ReadCentralDirectory(cdPos, cdSize, count, adjustment, conv) )
+    {
+        m_entries.clear();
+        m_index.clear();
+        m_file.Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool wxMappedZipFile::ReadEndRecord(wxUint64& cdPos,
+                                    wxUint64& cdSize,
+                                    wxUint64& count,
+                                    wxUint64& adjustment) const
+{
+    const char* const data = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    if ( size < END_SIZE )
+        return false;
+
+    // The end record is followed by a comment of up to 64KiB, so search for
+    // it backwards from the end of the file.
+    const size_t minPos = size > END_SIZE + MAX_COMMENT_SIZE
+                            ? size - END_SIZE - MAX_COMMENT_SIZE
+                            : 0;
+    size_t pos = size - END_SIZE;
+    for ( ;; )
+    {
+        if ( Get32(data + pos) == END_MAGIC &&
+                pos + END_SIZE + Get16(data + pos + 20) == size )
+            break;
+
+        if ( pos == minPos )
+            return false;
+
+        pos--;
+    }
+
+    const char* const end = data + pos;
+
+    // Multi-disk archives are not supported.
+    if ( Get16(end + 4) != 0 || Get16(end + 6) != 0 )
+        return false;
+
+    count = Get16(end + 10);
+    cdSize = Get32(end + 12);
+    wxUint64 cdOffset = Get32(end + 16);
+    wxUint64 cdEnd = pos;
+
+    if ( count == 0xffff || cdSize == 0xffffffff || cdOffset == 0xffffffff )
+    {
+        // This is a Zip64 archive, use the values from the Zip64 end record
+        // located using the locator preceding the normal end record.
+        if ( pos < Z64_LOC_SIZE )
+            return false;
+
+        const char* const loc = end - Z64_LOC_SIZE;
+        if ( Get32(loc) != Z64_LOC_MAGIC )
+            return false;
+
+        // Normally the Zip64 end record immediately precedes the locator,
+        // but use its offset if it's not the case.
+        wxUint64 z64Pos = pos - Z64_LOC_SIZE - Z64_END_SIZE;
+        if ( pos < Z64_LOC_SIZE + Z64_END_SIZE ||
+                Get32(data + z64Pos) != Z64_END_MAGIC )
+        {
+            z64Pos = Get64(loc + 8);
+            if ( size < Z64_END_SIZE || z64Pos > size - Z64_END_SIZE ||
+                    Get32(data + z64Pos) != Z64_END_MAGIC )
+                return false;
+        }
+
+        const char* const z64End = data + z64Pos;
+        count = Get64(z64End + 32);
+        cdSize = Get64(z64End + 40);
+        cdOffset = Get64(z64End + 48);
+        cdEnd = z64Pos;
+    }
+
+    if ( cdSize > cdEnd )
+        return false;
+
+    cdPos = cdEnd - cdSize;
+
+    // The archive may be preceded by some other data, e.g. a self-extracting
+    // stub, and the offsets in it may or may not take it into account, so use
+    // the actual position of the central directory to determine this, as
+    // wxZipInputStream does.
+    if ( cdOffset > cdPos )
+        return false;
+
+    adjustment = cdPos - cdOffset;
+
+    return true;
+}
+
+bool wxMappedZipFile::ReadCentralDirectory(wxUint64 cdPos,
+                                           wxUint64 cdSize,
+                                           wxUint64 count,
+                                           wxUint64 adjustment,
+                                           const wxMBConv& conv)
+{
+    const char* const data = m_file.GetData();
+    const char* p = data + cdPos;
+    const char* const cdEnd = p + cdSize;
+
+    // Don't trust the count too much, as each entry takes at least
+    // CENTRAL_SIZE bytes, it can't be greater than this.
+    if ( count > cdSize / CENTRAL_SIZE )
+        return false;
+
+    const size_t entriesCount = static_cast<size_t>(count);
+    m_entries.resize(entriesCount);
+
+    for ( size_t n = 0; n < entriesCount; n++ )
+    {
+        if ( cdEnd - p < CENTRAL_SIZE || Get32(p) != CENTRAL_MAGIC )
+            return false;
+
+        const wxUint16 nameLen = Get16(p + 28);
+        const wxUint16 extraLen = Get16(p + 30);
+        const wxUint16 commentLen = Get16(p + 32);
+
+        const char* const name = p + CENTRAL_SIZE;
+        const char* const extra = name + nameLen;
+        const char* const next = extra + extraLen + commentLen;
+        if ( next > cdEnd )
+            return false;
+
+        Entry& entry = m_entries[n];
+        entry.flags = Get16(p + 8);
+        entry.method = Get16(p + 10);
+        entry.dosTime = Get32(p + 12);
+        entry.crc = Get32(p + 16);
+        entry.compressedSize = Get32(p + 20);
+        entry.size = Get32(p + 24);
+        entry.externalAttributes = Get32(p + 38);
+        entry.localOffset = Get32(p + 42);
+
+        // The values which don't fit in 32 bits are stored in Zip64 extra
+        // field, in this order, but only if they are needed.
+        const bool z64Size = entry.size == 0xffffffff,
+                   z64CompressedSize = entry.compressedSize == 0xffffffff,
+                   z64Offset = entry.localOffset == 0xffffffff;
+        if ( z64Size || z64CompressedSize || z64Offset )
+        {
+            for ( const char* e = extra; extra + extraLen - e >= 4; )
+            {
+                const wxUint16 tag = Get16(e);
+                const wxUint16 len = Get16(e + 2);
+                const char* const fieldEnd = e + 4 + len;
+                if ( fieldEnd > extra + extraLen )
+                    break;
+
+                if ( tag == Z64_EXTRA_TAG )
+                {
+                    const char* v = e + 4;
+                    if ( z64Size && fieldEnd - v >= 8 )
+                    {
+                        entry.size = Get64(v);
+                        v += 8;
+                    }
+                    if ( z64CompressedSize && fieldEnd - v >= 8 )
+                    {
+                        entry.compressedSize = Get64(v);
+                        v += 8;
+                    }
+                    if ( z64Offset && fieldEnd - v >= 8 )
+                        entry.localOffset = Get64(v);
+                    break;
+                }
+
+                e = fieldEnd;
+            }
+        }
+
+        entry.localOffset += adjustment;
+
+        // Use the same name as wxZipEntry would.
+        const wxString rawName = entry.flags & FLAG_UTF8
+                                    ? wxString::FromUTF8(name, nameLen)
+                                    : wxString(name, conv, nameLen);
+
+        bool isDir;
+        entry.name = wxZipEntry::GetInternalName(rawName, wxPATH_UNIX, &isDir);
+        if ( !entry.name.empty() &&
+                (isDir || (entry.externalAttributes & wxZIP_A_SUBDIR)) )
+            entry.name += wxS('/');
+
+        // If there are several entries with the same name, the first one is
+        // used, as when reading the archive sequentially.
+        m_index.insert(IndexMap::value_type(entry.name, n));
+
+        p = next;
+    }
+
+    return true;
+}
+
+bool wxMappedZipFile::IsModified() const
+{
+    // Notice that the modification time has only one second resolution, so
+    // rewriting the file with the data of the same size during the same
+    // second is not detected, but this is not expected to happen in practice.
+    wxStructStat st;
+    return wxStat(m_filename, &st) != 0 ||
+                st.st_size != m_fileSize ||
+                    st.st_mtime != m_fileTime;
+}
+
+int wxMappedZipFile::Find(const wxString& name) const
+{
+    const IndexMap::const_iterator it = m_index.find(name);
+
+    return it == m_index.end() ? wxNOT_FOUND : static_cast<int>(it->second);
+}
+
+wxZipEntry* wxMappedZipFile::NewEntry(size_t n) const
+{
+    wxCHECK_MSG( n < m_entries.size(), NULL, "invalid entry index" );
+
+    const Entry& entry = m_entries[n];
+
+    wxZipEntry* const zipEntry = new wxZipEntry;
+    zipEntry->SetExternalAttributes(entry.externalAttributes);
+    zipEntry->SetName(entry.name, wxPATH_UNIX);
+    zipEntry->SetFlags(entry.flags);
+    zipEntry->SetMethod(entry.method);
+#if wxUSE_DATETIME
+    zipEntry->SetDateTime(wxDateTime().SetFromDOS(entry.dosTime));
+#endif // wxUSE_DATETIME
+    zipEntry->SetCrc(entry.crc);
+    zipEntry->SetCompressedSize(entry.compressedSize);
+    zipEntry->SetSize(entry.size);
+    zipEntry->SetOffset(entry.localOffset);
+
+    return zipEntry;
+}
+
+wxInputStream* wxMappedZipFile::OpenEntry(size_t n)
+{
+    wxCHECK_MSG( n < m_entries.size(), NULL, "invalid entry index" );
+
+    const Entry& entry = m_entries[n];
+
+    if ( entry.flags & FLAG_ENCRYPTED )
+        return NULL;
+
+    // The local header can have a different extra field than the central
+    // one, so its size must be read from it to find the start of the data.
+    const size_t size = m_file.GetSize();
+    if ( entry.localOffset > size || size - entry.localOffset < LOCAL_SIZE )
+        return NULL;
+
+    const char* const local = m_file.GetData() + entry.localOffset;
+    if ( Get32(local) != LOCAL_MAGIC )
+        return NULL;
+
+    const wxUint64 dataOffset = entry.localOffset + LOCAL_SIZE +
+                                    Get16(local + 26) + Get16(local + 28);
+    if ( dataOffset > size || size - dataOffset < entry.compressedSize )
+        return NULL;
+
+    const char* const data = m_file.GetData() + dataOffset;
+
+    switch ( entry.method )
+    {
+        case wxZIP_METHOD_STORE:
+            if ( entry.compressedSize != entry.size )
+                return NULL;
+
+            return new wxMappedZipStoredStream(this, data,
+                                               static_cast<size_t>(entry.size),
+                                               entry.crc);
+
+        case wxZIP_METHOD_DEFLATE:
+            {
+                wxMappedZipInflateStream* const
+                    stream = new wxMappedZipInflateStream(this, data,
+                                                          entry.compressedSize,
+                                                          entry.size,
+                                                          entry.crc);
+                if ( !stream->IsInitOk() )
+                {
+                    delete stream;
+                    return NULL;
+                }
+
+                return stream;
+            }
+    }
+
+    return NULL;
+}
+
+#endif // wxUSE_ZIPSTREAM && wxUSE_FILE
@@ -30,8 +30,12 @@
     #include "wx/log.h"
     #include "wx/intl.h"
     #include "wx/crt.h"
+    #include "wx/module.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+#include "wx/vector.h"
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -144,6 +148,89 @@ typedef wxChar wxRegChar;
 typedef char wxRegChar;
 #endif
 
+// a compiled regular expression: the programs which are not used by any
+// wxRegEx any more are kept in wxRegExProgramCache to be reused if the same
+// pattern is compiled again, but a program is only ever used by one wxRegEx at
+// a time as the regex library can't use the same one from different threads
+class wxRegExProgram
+{
+public:
+    wxRegExProgram(const wxString& pattern, int flags)
+        : m_pattern(pattern),
+          m_flags(flags)
+    {
+        m_nMatches = 0;
+        m_isCompiled = false;
+    }
+
+    ~wxRegExProgram()
+    {
+        if ( m_isCompiled )
+            wx_regfree(&m_RegEx);
+    }
+
+    // return false if the given text can't match because it doesn't contain
+    // the literal string which must be present in any match
+    bool MayMatch(const wxString& text) const
+    {
+        return m_literal.empty() || text.find(m_literal) != wxString::npos;
+    }
+
+    // the pattern and the flags used to compile it
+    const wxString m_pattern;
+    const int m_flags;
+
+    // compiled RE, only valid if m_isCompiled is true
+    regex_t m_RegEx;
+    bool m_isCompiled;
+
+    // the number of subexpressions, 0 if wxRE_NOSUB is used
+    size_t m_nMatches;
+
+    // the string which occurs in any match or empty if unknown
+    wxString m_literal;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExProgram);
+};
+
+// the cache of the programs not used by any wxRegEx object
+class wxRegExProgramCache
+{
+public:
+    // return the program for the given pattern and flags if we have it,
+    // removing it from the cache, or NULL otherwise
+    static wxRegExProgram *Take(const wxString& pattern, int flags);
+
+    // put the program which is not used any more into the cache, possibly
+    // deleting the least recently used program in it
+    static void Put(wxRegExProgram *program);
+
+    // delete all the programs, called on shutdown
+    static void Clear();
+
+private:
+    typedef wxVector<wxRegExProgram *> Programs;
+
+    // the maximal number of cached programs
+    enum { MAX_PROGRAMS = 64 };
+
+#if wxUSE_THREADS
+    static wxCriticalSection& GetCS()
+    {
+        static wxCriticalSection s_cs;
+        return s_cs;
+    }
+#endif // wxUSE_THREADS
+
+    // the cached programs, with the most recently used ones at the end: this
+    // is a pointer and not an object to avoid problems with the order of
+    // initialization and destruction of the static objects
+    static Programs *ms_programs;
+
+    // set to true once Clear() was called, we don't cache anything after it
+    static bool ms_shutdown;
+};
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -153,12 +240,16 @@ public:
     ~wxRegExImpl();
 
     // return true if Compile() had been called successfully
-    bool IsValid() const { return m_isCompiled; }
+    bool IsValid() const { return m_program != NULL; }
 
     // RE operations
     bool Compile(const wxString& expr, int flags = 0);
+    bool MayMatch(const wxString& text) const
+        { return m_program->MayMatch(text); }
     bool Matches(const wxRegChar *str, int flags
                  WXREGEX_IF_NEED_LEN(size_t len)) const;
+    void ResetMatches() const
+        { wxConstCast(this, wxRegExImpl)->m_matched = false; }
     bool GetMatch(size_t *start, size_t *len, size_t index = 0) const;
     size_t GetMatchCount() const;
     int Replace(wxString *pattern, const wxString& replacement,
@@ -166,22 +257,22 @@ public:
 
 private:
     // return the string containing the error message for the given err code
-    wxString GetErrorMsg(int errorcode, bool badconv) const;
+    static wxString GetErrorMsg(const regex_t *re, int errorcode, bool badconv);
 
     // init the members
     void Init()
     {
-        m_isCompiled = false;
+        m_program = NULL;
         m_Matches = NULL;
-        m_nMatches = 0;
+        m_matched = false;
     }
 
-    // free the RE if compiled
+    // release the RE if compiled
     void Free()
     {
         if ( IsValid() )
         {
-            wx_regfree(&m_RegEx);
+            wxRegExProgramCache::Put(m_program);
         }
 
         delete m_Matches;
@@ -194,22 +285,335 @@ private:
         Init();
     }
 
-    // compiled RE
-    regex_t         m_RegEx;
+    // compiled RE, owned by us while we use it
+    wxRegExProgram *m_program;
 
     // the subexpressions data
     wxRegExMatches *m_Matches;
-    size_t          m_nMatches;
 
-    // true if m_RegEx is valid
-    bool            m_isCompiled;
+    // true if the last call to Matches() succeeded, m_Matches is only valid
+    // in this case
+    bool m_matched;
 };
 
+// ----------------------------------------------------------------------------
+// private functions
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the longest string which must occur in any text matched by the given
+// pattern or an empty string if there is no such string or if we can't find
+// it: only the literal characters at the top level of the pattern without any
+// alternatives are taken into account, which is enough for the typical
+// patterns and errs on the safe side for all the others.
+wxString GetRequiredLiteral(const wxString& pattern, int flags)
+{
+    // we can't search for the literal string if the case is ignored
+    if ( flags & wxRE_ICASE )
+        return wxString();
+
+    const bool basic = (flags & wxRE_BASIC) != 0;
+
+    bool advanced = false;
+#ifdef wxHAS_REGEX_ADVANCED
+    if ( flags & wxRE_ADVANCED )
+    {
+        // the advanced syntax allows changing the options, including the
+        // syntax itself, at the start of the pattern, don't try to handle it
+        if ( pattern.StartsWith(wxS("***")) || pattern.StartsWith(wxS("(?")) )
+            return wxString();
+
+        advanced = true;
+    }
+#endif // wxHAS_REGEX_ADVANCED
+
+    wxString best,      // the longest run of literals found so far
+             current;   // the current run of literals
+
+    // the nesting level of the parentheses
+    int depth = 0;
+
+    const wxString::const_iterator end = pattern.end();
+    for ( wxString::const_iterator it = pattern.begin(); it != end; ++it )
+    {
+        wxUniChar ch = *it;
+
+        // true if ch is an ordinary character, false if it ends the run of
+        // literals, e.g. "." or a group
+        bool isLiteral = false;
+
+        // true if ch is a quantifier making the previous character optional
+        bool isOptional = false;
+
+        switch ( ch.GetValue() )
+        {
+            case '\\':
+                if ( ++it == end )
+                    return wxString();
+
+                ch = *it;
+                if ( basic && (ch == '(' || ch == ')') )
+                {
+                    depth += ch == '(' ? 1 : -1;
+                }
+                else if ( basic && ch == '{' )
+                {
+                    // skip the bounds of "\{m,n\}" quantifier
+                    for ( ++it; it != end && *it != '}'; ++it )
+                        ;
+                    if ( it == end )
+                        return wxString();
+
+                    isOptional = true;
+                }
+                else if ( wxStrchr(basic ? wxS("\\.[]*^$") : wxS("\\^$.|?*+()[]{}"),
+                                   ch) )
+                {
+                    // escaped special character is an ordinary one
+                    isLiteral = true;
+                }
+                //else: something special, e.g. "\d", "\<" or a back reference
+                break;
+
+            case '(':
+            case ')':
+                if ( basic )
+                    isLiteral = true;
+                else
+                    depth += ch == '(' ? 1 : -1;
+                break;
+
+            case '|':
+                if ( basic )
+                {
+                    isLiteral = true;
+                }
+                else if ( depth == 0 )
+                {
+                    // top level alternative, nothing is required any more
+                    return wxString();
+                }
+                break;
+
+            case '+':
+                if ( basic )
+                {
+                    isLiteral = true;
+                }
+                else if ( depth == 0 )
+                {
+                    // the preceding character must occur, but not necessarily
+                    // adjacent to the following ones
+                    if ( current.length() > best.length() )
+                        best = current;
+                    current.clear();
+                }
+                break;
+
+            case '?':
+                if ( basic )
+                    isLiteral = true;
+                else
+                    isOptional = true;
+                break;
+
+            case '*':
+                isOptional = true;
+                break;
+
+            case '{':
+                if ( basic )
+                {
+                    isLiteral = true;
+                }
+                else
+                {
+                    for ( ++it; it != end && *it != '}'; ++it )
+                        ;
+                    if ( it == end )
+                        return wxString();
+
+                    isOptional = true;
+                }
+                break;
+
+            case '[':
+                // skip the bracket expression: notice that "]" is literal if
+                // it comes first and that "[:", "[." and "[=" are terminated
+                // by ":]", ".]" and "=]"
+                if ( ++it != end && *it == '^' )
+                    ++it;
+                if ( it != end && *it == ']' )
+                    ++it;
+                for ( ; it != end && *it != ']'; ++it )
+                {
+                    if ( *it == '[' )
+                    {
+                        const wxString::const_iterator next = it + 1;
+                        if ( next != end &&
+                                (*next == ':' || *next == '.' || *next == '=') )
+                        {
+                            const wxUniChar delim = *next;
+                            for ( it = next + 1; it != end; ++it )
+                            {
+                                if ( *it == delim && it + 1 != end &&
+                                        *(it + 1) == ']' )
+                                {
+                                    ++it;
+                                    break;
+                                }
+                            }
+
+                            if ( it == end )
+                                return wxString();
+                        }
+                    }
+                    else if ( *it == '\\' && advanced )
+                    {
+                        if ( ++it == end )
+                            return wxString();
+                    }
+                }
+
+                if ( it == end )
+                    return wxString();
+                break;
+
+            case '.':
+            case '^':
+            case '$':
+                break;
+
+            default:
+                isLiteral = true;
+        }
+
+        if ( depth > 0 )
+            continue;
+
+        if ( depth < 0 )
+        {
+            // unbalanced parentheses, the pattern is probably invalid anyhow
+            return wxString();
+        }
+
+        if ( isLiteral )
+        {
+            current += ch;
+            continue;
+        }
+
+        // the character preceding an optional quantifier is not required
+        if ( isOptional && !current.empty() )
+            current.RemoveLast();
+
+        if ( current.length() > best.length() )
+            best = current;
+        current.clear();
+    }
+
+    if ( current.length() > best.length() )
+        best = current;
+
+    return best;
+}
+
+} // anonymous namespace
 
 // ============================================================================
 // implementation
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// wxRegExProgramCache
+// ----------------------------------------------------------------------------
+
+wxRegExProgramCache::Programs *wxRegExProgramCache::ms_programs = NULL;
+bool wxRegExProgramCache::ms_shutdown = false;
+
+/* static */
+wxRegExProgram *wxRegExProgramCache::Take(const wxString& pattern, int flags)
+{
+    wxCRIT_SECT_LOCKER(lock, GetCS());
+
+    if ( !ms_programs )
+        return NULL;
+
+    // look for the most recently used program first
+    for ( size_t n = ms_programs->size(); n > 0; n-- )
+    {
+        wxRegExProgram * const program = (*ms_programs)[n - 1];
+        if ( program->m_flags == flags && program->m_pattern == pattern )
+        {
+            ms_programs->erase(ms_programs->begin() + n - 1);
+            return program;
+        }
+    }
+
+    return NULL;
+}
+
+/* static */
+void wxRegExProgramCache::Put(wxRegExProgram *program)
+{
+    {
+        wxCRIT_SECT_LOCKER(lock, GetCS());
+
+        if ( !ms_shutdown )
+        {
+            if ( !ms_programs )
+                ms_programs = new Programs;
+
+            ms_programs->push_back(program);
+            if ( ms_programs->size() <= MAX_PROGRAMS )
+                return;
+
+            // delete the least recently used program below, outside the lock
+            program = ms_programs->front();
+            ms_programs->erase(ms_programs->begin());
+        }
+    }
+
+    delete program;
+}
+
+/* static */
+void wxRegExProgramCache::Clear()
+{
+    Programs *programs;
+    {
+        wxCRIT_SECT_LOCKER(lock, GetCS());
+
+        programs = ms_programs;
+        ms_programs = NULL;
+        ms_shutdown = true;
+    }
+
+    if ( programs )
+    {
+        for ( size_t n = 0; n < programs->size(); n++ )
+            delete (*programs)[n];
+
+        delete programs;
+    }
+}
+
+// the module responsible for freeing the cached programs
+class wxRegExModule : public wxModule
+{
+public:
+    wxRegExModule() { }
+    virtual bool OnInit() wxOVERRIDE { return true; }
+    virtual void OnExit() wxOVERRIDE { wxRegExProgramCache::Clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxRegExModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxRegExModule, wxModule);
+
 // ----------------------------------------------------------------------------
 // wxRegExImpl
 // ----------------------------------------------------------------------------
@@ -224,7 +628,8 @@ wxRegExImpl::~wxRegExImpl()
     Free();
 }
 
-wxString wxRegExImpl::GetErrorMsg(int errorcode, bool badconv) const
+/* static */
+wxString wxRegExImpl::GetErrorMsg(const regex_t *re, int errorcode, bool badconv)
 {
 #ifdef WXREGEX_CONVERT_TO_MB
     // currently only needed when using system library in Unicode mode
@@ -240,12 +645,12 @@ wxString wxRegExImpl::GetErrorMsg(int errorcode, bool badconv) const
     wxString szError;
 
     // first get the string length needed
-    int len = wx_regerror(errorcode, &m_RegEx, NULL, 0);
+    int len = wx_regerror(errorcode, re, NULL, 0);
     if ( len > 0 )
     {
         char* szcmbError = new char[++len];
 
-        (void)wx_regerror(errorcode, &m_RegEx, szcmbError, len);
+        (void)wx_regerror(errorcode, re, szcmbError, len);
 
         szError = wxConvLibc.cMB2WX(szcmbError);
         delete [] szcmbError;
@@ -272,6 +677,12 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
     wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    // reuse the program compiled for the same pattern before, if any: this
+    // is much faster than compiling it again
+    m_program = wxRegExProgramCache::Take(expr, flags);
+    if ( m_program )
+        return true;
+
     // translate our flags to regcomp() ones
     int flagsRE = 0;
     if ( !(flags & wxRE_BASIC) )
@@ -290,70 +701,76 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
     if ( flags & wxRE_NEWLINE )
         flagsRE |= REG_NEWLINE;
 
+    wxRegExProgram * const program = new wxRegExProgram(expr, flags);
+
     // compile it
 #ifdef WXREGEX_USING_BUILTIN
     bool conv = true;
     // FIXME-UTF8: use wc_str() after removing ANSI build
-    int errorcode = wx_re_comp(&m_RegEx, expr.c_str(), expr.length(), flagsRE);
+    int errorcode = wx_re_comp(&program->m_RegEx, expr.c_str(), expr.length(), flagsRE);
 #else
     // FIXME-UTF8: this is potentially broken, we shouldn't even try it
     //             and should always use builtin regex library (or PCRE?)
     const wxWX2MBbuf conv = expr.mbc_str();
-    int errorcode = conv ? regcomp(&m_RegEx, conv, flagsRE) : REG_BADPAT;
+    int errorcode = conv ? regcomp(&program->m_RegEx, conv, flagsRE) : REG_BADPAT;
 #endif
 
     if ( errorcode )
     {
         wxLogError(_("Invalid regular expression '%s': %s"),
-                   expr.c_str(), GetErrorMsg(errorcode, !conv).c_str());
+                   expr.c_str(),
+                   GetErrorMsg(&program->m_RegEx, errorcode, !conv).c_str());
 
-        m_isCompiled = false;
+        delete program;
+        return false;
     }
-    else // ok
+
+    program->m_isCompiled = true;
+
+    // don't allocate the matches array now, but do it later if necessary
+    if ( flags & wxRE_NOSUB )
     {
-        // don't allocate the matches array now, but do it later if necessary
-        if ( flags & wxRE_NOSUB )
-        {
-            // we don't need it at all
-            m_nMatches = 0;
-        }
-        else
-        {
-            // we will alloc the array later (only if really needed) but count
-            // the number of sub-expressions in the regex right now
+        // we don't need it at all
+        program->m_nMatches = 0;
+    }
+    else
+    {
+        // we will alloc the array later (only if really needed) but count
+        // the number of sub-expressions in the regex right now
 
-            // there is always one for the whole expression
-            m_nMatches = 1;
+        // there is always one for the whole expression
+        program->m_nMatches = 1;
 
-            // and some more for bracketed subexperessions
-            for ( const wxChar *cptr = expr.c_str(); *cptr; cptr++ )
+        // and some more for bracketed subexperessions
+        for ( const wxChar *cptr = expr.c_str(); *cptr; cptr++ )
+        {
+            if ( *cptr == wxT('\\') )
             {
-                if ( *cptr == wxT('\\') )
-                {
-                    // in basic RE syntax groups are inside \(...\)
-                    if ( *++cptr == wxT('(') && (flags & wxRE_BASIC) )
-                    {
-                        m_nMatches++;
-                    }
-                }
-                else if ( *cptr == wxT('(') && !(flags & wxRE_BASIC) )
+                // in basic RE syntax groups are inside \(...\)
+                if ( *++cptr == wxT('(') && (flags & wxRE_BASIC) )
                 {
-                    // we know that the previous character is not an unquoted
-                    // backslash because it would have been eaten above, so we
-                    // have a bare '(' and this indicates a group start for the
-                    // extended syntax. '(?' is used for extensions by perl-
-                    // like REs (e.g. advanced), and is not valid for POSIX
-                    // extended, so ignore them always.
-                    if ( cptr[1] != wxT('?') )
-                        m_nMatches++;
+                    program->m_nMatches++;
                 }
             }
+            else if ( *cptr == wxT('(') && !(flags & wxRE_BASIC) )
+            {
+                // we know that the previous character is not an unquoted
+                // backslash because it would have been eaten above, so we
+                // have a bare '(' and this indicates a group start for the
+                // extended syntax. '(?' is used for extensions by perl-
+                // like REs (e.g. advanced), and is not valid for POSIX
+                // extended, so ignore them always.
+                if ( cptr[1] != wxT('?') )
+                    program->m_nMatches++;
+            }
         }
-
-        m_isCompiled = true;
     }
 
-    return IsValid();
+    program->m_literal = GetRequiredLiteral(expr, flags);
+
+    m_program = program;
+
+    return true;
 }
 
 #ifdef WXREGEX_USING_RE_SEARCH
@@ -401,22 +818,27 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
 
     // allocate matches array if needed
     wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
-    if ( !m_Matches && m_nMatches )
+    const size_t nMatches = m_program->m_nMatches;
+    if ( !m_Matches && nMatches )
     {
-        self->m_Matches = new wxRegExMatches(m_nMatches);
+        self->m_Matches = new wxRegExMatches(nMatches);
     }
 
+    regex_t * const re = &m_program->m_RegEx;
+
     wxRegExMatches::match_type matches = m_Matches ? m_Matches->get() : NULL;
 
     // do match it
 #if defined WXREGEX_USING_BUILTIN
-    int rc = wx_re_exec(&self->m_RegEx, str, len, NULL, m_nMatches, matches, flagsRE);
+    int rc = wx_re_exec(re, str, len, NULL, nMatches, matches, flagsRE);
 #elif defined WXREGEX_USING_RE_SEARCH
-    int rc = str ? ReSearch(&self->m_RegEx, str, len, matches, flagsRE) : REG_BADPAT;
+    int rc = str ? ReSearch(re, str, len, matches, flagsRE) : REG_BADPAT;
 #else
-    int rc = str ? regexec(&self->m_RegEx, str, m_nMatches, matches, flagsRE) : REG_BADPAT;
+    int rc = str ? regexec(re, str, nMatches, matches, flagsRE) : REG_BADPAT;
 #endif
 
+    self->m_matched = rc == 0;
+
     switch ( rc )
     {
         case 0:
@@ -426,7 +848,7 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
         default:
             // an error occurred
             wxLogError(_("Failed to find match for regular expression: %s"),
-                       GetErrorMsg(rc, !str).c_str());
+                       GetErrorMsg(re, rc, !str).c_str());
             wxFALLTHROUGH;
 
         case REG_NOMATCH:
@@ -438,9 +860,13 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
 bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
-    wxCHECK_MSG( m_nMatches, false, wxT("can't use with wxRE_NOSUB") );
+    wxCHECK_MSG( m_program->m_nMatches, false, wxT("can't use with wxRE_NOSUB") );
     wxCHECK_MSG( m_Matches, false, wxT("must call Matches() first") );
-    wxCHECK_MSG( index < m_nMatches, false, wxT("invalid match index") );
+    wxCHECK_MSG( index < m_program->m_nMatches, false, wxT("invalid match index") );
+
+    // don't return the data of an older match if the last one failed
+    if ( !m_matched )
+        return false;
 
     if ( start )
         *start = m_Matches->Start(index);
@@ -453,9 +879,9 @@ bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
 size_t wxRegExImpl::GetMatchCount() const
 {
     wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
-    wxCHECK_MSG( m_nMatches, 0, wxT("can't use with wxRE_NOSUB") );
+    wxCHECK_MSG( m_program->m_nMatches, 0, wxT("can't use with wxRE_NOSUB") );
 
-    return m_nMatches;
+    return m_program->m_nMatches;
 }
 
 int wxRegExImpl::Replace(wxString *text,
@@ -465,6 +891,10 @@ int wxRegExImpl::Replace(wxString *text,
     wxCHECK_MSG( text, wxNOT_FOUND, wxT("NULL text in wxRegEx::Replace") );
     wxCHECK_MSG( IsValid(), wxNOT_FOUND, wxT("must successfully Compile() first") );
 
+    // don't bother with doing anything if there can be no matches at all
+    if ( !MayMatch(*text) )
+        return 0;
+
     // the input string
 #ifndef WXREGEX_CONVERT_TO_MB
     const wxChar *textstr = text->c_str();
@@ -474,7 +904,7 @@ int wxRegExImpl::Replace(wxString *text,
     if (!textstr)
     {
         wxLogError(_("Failed to find match for regular expression: %s"),
-                   GetErrorMsg(0, true).c_str());
+                   GetErrorMsg(&m_program->m_RegEx, 0, true).c_str());
         return 0;
     }
     size_t textlen = strlen(textstr);
@@ -651,6 +1081,15 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
 
+    // quickly reject the strings which can't match without running the much
+    // slower regex engine
+    if ( !m_impl->MayMatch(str) )
+    {
+        // but still forget the previous match, as the engine would do
+        m_impl->ResetMatches();
+        return false;
+    }
+
     return m_impl->Matches(WXREGEX_CHAR(str), flags
                             WXREGEX_IF_NEED_LEN(str.length()));
 }
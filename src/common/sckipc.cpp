@@ -42,6 +42,11 @@
 
 #include "wx/socket.h"
 
+#if wxUSE_ZLIB
+    #include "wx/mstream.h"
+    #include "wx/zstream.h"
+#endif // wxUSE_ZLIB
+
 // --------------------------------------------------------------------------
 // macros and constants
 // --------------------------------------------------------------------------
@@ -64,9 +69,22 @@ enum IPCCode
     IPC_FAIL            = 9,
     IPC_CONNECT         = 10,
     IPC_DISCONNECT      = 11,
+    IPC_COMPRESS_START  = 12,
+    IPC_COMPRESS_STOP   = 13,
     IPC_MAX
 };
 
+// Once the compression is enabled for the connection, all data is preceded by
+// one of these codes indicating how it is encoded.
+enum IPCDataEncoding
+{
+    IPC_DATA_RAW        = 0,
+    IPC_DATA_ZLIB       = 1
+};
+
+// Data smaller than this is never compressed as the gain would be negligible.
+const size_t IPC_COMPRESS_THRESHOLD = 512;
+
 } // anonymous namespace
 
 // headers needed for umask()
@@ -193,8 +211,14 @@ public:
           m_dataIn(m_socketStream),
           m_dataOut(m_bufferedOut)
     {
+        m_compressed = false;
     }
 
+    // the compressed data encoding must be enabled or disabled by both sides
+    // of the connection at once, see wxTCPConnection::Compress()
+    void SetCompressed(bool compressed) { m_compressed = compressed; }
+    bool IsCompressed() const { return m_compressed; }
+
     // expose the IO methods needed by IPC code (notice that writing is only
     // done via IPCOutput)
 
@@ -236,6 +260,24 @@ public:
         wxCHECK_MSG( conn, NULL, "NULL connection parameter" );
         wxCHECK_MSG( size, NULL, "NULL size parameter" );
 
+        if ( m_compressed )
+        {
+            switch ( Read8() )
+            {
+                case IPC_DATA_RAW:
+                    break;
+
+#if wxUSE_ZLIB
+                case IPC_DATA_ZLIB:
+                    return ReadCompressedData(conn, size);
+#endif // wxUSE_ZLIB
+
+                default:
+                    wxLogDebug("Unknown IPC data encoding.");
+                    return NULL;
+            }
+        }
+
         *size = Read32();
 
         void * const data = conn->GetBufferAtLeast(*size);
@@ -258,6 +300,34 @@ public:
     }
 
 
+#if wxUSE_ZLIB
+    // read the data written by IPCOutput::WriteCompressedData()
+    void *ReadCompressedData(wxConnectionBase *conn, size_t *size)
+    {
+        *size = Read32();
+        const size_t sizeCompressed = Read32();
+
+        void * const compressed = m_compressedBuf.GetWriteBuf(sizeCompressed);
+        wxCHECK_MSG( compressed, NULL, "IPC buffer allocation failed" );
+
+        m_socketStream.Read(compressed, sizeCompressed);
+        m_compressedBuf.UngetWriteBuf(sizeCompressed);
+
+        void * const data = conn->GetBufferAtLeast(*size);
+        wxCHECK_MSG( data, NULL, "IPC buffer allocation failed" );
+
+        wxMemoryInputStream memIn(compressed, sizeCompressed);
+        wxZlibInputStream zlibIn(memIn, wxZLIB_ZLIB);
+        if ( !zlibIn.ReadAll(data, *size) )
+        {
+            wxLogDebug("Failed to decompress IPC data.");
+            return NULL;
+        }
+
+        return data;
+    }
+#endif // wxUSE_ZLIB
+
     // these methods are only used by IPCOutput and not directly
     wxDataOutputStream& GetDataOut() { return m_dataOut; }
     wxOutputStream& GetUnformattedOut() { return m_bufferedOut; }
@@ -280,6 +350,15 @@ private:
     wxDataInputStream  m_dataIn;
     wxDataOutputStream m_dataOut;
 
+    // true if all data is preceded by IPCDataEncoding
+    bool m_compressed;
+
+#if wxUSE_ZLIB
+    // buffer used for reading the compressed data, reused to avoid allocating
+    // it for every message
+    wxMemoryBuffer m_compressedBuf;
+#endif // wxUSE_ZLIB
+
     wxDECLARE_NO_COPY_CLASS(wxIPCSocketStreams);
 };
 
@@ -329,12 +408,53 @@ public:
     // write arbitrary data
     void WriteData(const void *data, size_t size)
     {
+        if ( m_streams.IsCompressed() )
+        {
+#if wxUSE_ZLIB
+            if ( size >= IPC_COMPRESS_THRESHOLD &&
+                    WriteCompressedData(data, size) )
+                return;
+#endif // wxUSE_ZLIB
+
+            Write8(IPC_DATA_RAW);
+        }
+
         m_streams.GetDataOut().Write32(size);
         m_streams.GetUnformattedOut().Write(data, size);
     }
 
-
 private:
+#if wxUSE_ZLIB
+    // write the data compressed if this makes it smaller, return false
+    // without writing anything otherwise
+    bool WriteCompressedData(const void *data, size_t size)
+    {
+        wxMemoryOutputStream memOut;
+        {
+            // favour speed over compression ratio as the data is usually
+            // sent over a fast (often local) connection
+            wxZlibOutputStream zlibOut(memOut, wxZ_BEST_SPEED, wxZLIB_ZLIB);
+            if ( !zlibOut.WriteAll(data, size) || !zlibOut.Close() )
+                return false;
+        }
+
+        const size_t sizeCompressed = memOut.GetLength();
+        if ( sizeCompressed >= size )
+            return false;
+
+        Write8(IPC_DATA_ZLIB);
+        m_streams.GetDataOut().Write32(size);
+        m_streams.GetDataOut().Write32(sizeCompressed);
+        m_streams.GetUnformattedOut().Write
+            (
+                memOut.GetOutputStreamBuffer()->GetBufferStart(),
+                sizeCompressed
+            );
+
+        return true;
+    }
+#endif // wxUSE_ZLIB
+
     wxIPCSocketStreams& m_streams;
 
     wxDECLARE_NO_COPY_CLASS(IPCOutput);
@@ -559,9 +679,32 @@ wxTCPConnection::~wxTCPConnection()
     delete m_streams;
 }
 
-void wxTCPConnection::Compress(bool WXUNUSED(on))
+bool wxTCPConnection::Compress(bool on)
 {
-    // TODO
+    wxCHECK_MSG( m_streams, false, "not connected yet" );
+
+    if ( on == m_streams->IsCompressed() )
+        return true;
+
+#if wxUSE_ZLIB
+    if ( !m_sock->IsConnected() )
+        return false;
+
+    // the other side replies with the same code if it supports compression
+    // and with IPC_FAIL otherwise (this includes the old versions which don't
+    // know about it at all)
+    const IPCCode code = on ? IPC_COMPRESS_START : IPC_COMPRESS_STOP;
+    IPCOutput(m_streams).Write8(code);
+
+    if ( m_streams->Read8() != code )
+        return false;
+
+    m_streams->SetCompressed(on);
+
+    return true;
+#else // !wxUSE_ZLIB
+    return false;
+#endif // wxUSE_ZLIB/!wxUSE_ZLIB
 }
 
 // Calls that CLIENT can make.
@@ -836,6 +979,17 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
             }
             break;
 
+        case IPC_COMPRESS_START:
+        case IPC_COMPRESS_STOP:
+#if wxUSE_ZLIB
+            // the data sent after our reply will use the new encoding
+            streams->SetCompressed(msg == IPC_COMPRESS_START);
+            IPCOutput(streams).Write8(msg);
+#else // !wxUSE_ZLIB
+            error = true;
+#endif // wxUSE_ZLIB/!wxUSE_ZLIB
+            break;
+
         case IPC_DISCONNECT:
             HandleDisconnect(connection);
             break;
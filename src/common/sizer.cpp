@@ -34,6 +34,10 @@
 #include "wx/private/window.h"
 #include "wx/scopedptr.h"
 
+#ifndef wxNO_RTTI
+    #include <typeinfo>
+#endif
+
 
 //---------------------------------------------------------------------------
 
@@ -208,7 +212,8 @@ wxSizerItem::wxSizerItem(wxWindow *window,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -220,6 +225,9 @@ void wxSizerItem::DoSetSizer(wxSizer *sizer)
 {
     m_kind = Item_Sizer;
     m_sizer = sizer;
+
+    if ( m_sizer )
+        m_sizer->SetContainingSizer(m_containingSizer);
 }
 
 wxSizerItem::wxSizerItem(wxSizer *sizer,
@@ -234,7 +242,8 @@ wxSizerItem::wxSizerItem(wxSizer *sizer,
              m_flag(flag),
              m_id(wxID_NONE),
              m_ratio(0),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -252,6 +261,20 @@ void wxSizerItem::DoSetSpacer(const wxSize& size)
     SetRatio(size);
 }
 
+void wxSizerItem::SetContainingSizer(wxSizer *sizer)
+{
+    m_containingSizer = sizer;
+
+    if ( IsSizer() && m_sizer )
+        m_sizer->SetContainingSizer(sizer);
+}
+
+void wxSizerItem::InvalidateContainingSizer()
+{
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateMinSize();
+}
+
 wxSize wxSizerItem::AddBorderToSize(const wxSize& size) const
 {
     wxSize result = size;
@@ -292,7 +315,8 @@ wxSizerItem::wxSizerItem(int width,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -443,6 +467,15 @@ bool wxSizerItem::InformFirstDirection(int direction, int size, int availableOth
         }
     }
 
+    // our min size now depends on the layout and so can't be cached
+    if ( didUse )
+    {
+        if ( IsSizer() )
+            GetSizer()->InvalidateMinSize();
+        else
+            InvalidateContainingSizer();
+    }
+
     return didUse;
 }
 
@@ -629,6 +662,8 @@ void wxSizerItem::Show( bool show )
         default:
             wxFAIL_MSG( wxT("unexpected wxSizerItem::m_kind") );
     }
+
+    InvalidateContainingSizer();
 }
 
 bool wxSizerItem::IsShown() const
@@ -712,6 +747,9 @@ wxSizerItem* wxSizer::DoInsert( size_t index, wxSizerItem *item )
 
     m_children.Insert( index, item );
 
+    item->SetContainingSizer( this );
+    InvalidateMinSize();
+
     return guard.Release();
 }
 
@@ -751,6 +789,7 @@ bool wxSizer::Remove( wxSizer *sizer )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
 
@@ -772,6 +811,7 @@ bool wxSizer::Remove( int index )
 
     delete node->GetData();
     m_children.Erase( node );
+    InvalidateMinSize();
 
     return true;
 }
@@ -787,9 +827,11 @@ bool wxSizer::Detach( wxSizer *sizer )
 
         if (item->GetSizer() == sizer)
         {
+            sizer->SetContainingSizer( NULL );
             item->DetachSizer();
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -811,6 +853,7 @@ bool wxSizer::Detach( wxWindow *window )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -832,10 +875,14 @@ bool wxSizer::Detach( int index )
     wxSizerItem *item = node->GetData();
 
     if ( item->IsSizer() )
+    {
+        item->GetSizer()->SetContainingSizer( NULL );
         item->DetachSizer();
+    }
 
     delete item;
     m_children.Erase( node );
+    InvalidateMinSize();
     return true;
 }
 
@@ -914,6 +961,9 @@ bool wxSizer::Replace( size_t old, wxSizerItem *newitem )
     if (wxWindow* const w = newitem->GetWindow())
         w->SetContainingSizer(this);
 
+    newitem->SetContainingSizer(this);
+    InvalidateMinSize();
+
     return true;
 }
 
@@ -936,6 +986,8 @@ void wxSizer::Clear( bool delete_windows )
 
     // Now empty the list
     WX_CLEAR_LIST(wxSizerItemList, m_children);
+
+    InvalidateMinSize();
 }
 
 void wxSizer::DeleteWindows()
@@ -1050,8 +1102,8 @@ void wxSizer::RecalcSizes()
 void wxSizer::Layout()
 {
     // (re)calculates minimums needed for each item and other preparations
-    // for layout
-    const wxSize minSize = CalcMin();
+    // for layout, unless they didn't change since the last time
+    const wxSize minSize = CalcMinIfNeeded();
 
     // Applies the layout and repositions/resizes the items
     wxWindow::ChildrenRepositioningGuard repositionGuard(m_containingWindow);
@@ -1130,16 +1182,90 @@ wxSize wxSizer::VirtualFitSize( wxWindow *window )
 
 wxSize wxSizer::GetMinSize()
 {
-    wxSize ret( CalcMin() );
+    wxSize ret( CalcMinIfNeeded() );
     if (ret.x < m_minSize.x) ret.x = m_minSize.x;
     if (ret.y < m_minSize.y) ret.y = m_minSize.y;
     return ret;
 }
 
+// Return true if the sizer is an object of one of the standard classes whose
+// CalcMin() only depends on the things resulting in InvalidateMinSize() calls,
+// but not of a class deriving from them, as it could override CalcMin().
+static bool IsStandardCachingSizer(const wxSizer& sizer)
+{
+#ifndef wxNO_RTTI
+    const std::type_info& ti = typeid(sizer);
+
+    return ti == typeid(wxBoxSizer) ||
+           ti == typeid(wxGridSizer) ||
+           ti == typeid(wxFlexGridSizer)
+#if wxUSE_STATBOX
+           || ti == typeid(wxStaticBoxSizer)
+#endif // wxUSE_STATBOX
+#if wxUSE_BUTTON
+           || ti == typeid(wxStdDialogButtonSizer)
+#endif // wxUSE_BUTTON
+           ;
+#else // wxNO_RTTI
+    // We can't check if the sizer class is one of ours, so don't cache.
+    wxUnusedVar(sizer);
+
+    return false;
+#endif // !wxNO_RTTI/wxNO_RTTI
+}
+
+wxSize wxSizer::CalcMinIfNeeded()
+{
+    if ( m_cachedMinSizeValid )
+        return m_cachedMinSize;
+
+    if ( !CanCacheMinSize() )
+    {
+        // our min size may change without any notification, so the sizers
+        // containing us can't rely on their cached min sizes neither
+        InvalidateMinSize();
+
+        return CalcMin();
+    }
+
+    // Notice that the flag is set before calling CalcMin() and not after it
+    // as it can be reset while it runs, e.g. if one of our items makes use of
+    // the information passed to InformFirstDirection(), and then the value
+    // computed by it must not be reused.
+    m_cachedMinSizeValid = true;
+    m_cachedMinSize = CalcMin();
+
+    return m_cachedMinSize;
+}
+
+void wxSizer::InvalidateMinSize()
+{
+    wxSizer* sizer = this;
+    while ( sizer )
+    {
+        sizer->m_cachedMinSizeValid = false;
+
+        if ( sizer->m_containingSizer )
+        {
+            sizer = sizer->m_containingSizer;
+        }
+        else // top level sizer
+        {
+            // if it's used by a window, the best size of this window, and so
+            // the min size of the sizer containing it, depends on ours too
+            wxWindow* const win = sizer->m_containingWindow;
+            sizer = win && win->GetSizer() == sizer ? win->GetContainingSizer()
+                                                    : NULL;
+        }
+    }
+}
+
 void wxSizer::DoSetMinSize( int width, int height )
 {
     m_minSize.x = width;
     m_minSize.y = height;
+
+    InvalidateMinSize();
 }
 
 bool wxSizer::DoSetItemMinSize( wxWindow *window, int width, int height )
@@ -1478,6 +1604,11 @@ wxGridSizer::wxGridSizer( int rows, int cols, const wxSize& gap )
     wxASSERT(rows >= 0 && cols >= 0);
 }
 
+bool wxGridSizer::CanCacheMinSize() const
+{
+    return IsStandardCachingSizer(*this);
+}
+
 wxSizerItem *wxGridSizer::DoInsert(size_t index, wxSizerItem *item)
 {
     // Ensure that the item will be deleted in case of exception.
@@ -1717,6 +1848,13 @@ void wxFlexGridSizer::RepositionChildren(const wxSize& minSize)
     const wxPoint pt(GetPosition());
     const wxSize sz(GetSize());
 
+    // Reset the rows heights and columns widths to the values computed by
+    // CalcMin() as they were already adjusted by AdjustForGrowables() if it
+    // wasn't called since the previous layout because its result was cached.
+    m_rowHeights.assign(nrows, -1);
+    m_colWidths.assign(ncols, -1);
+    FindWidthsAndHeights(nrows, ncols);
+
     AdjustForGrowables(sz, minSize);
 
     wxSizerItemList::const_iterator i = m_children.begin();
@@ -2124,6 +2262,11 @@ void wxFlexGridSizer::RemoveGrowableRow( size_t idx )
 // wxBoxSizer
 //---------------------------------------------------------------------------
 
+bool wxBoxSizer::CanCacheMinSize() const
+{
+    return IsStandardCachingSizer(*this);
+}
+
 wxSizerItem *wxBoxSizer::DoInsert(size_t index, wxSizerItem *item)
 {
     const int flags = item->GetFlag();
@@ -20,6 +20,7 @@
 #endif
 
 #include "wx/textbuf.h"
+#include "wx/private/textbuf.h"
 
 // ============================================================================
 // wxTextBuffer class implementation
@@ -131,11 +132,126 @@ wxTextBuffer::wxTextBuffer(const wxString& strBufferName)
 {
     m_nCurLine = 0;
     m_isOpened = false;
+    m_lazyLines = NULL;
 }
 
 wxTextBuffer::~wxTextBuffer()
 {
-    // required here for Darwin
+    delete m_lazyLines;
+}
+
+// ----------------------------------------------------------------------------
+// lines retrieved on demand
+// ----------------------------------------------------------------------------
+
+void wxTextBuffer::SetLazyLines(wxTextBufferLazyLines *lazyLines)
+{
+    delete m_lazyLines;
+    m_lazyLines = lazyLines;
+
+    m_aLines.clear();
+    m_aTypes.clear();
+    m_nCurLine = 0;
+}
+
+bool wxTextBuffer::HasLazyLine(size_t n) const
+{
+    return m_lazyLines->HasLine(n);
+}
+
+size_t wxTextBuffer::GetLazyLineCount() const
+{
+    return m_lazyLines->GetCount();
+}
+
+const wxString& wxTextBuffer::GetLazyLine(size_t n) const
+{
+    return m_lazyLines->GetLine(n);
+}
+
+wxString& wxTextBuffer::GetModifiableLazyLine(size_t n)
+{
+    return m_lazyLines->GetModifiableLine(n);
+}
+
+wxTextFileType wxTextBuffer::GetLazyLineType(size_t n) const
+{
+    return m_lazyLines->GetLineType(n);
+}
+
+void wxTextBuffer::LoadLazyLines()
+{
+    wxTextBufferLazyLines * const lazyLines = m_lazyLines;
+    m_lazyLines = NULL;
+
+    const size_t count = lazyLines->GetCount();
+    m_aLines.reserve(count);
+    m_aTypes.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        m_aLines.push_back(lazyLines->GetLine(n));
+        m_aTypes.push_back(lazyLines->GetLineType(n));
+    }
+
+    delete lazyLines;
+}
+
+// ----------------------------------------------------------------------------
+// wxTextBufferLazyLines
+// ----------------------------------------------------------------------------
+
+const wxString& wxTextBufferLazyLines::GetLine(size_t n)
+{
+    const wxTextBufferModifiableLines::const_iterator
+        it = m_modifiableLines.find(n);
+
+    return it != m_modifiableLines.end() ? it->second.line : DoGetLine(n);
+}
+
+wxString& wxTextBufferLazyLines::GetModifiableLine(size_t n)
+{
+    const wxTextBufferModifiableLines::iterator it = m_modifiableLines.find(n);
+    if ( it != m_modifiableLines.end() )
+        return it->second.line;
+
+    ForgetUnmodifiedLines();
+
+    wxTextBufferModifiableLine& line = m_modifiableLines[n];
+    line.original = DoGetLine(n);
+    line.line = line.original;
+    m_maybeUnmodified.push_back(n);
+
+    return line.line;
+}
+
+void wxTextBufferLazyLines::ForgetUnmodifiedLines()
+{
+    // Don't do anything until there are twice as many lines as we need to
+    // keep, to avoid doing it for every line.
+    if ( m_maybeUnmodified.size() < 2*MODIFIABLE_LINES_KEPT )
+        return;
+
+    const size_t count = m_maybeUnmodified.size() - MODIFIABLE_LINES_KEPT;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        const wxTextBufferModifiableLines::iterator
+            it = m_modifiableLines.find(m_maybeUnmodified[i]);
+
+        wxTextBufferModifiableLine& line = it->second;
+        if ( line.line == line.original )
+        {
+            m_modifiableLines.erase(it);
+        }
+        else
+        {
+            // It was modified, so keep it, but its original value is not
+            // needed any more as the reference to it is not valid any longer.
+            line.original.clear();
+        }
+    }
+
+    m_maybeUnmodified.erase(m_maybeUnmodified.begin(),
+                            m_maybeUnmodified.begin() + count);
 }
 
 // ----------------------------------------------------------------------------
@@ -206,11 +322,11 @@ wxTextFileType wxTextBuffer::GuessType() const
 
     // we take MAX_LINES_SCAN in the beginning, middle and the end of buffer
     #define MAX_LINES_SCAN    (10)
-    size_t nCount = m_aLines.GetCount() / 3,
+    size_t nCount = GetLineCount() / 3,
         nScan =  nCount > 3*MAX_LINES_SCAN ? MAX_LINES_SCAN : nCount / 3;
 
     #define   AnalyseLine(n)              \
-        switch ( m_aTypes[n] ) {            \
+        switch ( GetLineType(n) ) {         \
             case wxTextFileType_Unix: nUnix++; break;   \
             case wxTextFileType_Dos:  nDos++;  break;   \
             case wxTextFileType_Mac:  nMac++;  break;   \
@@ -264,6 +380,11 @@ bool wxTextBuffer::Close()
 
 bool wxTextBuffer::Write(wxTextFileType typeNew, const wxMBConv& conv)
 {
+    // the lines may be retrieved from the same file we're going to overwrite,
+    // so make sure they're all in memory before doing it
+    if ( m_lazyLines )
+        LoadLazyLines();
+
     return OnWrite(typeNew, conv);
 }
 
@@ -32,6 +32,420 @@
 #include "wx/textfile.h"
 #include "wx/filename.h"
 #include "wx/buffer.h"
+#include "wx/convauto.h"
+#include "wx/hashmap.h"
+#include "wx/scopedptr.h"
+#include "wx/vector.h"
+
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
+
+#include "wx/private/mappedfile.h"
+#include "wx/private/textbuf.h"
+
+// ============================================================================
+// wxMappedTextLines: lines of a memory-mapped file decoded on demand
+// ============================================================================
+
+namespace
+{
+
+// Number of the most recently retrieved lines kept in memory, the references
+// returned by DoGetLine() remain valid until this many other lines are used.
+const size_t LINES_CACHE_SIZE = wxTextBufferLazyLines::MODIFIABLE_LINES_KEPT;
+
+// Size of the chunks in which the file is indexed when accessing its lines
+// sequentially, must be a multiple of any possible m_unit value.
+const size_t INDEX_CHUNK_SIZE = 64*1024;
+
+#if wxUSE_THREADS
+// Minimal amount of data remaining to be indexed for using multiple threads.
+const size_t INDEX_PARALLEL_MIN_SIZE = 8*1024*1024;
+#endif // wxUSE_THREADS
+
+WX_DECLARE_HASH_MAP(size_t, size_t, wxIntegerHash, wxIntegerEqual,
+                    wxLinesCacheSlots);
+
+class wxMappedTextLines : public wxTextBufferLazyLines
+{
+public:
+    wxMappedTextLines()
+    {
+        m_conv = NULL;
+        m_unit = 0;
+        m_first =
+        m_end =
+        m_scanned = 0;
+
+        m_cacheNext = 0;
+        for ( size_t n = 0; n < LINES_CACHE_SIZE; n++ )
+            m_cacheLines[n] = NO_LINE;
+    }
+
+    virtual ~wxMappedTextLines()
+    {
+        delete m_conv;
+    }
+
+    // Map the file and check that its lines can be found without decoding
+    // it, return false if this is impossible.
+    bool Init(const wxString& filename, const wxMBConv& conv);
+
+    virtual bool HasLine(size_t n) wxOVERRIDE
+    {
+        IndexUpTo(n);
+
+        return n < m_starts.size();
+    }
+
+    virtual size_t GetCount() wxOVERRIDE
+    {
+        IndexAll();
+
+        return m_starts.size();
+    }
+
+    virtual wxTextFileType GetLineType(size_t n) wxOVERRIDE
+    {
+        size_t start, end;
+        return GetLineBounds(n, start, end);
+    }
+
+    // Append the offsets of the lines starting after the line terminators
+    // found in [from, to) range, which must be aligned on m_unit, to starts.
+    //
+    // This is only public to allow calling it from the other threads.
+    void FindLineStarts(size_t from, size_t to, wxVector<size_t>& starts) const;
+
+protected:
+    virtual const wxString& DoGetLine(size_t n) wxOVERRIDE;
+
+private:
+    static const size_t NO_LINE = static_cast<size_t>(-1);
+
+    bool IsAt(size_t pos, const char* pattern) const
+    {
+        return memcmp(m_file.GetData() + pos, pattern, m_unit) == 0;
+    }
+
+    // Index the file until the line with the given index is found and its end
+    // is known, or until the end of the file.
+    void IndexUpTo(size_t n);
+
+    // Index the file until the end.
+    void IndexAll();
+
+    // Find the bytes range of the given line, without the line terminator,
+    // and return the type of the latter.
+    wxTextFileType GetLineBounds(size_t n, size_t& start, size_t& end);
+
+
+    wxMappedFile m_file;
+
+    // The conversion used for decoding the lines, owned by this object.
+    wxMBConv* m_conv;
+
+    // The line terminators in the file encoding and their length which is
+    // also the length of the code unit of this encoding.
+    char m_lf[4],
+         m_cr[4];
+    size_t m_unit;
+
+    // The offset of the first line, which is non-zero if the file starts with
+    // a BOM, and the end of the part of the file consisting of entire code
+    // units, which can be searched for the line terminators.
+    size_t m_first,
+           m_end;
+
+    // The offsets of the starts of all the lines found so far and the offset
+    // up to which the file has been indexed.
+    wxVector<size_t> m_starts;
+    size_t m_scanned;
+
+    // The cache of the decoded lines: the line with the index m_cacheLines[n]
+    // is stored in m_cache[n] and m_cacheSlots maps the line index to n.
+    wxString m_cache[LINES_CACHE_SIZE];
+    size_t m_cacheLines[LINES_CACHE_SIZE];
+    wxLinesCacheSlots m_cacheSlots;
+    size_t m_cacheNext;
+
+    wxDECLARE_NO_COPY_CLASS(wxMappedTextLines);
+};
+
+#if wxUSE_THREADS
+
+// Functor used for indexing a part of the file in a pool thread.
+class wxFindLineStartsFunctor
+{
+public:
+    wxFindLineStartsFunctor(const wxMappedTextLines& lines,
+                            size_t from,
+                            size_t to)
+        : m_lines(lines),
+          m_from(from),
+          m_to(to)
+    {
+    }
+
+    wxVector<size_t> operator()() const
+    {
+        wxVector<size_t> starts;
+        m_lines.FindLineStarts(m_from, m_to, starts);
+        return starts;
+    }
+
+private:
+    const wxMappedTextLines& m_lines;
+    const size_t m_from,
+                 m_to;
+
+    wxDECLARE_NO_ASSIGN_CLASS(wxFindLineStartsFunctor);
+};
+
+#endif // wxUSE_THREADS
+
+bool wxMappedTextLines::Init(const wxString& filename, const wxMBConv& conv)
+{
+    if ( !m_file.Open(filename) )
+        return false;
+
+    const char* const data = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    m_conv = conv.Clone();
+
+    // The conversion needs to be initialized before using it for the
+    // individual lines if it's wxConvAuto, so feed it the start of the file.
+    // Notice that this doesn't do anything for the other conversions which
+    // don't skip the BOM, but we still need to check if they can decode it.
+    m_first = 0;
+    const wxBOM bom = wxConvAuto::DetectBOM(data, wxMin(size, 4));
+    switch ( bom )
+    {
+        case wxBOM_Unknown:
+            // The file is too small to be worth bothering with it.
+            return false;
+
+        case wxBOM_None:
+            m_conv->ToWChar(NULL, 0, "\n", 1);
+            break;
+
+        default:
+            {
+                size_t bomLen = 0;
+                wxConvAuto::GetBOMChars(bom, &bomLen);
+
+                // Decode the BOM with the shortest possible sequence of the
+                // characters following it.
+                wchar_t wbuf[16];
+                size_t rc = wxCONV_FAILED;
+                for ( size_t len = bomLen + 1;
+                      len <= bomLen + 8 && len <= size;
+                      len++ )
+                {
+                    rc = m_conv->ToWChar(wbuf, WXSIZEOF(wbuf), data, len);
+                    if ( rc != wxCONV_FAILED )
+                        break;
+                }
+
+                if ( rc == wxCONV_FAILED )
+                    return false;
+
+                // Only skip the BOM if it was consumed by the conversion.
+                if ( !rc || wbuf[0] != 0xFEFF )
+                    m_first = bomLen;
+            }
+            break;
+    }
+
+    const size_t lenLF = m_conv->FromWChar(m_lf, WXSIZEOF(m_lf), L"\n", 1);
+    const size_t lenCR = m_conv->FromWChar(m_cr, WXSIZEOF(m_cr), L"\r", 1);
+    if ( lenLF != lenCR || lenLF != m_conv->GetMBNulLen() )
+        return false;
+
+    switch ( lenLF )
+    {
+        case 1:
+        case 2:
+        case 4:
+            break;
+
+        default:
+            // This includes wxCONV_FAILED.
+            return false;
+    }
+
+    m_unit = lenLF;
+    m_end = m_first + (size - m_first) / m_unit * m_unit;
+    m_scanned = m_first;
+    if ( m_first < size )
+        m_starts.push_back(m_first);
+
+    return true;
+}
+
+void
+wxMappedTextLines::FindLineStarts(size_t from,
+                                  size_t to,
+                                  wxVector<size_t>& starts) const
+{
+    const char* const data = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    if ( m_unit == 1 )
+    {
+        // Optimize for the most common case.
+        const char lf = m_lf[0],
+                   cr = m_cr[0];
+
+        for ( size_t pos = from; pos < to; pos++ )
+        {
+            const char ch = data[pos];
+            if ( ch == lf ||
+                    (ch == cr && (pos + 1 == size || data[pos + 1] != lf)) )
+            {
+                if ( pos + 1 < size )
+                    starts.push_back(pos + 1);
+            }
+        }
+    }
+    else
+    {
+        for ( size_t pos = from; pos < to; pos += m_unit )
+        {
+            const size_t next = pos + m_unit;
+            if ( IsAt(pos, m_lf) ||
+                    (IsAt(pos, m_cr) && (next == m_end || !IsAt(next, m_lf))) )
+            {
+                if ( next < size )
+                    starts.push_back(next);
+            }
+        }
+    }
+}
+
+void wxMappedTextLines::IndexUpTo(size_t n)
+{
+    // We need the start of the next line to find the end of this one.
+    while ( m_starts.size() <= n + 1 && m_scanned < m_end )
+    {
+        const size_t to = wxMin(m_scanned + INDEX_CHUNK_SIZE, m_end);
+        FindLineStarts(m_scanned, to, m_starts);
+        m_scanned = to;
+    }
+}
+
+void wxMappedTextLines::IndexAll()
+{
+    if ( m_scanned == m_end )
+        return;
+
+#if wxUSE_THREADS
+    // Split the remaining part of the file in chunks indexed in parallel if
+    // it's big enough to make it worth it. Notice that we must not wait for
+    // the other pool threads if we're running in one of them ourselves.
+    wxThreadPool& pool = wxThreadPool::Get();
+    const size_t remaining = m_end - m_scanned;
+    if ( remaining >= INDEX_PARALLEL_MIN_SIZE &&
+            pool.GetThreadCount() > 1 && !pool.IsPoolThread() )
+    {
+        const size_t numChunks = 4*pool.GetThreadCount();
+        const size_t chunkSize = (remaining / numChunks) / m_unit * m_unit;
+
+        wxVector< wxFuture< wxVector<size_t> > > futures;
+        futures.reserve(numChunks);
+        for ( size_t n = 0; n < numChunks; n++ )
+        {
+            const size_t from = m_scanned + n*chunkSize;
+            const size_t to = n == numChunks - 1 ? m_end : from + chunkSize;
+
+            futures.push_back(pool.Async< wxVector<size_t> >(
+                                wxFindLineStartsFunctor(*this, from, to)));
+        }
+
+        for ( size_t n = 0; n < numChunks; n++ )
+        {
+            const wxVector<size_t>& starts = futures[n].Get();
+            for ( size_t i = 0; i < starts.size(); i++ )
+                m_starts.push_back(starts[i]);
+        }
+
+        m_scanned = m_end;
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    FindLineStarts(m_scanned, m_end, m_starts);
+    m_scanned = m_end;
+}
+
+wxTextFileType
+wxMappedTextLines::GetLineBounds(size_t n, size_t& start, size_t& end)
+{
+    IndexUpTo(n);
+
+    wxCHECK_MSG( n < m_starts.size(), wxTextFileType_None,
+                 wxS("invalid line index") );
+
+    start = m_starts[n];
+    end = n + 1 < m_starts.size() ? m_starts[n + 1] : m_file.GetSize();
+
+    // Notice that the last line may end with an incomplete code unit, in
+    // which case it can't have any terminator.
+    if ( end - start >= m_unit && (end - m_first) % m_unit == 0 )
+    {
+        if ( IsAt(end - m_unit, m_lf) )
+        {
+            end -= m_unit;
+            if ( end - start >= m_unit && IsAt(end - m_unit, m_cr) )
+            {
+                end -= m_unit;
+                return wxTextFileType_Dos;
+            }
+
+            return wxTextFileType_Unix;
+        }
+
+        if ( IsAt(end - m_unit, m_cr) )
+        {
+            end -= m_unit;
+            return wxTextFileType_Mac;
+        }
+    }
+
+    return wxTextFileType_None;
+}
+
+const wxString& wxMappedTextLines::DoGetLine(size_t n)
+{
+    const wxLinesCacheSlots::const_iterator it = m_cacheSlots.find(n);
+    if ( it != m_cacheSlots.end() )
+        return m_cache[it->second];
+
+    // Reuse the least recently added slot.
+    const size_t slot = m_cacheNext;
+    m_cacheNext = (m_cacheNext + 1) % LINES_CACHE_SIZE;
+
+    if ( m_cacheLines[slot] != NO_LINE )
+        m_cacheSlots.erase(m_cacheLines[slot]);
+
+    wxString& line = m_cache[slot];
+
+    size_t start, end;
+    GetLineBounds(n, start, end);
+    if ( end > start )
+        line = wxString(m_file.GetData() + start, *m_conv, end - start);
+    else
+        line.clear();
+
+    m_cacheLines[slot] = n;
+    m_cacheSlots[n] = slot;
+
+    return line;
+}
+
+} // anonymous namespace
 
 // ============================================================================
 // wxTextFile class implementation
@@ -40,6 +454,16 @@
 wxTextFile::wxTextFile(const wxString& strFileName)
           : wxTextBuffer(strFileName)
 {
+    m_openMapped = false;
+}
+
+bool wxTextFile::OpenMapped(const wxString& strFileName, const wxMBConv& conv)
+{
+    m_openMapped = true;
+    const bool ok = Open(strFileName, conv);
+    m_openMapped = false;
+
+    return ok;
 }
 
 
@@ -90,6 +514,17 @@ bool wxTextFile::OnRead(const wxMBConv& conv)
     // file should be opened
     wxASSERT_MSG( m_file.IsOpened(), wxT("can't read closed file") );
 
+    if ( m_openMapped )
+    {
+        // Fall back to reading the file normally if it can't be mapped.
+        wxScopedPtr<wxMappedTextLines> lines(new wxMappedTextLines);
+        if ( lines->Init(m_strBufferName, conv) )
+        {
+            SetLazyLines(lines.release());
+            return true;
+        }
+    }
+
     wxString str;
     if ( !m_file.ReadAll(&str, conv) )
     {
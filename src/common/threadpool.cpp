@@ -0,0 +1,596 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/threadpool.h"
+
+#if wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+#endif // WX_PRECOMP
+
+#include "wx/stopwatch.h"           // for wxGetLocalTimeMillis()
+
+// ----------------------------------------------------------------------------
+// private classes
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Queue of the tasks of a single worker thread.
+//
+// The worker itself takes the tasks from the back of the queue, as the most
+// recently added tasks are the most likely to still have their data in the
+// cache, while the other workers steal them from the front.
+class TaskQueue
+{
+public:
+    TaskQueue() : m_first(0) { }
+
+    void PushBack(wxThreadPoolTask* task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        m_tasks.push_back(task);
+    }
+
+    wxThreadPoolTask* PopBack()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_first == m_tasks.size() )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks.back();
+        m_tasks.pop_back();
+
+        if ( m_first == m_tasks.size() )
+            Reset();
+
+        return task;
+    }
+
+    wxThreadPoolTask* PopFront()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_first == m_tasks.size() )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks[m_first++];
+
+        if ( m_first == m_tasks.size() )
+        {
+            Reset();
+        }
+        else if ( m_first >= 64 && m_first >= m_tasks.size() / 2 )
+        {
+            // Don't let the already taken tasks accumulate at the front.
+            m_tasks.erase(m_tasks.begin(), m_tasks.begin() + m_first);
+            m_first = 0;
+        }
+
+        return task;
+    }
+
+private:
+    void Reset()
+    {
+        m_tasks.clear();
+        m_first = 0;
+    }
+
+    wxCriticalSection m_cs;
+
+    // The tasks before m_first have been already taken.
+    wxVector<wxThreadPoolTask*> m_tasks;
+    size_t m_first;
+
+    wxDECLARE_NO_COPY_CLASS(TaskQueue);
+};
+
+class WorkerThread : public wxThread
+{
+public:
+    WorkerThread(wxThreadPoolImpl& impl, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_impl(impl),
+          m_index(index)
+    {
+    }
+
+protected:
+    virtual void* Entry() wxOVERRIDE;
+
+private:
+    wxThreadPoolImpl& m_impl;
+    const size_t m_index;
+
+    wxDECLARE_NO_COPY_CLASS(WorkerThread);
+};
+
+} // anonymous namespace
+
+class wxThreadPoolImpl
+{
+public:
+    explicit wxThreadPoolImpl(int numThreads);
+    ~wxThreadPoolImpl();
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    // Return the index of the worker corresponding to the current thread or
+    // GetThreadCount() if it's not one of our threads.
+    size_t GetCurrentWorker() const;
+
+    bool SubmitTask(wxThreadPoolTask* task);
+
+    void WaitIdle();
+
+    // Function executed by the worker with the given index.
+    void WorkerMain(size_t index);
+
+private:
+    // Take a task from the queue of the given worker or steal it from another
+    // one, return NULL if there are no tasks.
+    wxThreadPoolTask* TakeTask(size_t index);
+
+    void RunTask(wxThreadPoolTask* task);
+
+
+    wxVector<WorkerThread*> m_workers;
+    wxVector<TaskQueue*> m_queues;
+
+    // Used with both conditions and protects m_nextQueue and m_stopping.
+    //
+    // Notice that it is not used when taking the tasks from the queues, which
+    // are protected by their own locks, but only for waiting until there is
+    // something to do or until there is nothing left to do.
+    wxMutex m_mutex;
+
+    // Signalled when a new task is queued or the pool is shutting down.
+    wxCondition m_condWork;
+
+    // Signalled when there are no more pending tasks.
+    wxCondition m_condIdle;
+
+    // The number of tasks in all the queues: this is incremented before adding
+    // a task to a queue while holding m_mutex, so that a worker checking it
+    // under m_mutex doesn't miss the task, but decremented only after taking
+    // it from the queue without holding m_mutex, so it may be temporarily
+    // greater than the real number of queued tasks.
+    wxAtomicInt m_queued;
+
+    // The number of tasks either queued or being executed, incremented while
+    // holding m_mutex and decremented without it.
+    wxAtomicInt m_pending;
+
+    // Used for choosing the queue for the tasks submitted from outside.
+    size_t m_nextQueue;
+
+    bool m_stopping;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolImpl);
+};
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// WorkerThread
+// ----------------------------------------------------------------------------
+
+void* WorkerThread::Entry()
+{
+    m_impl.WorkerMain(m_index);
+
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolImpl
+// ----------------------------------------------------------------------------
+
+wxThreadPoolImpl::wxThreadPoolImpl(int numThreads)
+    : m_condWork(m_mutex),
+      m_condIdle(m_mutex),
+      m_queued(0),
+      m_pending(0),
+      m_nextQueue(0),
+      m_stopping(false)
+{
+    if ( numThreads <= 0 )
+    {
+        numThreads = wxThread::GetCPUCount();
+        if ( numThreads <= 0 )
+            numThreads = 1;
+    }
+
+    // Create all the queues before starting any threads as they access them.
+    for ( int n = 0; n < numThreads; n++ )
+        m_queues.push_back(new TaskQueue);
+
+    // Prevent the threads from starting to look at m_workers before we
+    // finish filling it.
+    wxMutexLocker lock(m_mutex);
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        WorkerThread* const thread = new WorkerThread(*this, n);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to create thread pool worker thread.");
+
+            delete thread;
+            break;
+        }
+
+        m_workers.push_back(thread);
+    }
+
+    // Don't keep the queues of the threads which couldn't be created.
+    while ( m_queues.size() > m_workers.size() )
+    {
+        delete m_queues.back();
+        m_queues.pop_back();
+    }
+}
+
+wxThreadPoolImpl::~wxThreadPoolImpl()
+{
+    WaitIdle();
+
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_stopping = true;
+        m_condWork.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        m_workers[n]->Wait();
+        delete m_workers[n];
+    }
+
+    for ( size_t n = 0; n < m_queues.size(); n++ )
+        delete m_queues[n];
+}
+
+size_t wxThreadPoolImpl::GetCurrentWorker() const
+{
+    wxThread* const current = wxThread::This();
+
+    size_t n;
+    for ( n = 0; n < m_workers.size(); n++ )
+    {
+        if ( m_workers[n] == current )
+            break;
+    }
+
+    return n;
+}
+
+bool wxThreadPoolImpl::SubmitTask(wxThreadPoolTask* task)
+{
+    const size_t numQueues = m_queues.size();
+    if ( !numQueues )
+    {
+        delete task;
+        return false;
+    }
+
+    // Tasks submitted from the worker threads themselves are put into their
+    // own queues, as it's more efficient to execute them in the same thread,
+    // while the other ones are distributed among all workers.
+    size_t index = GetCurrentWorker();
+
+    wxMutexLocker lock(m_mutex);
+
+    if ( index == numQueues )
+        index = m_nextQueue++ % numQueues;
+
+    wxAtomicInc(m_pending);
+    wxAtomicInc(m_queued);
+
+    // Notice that the task must be added to the queue while holding the
+    // mutex to ensure that the worker woken up below finds it.
+    m_queues[index]->PushBack(task);
+
+    m_condWork.Signal();
+
+    return true;
+}
+
+void wxThreadPoolImpl::WaitIdle()
+{
+    wxASSERT_MSG( GetCurrentWorker() == m_workers.size(),
+                  "can't wait for the thread pool from its own thread" );
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_pending > 0 )
+        m_condIdle.Wait();
+}
+
+wxThreadPoolTask* wxThreadPoolImpl::TakeTask(size_t index)
+{
+    // Only the locks of the individual queues are used here, so the workers
+    // taking the tasks from their own queues don't contend with each other.
+    wxThreadPoolTask* task = m_queues[index]->PopBack();
+
+    const size_t numQueues = m_queues.size();
+    for ( size_t n = 1; !task && n < numQueues; n++ )
+        task = m_queues[(index + n) % numQueues]->PopFront();
+
+    if ( task )
+        wxAtomicDec(m_queued);
+
+    return task;
+}
+
+void wxThreadPoolImpl::RunTask(wxThreadPoolTask* task)
+{
+    wxTRY
+    {
+        task->Run();
+    }
+    wxCATCH_ALL
+    (
+        if ( wxTheApp )
+            wxTheApp->OnUnhandledException();
+    )
+
+    // Notice that deleting the task may submit more tasks (e.g. the
+    // continuations of a future), so it must be done before updating the
+    // number of pending tasks to avoid becoming idle prematurely.
+    delete task;
+
+    if ( wxAtomicDec(m_pending) == 0 )
+    {
+        // Lock the mutex to ensure that WaitIdle() is either already waiting
+        // or will see the updated value.
+        wxMutexLocker lock(m_mutex);
+
+        m_condIdle.Broadcast();
+    }
+}
+
+void wxThreadPoolImpl::WorkerMain(size_t index)
+{
+    // Wait until the ctor finishes creating all the threads.
+    {
+        wxMutexLocker lock(m_mutex);
+    }
+
+    for ( ;; )
+    {
+        wxThreadPoolTask* const task = TakeTask(index);
+        if ( task )
+        {
+            RunTask(task);
+            continue;
+        }
+
+        // Notice that m_queued may be positive here if another worker has
+        // just taken the last task but not decremented it yet, in which case
+        // we just try taking a task again.
+        wxMutexLocker lock(m_mutex);
+
+        while ( m_queued <= 0 && !m_stopping )
+            m_condWork.Wait();
+
+        if ( m_queued <= 0 )
+            break;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPool
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxThreadPool* gs_threadPool = NULL;
+
+inline wxCriticalSection& GetThreadPoolCS()
+{
+    static wxCriticalSection s_csThreadPool;
+
+    return s_csThreadPool;
+}
+
+} // anonymous namespace
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_impl(new wxThreadPoolImpl(numThreads))
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    delete m_impl;
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    wxCriticalSectionLocker lock(GetThreadPoolCS());
+
+    if ( !gs_threadPool )
+        gs_threadPool = new wxThreadPool;
+
+    return *gs_threadPool;
+}
+
+int wxThreadPool::GetThreadCount() const
+{
+    return static_cast<int>(m_impl->GetThreadCount());
+}
+
+bool wxThreadPool::IsPoolThread() const
+{
+    return m_impl->GetCurrentWorker() != m_impl->GetThreadCount();
+}
+
+bool wxThreadPool::SubmitTask(wxThreadPoolTask* task)
+{
+    wxCHECK_MSG( task, false, "NULL task" );
+
+    return m_impl->SubmitTask(task);
+}
+
+void wxThreadPool::WaitIdle()
+{
+    m_impl->WaitIdle();
+}
+
+// ----------------------------------------------------------------------------
+// wxFutureStateBase
+// ----------------------------------------------------------------------------
+
+wxFutureStateBase::wxFutureStateBase(wxThreadPool& pool)
+    : m_pool(pool),
+      m_refCount(1),
+      m_condReady(m_mutex),
+      m_ready(false)
+{
+}
+
+wxFutureStateBase::~wxFutureStateBase()
+{
+    // This can only happen if the state was never made ready, which normally
+    // shouldn't be the case.
+    for ( size_t n = 0; n < m_continuations.size(); n++ )
+        delete m_continuations[n];
+}
+
+bool wxFutureStateBase::IsReady() const
+{
+    wxMutexLocker lock(m_mutex);
+
+    return m_ready;
+}
+
+void wxFutureStateBase::Wait() const
+{
+    // If all the pool threads did this, there would be no threads left to
+    // compute the value, so don't allow it at all, just as WaitIdle().
+    wxASSERT_MSG( !m_pool.IsPoolThread() || IsReady(),
+                  "can't wait for the future value from the pool thread" );
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( !m_ready )
+        m_condReady.Wait();
+}
+
+bool wxFutureStateBase::WaitTimeout(unsigned long milliseconds) const
+{
+    const wxMilliClock_t deadline = wxGetLocalTimeMillis() + milliseconds;
+
+    wxMutexLocker lock(m_mutex);
+
+    // Don't return before the timeout expires in case of spurious wakeups.
+    while ( !m_ready )
+    {
+        const wxMilliClock_t now = wxGetLocalTimeMillis();
+        if ( now >= deadline )
+            break;
+
+        m_condReady.WaitTimeout(wxMilliClockToLong(deadline - now));
+    }
+
+    return m_ready;
+}
+
+void wxFutureStateBase::MakeReady()
+{
+    wxVector<wxThreadPoolTask*> continuations;
+
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( m_ready )
+            return;
+
+        m_ready = true;
+        m_condReady.Broadcast();
+
+        continuations.swap(m_continuations);
+    }
+
+    for ( size_t n = 0; n < continuations.size(); n++ )
+        m_pool.SubmitTask(continuations[n]);
+}
+
+void wxFutureStateBase::AddContinuation(wxThreadPoolTask* task)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+
+        if ( !m_ready )
+        {
+            m_continuations.push_back(task);
+            return;
+        }
+    }
+
+    m_pool.SubmitTask(task);
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the global pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule() { }
+
+    virtual bool OnInit() wxOVERRIDE { return true; }
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxThreadPool* pool;
+        {
+            wxCriticalSectionLocker lock(GetThreadPoolCS());
+
+            pool = gs_threadPool;
+            gs_threadPool = NULL;
+        }
+
+        // Don't delete the pool while holding the lock as the tasks still
+        // running in it could call Get().
+        delete pool;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
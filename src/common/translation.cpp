@@ -45,6 +45,8 @@
 #include "wx/fontmap.h"
 #include "wx/scopedptr.h"
 #include "wx/stdpaths.h"
+#include "wx/thread.h"
+#include "wx/private/mappedfile.h"
 #include "wx/private/threadinfo.h"
 
 #ifdef __WINDOWS__
@@ -1022,15 +1024,26 @@ public:
     wxMsgCatalogFile();
     ~wxMsgCatalogFile();
 
-    // load the catalog from disk
+    // load the catalog from disk, memory-mapping it if requested and possible
     bool LoadFile(const wxString& filename,
-                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
+                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                  bool map = false);
     bool LoadData(const DataBuffer& data,
                   wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
 
     // fills the hash with string-translation pairs
     bool FillHash(wxStringToStringHashMap& hash, const wxString& domain) const;
 
+#if wxUSE_UNICODE
+    // prepare for using GetString(), must be called after loading the data
+    bool InitLookup();
+
+    // find the translation of the given msgid, including the context prefix
+    // if any, directly in the catalog data: the returned pointer remains
+    // valid as long as this object exists
+    const wxString *GetString(const wxString& msgid, unsigned index) const;
+#endif // wxUSE_UNICODE
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -1060,6 +1073,9 @@ private:
     // all data is stored here
     DataBuffer m_data;
 
+    // the memory-mapped file m_data refers to if the file was mapped
+    wxMappedFile m_mapped;
+
     // data description
     size_t32          m_numStrings;   // number of strings in this domain
     const
@@ -1093,6 +1109,36 @@ private:
 
     bool m_bSwapped;   // wrong endianness?
 
+#if wxUSE_UNICODE
+    // the hash function used for the catalog hash table, see gettext
+    // hash-string.c
+    static size_t32 GetHash(const char *str);
+
+    // compare the original string with the given index with the given string
+    // of the given length, the result is the same as for strcmp()
+    int CompareOrig(size_t32 n, const char *str, size_t len) const;
+
+    // find the index of the given original string, return false if not found
+    bool FindOrig(const char *str, size_t32& n) const;
+
+    // the hash table, if any, used by FindOrig()
+    const size_t32 *m_pHashTable;
+    size_t32        m_nHashSize;
+
+    // conversion from the catalog charset, m_convOwned is only used to delete
+    // m_conv if we allocated it ourselves
+    wxMBConv *m_conv;
+    wxScopedPtr<wxMBConv> m_convOwned;
+
+    // the already converted translations indexed by their offsets in m_data
+    WX_DECLARE_HASH_MAP(unsigned long, wxString,
+                        wxIntegerHash, wxIntegerEqual,
+                        wxMsgCatalogStrings);
+
+    mutable wxMsgCatalogStrings m_strings;
+    mutable wxCriticalSection m_stringsCS;
+#endif // wxUSE_UNICODE
+
     wxDECLARE_NO_COPY_CLASS(wxMsgCatalogFile);
 };
 
@@ -1102,6 +1148,11 @@ private:
 
 wxMsgCatalogFile::wxMsgCatalogFile()
 {
+#if wxUSE_UNICODE
+    m_pHashTable = NULL;
+    m_nHashSize = 0;
+    m_conv = NULL;
+#endif // wxUSE_UNICODE
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
@@ -1110,34 +1161,40 @@ wxMsgCatalogFile::~wxMsgCatalogFile()
 
 // open disk file and read in it's contents
 bool wxMsgCatalogFile::LoadFile(const wxString& filename,
-                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator)
+                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                                bool map)
 {
-    wxFile fileMsg(filename);
-    if ( !fileMsg.IsOpened() )
-        return false;
+    DataBuffer data;
+    if ( map && m_mapped.Open(filename) )
+    {
+        data = DataBuffer::CreateNonOwned(m_mapped.GetData(),
+                                          m_mapped.GetSize());
+    }
+    else // read the whole file in memory
+    {
+        wxFile fileMsg(filename);
+        if ( !fileMsg.IsOpened() )
+            return false;
 
-    // get the file size (assume it is less than 4GB...)
-    wxFileOffset lenFile = fileMsg.Length();
-    if ( lenFile == wxInvalidOffset )
-        return false;
+        // get the file size (assume it is less than 4GB...)
+        wxFileOffset lenFile = fileMsg.Length();
+        if ( lenFile == wxInvalidOffset )
+            return false;
 
-    size_t nSize = wx_truncate_cast(size_t, lenFile);
-    wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
+        size_t nSize = wx_truncate_cast(size_t, lenFile);
+        wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    wxMemoryBuffer filedata;
+        wxMemoryBuffer filedata;
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
+
+        filedata.UngetWriteBuf(nSize);
 
-    filedata.UngetWriteBuf(nSize);
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
-    if ( !ok )
+    if ( !LoadData(data, rPluralFormsCalculator) )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename.c_str());
         return false;
@@ -1338,14 +1395,208 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
     return true;
 }
 
+#if wxUSE_UNICODE
+
+bool wxMsgCatalogFile::InitLookup()
+{
+    // unlike FillHash(), we access the tables for all strings directly, so
+    // check that they're really inside the data
+    const wxMsgCatalogHeader* const
+        pHeader = reinterpret_cast<const wxMsgCatalogHeader*>(m_data.data());
+    const size_t len = m_data.length();
+    const size_t maxStrings = len / sizeof(wxMsgTableEntry);
+    if ( m_numStrings > maxStrings ||
+            Swap(pHeader->ofsOrigTable) > len - m_numStrings*sizeof(wxMsgTableEntry) ||
+                Swap(pHeader->ofsTransTable) > len - m_numStrings*sizeof(wxMsgTableEntry) )
+    {
+        wxLogWarning(_("Invalid message catalog."));
+        return false;
+    }
+
+    // the hash table is optional, we just won't use it if it's absent or
+    // invalid (notice that its size must be greater than 2 for the probing
+    // sequence to work)
+    const size_t32 nHashSize = Swap(pHeader->nHashSize);
+    if ( nHashSize > 2 &&
+            nHashSize <= len / sizeof(size_t32) &&
+                Swap(pHeader->ofsHashTable) <= len - nHashSize*sizeof(size_t32) )
+    {
+        m_pHashTable = reinterpret_cast<const size_t32*>(m_data.data() +
+                       Swap(pHeader->ofsHashTable));
+        m_nHashSize = nHashSize;
+    }
+
+    // use the same conversion as FillHash()
+    if ( !m_charset.empty() )
+    {
+        m_convOwned.reset(new wxCSConv(m_charset));
+        m_conv = m_convOwned.get();
+    }
+    else
+    {
+        m_conv = wxConvCurrent;
+    }
+
+    return true;
+}
+
+/* static */
+size_t32 wxMsgCatalogFile::GetHash(const char *str)
+{
+    size_t32 hval = 0;
+    for ( ; *str; ++str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str);
+
+        const size_t32 g = hval & (static_cast<size_t32>(0xf) << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+int wxMsgCatalogFile::CompareOrig(size_t32 n, const char *str, size_t len) const
+{
+    const char* const orig = StringAtOfs(m_pOrigTable, n);
+    if ( !orig )
+        return -1; // invalid entry, shouldn't happen for valid files
+
+    // the original string of the plural entries contains both the singular
+    // and plural forms separated by NUL, but only the former must be compared
+    const size_t lenOrig = wxStrnlen(orig, Swap(m_pOrigTable[n].nLen));
+
+    const int rc = memcmp(orig, str, wxMin(lenOrig, len));
+    if ( rc )
+        return rc;
+
+    return lenOrig < len ? -1 : lenOrig > len ? 1 : 0;
+}
+
+bool wxMsgCatalogFile::FindOrig(const char *str, size_t32& n) const
+{
+    const size_t len = strlen(str);
+
+    if ( m_pHashTable )
+    {
+        // use the same double hashing as GNU gettext
+        const size_t32 hval = GetHash(str);
+        const size_t32 incr = 1 + hval % (m_nHashSize - 2);
+        size_t32 idx = hval % m_nHashSize;
+
+        // don't loop forever if the table is corrupted and has no empty slots
+        for ( size_t32 probe = 0; probe < m_nHashSize; probe++ )
+        {
+            size_t32 nstr = Swap(m_pHashTable[idx]);
+            if ( !nstr )
+                return false;
+
+            // indices in the hash table are 1-based
+            nstr--;
+            if ( nstr < m_numStrings && CompareOrig(nstr, str, len) == 0 )
+            {
+                n = nstr;
+                return true;
+            }
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
+
+        return false;
+    }
+
+    // the original strings are sorted, so use binary search if there is no
+    // hash table
+    size_t32 lo = 0,
+             hi = m_numStrings;
+    while ( lo < hi )
+    {
+        const size_t32 mid = lo + (hi - lo) / 2;
+        const int rc = CompareOrig(mid, str, len);
+        if ( rc == 0 )
+        {
+            n = mid;
+            return true;
+        }
+
+        if ( rc < 0 )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return false;
+}
+
+const wxString *
+wxMsgCatalogFile::GetString(const wxString& msgid, unsigned index) const
+{
+    const wxCharBuffer buf(msgid.mb_str(*m_conv));
+    if ( !buf.data() )
+        return NULL; // msgid is not representable in the catalog charset
+
+    size_t32 n;
+    if ( !FindOrig(buf, n) )
+        return NULL;
+
+    const char* const data = StringAtOfs(m_pTransTable, n);
+    if ( !data )
+        return NULL;
+
+    // find the string corresponding to the given plural form, see FillHash()
+    const size_t length = Swap(m_pTransTable[n].nLen);
+    size_t offset = 0;
+    for ( ; index; --index )
+    {
+        offset += wxStrnlen(data + offset, length - offset) + 1;
+        if ( offset >= length )
+            return NULL;
+    }
+
+    const char* const str = data + offset;
+    const size_t len = wxStrnlen(str, length - offset);
+
+    // notice that FillHash() doesn't store the empty strings, so we don't
+    // return them neither
+    if ( !len )
+        return NULL;
+
+    wxCRIT_SECT_LOCKER(lock, m_stringsCS);
+
+    const unsigned long key = static_cast<unsigned long>(str - m_data.data());
+    wxMsgCatalogStrings::const_iterator it = m_strings.find(key);
+    if ( it != m_strings.end() )
+        return &it->second;
+
+    const wxString msgstr(str, *m_conv, len);
+    if ( msgstr.empty() )
+        return NULL;
+
+    // this doesn't invalidate the pointers to the existing elements
+    wxString& value = m_strings[key];
+    value = msgstr;
+    return &value;
+}
+
+#endif // wxUSE_UNICODE
+
 
 // ----------------------------------------------------------------------------
 // wxMsgCatalog class
 // ----------------------------------------------------------------------------
 
-#if !wxUSE_UNICODE
 wxMsgCatalog::~wxMsgCatalog()
 {
+    delete m_file;
+
+#if !wxUSE_UNICODE
     if ( m_conv )
     {
         if ( wxConvUI == m_conv )
@@ -1357,21 +1608,47 @@ wxMsgCatalog::~wxMsgCatalog()
 
         delete m_conv;
     }
-}
 #endif // !wxUSE_UNICODE
+}
+
+bool wxMsgCatalog::InitFromFile(wxMsgCatalogFile *file, int flags)
+{
+    wxScopedPtr<wxMsgCatalogFile> fileOwner(file);
+
+#if wxUSE_UNICODE
+    if ( flags & wxMSGCATALOG_LAZY )
+    {
+        if ( !file->InitLookup() )
+            return false;
+
+        m_file = fileOwner.release();
+        return true;
+    }
+#else // !wxUSE_UNICODE
+    // lazy loading is not supported in this build, just ignore the flag
+    wxUnusedVar(flags);
+#endif // wxUSE_UNICODE/!wxUSE_UNICODE
+
+    return file->FillHash(m_messages, m_domain);
+}
 
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
-                                           const wxString& domain)
+                                           const wxString& domain,
+                                           int flags)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    wxMsgCatalogFile* const file = new wxMsgCatalogFile;
 
-    if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
+    if ( !file->LoadFile(filename, cat->m_pluralFormsCalculator,
+                         (flags & wxMSGCATALOG_LAZY) != 0) )
+    {
+        delete file;
         return NULL;
+    }
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !cat->InitFromFile(file, flags) )
         return NULL;
 
     return cat.release();
@@ -1379,16 +1656,20 @@ wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
 
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
-                                           const wxString& domain)
+                                           const wxString& domain,
+                                           int flags)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
-    wxMsgCatalogFile file;
+    wxMsgCatalogFile* const file = new wxMsgCatalogFile;
 
-    if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
+    if ( !file->LoadData(data, cat->m_pluralFormsCalculator) )
+    {
+        delete file;
         return NULL;
+    }
 
-    if ( !file.FillHash(cat->m_messages, domain) )
+    if ( !cat->InitFromFile(file, flags) )
         return NULL;
 
     return cat.release();
@@ -1401,6 +1682,18 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
+
+#if wxUSE_UNICODE
+    if ( m_file )
+    {
+        // the plural form index is not part of the key in this case
+        if (context.IsEmpty())
+            return m_file->GetString(str, index);
+        else
+            return m_file->GetString(wxString(context) + wxString('\x04') + wxString(str), index);
+    }
+#endif // wxUSE_UNICODE
+
     wxStringToStringHashMap::const_iterator i;
     if (index != 0)
     {
@@ -1934,7 +2227,7 @@ wxMsgCatalog *wxFileTranslationsLoader::LoadCatalog(const wxString& domain,
     wxLogVerbose(_("using catalog '%s' from '%s'."), domain, strFullName.c_str());
     wxLogTrace(TRACE_I18N, wxS("Using catalog \"%s\"."), strFullName.c_str());
 
-    return wxMsgCatalog::CreateFromFile(strFullName, domain);
+    return wxMsgCatalog::CreateFromFile(strFullName, domain, m_flags);
 }
 
 
@@ -22,6 +22,18 @@
 
 #include <ctype.h>
 
+namespace
+{
+
+// The size of the blocks read from the stream by ReadLine(wxString&).
+const size_t TEXT_BLOCK_SIZE = 16384;
+
+// The number of characters decoded one by one by ReadLine(wxString&) if the
+// input can't be decoded in blocks.
+const size_t TEXT_SLOW_FILL_COUNT = 256;
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // wxTextInputStream
 // ----------------------------------------------------------------------------
@@ -35,6 +47,15 @@ wxTextInputStream::wxTextInputStream(wxInputStream &s,
     m_validBegin =
     m_validEnd = 0;
 
+    m_decoded = NULL;
+    m_decodedPos =
+    m_decodedLen = 0;
+
+    m_raw = NULL;
+    m_rawLen =
+    m_rawUnit = 0;
+    m_decodeInBlocks = true;
+
 #if SIZEOF_WCHAR_T == 2
     m_lastWChar = 0;
 #endif // SIZEOF_WCHAR_T == 2
@@ -47,12 +68,19 @@ wxTextInputStream::wxTextInputStream(wxInputStream &s, const wxString &sep)
     m_validEnd = 0;
 
     m_lastBytes[0] = 0;
+
+    m_decoded = NULL;
+    m_decodedPos =
+    m_decodedLen = 0;
 }
 #endif
 
 wxTextInputStream::~wxTextInputStream()
 {
+    delete [] m_decoded;
+
 #if wxUSE_UNICODE
+    delete [] m_raw;
     delete m_conv;
 #endif // wxUSE_UNICODE
 }
@@ -66,11 +94,34 @@ void wxTextInputStream::UngetLast()
         m_validBegin =
         m_validEnd = 0;
     }
+    else if ( m_decodedPos )
+    {
+        // The last character was returned from the decoded buffer (notice
+        // that m_validEnd is always 0 when it's not empty), so just put it
+        // back there.
+        m_decodedPos--;
+    }
 }
 
 wxChar wxTextInputStream::GetChar()
 {
+    // Return the characters already decoded by ReadLine(wxString&) first.
+    if ( HasDecodedChars() )
+        return m_decoded[m_decodedPos++];
+
 #if wxUSE_UNICODE
+    // And return the bytes read by it, but not decoded yet, to the stream to
+    // decode them below.
+    if ( m_rawLen )
+    {
+        m_input.Ungetch(m_raw, m_rawLen);
+        m_rawLen = 0;
+
+        // The stream is not at EOF any more if it was before.
+        if ( m_input.Eof() )
+            m_input.Reset();
+    }
+
 #if SIZEOF_WCHAR_T == 2
     // Return the already raed character remaining from the last call to this
     // function, if any.
@@ -217,10 +268,195 @@ bool wxTextInputStream::EatEOL(const wxChar &c)
     return false;
 }
 
+bool wxTextInputStream::FillBuffer()
+{
+    m_decodedPos =
+    m_decodedLen = 0;
+
+    if ( !m_decoded )
+    {
+        // We need an extra character for the second half of a surrogate
+        // remaining from the last GetChar() call, see below.
+        m_decoded = new wxChar[TEXT_BLOCK_SIZE + sizeof(m_lastBytes) + 1];
+#if wxUSE_UNICODE
+        m_raw = new char[TEXT_BLOCK_SIZE + sizeof(m_lastBytes)];
+#endif // wxUSE_UNICODE
+    }
+
+#if wxUSE_UNICODE
+    if ( !m_decodeInBlocks )
+    {
+        // Decode the characters one by one using GetChar(), which stops at
+        // the first invalid character. Notice that GetChar() doesn't use the
+        // buffer as long as m_decodedLen is 0.
+        size_t len = 0;
+        while ( len < TEXT_SLOW_FILL_COUNT )
+        {
+            const wxChar c = GetChar();
+            if ( !c )
+                break;
+
+            m_decoded[len++] = c;
+        }
+
+#if SIZEOF_WCHAR_T == 2
+        if ( m_lastWChar )
+        {
+            m_decoded[len++] = m_lastWChar;
+            m_lastWChar = 0;
+        }
+#endif // SIZEOF_WCHAR_T == 2
+
+        // Return the bytes read but not decoded by GetChar() to the stream
+        // as m_lastBytes must be empty while the buffer is used.
+        if ( m_validBegin < m_validEnd )
+            m_input.Ungetch(m_lastBytes + m_validBegin, m_validEnd - m_validBegin);
+
+        m_validBegin =
+        m_validEnd = 0;
+
+        m_decodedLen = len;
+
+        return m_decodedLen != 0;
+    }
+
+#if SIZEOF_WCHAR_T == 2
+    if ( m_lastWChar )
+    {
+        m_decoded[m_decodedLen++] = m_lastWChar;
+        m_lastWChar = 0;
+    }
+#endif // SIZEOF_WCHAR_T == 2
+
+    // Take over the bytes read, but not decoded yet, by GetChar(). Notice
+    // that m_raw is necessarily empty if there are any such bytes as GetChar()
+    // returns its contents to the stream before reading from it.
+    if ( m_validBegin < m_validEnd )
+    {
+        m_rawLen = m_validEnd - m_validBegin;
+        memcpy(m_raw, m_lastBytes + m_validBegin, m_rawLen);
+    }
+
+    m_validBegin =
+    m_validEnd = 0;
+
+    for ( ;; )
+    {
+        m_input.Read(m_raw + m_rawLen,
+                     TEXT_BLOCK_SIZE + sizeof(m_lastBytes) - m_rawLen);
+        const size_t lastRead = m_input.LastRead();
+        m_rawLen += lastRead;
+        if ( !m_rawLen )
+            return m_decodedLen != 0;
+
+        const bool eof = lastRead == 0;
+
+        size_t len = m_rawLen;
+        if ( !eof )
+        {
+            // Avoid passing an incomplete character at the end of the block
+            // to the conversion, as this would make it fail and, worse, could
+            // make wxConvAuto switch to its fallback encoding. If we don't
+            // know the code unit size yet, or it is 1, assume that the
+            // encoding is ASCII-compatible and stop after an ASCII character
+            // or before a byte which can start a UTF-8 sequence: this is
+            // always correct for UTF-8 and harmless for the other encodings.
+            if ( m_rawUnit > 1 )
+            {
+                len -= len % m_rawUnit;
+            }
+            else
+            {
+                for ( size_t n = 1; n <= sizeof(m_lastBytes) && n <= len; n++ )
+                {
+                    const unsigned char b = m_raw[len - n];
+                    if ( b < 0x80 )
+                    {
+                        len -= n - 1;
+                        break;
+                    }
+
+                    if ( b >= 0xc0 )
+                    {
+                        len -= n;
+                        break;
+                    }
+                }
+            }
+        }
+
+        size_t decoded = wxCONV_FAILED;
+        while ( len )
+        {
+            decoded = m_conv->ToWChar(m_decoded + m_decodedLen,
+                                      TEXT_BLOCK_SIZE + sizeof(m_lastBytes),
+                                      m_raw, len);
+            if ( decoded != wxCONV_FAILED )
+                break;
+
+            // The block may still end with an incomplete character if our
+            // guess above was wrong, so retry with fewer bytes, up to the
+            // maximal length of a character, before concluding that the input
+            // is invalid.
+            if ( eof || m_rawLen - len >= sizeof(m_lastBytes) )
+                break;
+
+            len--;
+        }
+
+        if ( decoded != wxCONV_FAILED )
+        {
+            m_decodedLen += decoded;
+
+            m_rawLen -= len;
+            memmove(m_raw, m_raw + len, m_rawLen);
+
+            if ( !m_rawUnit )
+            {
+                // We can only call this after the first successful conversion
+                // as wxConvAuto doesn't know the encoding before it.
+                m_rawUnit = m_conv->GetMBNulLen();
+                if ( m_rawUnit == wxCONV_FAILED )
+                    m_rawUnit = 1;
+            }
+
+            // Notice that we may not have decoded anything if the input
+            // consisted of the BOM only, continue reading in this case.
+            if ( m_decodedLen )
+                return true;
+        }
+        else if ( len || eof )
+        {
+            // Decoding failed: give the bytes back to the stream and decode
+            // them one by one to return all the valid characters before the
+            // error, as GetChar() does.
+            m_input.Ungetch(m_raw, m_rawLen);
+            m_rawLen = 0;
+
+            if ( m_input.Eof() )
+                m_input.Reset();
+
+            m_decodeInBlocks = false;
+
+            return m_decodedLen != 0 || FillBuffer();
+        }
+        //else: we didn't read enough bytes to decode anything yet
+    }
+#else // !wxUSE_UNICODE
+    m_validBegin =
+    m_validEnd = 0;
+
+    m_input.Read(m_decoded, TEXT_BLOCK_SIZE);
+    m_decodedLen = m_input.LastRead();
+
+    return m_decodedLen != 0;
+#endif // wxUSE_UNICODE/!wxUSE_UNICODE
+}
+
 wxUint64 wxTextInputStream::Read64(int base)
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
-    if(!m_input) return 0;
+    if(!IsInputOk()) return 0;
 
     wxString word = ReadWord();
     if(word.empty())
@@ -235,7 +471,7 @@ wxUint64 wxTextInputStream::Read64(int base)
 wxUint32 wxTextInputStream::Read32(int base)
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
-    if(!m_input) return 0;
+    if(!IsInputOk()) return 0;
 
     wxString word = ReadWord();
     if(word.empty())
@@ -256,7 +492,7 @@ wxUint8 wxTextInputStream::Read8(int base)
 wxInt64 wxTextInputStream::Read64S(int base)
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
-    if(!m_input) return 0;
+    if(!IsInputOk()) return 0;
 
     wxString word = ReadWord();
     if(word.empty())
@@ -271,7 +507,7 @@ wxInt64 wxTextInputStream::Read64S(int base)
 wxInt32 wxTextInputStream::Read32S(int base)
 {
     wxASSERT_MSG( !base || (base > 1 && base <= 36), wxT("invalid base") );
-    if(!m_input) return 0;
+    if(!IsInputOk()) return 0;
 
     wxString word = ReadWord();
     if(word.empty())
@@ -291,7 +527,7 @@ wxInt8 wxTextInputStream::Read8S(int base)
 
 double wxTextInputStream::ReadDouble()
 {
-    if(!m_input) return 0;
+    if(!IsInputOk()) return 0;
     wxString word = ReadWord();
     if(word.empty())
         return 0;
@@ -305,7 +541,7 @@ wxString wxTextInputStream::ReadLine()
     for ( ;; )
     {
         wxChar c = GetChar();
-        if ( m_input.Eof() )
+        if ( !c && m_input.Eof() )
             break;
 
         if (!c)
@@ -329,11 +565,59 @@ wxString wxTextInputStream::ReadLine()
     return line;
 }
 
+bool wxTextInputStream::ReadLine(wxString& line)
+{
+    line.clear();
+
+    bool readAny = false;
+    for ( ;; )
+    {
+        if ( !HasDecodedChars() && !FillBuffer() )
+        {
+            // As in ReadLine() above, we must signal the decoding errors at
+            // the stream level if we stopped before reaching its end.
+            if ( !m_input.Eof() )
+            {
+                m_input.Reset(wxSTREAM_READ_ERROR);
+                return false;
+            }
+
+            return readAny;
+        }
+
+        readAny = true;
+
+        const wxChar* const start = m_decoded + m_decodedPos;
+        const wxChar* const end = m_decoded + m_decodedLen;
+        const wxChar* p = start;
+        while ( p != end && *p != wxT('\n') && *p != wxT('\r') )
+            p++;
+
+        line.append(start, p - start);
+        m_decodedPos += p - start;
+
+        if ( p != end )
+        {
+            m_decodedPos++;
+
+            // Also eat the LF following CR, if any, for DOS line endings.
+            if ( *p == wxT('\r') &&
+                    (HasDecodedChars() || FillBuffer()) &&
+                        m_decoded[m_decodedPos] == wxT('\n') )
+            {
+                m_decodedPos++;
+            }
+
+            return true;
+        }
+    }
+}
+
 wxString wxTextInputStream::ReadWord()
 {
     wxString word;
 
-    if ( !m_input )
+    if ( !IsInputOk() )
         return word;
 
     wxChar c = NextNonSeparators();
@@ -342,7 +626,7 @@ wxString wxTextInputStream::ReadWord()
 
     word += c;
 
-    while ( !m_input.Eof() )
+    while ( HasDecodedChars() || !m_input.Eof() )
     {
         c = GetChar();
         if (!c)
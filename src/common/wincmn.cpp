@@ -657,6 +657,10 @@ void wxWindowBase::InvalidateBestSize()
 {
     m_bestSizeCache = wxDefaultSize;
 
+    // the min size of the sizer containing us depends on our best size
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateMinSize();
+
     // parent's best size calculation may depend on its children's
     // as long as child window we are in is not top level window itself
     // (because the TLW size is never resized automatically)
@@ -1150,6 +1154,10 @@ bool wxWindowBase::Show(bool show)
     {
         m_isShown = show;
 
+        // hidden windows don't take space in the containing sizer
+        if ( m_containingSizer )
+            m_containingSizer->InvalidateMinSize();
+
         return true;
     }
     else
@@ -2443,6 +2451,10 @@ void wxWindowBase::SetSizer(wxSizer *sizer, bool deleteOld)
         m_windowSizer->SetContainingWindow((wxWindow *)this);
     }
 
+    // our best size is determined by our sizer, if any
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateMinSize();
+
     SetAutoLayout(m_windowSizer != NULL);
 }
 
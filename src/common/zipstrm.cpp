@@ -28,6 +28,12 @@
 #include "wx/wfstream.h"
 #include "zlib.h"
 
+#if wxUSE_THREADS
+    #include "wx/sharedptr.h"
+    #include "wx/threadpool.h"
+    #include "wx/vector.h"
+#endif // wxUSE_THREADS
+
 // value for the 'version needed to extract' field (20 means 2.0)
 enum {
     VERSION_NEEDED_TO_EXTRACT = 20,
@@ -66,8 +72,12 @@ enum {
 // a zip entry is created. The purpose of this latency is so that
 // OpenCompressor() can see a little data before deciding which compressor
 // it should use.
+//
+// When compressing in parallel, the entries smaller than PARALLEL_LATENCY are
+// buffered entirely and compressed in memory by the pool threads.
 enum {
-    OUTPUT_LATENCY = 4096
+    OUTPUT_LATENCY = 4096,
+    PARALLEL_LATENCY = 1024 * 1024
 };
 
 // Some offsets into the local header
@@ -2165,6 +2175,115 @@ size_t wxZipInputStream::OnSysRead(void *buffer, size_t size)
     return count;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Entries compressed in parallel
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// The data of an entry and the result of compressing it in a pool thread.
+struct wxZipDeflateJob
+{
+    wxZipDeflateJob(const char *data, size_t size, int level)
+        : m_level(level),
+          m_crc(crc32(0, Z_NULL, 0)),
+          m_ok(false)
+    {
+        m_data.AppendData(data, size);
+    }
+
+    bool Compress()
+    {
+        const size_t len = m_data.GetDataLen();
+        m_crc = crc32(m_crc, static_cast<const Byte*>(m_data.GetData()), len);
+
+        wxMemoryOutputStream mem;
+        wxZlibOutputStream comp(mem, m_level, wxZLIB_NO_HEADER);
+        m_ok = comp.Write(m_data.GetData(), len).IsOk() && comp.Close();
+
+        if (m_ok) {
+            const size_t outLen = mem.GetSize();
+            mem.CopyTo(m_compressed.GetWriteBuf(outLen), outLen);
+            m_compressed.UngetWriteBuf(outLen);
+        }
+
+        return m_ok;
+    }
+
+    const int m_level;
+    wxMemoryBuffer m_data;
+    wxMemoryBuffer m_compressed;
+    wxUint32 m_crc;
+    bool m_ok;
+};
+
+typedef wxSharedPtr<wxZipDeflateJob> wxZipDeflateJobPtr;
+
+class wxZipDeflateFunctor
+{
+public:
+    explicit wxZipDeflateFunctor(const wxZipDeflateJobPtr& job) : m_job(job) { }
+
+    bool operator()() const { return m_job->Compress(); }
+
+private:
+    const wxZipDeflateJobPtr m_job;
+
+    wxDECLARE_NO_ASSIGN_CLASS(wxZipDeflateFunctor);
+};
+
+} // anonymous namespace
+
+// The entries created by wxZipOutputStream in parallel mode which haven't
+// been written yet, in order.
+class wxZipParallelQueue
+{
+public:
+    struct Item
+    {
+        wxZipEntry *m_entry;
+        bool m_magicWritten;
+        wxZipDeflateJobPtr m_job;
+
+        // Not valid for the stored entries which are not compressed at all.
+        wxFuture<bool> m_done;
+    };
+
+    wxZipParallelQueue(wxThreadPool& pool, wxThreadPool *ownedPool)
+        : m_pool(pool),
+          m_ownedPool(ownedPool),
+          m_magicPending(false)
+    {
+    }
+
+    ~wxZipParallelQueue()
+    {
+        for (size_t n = 0; n < m_items.size(); n++) {
+            if (m_items[n].m_done.IsOk())
+                m_items[n].m_done.Wait();
+            delete m_items[n].m_entry;
+        }
+        m_items.clear();
+
+        delete m_ownedPool;
+    }
+
+    wxThreadPool& m_pool;
+    wxThreadPool * const m_ownedPool;
+
+    wxVector<Item> m_items;
+
+    // True if the signature of the entry being currently created must be
+    // written after the queued entries.
+    bool m_magicPending;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipParallelQueue);
+};
+
+#endif // wxUSE_THREADS
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -2204,6 +2323,7 @@ void wxZipOutputStream::Init(int level)
     m_offsetAdjustment = wxInvalidOffset;
     m_endrecWritten = false;
     m_format = wxZIP_FORMAT_DEFAULT;
+    m_parallel = NULL;
 }
 
 wxZipOutputStream::~wxZipOutputStream()
@@ -2212,6 +2332,9 @@ wxZipOutputStream::~wxZipOutputStream()
     WX_CLEAR_LIST(wxZipEntryList_, m_entries);
     delete m_store;
     delete m_deflate;
+#if wxUSE_THREADS
+    delete m_parallel;
+#endif // wxUSE_THREADS
     delete m_pending;
     delete [] m_initialData;
     if (m_backlink)
@@ -2299,25 +2422,34 @@ bool wxZipOutputStream::DoCreate(wxZipEntry *entry, bool raw /*=false*/)
     if (!m_pending)
         return false;
 
-    // write the signature bytes right away
-    wxDataOutputStream ds(*m_parent_o_stream);
-    ds << LOCAL_MAGIC;
+#if wxUSE_THREADS
+    // if the previous entries are still being compressed, the signature can
+    // only be written after them
+    if (m_parallel && !m_parallel->m_items.empty()) {
+        m_parallel->m_magicPending = true;
+    } else
+#endif // wxUSE_THREADS
+    {
+        // write the signature bytes right away
+        wxDataOutputStream ds(*m_parent_o_stream);
+        ds << LOCAL_MAGIC;
 
-    // and if this is the first entry test for seekability
-    if (m_headerOffset == 0 && m_parent_o_stream->IsSeekable()) {
+        // and if this is the first entry test for seekability
+        if (m_headerOffset == 0 && m_parent_o_stream->IsSeekable()) {
 #if wxUSE_LOG
-        bool logging = wxLog::IsEnabled();
-        wxLogNull nolog;
+            bool logging = wxLog::IsEnabled();
+            wxLogNull nolog;
 #endif // wxUSE_LOG
-        wxFileOffset here = m_parent_o_stream->TellO();
+            wxFileOffset here = m_parent_o_stream->TellO();
 
-        if (here != wxInvalidOffset && here >= 4) {
-            if (m_parent_o_stream->SeekO(here - 4) == here - 4) {
-                m_offsetAdjustment = here - 4;
+            if (here != wxInvalidOffset && here >= 4) {
+                if (m_parent_o_stream->SeekO(here - 4) == here - 4) {
+                    m_offsetAdjustment = here - 4;
 #if wxUSE_LOG
-                wxLog::EnableLogging(logging);
+                    wxLog::EnableLogging(logging);
 #endif // wxUSE_LOG
-                m_parent_o_stream->SeekO(here);
+                    m_parent_o_stream->SeekO(here);
+                }
             }
         }
     }
@@ -2383,6 +2515,12 @@ wxOutputStream *wxZipOutputStream::OpenCompressor(
             else
                 m_deflate->Open(stream);
 
+#if wxUSE_THREADS
+            // the big entries are compressed in blocks in parallel
+            if (m_parallel && !m_deflate->IsParallelCompressionEnabled())
+                m_deflate->EnableParallelCompression(m_parallel->m_pool);
+#endif // wxUSE_THREADS
+
             return m_deflate;
         }
 
@@ -2408,8 +2546,11 @@ bool wxZipOutputStream::CloseCompressor(wxOutputStream *comp)
 void wxZipOutputStream::CreatePendingEntry(const void *buffer, size_t size)
 {
     wxASSERT(IsOk() && m_pending && !m_comp);
+    if (!FlushParallelEntries())
+        return;
     wxZipEntryPtr_ spPending(m_pending);
     m_pending = NULL;
+    spPending->SetOffset(m_headerOffset);
 
     Buffer bufs[] = {
         { m_initialData, m_initialSize },
@@ -2462,6 +2603,14 @@ void wxZipOutputStream::CreatePendingEntry()
 
         if (!comp)
             return;
+#if wxUSE_THREADS
+        if (m_parallel && (comp == m_deflate || comp == m_store)) {
+            if (comp == m_deflate)
+                CloseCompressor(comp);
+            QueueParallelEntry(spPending.release());
+            return;
+        }
+#endif // wxUSE_THREADS
         if (comp != m_store) {
             bool ok = comp->Write(m_initialData, m_initialSize).IsOk();
             CloseCompressor(comp);
@@ -2484,6 +2633,9 @@ void wxZipOutputStream::CreatePendingEntry()
         spPending->SetCompressedSize(m_initialSize);
     }
 
+    if (!FlushParallelEntries())
+        return;
+    spPending->SetOffset(m_headerOffset);
     spPending->m_Flags &= ~wxZIP_SUMS_FOLLOW;
     m_headerSize = spPending->WriteLocal(*m_parent_o_stream, GetConv(), m_format);
 
@@ -2502,6 +2654,8 @@ void wxZipOutputStream::CreatePendingEntry()
 bool wxZipOutputStream::Close()
 {
     CloseEntry();
+    if (!FlushParallelEntries())
+        m_lasterror = wxSTREAM_WRITE_ERROR;
 
     if (m_lasterror == wxSTREAM_WRITE_ERROR
         || (m_entries.size() == 0 && m_endrecWritten))
@@ -2632,7 +2786,8 @@ void wxZipOutputStream::Sync()
 size_t wxZipOutputStream::OnSysWrite(const void *buffer, size_t size)
 {
     if (IsOk() && m_pending) {
-        if (m_initialSize + size < OUTPUT_LATENCY) {
+        if (m_initialSize + size < (m_parallel ? PARALLEL_LATENCY
+                                               : OUTPUT_LATENCY)) {
             memcpy(m_initialData + m_initialSize, buffer, size);
             m_initialSize += size;
             return size;
@@ -2654,4 +2809,180 @@ size_t wxZipOutputStream::OnSysWrite(const void *buffer, size_t size)
     return m_comp->LastWrite();
 }
 
+bool wxZipOutputStream::EnableParallelCompression(int numThreads)
+{
+#if wxUSE_THREADS
+    wxCHECK_MSG( numThreads >= 0, false, "invalid number of threads" );
+
+    if (!numThreads)
+        return DoEnableParallelCompression(wxThreadPool::Get(), NULL);
+
+    wxThreadPool * const pool = new wxThreadPool(numThreads);
+    if (!DoEnableParallelCompression(*pool, pool)) {
+        delete pool;
+        return false;
+    }
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(numThreads);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+// Write the entries queued by QueueParallelEntry(), including the signature
+// of the entry being created if it couldn't be written yet, so that the next
+// entry can be written directly.
+//
+bool wxZipOutputStream::FlushParallelEntries()
+{
+#if wxUSE_THREADS
+    if (!m_parallel)
+        return true;
+
+    bool ok = WriteParallelEntries(0);
+
+    if (m_parallel->m_magicPending) {
+        m_parallel->m_magicPending = false;
+
+        wxDataOutputStream ds(*m_parent_o_stream);
+        ds << LOCAL_MAGIC;
+        if (!m_parent_o_stream->IsOk())
+            ok = false;
+    }
+
+    if (!ok)
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+
+    return ok;
+#else // !wxUSE_THREADS
+    return true;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+#if wxUSE_THREADS
+
+bool wxZipOutputStream::EnableParallelCompression(wxThreadPool& pool)
+{
+    return DoEnableParallelCompression(pool, NULL);
+}
+
+bool wxZipOutputStream::DoEnableParallelCompression(wxThreadPool& pool,
+                                                    wxThreadPool *ownedPool)
+{
+    wxCHECK_MSG( !m_parallel, false, "parallel compression already enabled" );
+    wxCHECK_MSG( m_headerOffset == 0 && !m_pending && !m_comp, false,
+                 "entries have already been written" );
+
+    // Waiting for the entries in a pool thread could deadlock, so just keep
+    // compressing sequentially there.
+    if (pool.GetThreadCount() == 0 || pool.IsPoolThread())
+        return false;
+
+    m_parallel = new wxZipParallelQueue(pool, ownedPool);
+
+    // buffer the bigger entries to be able to compress them in memory
+    delete [] m_initialData;
+    m_initialData = new char[PARALLEL_LATENCY];
+
+    return true;
+}
+
+// This is called instead of writing an entry created before PARALLEL_LATENCY
+// bytes have been written to it, to compress it in one of the pool threads.
+//
+void wxZipOutputStream::QueueParallelEntry(wxZipEntry *entry)
+{
+    wxZipParallelQueue::Item item;
+    item.m_entry = entry;
+    item.m_magicWritten = !m_parallel->m_magicPending;
+    item.m_job = wxZipDeflateJobPtr(new wxZipDeflateJob(m_initialData,
+                                                        m_initialSize,
+                                                        GetLevel()));
+
+    // the stored entries only need their crc and it's not worth using
+    // another thread for it
+    if (entry->GetMethod() == wxZIP_METHOD_STORE) {
+        item.m_job->m_crc = crc32(item.m_job->m_crc, (Byte*)m_initialData,
+                                  m_initialSize);
+        item.m_job->m_ok = true;
+    } else {
+        item.m_done = m_parallel->m_pool.Async<bool>(
+                            wxZipDeflateFunctor(item.m_job));
+    }
+
+    m_parallel->m_items.push_back(item);
+    m_parallel->m_magicPending = false;
+    m_initialSize = 0;
+    m_lasterror = wxSTREAM_NO_ERROR;
+
+    // don't let too many entries accumulate in memory
+    const size_t maxPending = 2 * m_parallel->m_pool.GetThreadCount();
+    if (!WriteParallelEntries(maxPending))
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+}
+
+// Write the queued entries until at most maxPending remain, waiting for them
+// to be compressed if necessary, and also the ones that are already done.
+//
+bool wxZipOutputStream::WriteParallelEntries(size_t maxPending)
+{
+    wxVector<wxZipParallelQueue::Item>& items = m_parallel->m_items;
+    bool ok = true;
+
+    while (!items.empty() &&
+            (items.size() > maxPending ||
+             !items[0].m_done.IsOk() || items[0].m_done.IsReady())) {
+        wxZipParallelQueue::Item item = items[0];
+        items.erase(items.begin());
+
+        wxZipEntryPtr_ entry(item.m_entry);
+        if (item.m_done.IsOk())
+            item.m_done.Wait();
+
+        // after an error just discard the remaining entries
+        const wxZipDeflateJob& job = *item.m_job;
+        if (!ok || !job.m_ok) {
+            ok = false;
+            continue;
+        }
+
+        wxDataOutputStream ds(*m_parent_o_stream);
+        if (!item.m_magicWritten)
+            ds << LOCAL_MAGIC;
+
+        // fall back to 'store' if the compressor makes the data larger
+        const size_t size = job.m_data.GetDataLen();
+        const size_t compressedSize = job.m_compressed.GetDataLen();
+        const wxMemoryBuffer& data =
+            compressedSize > 0 && compressedSize < size ? job.m_compressed
+                                                        : job.m_data;
+        if (&data == &job.m_data)
+            entry->SetMethod(wxZIP_METHOD_STORE);
+
+        entry->SetSize(size);
+        entry->SetCrc(job.m_crc);
+        entry->SetCompressedSize(data.GetDataLen());
+        entry->SetOffset(m_headerOffset);
+        entry->m_Flags &= ~wxZIP_SUMS_FOLLOW;
+
+        const size_t headerSize =
+            entry->WriteLocal(*m_parent_o_stream, GetConv(), m_format);
+        m_parent_o_stream->Write(data.GetData(), data.GetDataLen());
+
+        if (!m_parent_o_stream->IsOk()) {
+            ok = false;
+            continue;
+        }
+
+        m_headerOffset += headerSize + data.GetDataLen();
+        m_entries.push_back(entry.release());
+    }
+
+    return ok;
+}
+
+#endif // wxUSE_THREADS
+
 #endif // wxUSE_ZIPSTREAM
@@ -23,6 +23,12 @@
     #include "wx/utils.h"
 #endif
 
+#if wxUSE_THREADS
+    #include "wx/sharedptr.h"
+    #include "wx/threadpool.h"
+    #include "wx/vector.h"
+#endif // wxUSE_THREADS
+
 
 // normally, the compiler options should contain -I../zlib, but it is
 // apparently not the case for all MSW makefiles and so, unless we use
@@ -274,6 +280,462 @@ bool wxZlibInputStream::SetDictionary(const wxMemoryBuffer &buf)
 }
 
 
+#if wxUSE_THREADS
+
+//////////////////////
+// wxZlibParallelDeflater
+//////////////////////
+
+namespace
+{
+
+// A block of the data compressed by wxZlibParallelDeflater in one of the pool
+// threads. It is only accessed by the pool thread while it is being
+// compressed and only by the thread writing the stream after this.
+struct wxZlibBlock
+{
+    wxZlibBlock(size_t size, int level, int flags)
+        : m_input(size),
+          m_level(level),
+          m_flags(flags),
+          m_last(false),
+          m_check(0),
+          m_ok(false)
+    {
+    }
+
+    // Compress m_input into m_output, priming the compressor with m_dict,
+    // and compute the checksum of the input.
+    void Compress();
+
+    wxMemoryBuffer m_input;
+    wxMemoryBuffer m_dict;
+    const int m_level;
+    const int m_flags;
+    bool m_last;
+
+    wxMemoryBuffer m_output;
+    wxUint32 m_check;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxZlibBlock);
+};
+
+typedef wxSharedPtr<wxZlibBlock> wxZlibBlockPtr;
+
+void wxZlibBlock::Compress()
+{
+    const Bytef * const input = static_cast<const Bytef*>(m_input.GetData());
+    const size_t len = m_input.GetDataLen();
+
+    if (m_flags == wxZLIB_ZLIB)
+        m_check = adler32(adler32(0, Z_NULL, 0), input, len);
+    else if (m_flags == wxZLIB_GZIP)
+        m_check = crc32(crc32(0, Z_NULL, 0), input, len);
+
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (deflateInit2(&z, m_level, Z_DEFLATED, -MAX_WBITS,
+                     8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return;
+
+    if (m_dict.GetDataLen() &&
+            deflateSetDictionary(&z, static_cast<Bytef*>(m_dict.GetData()),
+                                 m_dict.GetDataLen()) != Z_OK) {
+        deflateEnd(&z);
+        return;
+    }
+
+    // All blocks but the last one end with an empty stored block, which
+    // aligns them on a byte boundary, so that they can be just concatenated.
+    const int flush = m_last ? Z_FINISH : Z_SYNC_FLUSH;
+
+    z.next_in = const_cast<Bytef*>(input);
+    z.avail_in = len;
+
+    // The bound doesn't account for the flush marker, so add some space for
+    // it, but still be prepared to extend the buffer if it's not enough.
+    size_t size = deflateBound(&z, len) + 16;
+    size_t done = 0;
+    int err;
+    for ( ;; ) {
+        Bytef * const out = static_cast<Bytef*>(m_output.GetWriteBuf(size));
+        z.next_out = out + done;
+        z.avail_out = size - done;
+
+        err = deflate(&z, flush);
+
+        done = size - z.avail_out;
+        m_output.UngetWriteBuf(done);
+
+        if (err != Z_OK || z.avail_out != 0)
+            break;
+
+        size *= 2;
+    }
+
+    deflateEnd(&z);
+
+    m_ok = err == (m_last ? Z_STREAM_END : Z_OK) ||
+           (!m_last && err == Z_BUF_ERROR);
+}
+
+// Functor compressing a block in one of the pool threads.
+class wxZlibBlockCompressor
+{
+public:
+    explicit wxZlibBlockCompressor(const wxZlibBlockPtr& block)
+        : m_block(block)
+    {
+    }
+
+    bool operator()() const
+    {
+        m_block->Compress();
+        return m_block->m_ok;
+    }
+
+private:
+    const wxZlibBlockPtr m_block;
+
+    wxDECLARE_NO_ASSIGN_CLASS(wxZlibBlockCompressor);
+};
+
+} // anonymous namespace
+
+// Compresses the data in blocks of fixed size in the threads of a pool in the
+// same way as pigz does: each block is compressed independently, but using
+// the end of the previous block as the dictionary, so that the compression
+// ratio is almost the same as when compressing the data sequentially, and
+// the resulting raw deflate streams are concatenated.
+class wxZlibParallelDeflater
+{
+public:
+    wxZlibParallelDeflater(wxThreadPool& pool, wxThreadPool *ownedPool,
+                           int level, int flags)
+        : m_pool(pool),
+          m_ownedPool(ownedPool),
+          m_level(level),
+          m_flags(flags)
+    {
+        Reset();
+    }
+
+    ~wxZlibParallelDeflater()
+    {
+        // Wait for the blocks still being compressed, as they may use the
+        // pool which we're going to delete.
+        Reset();
+
+        delete m_ownedPool;
+    }
+
+    bool SetDictionary(const char *data, size_t datalen);
+
+    // Add the data to the current block, starting to compress it if it is
+    // full, and write all the blocks already compressed to the stream.
+    bool Write(wxOutputStream& stream, const void *buffer, size_t size);
+
+    // Compress the current block and write all the blocks to the stream. If
+    // this is the final flush, also write the trailer and reset the state to
+    // allow compressing another stream.
+    bool Flush(wxOutputStream& stream, bool final);
+
+private:
+    enum {
+        BLOCK_SIZE = 128 * 1024,
+        DICT_SIZE  = 32 * 1024
+    };
+
+    // Discard all the blocks, waiting until they're not used by the pool
+    // threads any more, and prepare for compressing a new stream.
+    void Reset();
+
+    // Finish filling the current block and start a new one.
+    wxZlibBlockPtr EndBlock(bool last);
+
+    // Start compressing the current block in one of the pool threads.
+    void StartBlock(bool last);
+
+    // Write the compressed blocks until at most maxPending blocks remain,
+    // waiting for them if necessary, and also write all the blocks which are
+    // already compressed.
+    bool WriteBlocks(wxOutputStream& stream, size_t maxPending);
+    bool WriteBlock(wxOutputStream& stream, const wxZlibBlock& block);
+
+    bool WriteHeader(wxOutputStream& stream);
+    bool WriteTrailer(wxOutputStream& stream);
+
+    wxThreadPool& m_pool;
+    wxThreadPool * const m_ownedPool;
+    const int m_level;
+    const int m_flags;
+
+    // The block being filled with the data and the blocks being compressed,
+    // in order, and the futures becoming ready when they are.
+    wxZlibBlockPtr m_block;
+    wxVector<wxZlibBlockPtr> m_pending;
+    wxVector< wxFuture<bool> > m_done;
+
+    // The last bytes of the data preceding the current block.
+    wxMemoryBuffer m_dict;
+
+    bool m_headerWritten;
+    bool m_hasDictionary;
+    wxUint32 m_dictId;
+    wxUint32 m_check;
+    wxUint32 m_totalIn;
+
+    wxDECLARE_NO_COPY_CLASS(wxZlibParallelDeflater);
+};
+
+void wxZlibParallelDeflater::Reset()
+{
+    for (size_t n = 0; n < m_done.size(); n++)
+        m_done[n].Wait();
+    m_done.clear();
+    m_pending.clear();
+
+    m_dict.SetDataLen(0);
+    m_headerWritten = false;
+    m_hasDictionary = false;
+    m_dictId = 0;
+    m_check = m_flags == wxZLIB_ZLIB ? adler32(0, Z_NULL, 0)
+                                     : crc32(0, Z_NULL, 0);
+    m_totalIn = 0;
+
+    m_block = wxZlibBlockPtr(new wxZlibBlock(BLOCK_SIZE, m_level, m_flags));
+}
+
+bool wxZlibParallelDeflater::SetDictionary(const char *data, size_t datalen)
+{
+    // Just as deflateSetDictionary(), don't allow setting the dictionary for
+    // gzip streams or after starting compressing.
+    if (m_flags == wxZLIB_GZIP || m_headerWritten ||
+            !m_pending.empty() || m_block->m_input.GetDataLen())
+        return false;
+
+    m_hasDictionary = true;
+    m_dictId = adler32(adler32(0, Z_NULL, 0),
+                       reinterpret_cast<const Bytef*>(data), datalen);
+
+    if (datalen > DICT_SIZE) {
+        data += datalen - DICT_SIZE;
+        datalen = DICT_SIZE;
+    }
+    m_dict.SetDataLen(0);
+    m_dict.AppendData(data, datalen);
+
+    return true;
+}
+
+wxZlibBlockPtr wxZlibParallelDeflater::EndBlock(bool last)
+{
+    const wxMemoryBuffer& input = m_block->m_input;
+    const size_t len = input.GetDataLen();
+
+    m_block->m_last = last;
+    m_block->m_dict.AppendData(m_dict.GetData(), m_dict.GetDataLen());
+
+    // The dictionary of the next block consists of the last bytes of this
+    // one, possibly preceded by the end of the current dictionary if this
+    // block is too small.
+    if (len >= DICT_SIZE) {
+        m_dict.SetDataLen(0);
+        m_dict.AppendData(static_cast<const char*>(input.GetData())
+                            + len - DICT_SIZE, DICT_SIZE);
+    } else if (len) {
+        wxMemoryBuffer dict(DICT_SIZE);
+        const size_t keep = wxMin(m_dict.GetDataLen(), DICT_SIZE - len);
+        dict.AppendData(static_cast<const char*>(m_dict.GetData())
+                            + m_dict.GetDataLen() - keep, keep);
+        dict.AppendData(input.GetData(), len);
+        m_dict = dict;
+    }
+
+    const wxZlibBlockPtr block = m_block;
+    m_block = wxZlibBlockPtr(new wxZlibBlock(BLOCK_SIZE, m_level, m_flags));
+
+    return block;
+}
+
+void wxZlibParallelDeflater::StartBlock(bool last)
+{
+    const wxZlibBlockPtr block = EndBlock(last);
+
+    m_pending.push_back(block);
+    m_done.push_back(m_pool.Async<bool>(wxZlibBlockCompressor(block)));
+}
+
+bool wxZlibParallelDeflater::Write(wxOutputStream& stream,
+                                   const void *buffer,
+                                   size_t size)
+{
+    const char *data = static_cast<const char*>(buffer);
+
+    while (size) {
+        wxMemoryBuffer& input = m_block->m_input;
+        const size_t len = wxMin(size, BLOCK_SIZE - input.GetDataLen());
+        input.AppendData(data, len);
+        data += len;
+        size -= len;
+
+        if (input.GetDataLen() == BLOCK_SIZE) {
+            StartBlock(false);
+
+            // Keep all the threads busy, but limit the amount of memory used
+            // if the underlying stream can't keep up.
+            if (!WriteBlocks(stream, 2 * m_pool.GetThreadCount()))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflater::Flush(wxOutputStream& stream, bool final)
+{
+    bool ok;
+
+    if (final && m_pending.empty()) {
+        // There is nothing to wait for, so it's faster to compress the last
+        // block directly, which is notably the case for the small streams.
+        const wxZlibBlockPtr block = EndBlock(true);
+        block->Compress();
+        ok = WriteBlock(stream, *block);
+    } else {
+        if (final || m_block->m_input.GetDataLen())
+            StartBlock(final);
+
+        ok = WriteBlocks(stream, 0);
+    }
+
+    if (final) {
+        // The header still needs to be written for an empty stream.
+        ok = ok && WriteHeader(stream) && WriteTrailer(stream);
+
+        // Be ready for the next stream even after an error, as the object is
+        // reused by wxZipOutputStream for all the entries.
+        Reset();
+    }
+
+    return ok;
+}
+
+bool wxZlibParallelDeflater::WriteBlocks(wxOutputStream& stream,
+                                         size_t maxPending)
+{
+    while (!m_pending.empty() &&
+            (m_pending.size() > maxPending || m_done[0].IsReady())) {
+        const wxZlibBlockPtr block = m_pending[0];
+        const bool ok = m_done[0].Get();
+
+        m_pending.erase(m_pending.begin());
+        m_done.erase(m_done.begin());
+
+        if (!ok || !WriteBlock(stream, *block))
+            return false;
+    }
+
+    return true;
+}
+
+bool wxZlibParallelDeflater::WriteBlock(wxOutputStream& stream,
+                                        const wxZlibBlock& block)
+{
+    if (!block.m_ok) {
+        wxLogError(_("Can't write to deflate stream: %s"),
+                   _("compression failed"));
+        return false;
+    }
+
+    if (!WriteHeader(stream))
+        return false;
+
+    const size_t len = block.m_input.GetDataLen();
+    if (m_flags == wxZLIB_ZLIB)
+        m_check = adler32_combine(m_check, block.m_check, len);
+    else if (m_flags == wxZLIB_GZIP)
+        m_check = crc32_combine(m_check, block.m_check, len);
+    m_totalIn += static_cast<wxUint32>(len);
+
+    const size_t outLen = block.m_output.GetDataLen();
+    return stream.Write(block.m_output.GetData(), outLen).LastWrite() == outLen;
+}
+
+bool wxZlibParallelDeflater::WriteHeader(wxOutputStream& stream)
+{
+    if (m_headerWritten)
+        return true;
+
+    m_headerWritten = true;
+
+    unsigned char header[10];
+    size_t len = 0;
+
+    if (m_flags == wxZLIB_ZLIB) {
+        // Compression method and window size followed by the flags, using
+        // the same compression level flags as deflate() itself.
+        int levelFlags;
+        if (m_level == Z_DEFAULT_COMPRESSION || m_level == 6)
+            levelFlags = 2;
+        else if (m_level < 2)
+            levelFlags = 0;
+        else if (m_level < 6)
+            levelFlags = 1;
+        else
+            levelFlags = 3;
+
+        unsigned value = (0x78 << 8) | (levelFlags << 6);
+        if (m_hasDictionary)
+            value |= 0x20;
+        value += 31 - value % 31;
+
+        header[len++] = static_cast<unsigned char>(value >> 8);
+        header[len++] = static_cast<unsigned char>(value);
+
+        if (m_hasDictionary) {
+            for (int shift = 24; shift >= 0; shift -= 8)
+                header[len++] = static_cast<unsigned char>(m_dictId >> shift);
+        }
+    } else if (m_flags == wxZLIB_GZIP) {
+        // Magic, deflate method, no flags, no modification time, the extra
+        // flags indicating the compression level and unknown OS.
+        header[len++] = 0x1f;
+        header[len++] = 0x8b;
+        header[len++] = 8;
+        for (int n = 0; n < 5; n++)
+            header[len++] = 0;
+        header[len++] = m_level == 9 ? 2 : m_level == 1 ? 4 : 0;
+        header[len++] = 0xff;
+    }
+
+    return !len || stream.Write(header, len).LastWrite() == len;
+}
+
+bool wxZlibParallelDeflater::WriteTrailer(wxOutputStream& stream)
+{
+    unsigned char trailer[8];
+    size_t len = 0;
+
+    if (m_flags == wxZLIB_ZLIB) {
+        // Adler-32 checksum in big endian order.
+        for (int shift = 24; shift >= 0; shift -= 8)
+            trailer[len++] = static_cast<unsigned char>(m_check >> shift);
+    } else if (m_flags == wxZLIB_GZIP) {
+        // CRC-32 and the size modulo 2^32 in little endian order.
+        for (int shift = 0; shift < 32; shift += 8)
+            trailer[len++] = static_cast<unsigned char>(m_check >> shift);
+        for (int shift = 0; shift < 32; shift += 8)
+            trailer[len++] = static_cast<unsigned char>(m_totalIn >> shift);
+    }
+
+    return !len || stream.Write(trailer, len).LastWrite() == len;
+}
+
+#endif // wxUSE_THREADS
+
+
 //////////////////////
 // wxZlibOutputStream
 //////////////////////
@@ -300,6 +762,9 @@ void wxZlibOutputStream::Init(int level, int flags)
   m_z_buffer = new unsigned char[ZSTREAM_BUFFER_SIZE];
   m_z_size = ZSTREAM_BUFFER_SIZE;
   m_pos = 0;
+  m_level = level;
+  m_flags = flags;
+  m_parallel = NULL;
 
   if ( level == -1 )
   {
@@ -350,6 +815,9 @@ bool wxZlibOutputStream::Close()
    deflateEnd(m_deflate);
    wxDELETE(m_deflate);
    wxDELETEA(m_z_buffer);
+#if wxUSE_THREADS
+   wxDELETE(m_parallel);
+#endif // wxUSE_THREADS
 
   return wxFilterOutputStream::Close() && IsOk();
  }
@@ -361,6 +829,21 @@ void wxZlibOutputStream::DoFlush(bool final)
   if (!IsOk())
     return;
 
+#if wxUSE_THREADS
+  if (m_parallel) {
+    // A stream closed by a derived class in order to reuse it later, as
+    // wxZipOutputStream does, has been finished already.
+    if (m_pos == wxInvalidOffset)
+      return;
+
+    if (!m_parallel->Flush(*m_parent_o_stream, final)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+    }
+    return;
+  }
+#endif // wxUSE_THREADS
+
   int err = Z_OK;
   bool done = false;
 
@@ -396,6 +879,19 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
   if (!IsOk() || !size)
     return 0;
 
+#if wxUSE_THREADS
+  if (m_parallel) {
+    if (!m_parallel->Write(*m_parent_o_stream, buffer, size)) {
+      m_lasterror = wxSTREAM_WRITE_ERROR;
+      wxLogDebug(wxT("wxZlibOutputStream: Error writing to underlying stream"));
+      return 0;
+    }
+
+    m_pos += size;
+    return size;
+  }
+#endif // wxUSE_THREADS
+
   int err = Z_OK;
   m_deflate->next_in = const_cast<unsigned char*>(static_cast<const unsigned char*>(buffer));
   m_deflate->avail_in = size;
@@ -436,6 +932,11 @@ size_t wxZlibOutputStream::OnSysWrite(const void *buffer, size_t size)
 
 bool wxZlibOutputStream::SetDictionary(const char *data, size_t datalen)
 {
+#if wxUSE_THREADS
+    if (m_parallel)
+        return m_parallel->SetDictionary(data, datalen);
+#endif // wxUSE_THREADS
+
     return deflateSetDictionary(m_deflate, reinterpret_cast<const Bytef*>(data), datalen) == Z_OK;
 }
 
@@ -444,5 +945,55 @@ bool wxZlibOutputStream::SetDictionary(const wxMemoryBuffer &buf)
     return SetDictionary((char*)buf.GetData(), buf.GetDataLen());
 }
 
+bool wxZlibOutputStream::EnableParallelCompression(int numThreads)
+{
+#if wxUSE_THREADS
+    wxCHECK_MSG( numThreads >= 0, false, "invalid number of threads" );
+
+    if (!numThreads)
+        return DoEnableParallelCompression(wxThreadPool::Get(), NULL);
+
+    wxThreadPool * const pool = new wxThreadPool(numThreads);
+    if (!DoEnableParallelCompression(*pool, pool)) {
+        delete pool;
+        return false;
+    }
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(numThreads);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+#if wxUSE_THREADS
+
+bool wxZlibOutputStream::EnableParallelCompression(wxThreadPool& pool)
+{
+    return DoEnableParallelCompression(pool, NULL);
+}
+
+bool wxZlibOutputStream::DoEnableParallelCompression(wxThreadPool& pool,
+                                                     wxThreadPool *ownedPool)
+{
+    wxCHECK_MSG( !m_parallel, false, "parallel compression already enabled" );
+    wxCHECK_MSG( m_pos == 0, false, "data has already been written" );
+
+    if (!m_deflate || !IsOk())
+        return false;
+
+    // Waiting for the blocks in a pool thread could deadlock, so just keep
+    // compressing sequentially there.
+    if (pool.GetThreadCount() == 0 || pool.IsPoolThread())
+        return false;
+
+    m_parallel = new wxZlibParallelDeflater(pool, ownedPool, m_level, m_flags);
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
 #endif
   // wxUSE_ZLIB && wxUSE_STREAMS
@@ -1801,6 +1801,198 @@ private:
     const SortOrder m_sortOrder;
 };
 
+// Functions used for sorting the nodes by their values, see SortNodesByValue()
+// below.
+
+void GetStringSortKey(const wxVariant& value, wxString& key)
+{
+    key = value.GetString();
+}
+
+void GetLongSortKey(const wxVariant& value, long& key)
+{
+    key = value.GetLong();
+}
+
+void GetDoubleSortKey(const wxVariant& value, double& key)
+{
+    key = value.GetDouble();
+}
+
+// Note that long and not bool is used here because std::vector<bool>, which
+// may be used as wxVector<bool>, doesn't allow taking references to elements.
+void GetBoolSortKey(const wxVariant& value, long& key)
+{
+    key = value.GetBool();
+}
+
+void GetIconTextSortKey(const wxVariant& value, wxString& key)
+{
+    wxDataViewIconText iconText;
+    iconText << value;
+    key = iconText.GetText();
+}
+
+#if wxUSE_DATETIME
+void GetDateTimeSortKey(const wxVariant& value, wxDateTime& key)
+{
+    key = value.GetDateTime();
+}
+#endif // wxUSE_DATETIME
+
+// Compare the keys in the same way as wxDataViewModel::Compare() does.
+template <typename T>
+inline int CompareSortKeys(const T& key1, const T& key2)
+{
+    if ( key1 < key2 )
+        return -1;
+    if ( key2 < key1 )
+        return 1;
+    return 0;
+}
+
+inline int CompareSortKeys(const wxString& key1, const wxString& key2)
+{
+    return key1.Cmp(key2);
+}
+
+#if wxUSE_DATETIME
+inline int CompareSortKeys(const wxDateTime& key1, const wxDateTime& key2)
+{
+    if ( key1.IsEarlierThan(key2) )
+        return -1;
+    if ( key2.IsEarlierThan(key1) )
+        return 1;
+    return 0;
+}
+#endif // wxUSE_DATETIME
+
+// Comparator for the indices of the nodes in the given array using the keys
+// in the parallel array.
+template <typename T>
+class wxGenericTreeModelKeyCmp
+{
+public:
+    wxGenericTreeModelKeyCmp(const wxVector<T>& keys,
+                             const wxDataViewTreeNodes& nodes)
+        : m_keys(keys),
+          m_nodes(nodes)
+    {
+    }
+
+    bool operator()(unsigned n1, unsigned n2) const
+    {
+        const int rc = CompareSortKeys(m_keys[n1], m_keys[n2]);
+        if ( rc )
+            return rc < 0;
+
+        // As in wxDataViewModel::Compare(), order the items with the same
+        // value by their IDs.
+        return wxPtrToUInt(m_nodes[n1]->GetItem().GetID()) <
+                wxPtrToUInt(m_nodes[n2]->GetItem().GetID());
+    }
+
+private:
+    const wxVector<T>& m_keys;
+    const wxDataViewTreeNodes& m_nodes;
+};
+
+// Sort the nodes using the keys of the given type retrieved from the model
+// values using the provided function. Returns false, without changing the
+// nodes order, if the value of some node doesn't have the expected type.
+template <typename T>
+bool SortNodesByKeys(const wxDataViewModel* model,
+                     wxDataViewTreeNodes& nodes,
+                     unsigned column,
+                     bool ascending,
+                     const wxString& type,
+                     void (*getKey)(const wxVariant&, T&))
+{
+    const unsigned count = nodes.size();
+
+    // Retrieve all values only once and store them in a contiguous array.
+    wxVector<T> keys(count);
+    wxVariant value;
+    for ( unsigned n = 0; n < count; n++ )
+    {
+        const wxDataViewItem& item = nodes[n]->GetItem();
+        if ( !model->HasValue(item, column) )
+            return false;
+
+        model->GetValue(value, item, column);
+        if ( value.GetType() != type )
+            return false;
+
+        getKey(value, keys[n]);
+    }
+
+    // Sort the indices of the nodes instead of the keys themselves to avoid
+    // copying them around.
+    wxVector<unsigned> order(count);
+    for ( unsigned n = 0; n < count; n++ )
+        order[n] = n;
+
+    std::sort(order.begin(), order.end(),
+              wxGenericTreeModelKeyCmp<T>(keys, nodes));
+
+    // Descending order is exactly the reverse of the ascending one, including
+    // for the items with the same values.
+    wxDataViewTreeNodes sorted(count);
+    for ( unsigned n = 0; n < count; n++ )
+        sorted[n] = nodes[order[ascending ? n : count - n - 1]];
+
+    nodes.swap(sorted);
+
+    return true;
+}
+
+// Try to sort the nodes by the values in the given column without using
+// wxDataViewModel::Compare(), which retrieves the values of both items for
+// every comparison. Returns false if this couldn't be done, e.g. because the
+// column contains values of a custom type.
+bool SortNodesByValue(const wxDataViewModel* model,
+                      wxDataViewTreeNodes& nodes,
+                      const SortOrder& sortOrder)
+{
+    if ( nodes.size() < 2 )
+        return true;
+
+    const unsigned column = sortOrder.GetColumn();
+    const bool ascending = sortOrder.IsAscending();
+
+    // Use the type of the first value for all of them.
+    const wxDataViewItem& item = nodes[0]->GetItem();
+    if ( !model->HasValue(item, column) )
+        return false;
+
+    wxVariant value;
+    model->GetValue(value, item, column);
+
+    const wxString type = value.GetType();
+    if ( type == wxS("string") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetStringSortKey);
+    if ( type == wxS("long") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetLongSortKey);
+    if ( type == wxS("double") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetDoubleSortKey);
+#if wxUSE_DATETIME
+    if ( type == wxS("datetime") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetDateTimeSortKey);
+#endif // wxUSE_DATETIME
+    if ( type == wxS("bool") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetBoolSortKey);
+    if ( type == wxS("wxDataViewIconText") )
+        return SortNodesByKeys(model, nodes, column, ascending, type,
+                               GetIconTextSortKey);
+
+    return false;
+}
+
 } // anonymous namespace
 
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
@@ -1908,9 +2100,15 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            const wxDataViewModel* const model = window->GetModel();
+            if ( !sortOrder.UsesColumn() ||
+                 !model->CanSortByValue() ||
+                 !SortNodesByValue(model, nodes, sortOrder) )
+            {
+                std::sort(m_branchData->children.begin(),
+                          m_branchData->children.end(),
+                          wxGenericTreeModelNodeCmp(window, sortOrder));
+            }
 
             m_branchData->sortOrder = sortOrder;
         }
@@ -393,6 +393,10 @@ public:
 
 #if wxUSE_IMAGE
     wxImage ConvertToImage() const;
+
+    // Copy the pixels in the given rectangle to the existing image of the
+    // same size, which must have alpha if and only if our surface does.
+    bool CopyToImage(wxImage& image, const wxRect& rect) const;
 #endif // wxUSE_IMAGE
 
 private :
@@ -467,6 +471,10 @@ public:
 
     virtual void * GetNativeContext() wxOVERRIDE;
 
+    // Same as GetNativeContext() but for internal use only: unlike it, this
+    // doesn't assume that anything is drawn directly on the returned context.
+    cairo_t* GetCairoContext() const { return m_context; }
+
     virtual bool SetAntialiasMode(wxAntialiasMode antialias) wxOVERRIDE;
 
     virtual bool SetInterpolationQuality(wxInterpolationQuality interpolation) wxOVERRIDE;
@@ -514,6 +522,24 @@ protected:
     enum ApplyTransformMode { Apply_directly, Apply_scaled_dev_origin };
     void ApplyTransformFromDC(const wxDC& dc, ApplyTransformMode mode = Apply_directly);
 
+    // Start tracking the area affected by the drawing operations: this is
+    // only useful for the contexts which need to do something with the pixels
+    // drawn on them, such as wxCairoImageContext.
+    void EnableDirtyTracking() { m_trackDirty = true; }
+
+    // Return true if the dirty area is being tracked. This stops being the
+    // case after GetNativeContext() is called, as the drawing done directly
+    // on the native context can't be tracked, and all the pixels must be
+    // considered to be dirty then.
+    bool IsTrackingDirty() const { return m_trackDirty; }
+
+    // Return the rectangle, in device pixels, containing all the pixels
+    // changed since the tracking was enabled or the last ResetDirtyRect()
+    // call. It may extend beyond the surface boundaries and is meaningless if
+    // IsTrackingDirty() returns false.
+    const wxRect& GetDirtyRect() const { return m_dirtyRect; }
+    void ResetDirtyRect() { m_dirtyRect = wxRect(); }
+
 #ifdef __WXQT__
     QPainter* m_qtPainter;
     QImage* m_qtImage;
@@ -565,9 +591,19 @@ protected:
 #endif // __WXGTK__
 
 private:
+    // Update the dirty rectangle, if it is being tracked, before filling or
+    // stroking the current path or drawing inside the given rectangle (in user
+    // coordinates).
+    void MarkPathDirty(bool stroke);
+    void MarkRectDirty(double x1, double y1, double x2, double y2);
+
     cairo_t* m_context;
     cairo_matrix_t m_internalTransform;
 
+    // Dirty area tracking state, see EnableDirtyTracking().
+    bool m_trackDirty;
+    wxRect m_dirtyRect;
+
     wxVector<float> m_layerOpacities;
 
     wxDECLARE_NO_COPY_CLASS(wxCairoContext);
@@ -589,6 +625,8 @@ public:
         Init(cairo_create(m_data.GetCairoSurface()));
         m_width = image.GetWidth();
         m_height = image.GetHeight();
+
+        EnableDirtyTracking();
     }
 
     virtual ~wxCairoImageContext()
@@ -598,7 +636,44 @@ public:
 
     virtual void Flush() wxOVERRIDE
     {
-        m_image = m_data.ConvertToImage();
+        // Converting the entire surface back to the image is expensive for
+        // big images, so just update the pixels which were drawn on since the
+        // last flush if possible. This requires the image to be in the same
+        // format as the surface, i.e. to have alpha if and only if the surface
+        // does and to not have any mask, which is typically the case for all
+        // flushes but the very first one. And it's also impossible if the
+        // native context was used for drawing, as we don't know which pixels
+        // were changed then.
+        //
+        // Notice that this means that the changes done to the image directly
+        // outside of the dirty rectangle are preserved, unlike when the entire
+        // image is overwritten, as was always done before.
+        const bool surfaceHasAlpha =
+            cairo_image_surface_get_format(m_data.GetCairoSurface())
+                == CAIRO_FORMAT_ARGB32;
+
+        if ( m_image.IsOk() &&
+                m_image.GetSize() == m_data.GetSize() &&
+                    m_image.HasAlpha() == surfaceHasAlpha &&
+                        !m_image.HasMask() )
+        {
+            const wxRect all(m_data.GetSize());
+            const wxRect
+                rect = IsTrackingDirty() ? GetDirtyRect().Intersect(all) : all;
+            if ( !rect.IsEmpty() )
+            {
+                // Don't modify the data shared with the other images.
+                m_image.UnShare();
+
+                m_data.CopyToImage(m_image, rect);
+            }
+        }
+        else
+        {
+            m_image = m_data.ConvertToImage();
+        }
+
+        ResetDirtyRect();
     }
 
 private:
@@ -750,7 +825,8 @@ void wxCairoPenBrushBaseData::InitHatch(wxHatchStyle hatchStyle)
 
 void wxCairoPenBrushBaseData::Apply( wxGraphicsContext* context )
 {
-    cairo_t* const ctext = (cairo_t*) context->GetNativeContext();
+    cairo_t* const ctext =
+        static_cast<wxCairoContext*>(context)->GetCairoContext();
 
     if ( m_hatchStyle != wxHATCHSTYLE_INVALID && !m_pattern )
         InitHatchPattern(ctext);
@@ -1016,7 +1092,7 @@ void wxCairoPenData::Apply( wxGraphicsContext* context )
 {
     wxCairoPenBrushBaseData::Apply(context);
 
-    cairo_t * ctext = (cairo_t*) context->GetNativeContext();
+    cairo_t * ctext = static_cast<wxCairoContext*>(context)->GetCairoContext();
     cairo_set_line_width(ctext,m_width);
     cairo_set_line_cap(ctext,m_cap);
     cairo_set_line_join(ctext,m_join);
@@ -1178,7 +1254,7 @@ wxCairoFontData::~wxCairoFontData()
 
 void wxCairoFontData::Apply( wxGraphicsContext* context )
 {
-    cairo_t * ctext = (cairo_t*) context->GetNativeContext();
+    cairo_t * ctext = static_cast<wxCairoContext*>(context)->GetCairoContext();
     cairo_set_source_rgba(ctext,m_red,m_green, m_blue,m_alpha);
 #ifdef __WXGTK__
     if (m_wxfont.IsOk())
@@ -1830,13 +1906,26 @@ wxImage wxCairoBitmapData::ConvertToImage() const
             return wxNullImage;
     }
 
+    if ( !CopyToImage(image, wxRect(0, 0, m_width, m_height)) )
+        return wxNullImage;
+
+    return image;
+}
+
+bool wxCairoBitmapData::CopyToImage(wxImage& image, const wxRect& rect) const
+{
+    wxASSERT_MSG( wxRect(0, 0, m_width, m_height).Contains(rect),
+                  wxS("Rectangle outside of the surface.") );
+    wxASSERT_MSG( image.GetWidth() == m_width && image.GetHeight() == m_height,
+                  wxS("Image size must be the same as the surface size.") );
+
     // Prepare for copying data.
     cairo_surface_flush(m_surface);
     const wxUint32* src = (wxUint32*)cairo_image_surface_get_data(m_surface);
-    wxCHECK_MSG( src, wxNullImage, wxS("Failed to get Cairo surface data.") );
+    wxCHECK_MSG( src, false, wxS("Failed to get Cairo surface data.") );
 
     int stride = cairo_image_surface_get_stride(m_surface);
-    wxCHECK_MSG( stride > 0, wxNullImage,
+    wxCHECK_MSG( stride > 0, false,
                  wxS("Failed to get Cairo surface stride.") );
 
     // As we work with wxUint32 pointers and not char ones, we need to adjust
@@ -1845,16 +1934,29 @@ wxImage wxCairoBitmapData::ConvertToImage() const
     wxASSERT_MSG( !(stride % sizeof(wxUint32)), wxS("Unexpected stride.") );
     stride /= sizeof(wxUint32);
 
-    unsigned char* dst = image.GetData();
+    // Offsets of the first pixel to copy.
+    src += rect.y*stride + rect.x;
+    const size_t offset = (size_t)rect.y*m_width + rect.x;
+
+    unsigned char* dst = image.GetData() + offset*3;
     unsigned char *alpha = image.GetAlpha();
     if ( alpha )
     {
+        wxCHECK_MSG( cairo_image_surface_get_format(m_surface)
+                        == CAIRO_FORMAT_ARGB32,
+                     false,
+                     wxS("Image must not have alpha.") );
+
+        alpha += offset;
+
         // We need to also copy alpha and undo the pre-multiplication as Cairo
         // stores pre-multiplied values in this format while wxImage does not.
-        for ( int y = 0; y < m_height; y++ )
+        for ( int y = 0; y < rect.height; y++ )
         {
             const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
+            unsigned char* const rowStartDst = dst;
+            unsigned char* const rowStartAlpha = alpha;
+            for ( int x = 0; x < rect.width; x++ )
             {
                 const wxUint32 argb = *src++;
 
@@ -1868,15 +1970,18 @@ wxImage wxCairoBitmapData::ConvertToImage() const
             }
 
             src = rowStart + stride;
+            dst = rowStartDst + m_width*3;
+            alpha = rowStartAlpha + m_width;
         }
     }
     else // RGB
     {
         // Things are pretty simple in this case, just copy RGB bytes.
-        for ( int y = 0; y < m_height; y++ )
+        for ( int y = 0; y < rect.height; y++ )
         {
             const wxUint32* const rowStart = src;
-            for ( int x = 0; x < m_width; x++ )
+            unsigned char* const rowStartDst = dst;
+            for ( int x = 0; x < rect.width; x++ )
             {
                 const wxUint32 argb = *src++;
 
@@ -1886,10 +1991,11 @@ wxImage wxCairoBitmapData::ConvertToImage() const
             }
 
             src = rowStart + stride;
+            dst = rowStartDst + m_width*3;
         }
     }
 
-    return image;
+    return true;
 }
 
 #endif // wxUSE_IMAGE
@@ -2489,6 +2595,7 @@ void wxCairoContext::Init(cairo_t *context)
 #endif
 
     m_context = context;
+    m_trackDirty = false;
     if ( m_context )
     {
         // Store initial transformation settings
@@ -2609,6 +2716,7 @@ void wxCairoContext::StrokePath( const wxGraphicsPath& path )
         cairo_path_t* cp = (cairo_path_t*) path.GetNativePath() ;
         cairo_append_path(m_context,cp);
         ((wxCairoPenData*)m_pen.GetRefData())->Apply(this);
+        MarkPathDirty(true);
         cairo_stroke(m_context);
         path.UnGetNativePath(cp);
     }
@@ -2623,6 +2731,7 @@ void wxCairoContext::FillPath( const wxGraphicsPath& path , wxPolygonFillMode fi
         cairo_append_path(m_context,cp);
         ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
         cairo_set_fill_rule(m_context,fillStyle==wxODDEVEN_RULE ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
+        MarkPathDirty(false);
         cairo_fill(m_context);
         path.UnGetNativePath(cp);
     }
@@ -2633,6 +2742,7 @@ void wxCairoContext::ClearRectangle( wxDouble x, wxDouble y, wxDouble w, wxDoubl
     cairo_save(m_context);
     cairo_set_operator(m_context, CAIRO_OPERATOR_CLEAR);
     cairo_rectangle (m_context, x, y, w, h);
+    MarkPathDirty(false);
     cairo_fill (m_context);
     cairo_restore(m_context);
 }
@@ -2643,6 +2753,7 @@ void wxCairoContext::DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble
     {
         ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
         cairo_rectangle(m_context, x, y, w, h);
+        MarkPathDirty(false);
         cairo_fill(m_context);
     }
     if ( !m_pen.IsNull() )
@@ -2650,6 +2761,7 @@ void wxCairoContext::DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble
         wxCairoOffsetHelper helper( m_context, ShouldOffset() ) ;
         ((wxCairoPenData*)m_pen.GetRefData())->Apply(this);
         cairo_rectangle(m_context, x, y, w, h);
+        MarkPathDirty(true);
         cairo_stroke(m_context);
     }
 }
@@ -2756,6 +2868,7 @@ void wxCairoContext::DrawBitmap(const wxGraphicsBitmap &bmp, wxDouble x, wxDoubl
     // use the original size here since the context is scaled already...
     cairo_rectangle(m_context, 0, 0, size.GetWidth(), size.GetHeight());
     // fill the rectangle using the pattern
+    MarkPathDirty(false);
     cairo_fill(m_context);
 
     PopState();
@@ -2799,6 +2912,14 @@ void wxCairoContext::DoDrawText(const wxString& str, wxDouble x, wxDouble y)
         // need to use the scaled font here.
         font.GTKSetPangoAttrs(layout);
 
+        if ( m_trackDirty )
+        {
+            PangoRectangle ink;
+            pango_layout_get_pixel_extents(layout, &ink, NULL);
+            MarkRectDirty(x + ink.x, y + ink.y,
+                          x + ink.x + ink.width, y + ink.y + ink.height);
+        }
+
         cairo_move_to(m_context, x, y);
         pango_cairo_show_layout (m_context, layout);
 
@@ -2813,6 +2934,16 @@ void wxCairoContext::DoDrawText(const wxString& str, wxDouble x, wxDouble y)
     cairo_font_extents(m_context, &fe);
     cairo_move_to(m_context, x, y+fe.ascent);
 
+    if ( m_trackDirty )
+    {
+        cairo_text_extents_t te;
+        cairo_text_extents(m_context, data, &te);
+
+        const double x1 = x + te.x_bearing,
+                     y1 = y + fe.ascent + te.y_bearing;
+        MarkRectDirty(x1, y1, x1 + te.width, y1 + te.height);
+    }
+
     cairo_show_text(m_context, data);
 }
 
@@ -2950,6 +3081,9 @@ void wxCairoContext::GetPartialTextExtents(const wxString& text, wxArrayDouble&
 
 void * wxCairoContext::GetNativeContext()
 {
+    // Anything can be drawn using the native context from now on.
+    m_trackDirty = false;
+
     return m_context;
 }
 
@@ -3055,9 +3189,88 @@ void wxCairoContext::EndLayer()
     float opacity = m_layerOpacities.back();
     m_layerOpacities.pop_back();
     cairo_pop_group_to_source(m_context);
+
+    if ( m_trackDirty )
+    {
+        double x1, y1, x2, y2;
+        cairo_clip_extents(m_context, &x1, &y1, &x2, &y2);
+        MarkRectDirty(x1, y1, x2, y2);
+    }
+
     cairo_paint_with_alpha(m_context, double(opacity));
 }
 
+void wxCairoContext::MarkPathDirty(bool stroke)
+{
+    if ( !m_trackDirty )
+        return;
+
+    double x1, y1, x2, y2;
+    if ( stroke )
+        cairo_stroke_extents(m_context, &x1, &y1, &x2, &y2);
+    else
+        cairo_fill_extents(m_context, &x1, &y1, &x2, &y2);
+
+    MarkRectDirty(x1, y1, x2, y2);
+}
+
+void wxCairoContext::MarkRectDirty(double x1, double y1, double x2, double y2)
+{
+    if ( !m_trackDirty )
+        return;
+
+    double clipX1, clipY1, clipX2, clipY2;
+    cairo_clip_extents(m_context, &clipX1, &clipY1, &clipX2, &clipY2);
+
+    switch ( cairo_get_operator(m_context) )
+    {
+        case CAIRO_OPERATOR_IN:
+        case CAIRO_OPERATOR_OUT:
+        case CAIRO_OPERATOR_DEST_IN:
+        case CAIRO_OPERATOR_DEST_ATOP:
+            // These operators are unbounded, i.e. affect the entire clipping
+            // region and not just the area being drawn.
+            x1 = clipX1;
+            y1 = clipY1;
+            x2 = clipX2;
+            y2 = clipY2;
+            break;
+
+        default:
+            x1 = wxMax(x1, clipX1);
+            y1 = wxMax(y1, clipY1);
+            x2 = wxMin(x2, clipX2);
+            y2 = wxMin(y2, clipY2);
+    }
+
+    if ( x1 >= x2 || y1 >= y2 )
+        return;
+
+    // Find the bounding box of the rectangle in device coordinates, it may be
+    // rotated or skewed by the current transformation.
+    double xs[] = { x1, x2, x1, x2 };
+    double ys[] = { y1, y1, y2, y2 };
+    double devX1 = DBL_MAX, devY1 = DBL_MAX,
+           devX2 = -DBL_MAX, devY2 = -DBL_MAX;
+    for ( size_t n = 0; n < WXSIZEOF(xs); n++ )
+    {
+        cairo_user_to_device(m_context, &xs[n], &ys[n]);
+
+        devX1 = wxMin(devX1, xs[n]);
+        devY1 = wxMin(devY1, ys[n]);
+        devX2 = wxMax(devX2, xs[n]);
+        devY2 = wxMax(devY2, ys[n]);
+    }
+
+    // Include all partially covered pixels.
+    const int left = static_cast<int>(floor(devX1));
+    const int top = static_cast<int>(floor(devY1));
+    const int right = static_cast<int>(ceil(devX2));
+    const int bottom = static_cast<int>(ceil(devY2));
+
+    m_dirtyRect.Union(wxRect(left, top, right - left, bottom - top));
+}
+
 //-----------------------------------------------------------------------------
 // wxCairoRenderer declaration
 //-----------------------------------------------------------------------------
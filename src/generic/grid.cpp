@@ -71,11 +71,10 @@ WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
 namespace
 {
 
-//#define DEBUG_ATTR_CACHE
-#ifdef DEBUG_ATTR_CACHE
-    static size_t gs_nAttrCacheHits = 0;
-    static size_t gs_nAttrCacheMisses = 0;
-#endif
+// the number of slots in the attribute cache is always a power of 2 between
+// these limits
+const size_t ATTR_CACHE_MIN_SIZE = 64;
+const size_t ATTR_CACHE_MAX_SIZE = 16384;
 
 // this struct simply combines together the default header renderers
 //
@@ -773,6 +772,7 @@ void wxGridCellAttrData::SetAttr(wxGridCellAttr *attr, int row, int col)
         if ( attr )
         {
             // add the attribute
+            m_index[wxGridCellCoords(row, col)] = m_attrs.GetCount();
             m_attrs.Add(new wxGridCellWithAttr(row, col, attr));
         }
         //else: nothing to do
@@ -786,8 +786,19 @@ void wxGridCellAttrData::SetAttr(wxGridCellAttr *attr, int row, int col)
         }
         else
         {
-            // remove this attribute
-            m_attrs.RemoveAt((size_t)n);
+            // remove this attribute: as the order of the elements in m_attrs
+            // doesn't matter, move the last one into its place instead of
+            // shifting all the subsequent elements
+            m_index.erase(wxGridCellCoords(row, col));
+
+            const size_t last = m_attrs.GetCount() - 1;
+            if ( (size_t)n != last )
+            {
+                m_attrs[(size_t)n] = m_attrs[last];
+                m_index[m_attrs[(size_t)n].coords] = n;
+            }
+
+            m_attrs.RemoveAt(last);
         }
     }
 }
@@ -978,26 +989,36 @@ void UpdateCellAttrRowsOrCols(wxGridCellWithAttrArray& attrs, int editPos,
 void wxGridCellAttrData::UpdateAttrRows( size_t pos, int numRows )
 {
     UpdateCellAttrRowsOrCols(m_attrs, static_cast<int>(pos), numRows, 0);
+
+    RebuildIndex();
 }
 
 void wxGridCellAttrData::UpdateAttrCols( size_t pos, int numCols )
 {
     UpdateCellAttrRowsOrCols(m_attrs, static_cast<int>(pos), 0, numCols);
+
+    RebuildIndex();
 }
 
-int wxGridCellAttrData::FindIndex(int row, int col) const
+void wxGridCellAttrData::RebuildIndex()
 {
-    size_t count = m_attrs.GetCount();
+    m_index.clear();
+
+    const size_t count = m_attrs.GetCount();
     for ( size_t n = 0; n < count; n++ )
     {
-        const wxGridCellCoords& coords = m_attrs[n].coords;
-        if ( (coords.GetRow() == row) && (coords.GetCol() == col) )
-        {
-            return n;
-        }
+        m_index[m_attrs[n].coords] = n;
     }
+}
 
-    return wxNOT_FOUND;
+int wxGridCellAttrData::FindIndex(int row, int col) const
+{
+    wxGridCellCoordsToIndexHashMap::const_iterator
+        it = m_index.find(wxGridCellCoords(row, col));
+    if ( it == m_index.end() )
+        return wxNOT_FOUND;
+
+    return static_cast<int>(it->second);
 }
 
 // ----------------------------------------------------------------------------
@@ -1485,6 +1506,11 @@ wxGridTableBase::~wxGridTableBase()
 
 void wxGridTableBase::SetAttrProvider(wxGridCellAttrProvider *attrProvider)
 {
+    // the grid could have cached the attributes returned by the old provider
+    // which are going to be deleted together with it
+    if ( GetView() )
+        GetView()->RefreshAttrs();
+
     delete m_attrProvider;
     m_attrProvider = attrProvider;
 }
@@ -2681,14 +2707,6 @@ wxGrid::~wxGrid()
     ClearAttrCache();
     wxSafeDecRef(m_defaultCellAttr);
 
-#ifdef DEBUG_ATTR_CACHE
-    size_t total = gs_nAttrCacheHits + gs_nAttrCacheMisses;
-    wxPrintf(wxT("wxGrid attribute cache statistics: "
-                "total: %u, hits: %u (%u%%)\n"),
-             total, gs_nAttrCacheHits,
-             total ? (gs_nAttrCacheHits*100) / total : 0);
-#endif
-
     // if we own the table, just delete it, otherwise at least don't leave it
     // with dangling view pointer
     if ( m_ownTable )
@@ -2872,6 +2890,9 @@ wxGrid::SetTable(wxGridTableBase *table,
             m_table = NULL;
         }
 
+        // the cached attributes came from the old table
+        ClearAttrCache();
+
         wxDELETE(m_selection);
 
         m_ownTable = false;
@@ -2945,9 +2966,9 @@ void wxGrid::Init()
     m_setFixedCols = NULL;
 
     // init attr cache
-    m_attrCache.row = -1;
-    m_attrCache.col = -1;
-    m_attrCache.attr = NULL;
+    m_attrCacheHits =
+    m_attrCacheMisses = 0;
+    ReserveAttrCache(0);
 
     m_labelFont = GetFont();
     m_labelFont.SetWeight( wxFONTWEIGHT_BOLD );
@@ -3248,9 +3269,9 @@ bool wxGrid::Redimension( wxGridTableMessage& msg )
     int i;
     bool result = false;
 
-    // Clear the attribute cache as the attribute might refer to a different
-    // cell than stored in the cache after adding/removing rows/columns.
-    ClearAttrCache();
+    // Notice that the attribute cache was already cleared by our caller, as
+    // the attribute might refer to a different cell than stored in the cache
+    // after adding/removing rows/columns.
 
     // By the same reasoning, the editor should be dismissed if columns are
     // added or removed. And for consistency, it should IMHO always be
@@ -5358,6 +5379,9 @@ void wxGrid::UpdateGridWindows() const
 //
 bool wxGrid::ProcessTableMessage( wxGridTableMessage& msg )
 {
+    // any change to the table might affect the attributes of its cells too
+    ClearAttrCache();
+
     switch ( msg.GetId() )
     {
         case wxGRIDTABLE_NOTIFY_ROWS_INSERTED:
@@ -6283,6 +6307,10 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
         return;
 
     int i, numCells = cells.GetCount();
+
+    // make sure the attributes of all the cells we're going to draw fit into
+    // the cache, as they will be needed again during the next repaint
+    ReserveAttrCache(numCells);
     wxGridCellCoordsArray redrawCells;
 
     for ( i = numCells - 1; i >= 0; i-- )
@@ -7284,6 +7312,9 @@ void wxGrid::EndBatch()
 //
 void wxGrid::ForceRefresh()
 {
+    // the attributes may have changed too, don't use the cached ones
+    ClearAttrCache();
+
     BeginBatch();
     EndBatch();
 }
@@ -9289,60 +9320,113 @@ bool wxGrid::CanHaveAttributes() const
     return m_table->CanHaveAttributes();
 }
 
+wxGrid::CachedAttr& wxGrid::GetAttrCacheSlot(int row, int col) const
+{
+    const size_t hash = wxGridCellCoordsHash()(wxGridCellCoords(row, col));
+
+    // the cache size is a power of 2, so this is the same as modulo operation
+    return m_attrCache[hash & (m_attrCache.size() - 1)];
+}
+
+void wxGrid::ReserveAttrCache(size_t count)
+{
+    // use twice as many slots as the number of attributes to keep the number
+    // of collisions small
+    size_t size = ATTR_CACHE_MIN_SIZE;
+    while ( size < 2*count && size < ATTR_CACHE_MAX_SIZE )
+        size *= 2;
+
+    if ( size <= m_attrCache.size() )
+        return;
+
+    ClearAttrCache();
+
+    const CachedAttr empty = { -1, -1, NULL };
+    m_attrCache.assign(size, empty);
+}
+
 void wxGrid::ClearAttrCache()
 {
-    if ( m_attrCache.row != -1 )
+    ClearAttrCache(-1, -1);
+}
+
+void wxGrid::ClearAttrCache(int row, int col)
+{
+    // wxSafeDecRec(...) might cause event processing that accesses
+    // the cached attribute, if one exists (e.g. by deleting the
+    // editor stored within the attribute). Therefore it is important
+    // to invalidate the cache before calling wxSafeDecRef!
+    wxVector<wxGridCellAttr*> oldAttrs;
+
+    const size_t count = m_attrCache.size();
+    for ( size_t n = 0; n < count; n++ )
     {
-        wxGridCellAttr *oldAttr = m_attrCache.attr;
-        m_attrCache.attr = NULL;
-        m_attrCache.row = -1;
-        // wxSafeDecRec(...) might cause event processing that accesses
-        // the cached attribute, if one exists (e.g. by deleting the
-        // editor stored within the attribute). Therefore it is important
-        // to invalidate the cache  before calling wxSafeDecRef!
-        wxSafeDecRef(oldAttr);
+        CachedAttr& cached = m_attrCache[n];
+        if ( cached.row == -1 )
+            continue;
+
+        if ( (row != -1 && cached.row != row) ||
+                (col != -1 && cached.col != col) )
+            continue;
+
+        if ( cached.attr )
+            oldAttrs.push_back(cached.attr);
+
+        cached.row =
+        cached.col = -1;
+        cached.attr = NULL;
     }
+
+    for ( size_t n = 0; n < oldAttrs.size(); n++ )
+        oldAttrs[n]->DecRef();
 }
 
 void wxGrid::RefreshAttr(int row, int col)
 {
-    if ( m_attrCache.row == row && m_attrCache.col == col )
-        ClearAttrCache();
+    CachedAttr& cached = GetAttrCacheSlot(row, col);
+    if ( cached.row == row && cached.col == col )
+    {
+        // see the comment in ClearAttrCache() for why we reset the slot first
+        wxGridCellAttr* const oldAttr = cached.attr;
+        cached.row =
+        cached.col = -1;
+        cached.attr = NULL;
+
+        wxSafeDecRef(oldAttr);
+    }
 }
 
 
 void wxGrid::CacheAttr(int row, int col, wxGridCellAttr *attr) const
 {
-    if ( attr != NULL )
-    {
-        wxGrid * const self = const_cast<wxGrid *>(this);
+    // notice that we cache the absence of the attribute too, as this is the
+    // most common case for the majority of cells
+    CachedAttr& cached = GetAttrCacheSlot(row, col);
 
-        self->ClearAttrCache();
-        self->m_attrCache.row = row;
-        self->m_attrCache.col = col;
-        self->m_attrCache.attr = attr;
-        wxSafeIncRef(attr);
-    }
+    wxGridCellAttr* const oldAttr = cached.attr;
+    cached.row = row;
+    cached.col = col;
+    cached.attr = attr;
+    wxSafeIncRef(attr);
+
+    wxSafeDecRef(oldAttr);
 }
 
 bool wxGrid::LookupAttr(int row, int col, wxGridCellAttr **attr) const
 {
-    if ( row == m_attrCache.row && col == m_attrCache.col )
+    const CachedAttr& cached = GetAttrCacheSlot(row, col);
+    if ( cached.row == row && cached.col == col )
     {
-        *attr = m_attrCache.attr;
-        wxSafeIncRef(m_attrCache.attr);
+        *attr = cached.attr;
+        wxSafeIncRef(cached.attr);
 
-#ifdef DEBUG_ATTR_CACHE
-        gs_nAttrCacheHits++;
-#endif
+        m_attrCacheHits++;
 
         return true;
     }
     else
     {
-#ifdef DEBUG_ATTR_CACHE
-        gs_nAttrCacheMisses++;
-#endif
+        m_attrCacheMisses++;
 
         return false;
     }
@@ -9384,6 +9468,11 @@ wxGridCellAttr *wxGrid::GetOrCreateCellAttr(int row, int col) const
     wxCHECK_MSG( canHave, attr, wxT("Cell attributes not allowed"));
     wxCHECK_MSG( m_table, attr, wxT("must have a table") );
 
+    // the attribute returned from here is going to be modified, so the cached
+    // one, which may also be the result of merging it with row or column
+    // attributes, can't be used any longer
+    const_cast<wxGrid *>(this)->RefreshAttr(row, col);
+
     attr = m_table->GetAttr(row, col, wxGridCellAttr::Cell);
     if ( !attr )
     {
@@ -9455,7 +9544,7 @@ void wxGrid::SetAttr(int row, int col, wxGridCellAttr *attr)
     if ( CanHaveAttributes() )
     {
         m_table->SetAttr(attr, row, col);
-        ClearAttrCache();
+        RefreshAttr(row, col);
     }
     else
     {
@@ -9468,7 +9557,7 @@ void wxGrid::SetRowAttr(int row, wxGridCellAttr *attr)
     if ( CanHaveAttributes() )
     {
         m_table->SetRowAttr(attr, row);
-        ClearAttrCache();
+        ClearAttrCache(row, -1);
     }
     else
     {
@@ -9481,7 +9570,7 @@ void wxGrid::SetColAttr(int col, wxGridCellAttr *attr)
     if ( CanHaveAttributes() )
     {
         m_table->SetColAttr(attr, col);
-        ClearAttrCache();
+        ClearAttrCache(-1, col);
     }
     else
     {
@@ -10598,6 +10687,11 @@ void wxGrid::SetCellValue( int row, int col, const wxString& s )
     if ( m_table )
     {
         m_table->SetValue( row, col, s );
+
+        // custom attribute providers often use different attributes depending
+        // on the cell value, so don't keep using the old one
+        RefreshAttr(row, col);
+
         if ( ShouldRefresh() )
         {
             int dummy;
@@ -37,6 +37,7 @@
 #include "wx/itemattr.h"
 
 #include "wx/renderer.h"
+#include "wx/scopedptr.h"
 
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
@@ -56,6 +57,9 @@ WX_DEFINE_ARRAY_PTR(wxGenericTreeItem *, wxArrayGenericTreeItems);
 
 static const int NO_IMAGE = -1;
 
+// the row of the items which are not currently shown
+static const int NO_ROW = -1;
+
 static const int PIXELS_PER_UNIT = 10;
 
 // the margin between the item state image and the item normal image
@@ -142,6 +146,7 @@ public:
         m_data = NULL;
         m_widthText =
         m_heightText = -1;
+        m_row = NO_ROW;
     }
 
     wxGenericTreeItem( wxGenericTreeItem *parent,
@@ -199,6 +204,11 @@ public:
     int GetHeight() const { return m_height; }
     int GetWidth() const { return m_width; }
 
+    // the index of this item in wxGenericTreeCtrl::m_rows, if it's shown
+    int GetRow() const { return m_row; }
+    void SetRow(int row) { m_row = row; }
+    bool HasRow() const { return m_row != NO_ROW; }
+
     int GetTextHeight() const
     {
         wxASSERT_MSG( m_heightText != -1, "must call CalculateSize() first" );
@@ -251,20 +261,16 @@ public:
         { DoCalculateSize(control, dc, true /* dc uses normal font */); }
     void CalculateSize(wxGenericTreeCtrl *control);
 
-    void GetSize( int &x, int &y, const wxGenericTreeCtrl* );
-
     void ResetSize() { m_width = 0; }
     void ResetTextSize() { m_width = 0; m_widthText = -1; }
     void RecursiveResetSize();
     void RecursiveResetTextSize();
 
-        // return the item at given position (or NULL if no item), onButton is
-        // true if the point belongs to the item's button, otherwise it lies
-        // on the item's label
+        // return this item if the given position is inside it, with flags
+        // indicating which part of it the point lies on, or NULL otherwise
     wxGenericTreeItem *HitTest( const wxPoint& point,
                                 const wxGenericTreeCtrl *,
-                                int &flags,
-                                int level );
+                                int &flags );
 
     void Expand() { m_isCollapsed = false; }
     void Collapse() { m_isCollapsed = true; }
@@ -343,6 +349,7 @@ private:
     wxCoord             m_y;            // (virtual) offset from left
     int                 m_width;        // width of this item
     int                 m_height;       // height of this item
+    int                 m_row;          // index of the item row or NO_ROW
 
     // use bitfields to save size
     unsigned int        m_isCollapsed :1;
@@ -395,6 +402,42 @@ IsDescendantOf(const wxGenericTreeItem *parent, const wxGenericTreeItem *item)
     return false;
 }
 
+static void
+AddShownSubtree(wxGenericTreeItem *item, wxVector<wxGenericTreeItem *>& rows);
+
+// append all shown descendants of the given expanded item to rows
+static void
+AddShownChildren(wxGenericTreeItem *item, wxVector<wxGenericTreeItem *>& rows)
+{
+    const wxArrayGenericTreeItems& children = item->GetChildren();
+    const size_t count = children.GetCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        AddShownSubtree(children[n], rows);
+    }
+}
+
+// append the given item and all its shown descendants to rows
+static void
+AddShownSubtree(wxGenericTreeItem *item, wxVector<wxGenericTreeItem *>& rows)
+{
+    rows.push_back(item);
+
+    if ( item->IsExpanded() )
+        AddShownChildren(item, rows);
+}
+
+// return the index of the row following the last row of the subtree of the
+// given item, which must be either shown or the hidden root
+static size_t GetSubtreeRowsEnd(wxGenericTreeItem *item)
+{
+    // the last row is the last shown descendant of the item
+    while ( item->IsExpanded() && item->HasChildren() )
+        item = item->GetChildren().Last();
+
+    return item->HasRow() ? item->GetRow() + 1 : 0;
+}
+
 // -----------------------------------------------------------------------------
 // wxTreeRenameTimer (internal)
 // -----------------------------------------------------------------------------
@@ -605,6 +648,8 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
 
     m_widthText = -1;
     m_heightText = -1;
+
+    m_row = NO_ROW;
 }
 
 wxGenericTreeItem::~wxGenericTreeItem()
@@ -649,125 +694,84 @@ size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
     return total;
 }
 
-void wxGenericTreeItem::GetSize( int &x, int &y,
-                                 const wxGenericTreeCtrl *theButton )
-{
-    int bottomY=m_y+theButton->GetLineHeight(this);
-    if ( y < bottomY ) y = bottomY;
-    int width = m_x +  m_width;
-    if ( x < width ) x = width;
-
-    if (IsExpanded())
-    {
-        size_t count = m_children.GetCount();
-        for ( size_t n = 0; n < count; ++n )
-        {
-            m_children[n]->GetSize( x, y, theButton );
-        }
-    }
-}
-
 wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
                                               const wxGenericTreeCtrl *theCtrl,
-                                              int &flags,
-                                              int level)
+                                              int &flags)
 {
-    // for a hidden root node, don't evaluate it, but do evaluate children
-    if ( !(level == 0 && theCtrl->HasFlag(wxTR_HIDE_ROOT)) )
-    {
-        // evaluate the item
-        int h = theCtrl->GetLineHeight(this);
-        if ((point.y > m_y) && (point.y < m_y + h))
-        {
-            int y_mid = m_y + h/2;
-            if (point.y < y_mid )
-                flags |= wxTREE_HITTEST_ONITEMUPPERPART;
-            else
-                flags |= wxTREE_HITTEST_ONITEMLOWERPART;
+    int h = theCtrl->GetLineHeight(this);
+    if ((point.y <= m_y) || (point.y >= m_y + h))
+        return NULL;
 
-            int xCross = m_x - theCtrl->GetSpacing();
+    int y_mid = m_y + h/2;
+    if (point.y < y_mid )
+        flags |= wxTREE_HITTEST_ONITEMUPPERPART;
+    else
+        flags |= wxTREE_HITTEST_ONITEMLOWERPART;
+
+    int xCross = m_x - theCtrl->GetSpacing();
 #ifdef __WXMAC__
-            // according to the drawing code the triangels are drawn
-            // at -4 , -4  from the position up to +10/+10 max
-            const int triangleStart = theCtrl->FromDIP(4);
-            const int triangleEnd = theCtrl->FromDIP(10);
-            if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
-                (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
-                HasPlus() && theCtrl->HasButtons() )
+    // according to the drawing code the triangels are drawn
+    // at -4 , -4  from the position up to +10/+10 max
+    const int triangleStart = theCtrl->FromDIP(4);
+    const int triangleEnd = theCtrl->FromDIP(10);
+    if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
+        (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
+        HasPlus() && theCtrl->HasButtons() )
 #else
-            // 5 is the size of the plus sign
-            const int plusSize = 1 + theCtrl->FromDIP(5);
-            if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
-                (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
-                HasPlus() && theCtrl->HasButtons() )
+    // 5 is the size of the plus sign
+    const int plusSize = 1 + theCtrl->FromDIP(5);
+    if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
+        (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
+        HasPlus() && theCtrl->HasButtons() )
 #endif
-            {
-                flags |= wxTREE_HITTEST_ONITEMBUTTON;
-                return this;
-            }
-
-            if ((point.x >= m_x) && (point.x <= m_x+m_width))
-            {
-                int image_w = -1;
-
-                // assuming every image (normal and selected) has the same size!
-                if ( (GetImage() != NO_IMAGE) && theCtrl->m_imageListNormal )
-                {
-                    int image_h;
-                    theCtrl->m_imageListNormal->GetSize(GetImage(),
-                                                        image_w, image_h);
-                }
-
-                int state_w = -1;
-
-                if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
-                        theCtrl->m_imageListState )
-                {
-                    int state_h;
-                    theCtrl->m_imageListState->GetSize(GetState(),
-                                                       state_w, state_h);
-                }
+    {
+        flags |= wxTREE_HITTEST_ONITEMBUTTON;
+        return this;
+    }
 
-                if ((state_w != -1) && (point.x <= m_x + state_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMSTATEICON;
-                else if ((image_w != -1) &&
-                         (point.x <= m_x +
-                            (state_w != -1 ? state_w +
-                                                MARGIN_BETWEEN_STATE_AND_IMAGE
-                                           : 0)
-                                            + image_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMICON;
-                else
-                    flags |= wxTREE_HITTEST_ONITEMLABEL;
+    if ((point.x >= m_x) && (point.x <= m_x+m_width))
+    {
+        int image_w = -1;
 
-                return this;
-            }
+        // assuming every image (normal and selected) has the same size!
+        if ( (GetImage() != NO_IMAGE) && theCtrl->m_imageListNormal )
+        {
+            int image_h;
+            theCtrl->m_imageListNormal->GetSize(GetImage(),
+                                                image_w, image_h);
+        }
 
-            if (point.x < m_x)
-                flags |= wxTREE_HITTEST_ONITEMINDENT;
-            if (point.x > m_x+m_width)
-                flags |= wxTREE_HITTEST_ONITEMRIGHT;
+        int state_w = -1;
 
-            return this;
+        if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
+                theCtrl->m_imageListState )
+        {
+            int state_h;
+            theCtrl->m_imageListState->GetSize(GetState(),
+                                               state_w, state_h);
         }
 
-        // if children are expanded, fall through to evaluate them
-        if (m_isCollapsed) return NULL;
-    }
+        if ((state_w != -1) && (point.x <= m_x + state_w + 1))
+            flags |= wxTREE_HITTEST_ONITEMSTATEICON;
+        else if ((image_w != -1) &&
+                 (point.x <= m_x +
+                    (state_w != -1 ? state_w +
+                                        MARGIN_BETWEEN_STATE_AND_IMAGE
+                                   : 0)
+                                    + image_w + 1))
+            flags |= wxTREE_HITTEST_ONITEMICON;
+        else
+            flags |= wxTREE_HITTEST_ONITEMLABEL;
 
-    // evaluate children
-    size_t count = m_children.GetCount();
-    for ( size_t n = 0; n < count; n++ )
-    {
-        wxGenericTreeItem *res = m_children[n]->HitTest( point,
-                                                         theCtrl,
-                                                         flags,
-                                                         level + 1 );
-        if ( res != NULL )
-            return res;
+        return this;
     }
 
-    return NULL;
+    if (point.x < m_x)
+        flags |= wxTREE_HITTEST_ONITEMINDENT;
+    if (point.x > m_x+m_width)
+        flags |= wxTREE_HITTEST_ONITEMRIGHT;
+
+    return this;
 }
 
 int wxGenericTreeItem::GetCurrentImage() const
@@ -866,6 +870,8 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
             state_w += MARGIN_BETWEEN_IMAGE_AND_TEXT;
     }
 
+    const int heightOld = m_height;
+
     int img_h = wxMax(state_h, image_h);
     m_height = wxMax(img_h, text_h);
 
@@ -875,7 +881,15 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
         m_height += m_height / 10;   // otherwise 10% extra spacing
 
     if (m_height > control->m_lineHeight)
+    {
         control->m_lineHeight = m_height;
+        control->m_positionsDirty = true;
+    }
+    else if (m_height != heightOld && m_row != NO_ROW)
+    {
+        // this only matters when using wxTR_HAS_VARIABLE_ROW_HEIGHT
+        control->m_positionsDirty = true;
+    }
 
     m_width = state_w + image_w + m_widthText + 2;
 }
@@ -929,6 +943,8 @@ void wxGenericTreeCtrl::Init()
     m_select_me = NULL;
     m_hasFocus = false;
     m_dirty = false;
+    m_rowsDirty = false;
+    m_positionsDirty = false;
 
     m_lineHeight = 10;
     m_indent = 15;
@@ -1092,9 +1108,12 @@ void wxGenericTreeCtrl::SetWindowStyleFlag(long styles)
         // if we will hide the root, make sure children are visible
         m_anchor->SetHasPlus();
         m_anchor->Expand();
-        CalculatePositions();
     }
 
+    // showing or hiding the root changes all the rows
+    if ( (styles ^ m_windowStyle) & wxTR_HIDE_ROOT )
+        InvalidateRows();
+
     // right now, just sets the styles.  Eventually, we may
     // want to update the inherited styles, but right now
     // none of the parents has updatable styles
@@ -1656,6 +1675,7 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
 
     parent->Insert( item, previous == (size_t)-1 ? parent->GetChildren().size()
                                                  : previous );
+    AddItemRows(item);
 
     InvalidateBestSize();
     return item;
@@ -1683,9 +1703,10 @@ wxTreeItemId wxGenericTreeCtrl::AddRoot(const wxString& text,
         // into children
         m_anchor->SetHasPlus();
         m_anchor->Expand();
-        CalculatePositions();
     }
 
+    AddItemRows(m_anchor);
+
     if (!HasFlag(wxTR_MULTIPLE))
     {
         m_current = m_key_current = m_anchor;
@@ -1765,6 +1786,7 @@ void wxGenericTreeCtrl::DeleteChildren(const wxTreeItemId& itemId)
 
     wxGenericTreeItem *item = (wxGenericTreeItem*) itemId.m_pItem;
     ChildrenClosing(item);
+    RemoveChildrenRows(item);
     item->DeleteChildren(this);
     InvalidateBestSize();
 }
@@ -1823,6 +1845,7 @@ void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
     }
 
     // remove the item from the tree
+    RemoveItemRows(item);
     if ( parent )
     {
         parent->GetChildren().Remove( item );  // remove by value
@@ -1876,6 +1899,7 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
     }
 
     item->Expand();
+    AddChildrenRows(item);
     if ( !IsFrozen() )
     {
         CalculatePositions();
@@ -1917,6 +1941,7 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 
     ChildrenClosing(item);
+    RemoveChildrenRows(item);
     item->Collapse();
 
 #if 0  // TODO why should items be collapsed recursively?
@@ -1928,9 +1953,16 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 #endif
 
-    CalculatePositions();
+    if ( !IsFrozen() )
+    {
+        CalculatePositions();
 
-    RefreshSubtree(item);
+        RefreshSubtree(item);
+    }
+    else // frozen
+    {
+        m_dirty = true;
+    }
 
     event.SetEventType(wxEVT_TREE_ITEM_COLLAPSED);
     GetEventHandler()->ProcessEvent( event );
@@ -2311,6 +2343,10 @@ void wxGenericTreeCtrl::ScrollTo(const wxTreeItemId &item)
         DoDirtyProcessing();
 #endif
     }
+    else if (m_positionsDirty)
+    {
+        CalculatePositions();
+    }
 
     wxGenericTreeItem *gitem = (wxGenericTreeItem*) item.m_pItem;
 
@@ -2370,9 +2406,14 @@ void wxGenericTreeCtrl::SortChildren(const wxTreeItemId& itemId)
     {
         m_dirty = true;
 
+        // the order of the rows of the children changes too
+        RemoveChildrenRows(item);
+
         s_treeBeingSorted = this;
         children.Sort(tree_ctrl_compare_func);
         s_treeBeingSorted = NULL;
+
+        AddChildrenRows(item);
     }
     //else: don't make the tree dirty as nothing changed
 }
@@ -2489,8 +2530,23 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
 {
     if (m_anchor)
     {
+        if ( m_positionsDirty )
+            CalculatePositions();
+
         int x = 0, y = 0;
-        m_anchor->GetSize( x, y, this );
+        for ( size_t n = 0; n < m_rows.size(); n++ )
+        {
+            wxGenericTreeItem * const item = m_rows[n];
+            int width = item->GetX() + item->GetWidth();
+            if ( x < width ) x = width;
+        }
+
+        if ( !m_rows.empty() )
+        {
+            wxGenericTreeItem * const item = m_rows.back();
+            y = item->GetY() + GetLineHeight(item);
+        }
+
         y += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         x += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         int x_pos = GetScrollPos( wxHORIZONTAL );
@@ -2728,50 +2784,14 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
     }
 }
 
-void
-wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
-                              wxDC &dc,
-                              int level,
-                              int &y)
+void wxGenericTreeCtrl::PaintRow(wxGenericTreeItem *item, wxDC &dc)
 {
-    int x = level*m_indent;
-    if (!HasFlag(wxTR_HIDE_ROOT))
-    {
-        x += m_indent;
-    }
-    else if (level == 0)
-    {
-        // always expand hidden root
-        int origY = y;
-        wxArrayGenericTreeItems& children = item->GetChildren();
-        int count = children.GetCount();
-        if (count > 0)
-        {
-            int n = 0, oldY;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, 1, y);
-            } while (++n < count);
-
-            if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
-                    && count > 0 )
-            {
-                // draw line down to last child
-                origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
-                dc.DrawLine(3, origY, 3, oldY);
-            }
-        }
-        return;
-    }
-
-    item->SetX(x+m_spacing);
-    item->SetY(y);
+    int x = item->GetX() - m_spacing;
 
     int h = GetLineHeight(item);
-    int y_top = y;
+    int y_top = item->GetY();
     int y_mid = y_top + (h>>1);
-    y += h;
+    int y = y_top + h;
 
     int exposed_x = dc.LogicalToDeviceX(0);
     int exposed_y = dc.LogicalToDeviceY(y_top);
@@ -2884,46 +2904,49 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
             }
         }
     }
+}
 
-    if (item->IsExpanded())
+void wxGenericTreeCtrl::PaintChildrenLine(wxGenericTreeItem *item, wxDC &dc)
+{
+    const wxArrayGenericTreeItems& children = item->GetChildren();
+
+    // draw the line from the item, or from its first child for the hidden
+    // root, down to its last child
+    int x, y_start;
+    if ( item->HasRow() )
     {
-        wxArrayGenericTreeItems& children = item->GetChildren();
-        int count = children.GetCount();
-        if (count > 0)
-        {
-            int n = 0, oldY;
-            ++level;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, level, y);
-            } while (++n < count);
-
-            if (!HasFlag(wxTR_NO_LINES) && count > 0)
-            {
-                // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
-                if (HasButtons()) y_mid += 5;
-
-                // Only draw the portion of the line that is visible, in case
-                // it is huge
-                wxCoord xOrigin=0, yOrigin=0, width, height;
-                dc.GetDeviceOrigin(&xOrigin, &yOrigin);
-                yOrigin = abs(yOrigin);
-                GetClientSize(&width, &height);
-
-                // Move end points to the beginning/end of the view?
-                if (y_mid < yOrigin)
-                    y_mid = yOrigin;
-                if (oldY > yOrigin + height)
-                    oldY = yOrigin + height;
-
-                // after the adjustments if y_mid is larger than oldY then the
-                // line isn't visible at all so don't draw anything
-                if (y_mid < oldY)
-                    dc.DrawLine(x, y_mid, x, oldY);
-            }
-        }
+        x = item->GetX() - m_spacing;
+        y_start = item->GetY() + (GetLineHeight(item)>>1);
+        if (HasButtons()) y_start += 5;
+    }
+    else // hidden root
+    {
+        if ( !HasFlag(wxTR_LINES_AT_ROOT) )
+            return;
+
+        x = 3;
+        y_start = children[0]->GetY() + (GetLineHeight(children[0])>>1);
     }
+
+    wxGenericTreeItem * const last = children.Last();
+    int y_end = last->GetY() + (GetLineHeight(last)>>1);
+
+    // Only draw the portion of the line that is visible, in case it is huge
+    wxCoord xOrigin=0, yOrigin=0, width, height;
+    dc.GetDeviceOrigin(&xOrigin, &yOrigin);
+    yOrigin = abs(yOrigin);
+    GetClientSize(&width, &height);
+
+    // Move end points to the beginning/end of the view?
+    if (y_start < yOrigin)
+        y_start = yOrigin;
+    if (y_end > yOrigin + height)
+        y_end = yOrigin + height;
+
+    // after the adjustments if y_start is larger than y_end then the line
+    // isn't visible at all so don't draw anything
+    if (y_start < y_end)
+        dc.DrawLine(x, y_start, x, y_end);
 }
 
 void wxGenericTreeCtrl::DrawDropEffect(wxGenericTreeItem *item)
@@ -3023,12 +3046,48 @@ void wxGenericTreeCtrl::OnPaint( wxPaintEvent &WXUNUSED(event) )
     dc.SetFont( m_normalFont );
     dc.SetPen( m_dottedPen );
 
-    // this is now done dynamically
-    //if(GetImageList() == NULL)
-    // m_lineHeight = (int)(dc.GetCharHeight() + 4);
+    // the positions are normally already up to date, but they may have been
+    // invalidated by the changes done since they were last calculated
+    if ( m_dirty || m_positionsDirty )
+        CalculatePositions(&dc);
 
-    int y = 2;
-    PaintLevel( m_anchor, dc, 0, y );
+    // only paint the rows intersecting the update region
+    const wxRect rectUpdate = GetUpdateClientRect();
+    int y_top, y_bottom;
+    CalcUnscrolledPosition(0, rectUpdate.GetTop(), NULL, &y_top);
+    CalcUnscrolledPosition(0, rectUpdate.GetBottom(), NULL, &y_bottom);
+
+    const size_t first = GetRowAtY(y_top);
+    size_t last;
+    for ( last = first; last < m_rows.size(); last++ )
+    {
+        wxGenericTreeItem * const item = m_rows[last];
+        if ( item->GetY() > y_bottom )
+            break;
+
+        PaintRow(item, dc);
+    }
+
+    if ( HasFlag(wxTR_NO_LINES) || first == last )
+        return;
+
+    // draw the vertical lines going through the painted rows: these are the
+    // lines of the ancestors of the first row and of the painted rows
+    dc.SetPen( m_dottedPen );
+
+    for ( wxGenericTreeItem *parent = m_rows[first]->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        PaintChildrenLine(parent, dc);
+    }
+
+    for ( size_t n = first; n < last; n++ )
+    {
+        wxGenericTreeItem * const item = m_rows[n];
+        if ( item->IsExpanded() && item->HasChildren() )
+            PaintChildrenLine(item, dc);
+    }
 }
 
 void wxGenericTreeCtrl::OnSetFocus( wxFocusEvent &event )
@@ -3436,8 +3495,7 @@ wxGenericTreeCtrl::DoTreeHitTest(const wxPoint& point, int& flags) const
         return wxTreeItemId();
     }
 
-    wxGenericTreeItem *hit =  m_anchor->HitTest(CalcUnscrolledPosition(point),
-                                                this, flags, 0);
+    wxGenericTreeItem *hit = HitTestRows(CalcUnscrolledPosition(point), flags);
     if (hit == NULL)
     {
         flags = wxTREE_HITTEST_NOWHERE;
@@ -3454,6 +3512,10 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
     wxCHECK_MSG( item.IsOk(), false,
                  "invalid item in wxGenericTreeCtrl::GetBoundingRect" );
 
+    // the item could have been just added or moved
+    if ( m_positionsDirty )
+        wxConstCast(this, wxGenericTreeCtrl)->CalculatePositions();
+
     wxGenericTreeItem *i = (wxGenericTreeItem*) item.m_pItem;
 
     if ( textOnly )
@@ -3575,7 +3637,7 @@ void wxGenericTreeCtrl::OnMouse( wxMouseEvent &event )
 
     // Is the mouse over a tree item button?
     int flags = 0;
-    wxGenericTreeItem *thisItem = m_anchor->HitTest(pt, this, flags, 0);
+    wxGenericTreeItem *thisItem = HitTestRows(pt, flags);
     wxGenericTreeItem *underMouse = thisItem;
 #if wxUSE_TOOLTIPS
     bool underMouseChanged = (underMouse != m_underMouse) ;
@@ -3660,7 +3722,7 @@ void wxGenericTreeCtrl::OnMouse( wxMouseEvent &event )
 
 
     flags = 0;
-    wxGenericTreeItem *item = m_anchor->HitTest(pt, this, flags, 0);
+    wxGenericTreeItem *item = HitTestRows(pt, flags);
 
     if ( event.Dragging() && !m_isDragging )
     {
@@ -3964,60 +4026,230 @@ void wxGenericTreeCtrl::OnInternalIdle()
         DoDirtyProcessing();
 }
 
+bool wxGenericTreeCtrl::AreChildrenShown(wxGenericTreeItem *item) const
+{
+    // the children of the hidden root are always shown
+    return item->IsExpanded() && (item->HasRow() || item == m_anchor);
+}
+
+bool wxGenericTreeCtrl::ShouldUpdateRows()
+{
+    // nothing to do if the rows will be rebuilt anyhow
+    if ( m_rowsDirty )
+        return false;
+
+    // while frozen, many items can be added or expanded at once, so don't
+    // update the rows for each of them but just rebuild them all later
+    if ( IsFrozen() )
+    {
+        InvalidateRows();
+        return false;
+    }
+
+    return true;
+}
+
 void
-wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
-                                  wxDC &dc,
-                                  int level,
-                                  int &y )
+wxGenericTreeCtrl::InsertRows(size_t pos,
+                              const wxVector<wxGenericTreeItem *>& rows)
+{
+    if ( rows.empty() )
+        return;
+
+    m_rows.insert(m_rows.begin() + pos, rows.size(), NULL);
+    for ( size_t n = 0; n < rows.size(); n++ )
+        m_rows[pos + n] = rows[n];
+
+    // renumber all the rows after the inserted ones too
+    for ( size_t n = pos; n < m_rows.size(); n++ )
+        m_rows[n]->SetRow(n);
+
+    m_positionsDirty = true;
+}
+
+void wxGenericTreeCtrl::RemoveRows(size_t first, size_t last)
+{
+    if ( first == last )
+        return;
+
+    for ( size_t n = first; n < last; n++ )
+        m_rows[n]->SetRow(NO_ROW);
+
+    m_rows.erase(m_rows.begin() + first, m_rows.begin() + last);
+
+    for ( size_t n = first; n < m_rows.size(); n++ )
+        m_rows[n]->SetRow(n);
+
+    m_positionsDirty = true;
+}
+
+void wxGenericTreeCtrl::AddItemRows(wxGenericTreeItem *item)
 {
-    int x = level*m_indent;
-    if (!HasFlag(wxTR_HIDE_ROOT))
+    if ( !ShouldUpdateRows() )
+        return;
+
+    size_t pos;
+    wxGenericTreeItem * const parent = item->GetParent();
+    if ( parent )
     {
-        x += m_indent;
+        if ( !AreChildrenShown(parent) )
+            return;
+
+        // the item rows follow those of its previous sibling, if any, or
+        // the parent row otherwise
+        const wxArrayGenericTreeItems& siblings = parent->GetChildren();
+        const int index = siblings.Index(item, true /* from end */);
+        if ( index > 0 )
+            pos = GetSubtreeRowsEnd(siblings[index - 1]);
+        else
+            pos = parent->HasRow() ? parent->GetRow() + 1 : 0;
     }
-    else if (level == 0)
+    else // the root
     {
-        // a hidden root is not evaluated, but its
-        // children are always calculated
-        goto Recurse;
+        if ( HasFlag(wxTR_HIDE_ROOT) )
+            return;
+
+        pos = 0;
     }
 
-    item->CalculateSize(this, dc);
+    wxVector<wxGenericTreeItem *> rows;
+    AddShownSubtree(item, rows);
+    InsertRows(pos, rows);
+}
 
-    // set its position
-    item->SetX( x+m_spacing );
-    item->SetY( y );
-    y += GetLineHeight(item);
+void wxGenericTreeCtrl::RemoveItemRows(wxGenericTreeItem *item)
+{
+    if ( !ShouldUpdateRows() )
+        return;
 
-    if ( !item->IsExpanded() )
-    {
-        // we don't need to calculate collapsed branches
+    if ( item->HasRow() )
+        RemoveRows(item->GetRow(), GetSubtreeRowsEnd(item));
+    else if ( item == m_anchor )
+        RemoveRows(0, m_rows.size());
+}
+
+void wxGenericTreeCtrl::AddChildrenRows(wxGenericTreeItem *item)
+{
+    if ( !ShouldUpdateRows() || !AreChildrenShown(item) )
+        return;
+
+    wxVector<wxGenericTreeItem *> rows;
+    AddShownChildren(item, rows);
+    InsertRows(item->HasRow() ? item->GetRow() + 1 : 0, rows);
+}
+
+void wxGenericTreeCtrl::RemoveChildrenRows(wxGenericTreeItem *item)
+{
+    if ( !ShouldUpdateRows() || !AreChildrenShown(item) )
+        return;
+
+    RemoveRows(item->HasRow() ? item->GetRow() + 1 : 0,
+               GetSubtreeRowsEnd(item));
+}
+
+void wxGenericTreeCtrl::InvalidateRows()
+{
+    if ( m_rowsDirty )
+        return;
+
+    RemoveRows(0, m_rows.size());
+    m_rowsDirty = true;
+    m_positionsDirty = true;
+}
+
+void wxGenericTreeCtrl::UpdateRows()
+{
+    if ( !m_rowsDirty )
         return;
+
+    m_rowsDirty = false;
+
+    if ( !m_anchor )
+        return;
+
+    wxVector<wxGenericTreeItem *> rows;
+    if ( HasFlag(wxTR_HIDE_ROOT) )
+        AddShownChildren(m_anchor, rows);
+    else
+        AddShownSubtree(m_anchor, rows);
+
+    InsertRows(0, rows);
+}
+
+size_t wxGenericTreeCtrl::GetRowAtY(int y) const
+{
+    size_t lo = 0,
+           hi = m_rows.size();
+    while ( lo < hi )
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        wxGenericTreeItem * const item = m_rows[mid];
+        if ( item->GetY() + GetLineHeight(item) > y )
+            hi = mid;
+        else
+            lo = mid + 1;
     }
 
-  Recurse:
-    wxArrayGenericTreeItems& children = item->GetChildren();
-    size_t n, count = children.GetCount();
-    ++level;
-    for (n = 0; n < count; ++n )
-        CalculateLevel( children[n], dc, level, y );  // recurse
+    return lo;
 }
 
-void wxGenericTreeCtrl::CalculatePositions()
+wxGenericTreeItem *
+wxGenericTreeCtrl::HitTestRows(const wxPoint& point, int& flags) const
+{
+    if ( m_positionsDirty )
+        wxConstCast(this, wxGenericTreeCtrl)->CalculatePositions();
+
+    const size_t row = GetRowAtY(point.y);
+    if ( row == m_rows.size() )
+        return NULL;
+
+    return m_rows[row]->HitTest(point, this, flags);
+}
+
+void wxGenericTreeCtrl::CalculatePositions(wxDC *dc)
 {
     if ( !m_anchor ) return;
 
-    wxClientDC dc(this);
-    PrepareDC( dc );
+    UpdateRows();
 
-    dc.SetFont( m_normalFont );
+    // calculate the sizes of the new items first as this may change the line
+    // height and so the positions of all items
+    const size_t count = m_rows.size();
+    size_t first = 0;
+    while ( first < count && m_rows[first]->GetWidth() != 0 )
+        first++;
 
-    dc.SetPen( m_dottedPen );
-    //if(GetImageList() == NULL)
-    // m_lineHeight = (int)(dc.GetCharHeight() + 4);
+    if ( first < count )
+    {
+        wxScopedPtr<wxClientDC> dcClient;
+        if ( !dc )
+        {
+            dcClient.reset(new wxClientDC(this));
+            dcClient->SetFont( m_normalFont );
+            dc = dcClient.get();
+        }
+
+        for ( size_t n = first; n < count; n++ )
+            m_rows[n]->CalculateSize(this, *dc);
+    }
 
     int y = 2;
-    CalculateLevel( m_anchor, dc, 0, y ); // start recursion
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxGenericTreeItem * const item = m_rows[n];
+
+        // the parent row, if any, always precedes the rows of its children
+        wxGenericTreeItem * const parent = item->GetParent();
+        if ( parent && parent->HasRow() )
+            item->SetX( parent->GetX() + m_indent );
+        else
+            item->SetX( m_indent + m_spacing );
+
+        item->SetY( y );
+        y += GetLineHeight(item);
+    }
+
+    m_positionsDirty = false;
 }
 
 void wxGenericTreeCtrl::Refresh(bool eraseBackground, const wxRect *rect)
@@ -1233,6 +1233,7 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(NULL);
     cell->SetNext(NULL);
+    m_LastLayout = -1;
 }
 
 
@@ -317,6 +317,8 @@ void wxHtmlWindow::Init()
     m_HistoryOn = true;
     m_History = new wxHtmlHistoryArray;
     m_Processors = NULL;
+    m_incrementalAppend = false;
+    m_maxAppendedFragments = 0;
     SetBorders(10);
     m_selection = NULL;
     m_makingSelection = false;
@@ -417,7 +419,7 @@ void wxHtmlWindow::SetFonts(const wxString& normal_face, const wxString& fixed_f
     m_Parser->SetFonts(normal_face, fixed_face, sizes);
 
     // re-layout the page after changing fonts:
-    DoSetPage(*(m_Parser->GetSource()));
+    ReparsePage();
 }
 
 void wxHtmlWindow::SetStandardFonts(int size,
@@ -427,7 +429,7 @@ void wxHtmlWindow::SetStandardFonts(int size,
     m_Parser->SetStandardFonts(size, normal_face, fixed_face);
 
     // re-layout the page after changing fonts:
-    DoSetPage(*(m_Parser->GetSource()));
+    ReparsePage();
 }
 
 bool wxHtmlWindow::SetPage(const wxString& source)
@@ -438,16 +440,10 @@ bool wxHtmlWindow::SetPage(const wxString& source)
     return DoSetPage(source);
 }
 
-bool wxHtmlWindow::DoSetPage(const wxString& source)
+wxString wxHtmlWindow::ApplyProcessors(const wxString& source) const
 {
     wxString newsrc(source);
 
-    wxDELETE(m_selection);
-
-    // we will soon delete all the cells, so clear pointers to them:
-    m_tmpSelFromCell = NULL;
-
-    // pass HTML through registered processors:
     if (m_Processors || m_GlobalProcessors)
     {
         wxHtmlProcessorList::compatibility_iterator nodeL, nodeG;
@@ -482,11 +478,13 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
         }
     }
 
-    // ...and run the parser on it:
+    return newsrc;
+}
+
+wxHtmlContainerCell *wxHtmlWindow::ParseSource(const wxString& source)
+{
     wxClientDC dc(this);
     dc.SetMapMode(wxMM_TEXT);
-    SetBackgroundColour(wxColour(0xFF, 0xFF, 0xFF));
-    SetBackgroundImage(wxNullBitmap);
 
     double pixelScale = 1.0;
 #ifndef wxHAVE_DPI_INDEPENDENT_PIXELS
@@ -495,17 +493,41 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
 
     m_Parser->SetDC(&dc, pixelScale, 1.0);
 
+    wxHtmlContainerCell * const
+        cell = (wxHtmlContainerCell*) m_Parser->Parse(source);
+
+    // The parser doesn't need the DC any more, so ensure it's not left with a
+    // dangling pointer after the DC object goes out of scope.
+    m_Parser->SetDC(NULL);
+
+    return cell;
+}
+
+bool wxHtmlWindow::DoSetPage(const wxString& source)
+{
+    wxDELETE(m_selection);
+
+    // we will soon delete all the cells, so clear pointers to them:
+    m_tmpSelFromCell = NULL;
+    m_appendedSources.clear();
+    m_appendedCells.clear();
+
+    // pass HTML through registered processors and remember the result as the
+    // parser source only contains the last fragment after AppendToPage() in
+    // incremental mode:
+    m_pageSource = ApplyProcessors(source);
+
+    // ...and run the parser on it:
+    SetBackgroundColour(wxColour(0xFF, 0xFF, 0xFF));
+    SetBackgroundImage(wxNullBitmap);
+
     // notice that it's important to set m_Cell to NULL here before calling
     // Parse() below, even if it will be overwritten by its return value as
     // without this we may crash if it's used from inside Parse(), so use
     // wxDELETE() and not just delete here
     wxDELETE(m_Cell);
 
-    m_Cell = (wxHtmlContainerCell*) m_Parser->Parse(newsrc);
-
-    // The parser doesn't need the DC any more, so ensure it's not left with a
-    // dangling pointer after the DC object goes out of scope.
-    m_Parser->SetDC(NULL);
+    m_Cell = ParseSource(m_pageSource);
 
     m_Cell->SetIndent(m_Borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
     m_Cell->SetAlignHor(wxHTML_ALIGN_CENTER);
@@ -515,9 +537,114 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
     return true;
 }
 
+wxString wxHtmlWindow::GetPageSource() const
+{
+    wxString source(m_pageSource);
+    for ( size_t n = 0; n < m_appendedSources.size(); n++ )
+        source += m_appendedSources[n];
+
+    return source;
+}
+
+void wxHtmlWindow::ReparsePage()
+{
+    if ( m_appendedSources.empty() )
+    {
+        DoSetPage(m_pageSource);
+        return;
+    }
+
+    // DoSetPage() forgets about the appended fragments, so save them first
+    const wxString page(m_pageSource);
+    const wxArrayString fragments(m_appendedSources);
+
+    DoSetPage(page);
+
+    // and then append them again in the same way as they were added before
+    for ( size_t n = 0; n < fragments.size(); n++ )
+        DoAppendFragment(fragments[n]);
+
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+}
+
+void wxHtmlWindow::DoAppendFragment(const wxString& source)
+{
+    const wxString newsrc = ApplyProcessors(source);
+    wxHtmlContainerCell * const top = ParseSource(newsrc);
+
+    // move all the cells of the fragment to the end of the page, this
+    // preserves the layout of the existing cells, so only the new ones are
+    // laid out by CreateLayout() later
+    wxHtmlCell * const first = top->GetFirstChild();
+    while ( wxHtmlCell * const cell = top->GetFirstChild() )
+    {
+        top->Detach(cell);
+        m_Cell->InsertCell(cell);
+    }
+
+    delete top;
+
+    if ( !first )
+        return;
+
+    m_appendedSources.push_back(newsrc);
+    m_appendedCells.push_back(first);
+
+    if ( m_maxAppendedFragments )
+    {
+        while ( m_appendedCells.size() > m_maxAppendedFragments )
+            DropOldestFragment();
+    }
+}
+
+void wxHtmlWindow::DropOldestFragment()
+{
+    // the cells being deleted could be selected
+    wxDELETE(m_selection);
+    m_tmpSelFromCell = NULL;
+
+    wxHtmlCell * const
+        end = m_appendedCells.size() > 1 ? m_appendedCells[1] : NULL;
+    for ( wxHtmlCell *cell = m_appendedCells[0]; cell != end; )
+    {
+        wxHtmlCell * const next = cell->GetNext();
+        m_Cell->Detach(cell);
+        delete cell;
+        cell = next;
+    }
+
+    m_appendedSources.RemoveAt(0);
+    m_appendedCells.erase(m_appendedCells.begin());
+}
+
+void wxHtmlWindow::SetMaxAppendedFragments(size_t count)
+{
+    m_maxAppendedFragments = count;
+
+    if ( !count || m_appendedCells.size() <= count )
+        return;
+
+    while ( m_appendedCells.size() > count )
+        DropOldestFragment();
+
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+}
+
 bool wxHtmlWindow::AppendToPage(const wxString& source)
 {
-    return DoSetPage(*(GetParser()->GetSource()) + source);
+    if ( !m_incrementalAppend || !m_Cell )
+        return DoSetPage(GetPageSource() + source);
+
+    DoAppendFragment(source);
+
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+    return true;
 }
 
 bool wxHtmlWindow::LoadPage(const wxString& location)
@@ -1321,7 +1448,7 @@ void wxHtmlWindow::OnSize(wxSizeEvent& event)
 
 void wxHtmlWindow::OnDPIChanged(wxDPIChangedEvent& WXUNUSED(event))
 {
-    DoSetPage(*(m_Parser->GetSource()));
+    ReparsePage();
 }
 
 void wxHtmlWindow::OnMouseMove(wxMouseEvent& WXUNUSED(event))
@@ -1369,6 +1369,7 @@ size_t wxRichTextCompositeObject::AppendChild(wxRichTextObject* child)
 {
     m_children.Append(child);
     child->SetParent(this);
+    OnChildrenChanged();
     return m_children.GetCount() - 1;
 }
 
@@ -1383,6 +1384,7 @@ bool wxRichTextCompositeObject::InsertChild(wxRichTextObject* child, wxRichTextO
     else
         m_children.Insert(child);
     child->SetParent(this);
+    OnChildrenChanged();
 
     return true;
 }
@@ -1395,6 +1397,7 @@ bool wxRichTextCompositeObject::RemoveChild(wxRichTextObject* child, bool delete
     {
         wxRichTextObject* obj = node->GetData();
         m_children.Erase(node);
+        OnChildrenChanged();
         if (deleteChild)
             delete obj;
 
@@ -1418,6 +1421,8 @@ bool wxRichTextCompositeObject::DeleteChildren()
         m_children.Erase(oldNode);
     }
 
+    OnChildrenChanged();
+
     return true;
 }
 
@@ -1444,6 +1449,8 @@ void wxRichTextCompositeObject::Copy(const wxRichTextCompositeObject& obj)
 
         node = node->GetNext();
     }
+
+    OnChildrenChanged();
 }
 
 /// Hit-testing: returns a flag indicating hit test details, plus
@@ -1659,6 +1666,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
                         }
                         else
                             node = node->GetNext();
@@ -1705,6 +1713,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
 
                             // Don't set node -- we'll see if we can merge again with the next
                             // child. UNLESS we split this or the next child, in which case we know we have to
@@ -1743,6 +1752,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                 {
                     child->Dereference();
                     m_children.Erase(node);
+                    OnChildrenChanged();
                 }
                 node = next;
             }
@@ -2035,6 +2045,78 @@ void wxRichTextParagraphLayoutBox::UpdateRanges()
     CalculateRange(start, end);
 }
 
+void wxRichTextParagraphLayoutBox::CalculateRange(long start, long& end)
+{
+    wxRichTextCompositeObject::CalculateRange(start, end);
+
+    // The children may have changed too, as the ranges are always updated
+    // after doing it.
+    InvalidateChildIndex();
+}
+
+// Find the child containing the given position using binary search
+wxRichTextObject* wxRichTextParagraphLayoutBox::FindChildAtPosition(long pos) const
+{
+    const size_t count = m_children.GetCount();
+
+    // Check the number of children too to avoid using a stale index if
+    // the children were added or removed without updating the ranges.
+    if (m_childIndex.size() != count)
+    {
+        m_childIndex.clear();
+        m_childIndex.reserve(count);
+
+        wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+        while (node)
+        {
+            m_childIndex.push_back(node->GetData());
+            node = node->GetNext();
+        }
+    }
+
+    // Find the first child not ending before the position.
+    size_t lo = 0,
+           hi = count;
+    while (lo < hi)
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (m_childIndex[mid]->GetRange().GetEnd() < pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < count && m_childIndex[lo]->GetRange().Contains(pos))
+        return m_childIndex[lo];
+
+    return NULL;
+}
+
+void wxRichTextParagraphLayoutBox::ReplaceChildInIndex(wxRichTextObject* oldChild, wxRichTextObject* newChild)
+{
+    // Nothing to do if the index will be rebuilt anyhow.
+    if (m_childIndex.size() != m_children.GetCount())
+        return;
+
+    // Find the old child slot, it must be still valid at this point.
+    const long pos = oldChild->GetRange().GetStart();
+    size_t lo = 0,
+           hi = m_childIndex.size();
+    while (lo < hi)
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (m_childIndex[mid]->GetRange().GetEnd() < pos)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < m_childIndex.size() && m_childIndex[lo] == oldChild)
+        m_childIndex[lo] = newChild;
+    else
+        InvalidateChildIndex();
+}
+
 // HitTest
 int wxRichTextParagraphLayoutBox::HitTest(wxDC& dc, wxRichTextDrawingContext& context, const wxPoint& pt, long& textPosition, wxRichTextObject** obj, wxRichTextObject** contextObj, int flags)
 {
@@ -2576,27 +2658,8 @@ wxRichTextParagraph* wxRichTextParagraphLayoutBox::GetParagraphAtPosition(long p
     if (caretPosition)
         pos ++;
 
-    // First find the first paragraph whose starting position is within the range.
-    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
-    while (node)
-    {
-        // child is a paragraph
-        wxRichTextParagraph* child = wxDynamicCast(node->GetData(), wxRichTextParagraph);
-        // wxASSERT (child != NULL);
-
-        if (child)
-        {
-            // Return first child in buffer if position is -1
-            // if (pos == -1)
-            //    return child;
-
-            if (child->GetRange().Contains(pos))
-                return child;
-        }
-
-        node = node->GetNext();
-    }
-    return NULL;
+    // child is a paragraph
+    return wxDynamicCast(FindChildAtPosition(pos), wxRichTextParagraph);
 }
 
 /// Get the line at the given position
@@ -2605,46 +2668,40 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtPosition(long pos, bool c
     if (caretPosition)
         pos ++;
 
-    // First find the first paragraph whose starting position is within the range.
-    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
-    while (node)
+    // First find the paragraph containing this position.
+    wxRichTextParagraph* child = wxDynamicCast(FindChildAtPosition(pos), wxRichTextParagraph);
+    if (child)
     {
-        wxRichTextObject* obj = (wxRichTextObject*) node->GetData();
-        if (obj->GetRange().Contains(pos))
+        wxRichTextLineList::compatibility_iterator node2 = child->GetLines().GetFirst();
+        while (node2)
         {
-            // child is a paragraph
-            wxRichTextParagraph* child = wxDynamicCast(obj, wxRichTextParagraph);
-            // wxASSERT (child != NULL);
-
-            if (child)
-            {
-                wxRichTextLineList::compatibility_iterator node2 = child->GetLines().GetFirst();
-                while (node2)
-                {
-                    wxRichTextLine* line = node2->GetData();
+            wxRichTextLine* line = node2->GetData();
 
-                    wxRichTextRange range = line->GetAbsoluteRange();
+            wxRichTextRange range = line->GetAbsoluteRange();
 
-                    if (range.Contains(pos) ||
+            if (range.Contains(pos) ||
 
-                        // If the position is end-of-paragraph, then return the last line of
-                        // of the paragraph.
-                        ((range.GetEnd() == child->GetRange().GetEnd()-1) && (pos == child->GetRange().GetEnd())))
-                        return line;
+                // If the position is end-of-paragraph, then return the last line of
+                // of the paragraph.
+                ((range.GetEnd() == child->GetRange().GetEnd()-1) && (pos == child->GetRange().GetEnd())))
+                return line;
 
-                    node2 = node2->GetNext();
-                }
-            }
+            node2 = node2->GetNext();
         }
+    }
 
-        node = node->GetNext();
+    // Return the last line, without counting all the lines.
+    wxRichTextObjectList::compatibility_iterator node = m_children.GetLast();
+    while (node)
+    {
+        wxRichTextParagraph* para = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+        if (para && !para->GetLines().IsEmpty())
+            return para->GetLines().GetLast()->GetData();
+
+        node = node->GetPrevious();
     }
 
-    int lineCount = GetLineCount();
-    if (lineCount > 0)
-        return GetLineForVisibleLineNumber(lineCount-1);
-    else
-        return NULL;
+    return NULL;
 }
 
 /// Get the line at the given y pixel position, or the last line.
@@ -3314,6 +3371,7 @@ bool wxRichTextParagraphLayoutBox::DeleteRange(const wxRichTextRange& range)
 
                             wxRichTextObjectList::compatibility_iterator next1 = node1->GetNext();
                             nextParagraph->GetChildren().Erase(node1);
+                            nextParagraph->OnChildrenChanged();
 
                             node1 = next1;
                         }
@@ -4140,6 +4198,10 @@ void wxRichTextParagraphLayoutBox::Invalidate(const wxRichTextRange& invalidRang
     wxRichTextCompositeObject::Invalidate(invalidRange);
 
     DoInvalidate(invalidRange);
+
+    // Objects may have been replaced without changing the ranges.
+    if (invalidRange != wxRICHTEXT_NONE)
+        InvalidateChildIndex();
 }
 
 // Do the (in)validation for this object only
@@ -6224,6 +6286,7 @@ wxRichTextObject* wxRichTextParagraph::SplitAt(long pos, wxRichTextObject** prev
                 else
                     m_children.Append(newObject);
                 newObject->SetParent(this);
+                OnChildrenChanged();
 
                 if (previousObject)
                     *previousObject = child;
@@ -6254,6 +6317,8 @@ void wxRichTextParagraph::MoveToList(wxRichTextObject* obj, wxList& list)
 
         m_children.DeleteNode(oldNode);
     }
+
+    OnChildrenChanged();
 }
 
 /// Add content back from list
@@ -7682,6 +7747,8 @@ wxRichTextObject* wxRichTextPlainText::Split(wxRichTextDrawingContext& context)
                     }
                 }
 
+                parent->OnChildrenChanged();
+
                 return lastPlainText;
             }
         }
@@ -12037,6 +12104,8 @@ bool wxRichTextAction::Do()
                     {
                         wxRichTextObject* nodeObj = node->GetData();
                         node->SetData(m_object);
+                        parent->OnChildrenChanged();
+
                         m_object = nodeObj;
                     }
                 }
@@ -12406,7 +12475,10 @@ void wxRichTextAction::ApplyParagraphs(const wxRichTextParagraphLayoutBox& fragm
                 wxRichTextParagraph* newPara = new wxRichTextParagraph(*para);
                 newPara->SetParent(container);
 
+                // Update the index in place instead of just invalidating it
+                // as it's used for finding the next paragraph to replace.
                 bufferParaNode->SetData(newPara);
+                container->ReplaceChildInIndex(existingPara, newPara);
 
                 delete existingPara;
             }
@@ -34,6 +34,7 @@
 #include "wx/sizer.h"
 #include "wx/renderer.h"
 #include "wx/hashset.h"
+#include "wx/hashmap.h"
 #include "wx/dcclient.h"
 #include "wx/wupdlock.h"
 
@@ -102,6 +103,295 @@ namespace
 
 inline wxWindow* GETWIN(WindowID id) { return (wxWindow*)id; }
 
+#if wxUSE_UNICODE
+
+// Hash and equality functors for using std::string keys in wxHashMap.
+class wxStringBytesHash
+{
+public:
+    wxStringBytesHash() { }
+
+    unsigned long operator()(const std::string& s) const
+    {
+        // FNV-1a hash
+        unsigned long h = 2166136261u;
+        for ( size_t n = 0; n < s.length(); n++ )
+        {
+            h ^= static_cast<unsigned char>(s[n]);
+            h *= 16777619u;
+        }
+
+        return h;
+    }
+};
+
+class wxStringBytesEqual
+{
+public:
+    wxStringBytesEqual() { }
+
+    bool operator()(const std::string& a, const std::string& b) const
+    {
+        return a == b;
+    }
+};
+
+WX_DECLARE_HASH_MAP(std::string, wxVector<XYPOSITION>,
+                    wxStringBytesHash, wxStringBytesEqual,
+                    wxTextRunWidthsMap);
+
+WX_DECLARE_HASH_MAP(wxUint32, int,
+                    wxIntegerHash, wxIntegerEqual,
+                    wxCharWidthsMap);
+
+// Cache of the text measurements done by SurfaceImpl::MeasureWidths() for a
+// single font.
+//
+// For fixed width fonts, the widths of the individual characters are cached
+// and the positions are computed from them without measuring the text at all.
+// As this is only correct if the widths are integer, the characters for which
+// they are not, as well as the characters whose width may depend on their
+// neighbours, are never cached. For all fonts, the positions for the short
+// runs of text are cached too.
+//
+// The cache is associated with the font, so it's invalidated when the font
+// changes, which also happens when the DPI changes, but it is also cleared if
+// it is used with a DC using a different scale.
+class wxTextWidthsCache
+{
+public:
+    wxTextWidthsCache()
+        : m_scale(0.0),
+          m_fixedWidth(-1)
+    {
+        Clear();
+    }
+
+    // Fill the positions array with the cached measurements for the text and
+    // return true or return false if the text needs to be measured.
+    bool Get(wxDC& dc, const wxFont& font, const char* s, int len,
+             XYPOSITION* positions)
+    {
+        CheckScale(dc);
+
+        if ( m_fixedWidth == -1 )
+            m_fixedWidth = font.IsFixedWidth();
+
+        if ( m_fixedWidth && GetFromCharWidths(dc, s, len, positions) )
+            return true;
+
+        if ( len > MAX_RUN_LENGTH )
+            return false;
+
+        const wxTextRunWidthsMap::const_iterator
+            it = m_runs.find(std::string(s, len));
+        if ( it == m_runs.end() )
+            return false;
+
+        const wxVector<XYPOSITION>& widths = it->second;
+        for ( int i = 0; i < len; i++ )
+            positions[i] = widths[i];
+
+        return true;
+    }
+
+    // Store the result of measuring the given text, if it is short enough.
+    void Store(const char* s, int len, const XYPOSITION* positions)
+    {
+        if ( len > MAX_RUN_LENGTH )
+            return;
+
+        // don't let the cache grow indefinitely
+        if ( m_runs.size() >= MAX_RUNS_COUNT )
+            m_runs.clear();
+
+        m_runs[std::string(s, len)].assign(positions, positions + len);
+    }
+
+private:
+    // the longest run of text, in bytes, for which the positions are cached
+    enum { MAX_RUN_LENGTH = 64 };
+
+    // the maximal number of runs in the cache
+    enum { MAX_RUNS_COUNT = 4096 };
+
+    // the number of copies of the character used to check if its width is an
+    // integer, only the runs of up to half as many characters can be measured
+    // using the widths of the individual characters
+    enum { CHECK_COUNT = 256 };
+
+    // the values of m_asciiWidths elements which are not widths
+    enum
+    {
+        WIDTH_UNKNOWN = -1,
+        WIDTH_NOT_CACHEABLE = -2
+    };
+
+    void Clear()
+    {
+        for ( int n = 0; n < 128; n++ )
+            m_asciiWidths[n] = WIDTH_UNKNOWN;
+
+        m_charWidths.clear();
+        m_runs.clear();
+    }
+
+    void CheckScale(wxDC& dc)
+    {
+        double scaleX, scaleY;
+        dc.GetUserScale(&scaleX, &scaleY);
+
+        const double scale = dc.GetContentScaleFactor() * scaleX;
+        if ( scale != m_scale )
+        {
+            Clear();
+            m_scale = scale;
+        }
+    }
+
+    // Return true for the characters which always have the same width,
+    // whatever their neighbours are, in fixed width fonts.
+    static bool IsSimpleChar(wxUint32 c)
+    {
+        if ( c < 0x80 )
+            return c >= 0x20 && c < 0x7f;
+
+        // exclude the combining characters and the scripts using contextual
+        // forms, only keep Latin, Greek, Cyrillic, symbols and CJK
+        return (c >= 0xa0 && c < 0x300) ||
+               (c >= 0x370 && c < 0x483) ||
+               (c >= 0x48a && c < 0x530) ||
+               (c >= 0x1e00 && c < 0x2000) ||
+               (c >= 0x2010 && c < 0x2028) ||
+               (c >= 0x2030 && c < 0x2060) ||
+               (c >= 0x20a0 && c < 0x20d0) ||
+               (c >= 0x2100 && c < 0x2e00) ||
+               (c >= 0x3040 && c < 0x3099) ||
+               (c >= 0x309b && c < 0xa000) ||
+               (c >= 0xac00 && c < 0xd7a4) ||
+               (c >= 0xff01 && c < 0xff61);
+    }
+
+    // Return the cached width of the character, measuring it if necessary,
+    // or WIDTH_NOT_CACHEABLE.
+    int GetCharWidth(wxDC& dc, wxUint32 c)
+    {
+        int* width;
+        if ( c < 0x80 )
+        {
+            width = &m_asciiWidths[c];
+        }
+        else
+        {
+            wxCharWidthsMap::iterator it = m_charWidths.find(c);
+            if ( it != m_charWidths.end() )
+                return it->second;
+
+            width = &m_charWidths[c];
+            *width = WIDTH_UNKNOWN;
+        }
+
+        if ( *width == WIDTH_UNKNOWN )
+        {
+            *width = WIDTH_NOT_CACHEABLE;
+
+            if ( IsSimpleChar(c) )
+            {
+                wxArrayInt widths;
+                dc.GetPartialTextExtents(wxString(wxUniChar(c), CHECK_COUNT),
+                                         widths);
+                if ( widths.size() == CHECK_COUNT &&
+                        widths[0] > 0 &&
+                            widths[CHECK_COUNT - 1] == CHECK_COUNT*widths[0] )
+                {
+                    *width = widths[0];
+                }
+            }
+        }
+
+        return *width;
+    }
+
+    bool GetFromCharWidths(wxDC& dc, const char* s, int len,
+                           XYPOSITION* positions)
+    {
+        const unsigned char* const p = reinterpret_cast<const unsigned char*>(s);
+
+        int pos = 0;
+        int count = 0;
+        for ( int i = 0; i < len; count++ )
+        {
+            if ( count == CHECK_COUNT / 2 )
+                return false;
+
+            // decode the next character, we only handle the characters from
+            // the BMP here, longer sequences are left for the generic code
+            wxUint32 c = p[i];
+            int n = 1;
+            if ( c >= 0x80 )
+            {
+                if ( c >= 0xc2 && c < 0xe0 )
+                {
+                    n = 2;
+                    c &= 0x1f;
+                }
+                else if ( c >= 0xe0 && c < 0xf0 )
+                {
+                    n = 3;
+                    c &= 0x0f;
+                }
+                else
+                {
+                    return false;
+                }
+
+                if ( i + n > len )
+                    return false;
+
+                for ( int k = 1; k < n; k++ )
+                {
+                    if ( (p[i + k] & 0xc0) != 0x80 )
+                        return false;
+
+                    c = (c << 6) | (p[i + k] & 0x3f);
+                }
+
+                // reject overlong sequences and surrogates
+                if ( n == 3 && (c < 0x800 || (c >= 0xd800 && c < 0xe000)) )
+                    return false;
+            }
+
+            const int width = GetCharWidth(dc, c);
+            if ( width == WIDTH_NOT_CACHEABLE )
+                return false;
+
+            // all bytes of the character get the position of its end
+            pos += width;
+            for ( int k = 0; k < n; k++ )
+                positions[i++] = pos;
+        }
+
+        return true;
+    }
+
+    // the scale for which the widths were measured
+    double m_scale;
+
+    // 1 if the font is fixed width, 0 if it isn't or -1 if not checked yet
+    int m_fixedWidth;
+
+    // the widths of ASCII characters, used for fixed width fonts only
+    int m_asciiWidths[128];
+
+    // the widths of the other characters, also only for fixed width fonts
+    wxCharWidthsMap m_charWidths;
+
+    // the positions for the short runs of text
+    wxTextRunWidthsMap m_runs;
+};
+
+#endif // wxUSE_UNICODE
+
 // wxFont with ascent cached, a pointer to this type is stored in Font::fid.
 class wxFontWithAscent : public wxFont
 {
@@ -129,9 +419,17 @@ public:
     SurfaceData* GetSurfaceFontData() const { return m_surfaceFontData; }
     void SetSurfaceFontData(SurfaceData* data) { m_surfaceFontData=data; }
 
+#if wxUSE_UNICODE
+    wxTextWidthsCache& GetWidthsCache() { return m_widthsCache; }
+#endif // wxUSE_UNICODE
+
 private:
     int m_ascent;
     SurfaceData* m_surfaceFontData;
+
+#if wxUSE_UNICODE
+    wxTextWidthsCache m_widthsCache;
+#endif // wxUSE_UNICODE
 };
 
 void SetAscent(Font& f, int ascent)
@@ -611,11 +909,22 @@ void SurfaceImpl::DrawTextTransparent(PRectangle rc, Font &font, XYPOSITION ybas
 
 void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *positions) {
 
+    SetFont(font);
+
+#if wxUSE_UNICODE
+    // Measuring the text is slow, so try to reuse the previous measurements.
+    wxTextWidthsCache* cache = NULL;
+    if ( font.GetID() ) {
+        wxFontWithAscent* const f = wxFontWithAscent::FromFID(font.GetID());
+        cache = &f->GetWidthsCache();
+        if ( cache->Get(*hdc, *f, s, len, positions) )
+            return;
+    }
+#endif // wxUSE_UNICODE
+
     wxString   str = stc2wx(s, len);
     wxArrayInt tpos;
 
-    SetFont(font);
-
     hdc->GetPartialTextExtents(str, tpos);
 
 #if wxUSE_UNICODE
@@ -645,6 +954,9 @@ void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *
         if (c >= 0x10000)
             positions[utf8i++] = tpos[wxi];
     }
+
+    if ( cache && utf8i == static_cast<size_t>(len) )
+        cache->Store(s, len, positions);
 #else // !wxUSE_UNICODE
     // If not unicode then just use the widths we have
     for (int i = 0; i < len; i++) {
@@ -76,11 +76,51 @@ private:
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// wxDirData
+// helper functions
 // ----------------------------------------------------------------------------
 
 #if !defined( __VMS__ ) || ( __VMS_VER >= 70000000 )
 
+// return true if the directory entry with the given full path is a directory
+static bool IsDirEntry(const dirent *de, const wxString& path, bool followLinks)
+{
+#ifdef DT_DIR
+    // avoid calling stat() for each entry if we can: d_type is filled in by
+    // most of the file systems, but not all of them
+    switch ( de->d_type )
+    {
+        case DT_DIR:
+            return true;
+
+        case DT_LNK:
+            // we need to check what the link points to
+            if ( !followLinks )
+                return false;
+            break;
+
+        case DT_UNKNOWN:
+            break;
+
+        default:
+            return false;
+    }
+#else // !DT_DIR
+    wxUnusedVar(de);
+#endif // DT_DIR/!DT_DIR
+
+    wxFileName fn = wxFileName::DirName(path);
+    if ( !followLinks )
+    {
+        fn.DontFollowLink();
+    }
+
+    return fn.DirExists();
+}
+
+// ----------------------------------------------------------------------------
+// wxDirData
+// ----------------------------------------------------------------------------
+
 wxDirData::wxDirData(const wxString& dirname)
          : m_dirname(dirname)
 {
@@ -112,9 +152,6 @@ wxDirData::~wxDirData()
 
 bool wxDirData::Read(wxString *filename)
 {
-    dirent *de = NULL;    // just to silence compiler warnings
-    bool matches = false;
-
     // speed up string concatenation in the loop a bit
     wxString path = m_dirname;
     path += wxT('/');
@@ -122,9 +159,9 @@ bool wxDirData::Read(wxString *filename)
 
     wxString de_d_name;
 
-    while ( !matches )
+    for ( ;; )
     {
-        de = readdir(m_dir);
+        const dirent * const de = readdir(m_dir);
         if ( !de )
             return false;
 
@@ -146,36 +183,42 @@ bool wxDirData::Read(wxString *filename)
             break;
         }
 
-        // check the type now: notice that we may want to check the type of
-        // the path itself and not whatever it points to in case of a symlink
-        wxFileName fn = wxFileName::DirName(path + de_d_name);
-        if ( m_flags & wxDIR_NO_FOLLOW )
-        {
-            fn.DontFollowLink();
-        }
-
-        if ( !(m_flags & wxDIR_FILES) && !fn.DirExists() )
-        {
-            // it's a file, but we don't want them
-            continue;
-        }
-        else if ( !(m_flags & wxDIR_DIRS) && fn.DirExists() )
-        {
-            // it's a dir, and we don't want it
-            continue;
-        }
-
-        // finally, check the name
+        // check the name first as it's cheaper than checking the type
         if ( m_filespec.empty() )
         {
-            matches = m_flags & wxDIR_HIDDEN ? true : de->d_name[0] != '.';
+            if ( !(m_flags & wxDIR_HIDDEN) && de->d_name[0] == '.' )
+                continue;
         }
         else
         {
             // test against the pattern
-            matches = wxMatchWild(m_filespec, de_d_name,
-                                  !(m_flags & wxDIR_HIDDEN));
+            if ( !wxMatchWild(m_filespec, de_d_name,
+                              !(m_flags & wxDIR_HIDDEN)) )
+                continue;
         }
+
+        // check the type now if we need it: notice that we may want to check
+        // the type of the path itself and not whatever it points to in case of
+        // a symlink
+        if ( (m_flags & (wxDIR_FILES | wxDIR_DIRS)) != (wxDIR_FILES | wxDIR_DIRS) )
+        {
+            const bool isDir = IsDirEntry(de, path + de_d_name,
+                                          !(m_flags & wxDIR_NO_FOLLOW));
+
+            if ( !(m_flags & wxDIR_FILES) && !isDir )
+            {
+                // it's a file, but we don't want them
+                continue;
+            }
+            else if ( !(m_flags & wxDIR_DIRS) && isDir )
+            {
+                // it's a dir, and we don't want it
+                continue;
+            }
+        }
+
+        // we found a valid match
+        break;
     }
 
     *filename = de_d_name;
@@ -38,12 +38,12 @@
 
 #include "wx/unix/private/timer.h"
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxTimerList)
-
 // trace mask for the debugging messages used here
 #define wxTrace_Timer wxT("timer")
 
+// value of wxUnixTimerImpl::GetSchedulerIndex() for the timers not in the heap
+static const size_t wxNOT_SCHEDULED = static_cast<size_t>(-1);
+
 // ============================================================================
 // wxTimerScheduler implementation
 // ============================================================================
@@ -52,56 +52,93 @@ wxTimerScheduler *wxTimerScheduler::ms_instance = NULL;
 
 wxTimerScheduler::~wxTimerScheduler()
 {
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    for ( size_t n = 0; n < m_timers.size(); n++ )
+        m_timers[n].m_timer->SetSchedulerIndex(wxNOT_SCHEDULED);
+}
+
+void wxTimerScheduler::MoveUp(size_t n)
+{
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
     {
-        delete *node;
+        const size_t parent = (n - 1) / 2;
+        if ( !s.IsBefore(m_timers[parent]) )
+            break;
+
+        SetAt(n, m_timers[parent]);
+        n = parent;
     }
+
+    SetAt(n, s);
 }
 
-void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+void wxTimerScheduler::MoveDown(size_t n)
 {
-    DoAddTimer(new wxTimerSchedule(timer, expiration));
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
+    {
+        size_t child = 2*n + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count && m_timers[child + 1].IsBefore(m_timers[child]) )
+            child++;
+
+        if ( !m_timers[child].IsBefore(s) )
+            break;
+
+        SetAt(n, m_timers[child]);
+        n = child;
+    }
+
+    SetAt(n, s);
 }
 
-void wxTimerScheduler::DoAddTimer(wxTimerSchedule *s)
+void wxTimerScheduler::RemoveAt(size_t n)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
+    m_timers[n].m_timer->SetSchedulerIndex(wxNOT_SCHEDULED);
+
+    // replace the removed timer with the last one and restore the heap order
+    const size_t last = m_timers.size() - 1;
+    if ( n != last )
     {
-        wxASSERT_MSG( (*node)->m_timer != s->m_timer,
-                      wxT("adding the same timer twice?") );
+        SetAt(n, m_timers[last]);
+        m_timers.pop_back();
 
-        if ( (*node)->m_expiration > s->m_expiration )
-            break;
+        if ( n > 0 && m_timers[n].IsBefore(m_timers[(n - 1) / 2]) )
+            MoveUp(n);
+        else
+            MoveDown(n);
+    }
+    else
+    {
+        m_timers.pop_back();
     }
+}
 
-    m_timers.insert(node, s);
+void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+{
+    wxASSERT_MSG( timer->GetSchedulerIndex() == wxNOT_SCHEDULED,
+                  wxT("adding the same timer twice?") );
+
+    m_timers.push_back(wxTimerSchedule(timer, expiration, m_nextOrder++));
+    MoveUp(m_timers.size() - 1);
 
     wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
-               s->m_timer->GetId(),
-               s->m_expiration.ToString());
+               timer->GetId(),
+               expiration.ToString());
 }
 
 void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
-    {
-        if ( (*node)->m_timer == timer )
-        {
-            delete *node;
-            m_timers.erase(node);
-            return;
-        }
-    }
+    const size_t n = timer->GetSchedulerIndex();
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    RemoveAt(n);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -111,7 +148,7 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("NULL pointer") );
 
-    *remaining = (*m_timers.begin())->m_expiration - wxGetUTCTimeUSec();
+    *remaining = m_timers[0].m_expiration - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -128,35 +165,35 @@ bool wxTimerScheduler::NotifyExpired()
 
     const wxUsecClock_t now = wxGetUTCTimeUSec();
 
+    // take all the expired timers from the heap at once, in expiration order
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() && m_timers[0].m_expiration <= now )
     {
-        wxTimerSchedule * const s = *cur;
-        if ( s->m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
+        wxUnixTimerImpl * const timer = m_timers[0].m_timer;
+        RemoveAt(0);
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
+        toNotify.push_back(timer);
+    }
 
-        m_timers.erase(cur);
+    if ( toNotify.empty() )
+        return false;
 
-        // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s->m_timer;
+    // check whether we need to keep these timers: notice that we only do it
+    // once all the expired ones have been removed, as otherwise a periodic
+    // timer with (almost) zero interval could be found again in the loop above
+    for ( TimerImpls::const_iterator i = toNotify.begin(),
+                                     end = toNotify.end();
+          i != end;
+          ++i )
+    {
+        wxUnixTimerImpl * const timer = *i;
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
-
-            // don't need it any more
-            delete s;
         }
         else // reschedule the next timer expiration
         {
@@ -164,20 +201,13 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s->m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            AddTimer(timer, now + timer->GetInterval()*1000);
         }
-
-        // we can't notify the timer from this loop as the timer event handler
-        // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
-        toNotify.push_back(timer);
     }
 
-    if ( toNotify.empty() )
-        return false;
-
+    // we can't notify the timers from the loops above as the timer event
+    // handler could modify m_timers (for example, but not only, by stopping
+    // this timer), so do it only now
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
@@ -197,6 +227,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_schedulerIndex = wxNOT_SCHEDULED;
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
@@ -27,6 +27,8 @@
 #include "wx/strconv.h"
 #include "wx/scopedptr.h"
 #include "wx/versioninfo.h"
+#include "wx/tokenzr.h"
+#include "wx/vector.h"
 
 #include "expat.h" // from Expat
 
@@ -955,6 +957,612 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
 
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlReader
+//-----------------------------------------------------------------------------
+
+// An item produced by the parser and returned by wxXmlReader.
+struct wxXmlReaderItem
+{
+    wxXmlReaderItem()
+        : event(wxXML_EVENT_EOF), attrsCount(0), depth(0), lineNo(-1)
+    {
+    }
+
+    wxXmlReaderEvent event;
+    wxString name;
+    wxString content;
+    wxVector<wxString> attrs;           // names and values, alternating
+    size_t attrsCount;
+    int depth;
+    int lineNo;
+};
+
+// The parser is fed the input in chunks and the items produced by the
+// handlers for each chunk are queued and then returned by Advance() one by
+// one, so that the memory used doesn't depend on the document size.
+//
+// Notice that the items in the queue are reused for the next chunk to avoid
+// allocating memory for them, and their strings, again.
+class wxXmlReaderImpl
+{
+public:
+    wxXmlReaderImpl(wxInputStream& stream, int flags, const wxString& encoding);
+    ~wxXmlReaderImpl();
+
+    // Make the next item current, parsing more input if necessary.
+    wxXmlReaderEvent Advance();
+
+    // Skip everything until the end of the element started at the given depth
+    // which must still be open.
+    void StartSkipping(int depth);
+
+    // Add a new item to the queue, after the pending text, if any.
+    wxXmlReaderItem& AddItem(wxXmlReaderEvent event, int depth);
+
+    // Add the pending text to the queue as a text or CDATA item.
+    void FlushText();
+
+    int GetLineNumber() const
+        { return static_cast<int>(XML_GetCurrentLineNumber(m_parser)); }
+
+    XML_Parser m_parser;
+    wxInputStream& m_stream;
+    wxMBConv *m_conv;
+    const bool m_removeWhiteOnlyNodes;
+
+    // The current item, either one of m_items elements or m_eof.
+    const wxXmlReaderItem *m_current;
+    wxXmlReaderItem m_eof;
+
+    // The items queue: only the first m_itemsCount items are valid.
+    wxVector<wxXmlReaderItem> m_items;
+    size_t m_itemsCount;
+    size_t m_nextItem;
+
+    // The text not yet added to the queue, in UTF-8, as it may be split over
+    // several calls to the text handler.
+    wxMemoryBuffer m_text;
+    int m_textLineNo;
+    bool m_inCdata;
+
+    // Depth of the element being parsed.
+    int m_depth;
+
+    // If non-zero, the depth of the element whose contents are being skipped.
+    int m_skipDepth;
+
+    // The names of the elements containing the current item.
+    wxVector<wxString> m_path;
+
+    // The last path passed to FindElement() and its components.
+    wxString m_findPath;
+    wxArrayString m_findComponents;
+
+    bool m_done;
+    bool m_error;
+
+private:
+    // Feed the next chunk of input to the parser.
+    void ParseChunk();
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReaderImpl);
+};
+
+wxXmlReaderItem& wxXmlReaderImpl::AddItem(wxXmlReaderEvent event, int depth)
+{
+    FlushText();
+
+    if ( m_itemsCount == m_items.size() )
+        m_items.resize(m_itemsCount + 1);
+
+    wxXmlReaderItem& item = m_items[m_itemsCount++];
+    item.event = event;
+    item.attrsCount = 0;
+    item.depth = depth;
+    item.lineNo = GetLineNumber();
+
+    return item;
+}
+
+void wxXmlReaderImpl::FlushText()
+{
+    const size_t len = m_text.GetDataLen();
+    if ( !len && !m_inCdata )
+        return;
+
+    const char * const s = static_cast<const char *>(m_text.GetData());
+    if ( !m_inCdata && m_removeWhiteOnlyNodes )
+    {
+        size_t n;
+        for ( n = 0; n < len; n++ )
+        {
+            const char c = s[n];
+            if ( c != ' ' && c != '\t' && c != '\n' && c != '\r' )
+                break;
+        }
+
+        if ( n == len )
+        {
+            m_text.SetDataLen(0);
+            return;
+        }
+    }
+
+    if ( m_itemsCount == m_items.size() )
+        m_items.resize(m_itemsCount + 1);
+
+    wxXmlReaderItem& item = m_items[m_itemsCount++];
+    item.event = m_inCdata ? wxXML_EVENT_CDATA : wxXML_EVENT_TEXT;
+    item.name = m_inCdata ? wxS("cdata") : wxS("text");
+    item.content = CharToString(m_conv, s, len);
+    item.attrsCount = 0;
+    item.depth = m_depth;
+    item.lineNo = m_textLineNo;
+
+    m_text.SetDataLen(0);
+    m_inCdata = false;
+}
+
+extern "C" {
+static void ReaderStartElementHnd(void *userData, const char *name, const char **atts)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    ctx->m_depth++;
+    if ( ctx->m_skipDepth )
+        return;
+
+    wxXmlReaderItem& item = ctx->AddItem(wxXML_EVENT_START_ELEMENT, ctx->m_depth);
+    item.name = CharToString(ctx->m_conv, name);
+
+    size_t n = 0;
+    for ( const char **a = atts; *a; a++, n++ )
+    {
+        if ( n == item.attrs.size() )
+            item.attrs.push_back(CharToString(ctx->m_conv, *a));
+        else
+            item.attrs[n] = CharToString(ctx->m_conv, *a);
+    }
+
+    item.attrsCount = n / 2;
+}
+
+static void ReaderEndElementHnd(void *userData, const char *name)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+    {
+        if ( ctx->m_depth-- != ctx->m_skipDepth )
+            return;
+
+        ctx->m_skipDepth = 0;
+        ctx->m_depth++;
+    }
+
+    // notice that the depth must be updated only after adding the item as
+    // any pending text is flushed at the current depth
+    wxXmlReaderItem& item = ctx->AddItem(wxXML_EVENT_END_ELEMENT, ctx->m_depth);
+    item.name = CharToString(ctx->m_conv, name);
+
+    ctx->m_depth--;
+}
+
+static void ReaderTextHnd(void *userData, const char *s, int len)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+        return;
+
+    if ( !ctx->m_text.GetDataLen() && !ctx->m_inCdata )
+        ctx->m_textLineNo = ctx->GetLineNumber();
+
+    ctx->m_text.AppendData(s, len);
+}
+
+static void ReaderStartCdataHnd(void *userData)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+        return;
+
+    ctx->FlushText();
+    ctx->m_inCdata = true;
+    ctx->m_textLineNo = ctx->GetLineNumber();
+}
+
+static void ReaderEndCdataHnd(void *userData)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+        return;
+
+    // this adds the CDATA item even if it's empty, as wxXmlDocument does
+    ctx->FlushText();
+}
+
+static void ReaderCommentHnd(void *userData, const char *data)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+        return;
+
+    wxXmlReaderItem& item = ctx->AddItem(wxXML_EVENT_COMMENT, ctx->m_depth);
+    item.name = wxS("comment");
+    item.content = CharToString(ctx->m_conv, data);
+}
+
+static void ReaderPIHnd(void *userData, const char *target, const char *data)
+{
+    wxXmlReaderImpl *ctx = (wxXmlReaderImpl*)userData;
+
+    if ( ctx->m_skipDepth )
+        return;
+
+    wxXmlReaderItem& item = ctx->AddItem(wxXML_EVENT_PI, ctx->m_depth);
+    item.name = CharToString(ctx->m_conv, target);
+    item.content = CharToString(ctx->m_conv, data);
+}
+} // extern "C"
+
+wxXmlReaderImpl::wxXmlReaderImpl(wxInputStream& stream,
+                                 int flags,
+                                 const wxString& encoding)
+    : m_stream(stream),
+      m_removeWhiteOnlyNodes((flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0)
+{
+    m_conv = NULL;
+#if wxUSE_UNICODE
+    wxUnusedVar(encoding);
+#else
+    if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
+        m_conv = new wxCSConv(encoding);
+#endif
+
+    m_current = &m_eof;
+    m_itemsCount =
+    m_nextItem = 0;
+    m_textLineNo = -1;
+    m_inCdata = false;
+    m_depth =
+    m_skipDepth = 0;
+    m_done =
+    m_error = false;
+
+    m_parser = XML_ParserCreate(NULL);
+    XML_SetUserData(m_parser, this);
+    XML_SetElementHandler(m_parser, ReaderStartElementHnd, ReaderEndElementHnd);
+    XML_SetCharacterDataHandler(m_parser, ReaderTextHnd);
+    XML_SetCdataSectionHandler(m_parser, ReaderStartCdataHnd, ReaderEndCdataHnd);
+    XML_SetCommentHandler(m_parser, ReaderCommentHnd);
+    XML_SetProcessingInstructionHandler(m_parser, ReaderPIHnd);
+    XML_SetUnknownEncodingHandler(m_parser, UnknownEncodingHnd, NULL);
+}
+
+wxXmlReaderImpl::~wxXmlReaderImpl()
+{
+    XML_ParserFree(m_parser);
+    delete m_conv;
+}
+
+void wxXmlReaderImpl::ParseChunk()
+{
+    const size_t BUFSIZE = 16384;
+
+    void * const buf = XML_GetBuffer(m_parser, BUFSIZE);
+    size_t len = 0;
+    if ( buf )
+        len = m_stream.Read(buf, BUFSIZE).LastRead();
+
+    const bool last = len < BUFSIZE;
+    if ( !buf || !XML_ParseBuffer(m_parser, len, last) )
+    {
+        wxString error(XML_ErrorString(XML_GetErrorCode(m_parser)),
+                       *wxConvCurrent);
+        wxLogError(_("XML parsing error: '%s' at line %d"),
+                   error.c_str(),
+                   GetLineNumber());
+        m_error = true;
+        m_done = true;
+    }
+    else if ( last )
+    {
+        FlushText();
+        m_done = true;
+    }
+}
+
+wxXmlReaderEvent wxXmlReaderImpl::Advance()
+{
+    if ( m_current->event == wxXML_EVENT_END_ELEMENT )
+        m_path.pop_back();
+
+    if ( m_nextItem == m_itemsCount )
+    {
+        // all the items were consumed, so they can be reused
+        m_itemsCount =
+        m_nextItem = 0;
+
+        while ( !m_itemsCount && !m_done )
+            ParseChunk();
+    }
+
+    if ( m_nextItem < m_itemsCount )
+    {
+        m_current = &m_items[m_nextItem++];
+
+        if ( m_current->event == wxXML_EVENT_START_ELEMENT )
+            m_path.push_back(m_current->name);
+    }
+    else
+    {
+        m_current = &m_eof;
+    }
+
+    return m_current->event;
+}
+
+void wxXmlReaderImpl::StartSkipping(int depth)
+{
+    wxASSERT( m_nextItem == m_itemsCount );
+    wxASSERT( m_depth >= depth );
+
+    // any pending text is inside the element being skipped
+    m_text.SetDataLen(0);
+    m_inCdata = false;
+
+    // the items inside the element which were already returned may have been
+    // the starts of elements whose ends will never be, so drop their names
+    m_path.resize(depth);
+    m_current = &m_eof;
+
+    m_skipDepth = depth;
+}
+
+wxXmlReader::wxXmlReader(wxInputStream& stream,
+                         int flags,
+                         const wxString& encoding)
+    : m_impl(new wxXmlReaderImpl(stream, flags, encoding))
+{
+}
+
+wxXmlReader::~wxXmlReader()
+{
+    delete m_impl;
+}
+
+wxXmlReaderEvent wxXmlReader::Next()
+{
+    return m_impl->Advance();
+}
+
+wxXmlReaderEvent wxXmlReader::GetEvent() const
+{
+    return m_impl->m_current->event;
+}
+
+bool wxXmlReader::HasError() const
+{
+    return m_impl->m_error;
+}
+
+const wxString& wxXmlReader::GetName() const
+{
+    return m_impl->m_current->name;
+}
+
+const wxString& wxXmlReader::GetContent() const
+{
+    return m_impl->m_current->content;
+}
+
+size_t wxXmlReader::GetAttributesCount() const
+{
+    return m_impl->m_current->attrsCount;
+}
+
+const wxString& wxXmlReader::GetAttributeName(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributesCount(), m_impl->m_eof.name,
+                 wxS("invalid attribute index") );
+
+    return m_impl->m_current->attrs[2*n];
+}
+
+const wxString& wxXmlReader::GetAttributeValue(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributesCount(), m_impl->m_eof.name,
+                 wxS("invalid attribute index") );
+
+    return m_impl->m_current->attrs[2*n + 1];
+}
+
+bool wxXmlReader::GetAttribute(const wxString& attrName, wxString *value) const
+{
+    const size_t count = GetAttributesCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( m_impl->m_current->attrs[2*n] == attrName )
+        {
+            if ( value )
+                *value = m_impl->m_current->attrs[2*n + 1];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+wxString
+wxXmlReader::GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal) const
+{
+    wxString tmp;
+    return GetAttribute(attrName, &tmp) ? tmp : defaultVal;
+}
+
+bool wxXmlReader::HasAttribute(const wxString& attrName) const
+{
+    return GetAttribute(attrName, NULL);
+}
+
+int wxXmlReader::GetDepth() const
+{
+    return m_impl->m_current->depth;
+}
+
+int wxXmlReader::GetLineNumber() const
+{
+    return m_impl->m_current->lineNo;
+}
+
+bool wxXmlReader::SkipElement()
+{
+    wxCHECK_MSG( GetEvent() == wxXML_EVENT_START_ELEMENT, false,
+                 wxS("must be called at the start of an element") );
+
+    const int depth = GetDepth();
+
+    // the end of the element may be already in the queue
+    while ( m_impl->m_nextItem < m_impl->m_itemsCount )
+    {
+        if ( Next() == wxXML_EVENT_END_ELEMENT && GetDepth() == depth )
+            return true;
+    }
+
+    // if not, avoid creating the items for its contents entirely
+    if ( !m_impl->m_done )
+    {
+        m_impl->StartSkipping(depth);
+
+        if ( Next() == wxXML_EVENT_END_ELEMENT )
+            return true;
+    }
+
+    return false;
+}
+
+wxXmlNode *wxXmlReader::ReadElement()
+{
+    wxCHECK_MSG( GetEvent() == wxXML_EVENT_START_ELEMENT, NULL,
+                 wxS("must be called at the start of an element") );
+
+    const int depth = GetDepth();
+
+    wxXmlNode * const root = new wxXmlNode(wxXML_ELEMENT_NODE, GetName(),
+                                           wxEmptyString, GetLineNumber());
+    const size_t count = GetAttributesCount();
+    for ( size_t n = 0; n < count; n++ )
+        root->AddAttribute(GetAttributeName(n), GetAttributeValue(n));
+
+    wxXmlNode *parent = root;
+    wxXmlNode *lastChild = NULL;
+    for ( ;; )
+    {
+        wxXmlNode *node;
+        switch ( Next() )
+        {
+            case wxXML_EVENT_START_ELEMENT:
+                node = new wxXmlNode(wxXML_ELEMENT_NODE, GetName(),
+                                     wxEmptyString, GetLineNumber());
+                for ( size_t n = 0; n < GetAttributesCount(); n++ )
+                    node->AddAttribute(GetAttributeName(n), GetAttributeValue(n));
+
+                parent->InsertChildAfter(node, lastChild);
+                parent = node;
+                lastChild = NULL;
+                continue;
+
+            case wxXML_EVENT_END_ELEMENT:
+                if ( GetDepth() == depth )
+                    return root;
+
+                lastChild = parent;
+                parent = parent->GetParent();
+                continue;
+
+            case wxXML_EVENT_TEXT:
+                node = new wxXmlNode(wxXML_TEXT_NODE, GetName(),
+                                     GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_EVENT_CDATA:
+                node = new wxXmlNode(wxXML_CDATA_SECTION_NODE, GetName(),
+                                     GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_EVENT_COMMENT:
+                node = new wxXmlNode(wxXML_COMMENT_NODE, GetName(),
+                                     GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_EVENT_PI:
+                node = new wxXmlNode(wxXML_PI_NODE, GetName(),
+                                     GetContent(), GetLineNumber());
+                break;
+
+            case wxXML_EVENT_EOF:
+            default:
+                delete root;
+                return NULL;
+        }
+
+        parent->InsertChildAfter(node, lastChild);
+        lastChild = node;
+    }
+}
+
+bool wxXmlReader::FindElement(const wxString& path)
+{
+    // this function is typically called in a loop with the same path, so
+    // avoid splitting it every time
+    wxArrayString& components = m_impl->m_findComponents;
+    if ( path != m_impl->m_findPath )
+    {
+        components = wxStringTokenize(path, wxS("/"), wxTOKEN_STRTOK);
+        m_impl->m_findPath = path;
+    }
+
+    const size_t count = components.size();
+    wxCHECK_MSG( count, false, wxS("empty path") );
+
+    const wxVector<wxString>& current = m_impl->m_path;
+    while ( Next() != wxXML_EVENT_EOF )
+    {
+        if ( GetEvent() != wxXML_EVENT_START_ELEMENT )
+            continue;
+
+        // check if the path of this element is the searched for path or a
+        // prefix of it and skip it entirely if it isn't
+        const size_t depth = current.size();
+        bool matches = depth <= count;
+        for ( size_t n = 0; matches && n < depth; n++ )
+        {
+            if ( components[n] != wxS("*") && components[n] != current[n] )
+                matches = false;
+        }
+
+        if ( !matches )
+        {
+            if ( !SkipElement() )
+                break;
+        }
+        else if ( depth == count )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlDocument saving routines
 //-----------------------------------------------------------------------------
@@ -248,4 +248,105 @@ CppUnit::Test *ziptest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(ziptest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ziptest, "archive/zip");
 
+#if wxUSE_THREADS
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel compression
+
+static string GetParallelEntryData(int n)
+{
+    // Mix empty, small, medium (compressed in memory) and big (compressed in
+    // blocks) entries, keeping the whole archive smaller than the seek limit
+    // of TestOutputStream.
+    int count = (n * 37) % 200;
+    if ( n % 7 == 3 )
+        count = 50000;
+    else if ( n % 11 == 5 )
+        count = 200000;
+
+    string data;
+    for ( int i = 0; i < count; i++ )
+        data += wxString::Format("%d %d\n", i % 1000, n).ToStdString();
+
+    return data;
+}
+
+static void TestParallelZip(int options)
+{
+    const int count = 40;
+
+    TestOutputStream out(options);
+    {
+        wxZipOutputStream zip(out);
+        REQUIRE( zip.EnableParallelCompression(3) );
+
+        for ( int n = 0; n < count; n++ )
+        {
+            if ( n % 9 == 4 )
+            {
+                REQUIRE( zip.PutNextDirEntry(wxString::Format("dir%d", n)) );
+                continue;
+            }
+
+            if ( n == 21 )
+                zip.SetLevel(0);
+            else if ( n == 24 )
+                zip.SetLevel(9);
+
+            REQUIRE( zip.PutNextEntry(wxString::Format("dir%d/file%d", n % 3, n)) );
+
+            const string data = GetParallelEntryData(n);
+            for ( size_t pos = 0; pos < data.size(); pos += 3001 )
+                zip.Write(data.data() + pos, wxMin(3001, data.size() - pos));
+        }
+
+        REQUIRE( zip.Close() );
+    }
+
+    TestInputStream in(out, 0);
+    wxZipInputStream zip(in);
+
+    for ( int n = 0; n < count; n++ )
+    {
+        wxScopedPtr<wxZipEntry> entry(zip.GetNextEntry());
+        REQUIRE( entry );
+
+        if ( n % 9 == 4 )
+        {
+            CHECK( entry->IsDir() );
+            CHECK( entry->GetName(wxPATH_UNIX) == wxString::Format("dir%d/", n) );
+            continue;
+        }
+
+        CHECK( entry->GetName(wxPATH_UNIX) ==
+                wxString::Format("dir%d/file%d", n % 3, n) );
+
+        string result;
+        char buf[4096];
+        while ( zip.Read(buf, sizeof(buf)).LastRead() )
+            result.append(buf, zip.LastRead());
+
+        CHECK( zip.Eof() );
+        CHECK( result == GetParallelEntryData(n) );
+    }
+
+    CHECK( !zip.GetNextEntry() );
+}
+
+TEST_CASE("wxZipOutputStream::Parallel", "[archive][zip][thread]")
+{
+    SECTION("Seekable")
+    {
+        TestParallelZip(0);
+    }
+
+    // The data descriptors are used for the big entries in this case.
+    SECTION("NonSeekable")
+    {
+        TestParallelZip(PipeOut);
+    }
+}
+
+#endif // wxUSE_THREADS
+
 #endif // wxUSE_STREAMS && wxUSE_ZIPSTREAM
@@ -63,6 +63,12 @@ public:
     int GetNumericParameter() const { return m_numParam; }
     const wxString& GetStringParameter() const { return m_strParam; }
 
+    void SetWorkAmount(double amount, const char *units)
+    {
+        m_workAmount = amount;
+        m_workUnits = units;
+    }
+
 private:
     // list all registered benchmarks
     void ListBenchmarks();
@@ -73,6 +79,10 @@ private:
          m_avgCount,
          m_numParam;
     wxString m_strParam;
+
+    // amount of work done by a single run of the current benchmark, if set
+    double m_workAmount;
+    wxString m_workUnits;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -93,6 +103,11 @@ wxString Bench::GetStringParameter()
     return wxGetApp().GetStringParameter();
 }
 
+void Bench::SetWorkAmount(double amount, const char *units)
+{
+    wxGetApp().SetWorkAmount(amount, units);
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -102,6 +117,7 @@ BenchApp::BenchApp()
     m_avgCount = 10;
     m_numRuns = 10000; // just some default (TODO: switch to time-based one)
     m_numParam = 0;
+    m_workAmount = 0;
 }
 
 bool BenchApp::OnInit()
@@ -254,6 +270,9 @@ int BenchApp::OnRun()
 
         wxPrintf("Benchmarking %s%s: ", func->GetName(), params);
 
+        m_workAmount = 0;
+        m_workUnits.clear();
+
         long timeMin = LONG_MAX,
              timeMax = 0,
              timeTotal = 0;
@@ -294,8 +313,16 @@ int BenchApp::OnRun()
                 times -= 2;
             }
 
-            wxPrintf("%.2f avg (min=%ld, max=%ld)\n",
+            wxPrintf("%.2f avg (min=%ld, max=%ld)",
                      (float)timeTotal / times, timeMin, timeMax);
+
+            if ( m_workAmount > 0 && timeMin > 0 )
+            {
+                wxPrintf(", %.2f %s/s",
+                         m_workAmount*m_numRuns*1000 / timeMin, m_workUnits);
+            }
+
+            wxPrintf("\n");
         }
 
         fflush(stdout);
@@ -93,6 +93,17 @@ long GetNumericParameter();
  */
 wxString GetStringParameter();
 
+/**
+    Set the amount of work done by a single run of the current benchmark.
+
+    If this function is called by the benchmark function (or its init
+    function), the throughput of the benchmark, computed using the fastest of
+    the runs, is shown in the given units per second in addition to the time
+    taken by it, e.g. calling it with 1.5 and "MP" for a benchmark processing
+    1.5 megapixels results in the throughput being shown in "MP/s".
+ */
+void SetWorkAmount(double amount, const char *units);
+
 } // namespace Bench
 
 /**
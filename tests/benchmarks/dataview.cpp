@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dataview.cpp
+// Purpose:     wxDataViewCtrl benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_DATAVIEWCTRL
+
+#include "wx/frame.h"
+#include "wx/dataview.h"
+
+#include "bench.h"
+
+// List model with a string and a numeric column containing values in pseudo
+// random order.
+class SortBenchModel : public wxDataViewIndexListModel
+{
+public:
+    SortBenchModel(unsigned int count, bool sortByValue)
+        : wxDataViewIndexListModel(count),
+          m_sortByValue(sortByValue)
+    {
+    }
+
+    virtual unsigned int GetColumnCount() const wxOVERRIDE { return 2; }
+
+    virtual wxString GetColumnType(unsigned int col) const wxOVERRIDE
+    {
+        return col == 0 ? "string" : "long";
+    }
+
+    virtual void GetValueByRow(wxVariant& variant,
+                               unsigned int row,
+                               unsigned int col) const wxOVERRIDE
+    {
+        // Multiplying by a number coprime with a prime modulus gives a
+        // permutation of the rows as long as there are fewer of them.
+        const unsigned long
+            value = static_cast<unsigned long>(wxUint64(row) * 7919 % 1000003);
+        if ( col == 0 )
+            variant = wxString::Format("Item %07lu", value);
+        else
+            variant = static_cast<long>(value);
+    }
+
+    virtual bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                               unsigned int WXUNUSED(row),
+                               unsigned int WXUNUSED(col)) wxOVERRIDE
+    {
+        return false;
+    }
+
+    virtual bool CanSortByValue() const wxOVERRIDE { return m_sortByValue; }
+
+private:
+    const bool m_sortByValue;
+};
+
+static wxFrame* gs_frame = NULL;
+static wxDataViewCtrl* gs_dvc = NULL;
+static SortBenchModel* gs_model = NULL;
+
+static bool InitDataView(bool sortByValue)
+{
+    // The number of rows is given by the numeric parameter and is 100000 by
+    // default, sorting 1000000 rows using Compare() takes a long time.
+    const long count = Bench::GetNumericParameter();
+
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxDataViewCtrl benchmark",
+                           wxDefaultPosition, wxSize(400, 600));
+    gs_dvc = new wxDataViewCtrl(gs_frame, wxID_ANY);
+
+    gs_model = new SortBenchModel(count ? count : 100000, sortByValue);
+    gs_dvc->AssociateModel(gs_model);
+
+    gs_dvc->AppendTextColumn("String", 0)->SetSortable(true);
+    gs_dvc->AppendTextColumn("Number", 1)->SetSortable(true);
+
+    gs_frame->Show();
+    gs_frame->Update();
+
+    return true;
+}
+
+static bool InitDataViewByValue()
+{
+    return InitDataView(true);
+}
+
+static bool InitDataViewCompare()
+{
+    return InitDataView(false);
+}
+
+static void DoneDataView()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_dvc = NULL;
+
+    gs_model->DecRef();
+    gs_model = NULL;
+}
+
+// Sort by the given column, alternating between ascending and descending
+// order, so that every run actually sorts the items.
+static bool SortByColumn(unsigned int col)
+{
+    Bench::SetWorkAmount(gs_model->GetCount(), "rows");
+
+    wxDataViewColumn* const column = gs_dvc->GetColumn(col);
+    column->SetSortOrder(!column->IsSortKey() ||
+                            !column->IsSortOrderAscending());
+    gs_model->Resort();
+
+    return gs_dvc->GetSortingColumn() == column;
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSortString, InitDataViewByValue, DoneDataView)
+{
+    return SortByColumn(0);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSortStringCompare, InitDataViewCompare, DoneDataView)
+{
+    return SortByColumn(0);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSortLong, InitDataViewByValue, DoneDataView)
+{
+    return SortByColumn(1);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSortLongCompare, InitDataViewCompare, DoneDataView)
+{
+    return SortByColumn(1);
+}
+
+#endif // wxUSE_DATAVIEWCTRL
@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dir.cpp
+// Purpose:     wxDir::Traverse() benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/arrstr.h"
+#include "wx/dir.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+
+#include "bench.h"
+
+// The number of files in the tree used by the benchmarks below in thousands
+// is given by the numeric parameter and is 20 by default.
+static size_t GetFilesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return (count ? count : 20)*1000;
+}
+
+static wxString gs_dirname;
+
+// Create a tree of directories with 3 levels of 10 subdirectories and 20 files
+// in each of the leaf ones, repeated as many times as needed.
+static bool InitDirTree()
+{
+    gs_dirname = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_dirname.empty() )
+        return false;
+
+    wxRemoveFile(gs_dirname);
+
+    const size_t count = GetFilesCount();
+    for ( size_t n = 0; n < count; n += 20 )
+    {
+        const size_t leaf = n / 20;
+        const wxString dirname = wxString::Format
+                                 (
+                                    "%s/tree%lu/dir%lu/subdir%lu/leaf%lu",
+                                    gs_dirname,
+                                    (unsigned long)(leaf / 1000),
+                                    (unsigned long)(leaf / 100 % 10),
+                                    (unsigned long)(leaf / 10 % 10),
+                                    (unsigned long)(leaf % 10)
+                                 );
+
+        if ( !wxFileName::Mkdir(dirname, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL) )
+            return false;
+
+        for ( size_t i = 0; i < 20; i++ )
+        {
+            wxFFile file(wxString::Format("%s/file%lu.txt",
+                                          dirname, (unsigned long)i), "w");
+            if ( !file.IsOpened() )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+static void DoneDirTree()
+{
+    wxFileName::Rmdir(gs_dirname, wxPATH_RMDIR_RECURSIVE);
+    gs_dirname.clear();
+}
+
+static bool DoGetAllFiles(int flags)
+{
+    Bench::SetWorkAmount(GetFilesCount() / 1000., "thousands of files");
+
+    wxArrayString files;
+    return wxDir::GetAllFiles(gs_dirname, &files, wxString(), flags)
+            == GetFilesCount();
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFiles, InitDirTree, DoneDirTree)
+{
+    return DoGetAllFiles(wxDIR_DEFAULT);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesParallel, InitDirTree, DoneDirTree)
+{
+    return DoGetAllFiles(wxDIR_DEFAULT | wxDIR_PARALLEL);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirGetAllFilesUnordered, InitDirTree, DoneDirTree)
+{
+    return DoGetAllFiles(wxDIR_DEFAULT | wxDIR_PARALLEL | wxDIR_UNORDERED);
+}
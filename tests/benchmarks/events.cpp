@@ -0,0 +1,224 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Event-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+// The number of events queued by each run of the benchmarks below is given by
+// the numeric parameter and is 1000 by default.
+static long GetEventsCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 1000;
+}
+
+// Simple handler just counting the events it receives.
+class CountingHandler : public wxEvtHandler
+{
+public:
+    CountingHandler()
+    {
+        m_count = 0;
+
+        Bind(wxEVT_THREAD, &CountingHandler::OnThreadEvent, this);
+    }
+
+    long GetCount() const { return m_count; }
+
+private:
+    void OnThreadEvent(wxThreadEvent& WXUNUSED(event))
+    {
+        m_count++;
+    }
+
+    long m_count;
+
+    wxDECLARE_NO_COPY_CLASS(CountingHandler);
+};
+
+// Process the pending events until the handler gets the expected number of
+// them, return false if this doesn't happen.
+static bool ProcessEventsUntil(const CountingHandler& handler, long count)
+{
+    while ( handler.GetCount() < count )
+    {
+        if ( !wxTheApp->HasPendingEvents() )
+            return false;
+
+        wxTheApp->ProcessPendingEvents();
+    }
+
+    return handler.GetCount() == count;
+}
+
+BENCHMARK_FUNC(QueueEvent)
+{
+    CountingHandler handler;
+
+    const long count = GetEventsCount();
+    for ( long n = 0; n < count; n++ )
+        handler.QueueEvent(new wxThreadEvent());
+
+    return ProcessEventsUntil(handler, count);
+}
+
+#if wxUSE_THREADS
+
+// Thread queuing the given number of events for the handler.
+class QueueEventThread : public wxThread
+{
+public:
+    QueueEventThread(wxEvtHandler& handler, long count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual void* Entry() wxOVERRIDE
+    {
+        for ( long n = 0; n < m_count; n++ )
+            wxQueueEvent(&m_handler, new wxThreadEvent());
+
+        return NULL;
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const long m_count;
+
+    wxDECLARE_NO_COPY_CLASS(QueueEventThread);
+};
+
+static bool DoQueueEventFromThreads(int numThreads)
+{
+    CountingHandler handler;
+
+    const long countPerThread = GetEventsCount() / numThreads;
+
+    wxVector<QueueEventThread*> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        QueueEventThread* const thread = new QueueEventThread(handler,
+                                                              countPerThread);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    // Process the events while they're being queued, as it would happen in
+    // a real application.
+    const long count = countPerThread*threads.size();
+    while ( handler.GetCount() < count )
+    {
+        if ( wxTheApp->HasPendingEvents() )
+            wxTheApp->ProcessPendingEvents();
+        else
+            wxThread::Yield();
+    }
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    return threads.size() == static_cast<size_t>(numThreads) &&
+                ProcessEventsUntil(handler, count);
+}
+
+BENCHMARK_FUNC(QueueEventFrom1Thread)
+{
+    return DoQueueEventFromThreads(1);
+}
+
+BENCHMARK_FUNC(QueueEventFrom4Threads)
+{
+    return DoQueueEventFromThreads(4);
+}
+
+#endif // wxUSE_THREADS
+
+// Handler with many dynamically bound event handlers for different event
+// types, as is typical for the real windows, and a single one for the events
+// which are actually processed.
+class ManyBindingsHandler : public wxEvtHandler
+{
+public:
+    // Total number of the bound handlers.
+    enum { BINDINGS_COUNT = 500 };
+
+    ManyBindingsHandler()
+    {
+        m_count = 0;
+
+        Bind(wxEVT_THREAD, &ManyBindingsHandler::OnThreadEvent, this);
+
+        for ( int n = 1; n < BINDINGS_COUNT; n++ )
+        {
+            Bind(wxEventTypeTag<wxThreadEvent>(wxNewEventType()),
+                 &ManyBindingsHandler::OnOtherEvent, this);
+        }
+    }
+
+    long GetCount() const { return m_count; }
+
+private:
+    void OnThreadEvent(wxThreadEvent& WXUNUSED(event))
+    {
+        m_count++;
+    }
+
+    void OnOtherEvent(wxThreadEvent& WXUNUSED(event))
+    {
+    }
+
+    long m_count;
+
+    wxDECLARE_NO_COPY_CLASS(ManyBindingsHandler);
+};
+
+static ManyBindingsHandler* gs_manyBindingsHandler = NULL;
+
+static bool InitManyBindings()
+{
+    gs_manyBindingsHandler = new ManyBindingsHandler;
+
+    return true;
+}
+
+static void DoneManyBindings()
+{
+    delete gs_manyBindingsHandler;
+    gs_manyBindingsHandler = NULL;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ProcessEventWithManyBindings,
+                         InitManyBindings, DoneManyBindings)
+{
+    const long countBefore = gs_manyBindingsHandler->GetCount();
+
+    wxThreadEvent event;
+
+    const long count = GetEventsCount();
+    for ( long n = 0; n < count; n++ )
+        gs_manyBindingsHandler->ProcessEvent(event);
+
+    return gs_manyBindingsHandler->GetCount() == countBefore + count;
+}
@@ -67,7 +67,8 @@ struct GraphicsBenchmarkOptions
         testEllipses =
         testTextExtent =
         testMultiLineTextExtent =
-        testPartialTextExtents = false;
+        testPartialTextExtents =
+        testImageContext = false;
 
         usePaint =
         useClient =
@@ -97,7 +98,8 @@ struct GraphicsBenchmarkOptions
          testEllipses,
          testTextExtent,
          testMultiLineTextExtent,
-         testPartialTextExtents;
+         testPartialTextExtents,
+         testImageContext;
 
     bool usePaint,
          useClient,
@@ -376,6 +378,9 @@ private:
 
         }
 
+        if ( opts.useGC )
+            BenchmarkImageContext();
+
         wxTheApp->ExitMainLoop();
     }
 
@@ -677,6 +682,46 @@ private:
                  opts.numIters, t, (1000. * t)/opts.numIters);
     }
 
+    // Draw a small shape on a big image and flush the context after it, as
+    // it's done when updating an off-screen image incrementally. Use -w 3840
+    // -h 2160 options to measure it for 4K images.
+    void BenchmarkImageContext()
+    {
+        if ( !opts.testImageContext || !m_renderer )
+            return;
+
+        wxPrintf("Benchmarking image GC (%s): ", m_renderer->GetName());
+        fflush(stdout);
+
+        wxImage image(opts.width, opts.height);
+        wxGraphicsContext* const gc = m_renderer->CreateContextFromImage(image);
+        if ( !gc )
+        {
+            wxPrintf("ERROR: creating image context failed\n");
+            return;
+        }
+
+        gc->SetPen(*wxWHITE_PEN);
+        gc->SetBrush(*wxRED_BRUSH);
+
+        wxStopWatch sw;
+        for ( int n = 0; n < opts.numIters; n++ )
+        {
+            int x = rand() % opts.width,
+                y = rand() % opts.height;
+
+            gc->DrawRectangle(x, y, 32, 32);
+            gc->Flush();
+        }
+
+        const long t = sw.Time();
+
+        delete gc;
+
+        wxPrintf("%ld flushed drawings done in %ldms = %gus/drawing\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+    }
+
     void BenchmarkBitmaps(const wxString& msg, wxDC& dc)
     {
         if ( !opts.testBitmaps )
@@ -854,6 +899,7 @@ public:
             { wxCMD_LINE_SWITCH, "",  "textextent" },
             { wxCMD_LINE_SWITCH, "",  "multilinetextextent" },
             { wxCMD_LINE_SWITCH, "",  "partialtextextents" },
+            { wxCMD_LINE_SWITCH, "",  "imagecontext" },
             { wxCMD_LINE_SWITCH, "",  "paint" },
             { wxCMD_LINE_SWITCH, "",  "client" },
             { wxCMD_LINE_SWITCH, "",  "memory" },
@@ -930,10 +976,12 @@ public:
         opts.testTextExtent = parser.Found("textextent");
         opts.testMultiLineTextExtent = parser.Found("multilinetextextent");
         opts.testPartialTextExtents = parser.Found("partialtextextents");
+        opts.testImageContext = parser.Found("imagecontext");
         if ( !(opts.testBitmaps || opts.testImages || opts.testLines
                     || opts.testRawBitmaps || opts.testRectangles
                     || opts.testCircles || opts.testEllipses
-                    || opts.testTextExtent || opts.testPartialTextExtents) )
+                    || opts.testTextExtent || opts.testPartialTextExtents
+                    || opts.testImageContext) )
         {
             // Do everything by default.
             opts.testBitmaps =
@@ -944,7 +992,8 @@ public:
             opts.testCircles =
             opts.testEllipses =
             opts.testTextExtent =
-            opts.testPartialTextExtents = true;
+            opts.testPartialTextExtents =
+            opts.testImageContext = true;
         }
 
         opts.usePaint = parser.Found("paint");
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/grid.h"
+
+#include "bench.h"
+
+// The number of cells with attributes used by the benchmarks below is given
+// by the numeric parameter, e.g. use "-p 1000000" to test with 10^6 attributed
+// cells (and a smaller number of runs), and is 10^4 by default.
+static int GetAttrCellsCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 10000;
+}
+
+// The cells are laid out in rows of this many columns.
+static const int ATTR_COLS_COUNT = 100;
+
+static void SetAttrForAllCells(wxGridCellAttrProvider& provider)
+{
+    const int count = GetAttrCellsCount();
+    for ( int n = 0; n < count; n++ )
+    {
+        wxGridCellAttr* const attr = new wxGridCellAttr;
+        attr->SetBackgroundColour(n % 2 ? *wxRED : *wxGREEN);
+
+        provider.SetAttr(attr, n / ATTR_COLS_COUNT, n % ATTR_COLS_COUNT);
+    }
+}
+
+BENCHMARK_FUNC(GridSetCellAttr)
+{
+    wxGridCellAttrProvider provider;
+    SetAttrForAllCells(provider);
+
+    wxGridCellAttr* const attr = provider.GetAttr(0, 0, wxGridCellAttr::Cell);
+    if ( !attr )
+        return false;
+
+    attr->DecRef();
+    return true;
+}
+
+static wxGridCellAttrProvider* gs_provider = NULL;
+
+static bool InitGetCellAttr()
+{
+    gs_provider = new wxGridCellAttrProvider;
+    SetAttrForAllCells(*gs_provider);
+
+    return true;
+}
+
+static void DoneGetCellAttr()
+{
+    delete gs_provider;
+    gs_provider = NULL;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridGetCellAttr, InitGetCellAttr, DoneGetCellAttr)
+{
+    int found = 0;
+
+    const int count = GetAttrCellsCount();
+    for ( int n = 0; n < count; n++ )
+    {
+        wxGridCellAttr* const attr = gs_provider->GetAttr
+                                     (
+                                        n / ATTR_COLS_COUNT,
+                                        n % ATTR_COLS_COUNT,
+                                        wxGridCellAttr::Cell
+                                     );
+        if ( attr )
+        {
+            found++;
+            attr->DecRef();
+        }
+    }
+
+    return found == count;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridInsertRowsWithCellAttr, InitGetCellAttr, DoneGetCellAttr)
+{
+    // Insert and delete a row in the middle of the attributed cells, this
+    // requires updating the coordinates of about half of them each time.
+    const int pos = GetAttrCellsCount() / ATTR_COLS_COUNT / 2;
+    gs_provider->UpdateAttrRows(pos, 1);
+    gs_provider->UpdateAttrRows(pos, -1);
+
+    return true;
+}
@@ -0,0 +1,98 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/htmlwindow.cpp
+// Purpose:     wxHtmlWindow benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_HTML
+
+#include "wx/frame.h"
+#include "wx/html/htmlwin.h"
+
+#include "bench.h"
+
+// The number of fragments appended by each run of the benchmarks below is
+// given by the numeric parameter or the given default value if it's not
+// specified.
+static long GetFragmentsCount(long defaultCount)
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : defaultCount;
+}
+
+static wxFrame* gs_frame = NULL;
+static wxHtmlWindow* gs_html = NULL;
+
+static bool InitHtml()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxHtmlWindow benchmark",
+                           wxDefaultPosition, wxSize(600, 400));
+    gs_html = new wxHtmlWindow(gs_frame);
+
+    gs_frame->Show();
+    gs_frame->Update();
+
+    return true;
+}
+
+static void DoneHtml()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_html = NULL;
+}
+
+// Append the given number of lines to the page, as a log window would do.
+static bool AppendLines(long count)
+{
+    Bench::SetWorkAmount(count, "fragments");
+
+    gs_html->SetPage("<html><body><h3>Log</h3></body></html>");
+
+    for ( long n = 0; n < count; n++ )
+    {
+        gs_html->AppendToPage(wxString::Format
+                              (
+                                "<p><b>%ld:</b> <font color=\"blue\">message</font> "
+                                "with some <i>formatted</i> text</p>",
+                                n
+                              ));
+    }
+
+    gs_html->Update();
+
+    return gs_html->GetInternalRepresentation() != NULL;
+}
+
+BENCHMARK_FUNC_WITH_INIT(HtmlAppendIncremental, InitHtml, DoneHtml)
+{
+    gs_html->EnableIncrementalAppend();
+
+    return AppendLines(GetFragmentsCount(10000));
+}
+
+// The same benchmark as above but with only the last 1000 fragments kept.
+BENCHMARK_FUNC_WITH_INIT(HtmlAppendIncrementalCapped, InitHtml, DoneHtml)
+{
+    gs_html->EnableIncrementalAppend();
+    gs_html->SetMaxAppendedFragments(1000);
+
+    return AppendLines(GetFragmentsCount(10000));
+}
+
+// Appending in the default mode takes quadratic time, so use fewer fragments
+// by default for it.
+BENCHMARK_FUNC_WITH_INIT(HtmlAppendFull, InitHtml, DoneHtml)
+{
+    gs_html->EnableIncrementalAppend(false);
+
+    return AppendLines(GetFragmentsCount(1000));
+}
+
+#endif // wxUSE_HTML
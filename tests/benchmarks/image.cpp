@@ -8,6 +8,7 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "wx/image.h"
+#include "wx/math.h"
 
 #include "bench.h"
 
@@ -78,6 +79,8 @@ BENCHMARK_FUNC(EnlargeNormal)
 
 BENCHMARK_FUNC(EnlargeHighQuality)
 {
+    Bench::SetWorkAmount(300*300/1e6, "MP");
+
     return GetTestImage().Scale(300, 300, wxIMAGE_QUALITY_HIGH).IsOk();
 }
 
@@ -88,5 +91,103 @@ BENCHMARK_FUNC(ShrinkNormal)
 
 BENCHMARK_FUNC(ShrinkHighQuality)
 {
+    Bench::SetWorkAmount(50*50/1e6, "MP");
+
     return GetTestImage().Scale(50, 50, wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+// The benchmarks below use a big generated image, with the size in megapixels
+// given by the numeric parameter (3 by default), and are much slower than the
+// ones above, so it's recommended to run them with small --num-runs value.
+static const wxImage& GetBigTestImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const long mp = Bench::GetNumericParameter();
+        const int height = wxRound(sqrt((mp ? mp : 3)*1e6 / 1.5));
+        const int width = height*3/2;
+
+        s_image.Create(width, height, false);
+        s_image.SetAlpha();
+
+        unsigned char* rgb = s_image.GetData();
+        unsigned char* alpha = s_image.GetAlpha();
+        for ( int y = 0; y < height; y++ )
+        {
+            for ( int x = 0; x < width; x++ )
+            {
+                *rgb++ = static_cast<unsigned char>(x);
+                *rgb++ = static_cast<unsigned char>(y);
+                *rgb++ = static_cast<unsigned char>(x ^ y);
+                *alpha++ = static_cast<unsigned char>(x + y);
+            }
+        }
+    }
+
+    return s_image;
+}
+
+static bool DoScaleBig(double factor, wxImageResizeQuality quality)
+{
+    const wxImage& image = GetBigTestImage();
+    const int width = wxRound(image.GetWidth()*factor);
+    const int height = wxRound(image.GetHeight()*factor);
+
+    Bench::SetWorkAmount(width*(double)height/1e6, "MP");
+
+    return image.Scale(width, height, quality).IsOk();
+}
+
+BENCHMARK_FUNC(ShrinkBigBilinear)
+{
+    return DoScaleBig(0.7, wxIMAGE_QUALITY_BILINEAR);
+}
+
+BENCHMARK_FUNC(ShrinkBigBicubic)
+{
+    return DoScaleBig(0.7, wxIMAGE_QUALITY_BICUBIC);
+}
+
+BENCHMARK_FUNC(ShrinkBigBox)
+{
+    return DoScaleBig(0.3, wxIMAGE_QUALITY_BOX_AVERAGE);
+}
+
+BENCHMARK_FUNC(EnlargeBigBicubic)
+{
+    return DoScaleBig(1.5, wxIMAGE_QUALITY_BICUBIC);
+}
+
+static bool DoBlurBig(int radius)
+{
+    const wxImage& image = GetBigTestImage();
+
+    Bench::SetWorkAmount(image.GetWidth()*(double)image.GetHeight()/1e6, "MP");
+
+    return image.Blur(radius).IsOk();
+}
+
+BENCHMARK_FUNC(BlurBigRadius2)
+{
+    return DoBlurBig(2);
+}
+
+BENCHMARK_FUNC(BlurBigRadius8)
+{
+    return DoBlurBig(8);
+}
+
+BENCHMARK_FUNC(BlurBigRadius64)
+{
+    return DoBlurBig(64);
+}
+
+BENCHMARK_FUNC(BlurGaussianBig)
+{
+    const wxImage& image = GetBigTestImage();
+
+    Bench::SetWorkAmount(image.GetWidth()*(double)image.GetHeight()/1e6, "MP");
+
+    return image.BlurGaussian(8).IsOk();
+}
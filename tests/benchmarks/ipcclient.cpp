@@ -142,29 +142,98 @@ bool ConnInit()
     return true;
 }
 
+// the size of the text data used by the benchmarks below
+const size_t TEXT_DATA_SIZE = 4*1024;
+
+bool ConnInitText()
+{
+    if ( !ConnInit() )
+        return false;
+
+    Bench::SetWorkAmount(TEXT_DATA_SIZE, "bytes");
+
+    return true;
+}
+
+bool ConnInitTextCompressed()
+{
+    if ( !ConnInitText() )
+        return false;
+
+    if ( !theConnection->Get()->Compress(true) )
+    {
+        delete theConnection;
+        theConnection = NULL;
+        return false;
+    }
+
+    return true;
+}
+
 void ConnDone()
 {
     delete theConnection;
 }
 
-} // anonymous namespace
+// Return a string of the given size looking like some typical text data.
+wxString MakeTextData(size_t size)
+{
+    wxString s;
+    s.reserve(size + 80);
+    for ( unsigned n = 0; s.length() < size; n++ )
+    {
+        s += wxString::Format("item %u: value=%u, status=%s\n",
+                              n, n*n % 1009, n % 7 ? "ok" : "pending");
+    }
 
-BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
+    s.Truncate(size);
+
+    return s;
+}
+
+// Poke the given data to the server and wait until it advises us about it.
+bool PokeAndWaitForAdvise(const wxString& s)
 {
     wxEventLoop loop;
 
     PokeAdviseConn * const conn = theConnection->Get();
 
-    const wxString s(1024, '@');
-
     if ( !conn->Poke(IPC_BENCHMARK_ITEM, s) )
         return false;
 
+    // socket events are queued, so process them after dispatching
     while ( !conn->GotAdvised() )
+    {
         loop.Dispatch();
+        wxTheApp->ProcessPendingEvents();
+    }
 
     if ( conn->GetItem() != s )
         return false;
 
     return true;
 }
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
+{
+    return PokeAndWaitForAdvise(wxString(1024, '@'));
+}
+
+// The benchmarks below use bigger and more realistic data to show the effect
+// of the compression.
+BENCHMARK_FUNC_WITH_INIT(IPCPokeAdviseText, ConnInitText, ConnDone)
+{
+    static const wxString s = MakeTextData(TEXT_DATA_SIZE);
+
+    return PokeAndWaitForAdvise(s);
+}
+
+BENCHMARK_FUNC_WITH_INIT(IPCPokeAdviseTextCompressed,
+                         ConnInitTextCompressed, ConnDone)
+{
+    static const wxString s = MakeTextData(TEXT_DATA_SIZE);
+
+    return PokeAndWaitForAdvise(s);
+}
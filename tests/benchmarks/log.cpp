@@ -9,7 +9,11 @@
 
 #include "bench.h"
 
+#include "wx/filename.h"
 #include "wx/log.h"
+#include "wx/logasync.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
 
 // This class is used to check that the arguments of log functions are not
 // evaluated.
@@ -106,3 +110,138 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+#if wxUSE_THREADS
+
+// The number of messages logged by the benchmarks below in thousands is given
+// by the numeric parameter and is 100 by default.
+static int GetMessagesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return (count ? count : 100)*1000;
+}
+
+static wxString gs_logFilename;
+static FILE* gs_logFile = NULL;
+
+static bool InitLogFile()
+{
+    gs_logFilename = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_logFilename.empty() )
+        return false;
+
+    gs_logFile = wxFopen(gs_logFilename, "w");
+
+    return gs_logFile != NULL;
+}
+
+static void DoneLogFile()
+{
+    if ( gs_logFile )
+    {
+        fclose(gs_logFile);
+        gs_logFile = NULL;
+    }
+
+    wxRemoveFile(gs_logFilename);
+    gs_logFilename.clear();
+}
+
+// Thread logging the given number of messages.
+class LogThread : public wxThread
+{
+public:
+    LogThread(int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual void* Entry() wxOVERRIDE
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("Message %d from thread %d", n, m_id);
+
+        return NULL;
+    }
+
+private:
+    const int m_id;
+    const int m_count;
+
+    wxDECLARE_NO_COPY_CLASS(LogThread);
+};
+
+// Log all messages using the given target, which is deleted by this function,
+// either from the main thread, if numThreads is 0, or from the given number of
+// worker threads and wait until all of them are written out.
+static bool DoLogMessages(wxLog* log, int numThreads)
+{
+    const int count = GetMessagesCount();
+    Bench::SetWorkAmount(count / 1000., "thousands of messages");
+
+    wxLog* const logOld = wxLog::SetActiveTarget(log);
+
+    bool ok = true;
+    if ( !numThreads )
+    {
+        for ( int n = 0; n < count; n++ )
+            wxLogMessage("Message %d from main thread", n);
+    }
+    else
+    {
+        wxVector<LogThread*> threads;
+        for ( int n = 0; n < numThreads; n++ )
+        {
+            LogThread* const thread = new LogThread(n, count / numThreads);
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                delete thread;
+                ok = false;
+                break;
+            }
+
+            threads.push_back(thread);
+        }
+
+        for ( size_t n = 0; n < threads.size(); n++ )
+        {
+            threads[n]->Wait();
+            delete threads[n];
+        }
+    }
+
+    // This writes out the messages buffered by the worker threads for the
+    // standard targets, which can only be done from the main thread.
+    wxLog::FlushActive();
+
+    wxLog::SetActiveTarget(logOld);
+    delete log;
+
+    return ok;
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogMainStderr, InitLogFile, DoneLogFile)
+{
+    return DoLogMessages(new wxLogStderr(gs_logFile), 0);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogMainAsync, InitLogFile, DoneLogFile)
+{
+    return DoLogMessages(new wxLogAsync(gs_logFile), 0);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogThreadsStderr, InitLogFile, DoneLogFile)
+{
+    return DoLogMessages(new wxLogStderr(gs_logFile), 4);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LogThreadsAsync, InitLogFile, DoneLogFile)
+{
+    return DoLogMessages(new wxLogAsync(gs_logFile), 4);
+}
+
+#endif // wxUSE_THREADS
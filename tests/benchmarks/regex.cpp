@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/regex.cpp
+// Purpose:     wxRegEx benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_REGEX
+
+#include "wx/regex.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+// Patterns typically used for filtering log files: all of them, except the
+// last one, contain a literal string which must be present in the line.
+static const char* const gs_patterns[] =
+{
+    "ERROR: .*",
+    "WARNING: disk [a-z]+ is ([0-9]+)% full",
+    "connection from ([0-9.]+) refused",
+    "user '([^']+)' logged (in|out)",
+    "timeout after ([0-9]+) ?ms",
+    "^[0-9]{4}-[0-9]{2}-[0-9]{2} .*segfault",
+    "GET /api/v[0-9]+/items",
+    "checksum mismatch",
+    "retrying \\(attempt [0-9]+\\)",
+    "out of memory",
+    "thread [0-9]+ (started|exited)",
+    "[0-9]+\\.[0-9]+s"
+};
+
+// The number of lines used by the benchmarks below is given by the numeric
+// parameter and is 10000 by default.
+static wxVector<wxString> gs_lines;
+
+static bool InitLines()
+{
+    const long count = Bench::GetNumericParameter();
+    const size_t linesCount = count ? count : 10000;
+
+    gs_lines.reserve(linesCount);
+    for ( size_t n = 0; n < linesCount; n++ )
+    {
+        // only a few lines match any of the patterns above
+        wxString line;
+        switch ( n % 50 )
+        {
+            case 0:
+                line.Printf("2026-10-18 12:%02u:%02u ERROR: unexpected EOF",
+                            unsigned(n / 60 % 60), unsigned(n % 60));
+                break;
+
+            case 25:
+                line.Printf("2026-10-18 12:%02u:%02u thread %u started",
+                            unsigned(n / 60 % 60), unsigned(n % 60),
+                            unsigned(n));
+                break;
+
+            default:
+                line.Printf("2026-10-18 12:%02u:%02u INFO: processed request "
+                            "%u for client %u in %u ms",
+                            unsigned(n / 60 % 60), unsigned(n % 60),
+                            unsigned(n), unsigned(n % 97), unsigned(n % 13));
+        }
+
+        gs_lines.push_back(line);
+    }
+
+    Bench::SetWorkAmount(WXSIZEOF(gs_patterns)*linesCount, "matches");
+
+    return true;
+}
+
+static bool InitLinesForCompile()
+{
+    if ( !InitLines() )
+        return false;
+
+    Bench::SetWorkAmount(gs_lines.size(), "compilations");
+
+    return true;
+}
+
+static void DoneLines()
+{
+    gs_lines.clear();
+}
+
+// Match all the lines against all the patterns using the given flags.
+static bool MatchAll(int flags)
+{
+    size_t matches = 0;
+    for ( size_t n = 0; n < WXSIZEOF(gs_patterns); n++ )
+    {
+        const wxRegEx re(gs_patterns[n], flags);
+        if ( !re.IsValid() )
+            return false;
+
+        for ( size_t i = 0; i < gs_lines.size(); i++ )
+        {
+            if ( re.Matches(gs_lines[i]) )
+                matches++;
+        }
+    }
+
+    return matches != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(RegExMatchLines, InitLines, DoneLines)
+{
+    return MatchAll(wxRE_EXTENDED);
+}
+
+// Literal prefilter is not used for case-insensitive patterns, so this shows
+// the cost of using the regex engine for every line.
+BENCHMARK_FUNC_WITH_INIT(RegExMatchLinesICase, InitLines, DoneLines)
+{
+    return MatchAll(wxRE_EXTENDED | wxRE_ICASE);
+}
+
+// Create a new wxRegEx object for each line, as is commonly done when the
+// pattern is chosen depending on the line contents.
+BENCHMARK_FUNC_WITH_INIT(RegExCompileEach, InitLinesForCompile, DoneLines)
+{
+    size_t matches = 0;
+    for ( size_t i = 0; i < gs_lines.size(); i++ )
+    {
+        const wxRegEx re(gs_patterns[i % WXSIZEOF(gs_patterns)]);
+        if ( re.Matches(gs_lines[i]) )
+            matches++;
+    }
+
+    return matches != 0;
+}
+
+#endif // wxUSE_REGEX
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/richtext.cpp
+// Purpose:     wxRichTextBuffer benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_RICHTEXT
+
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/richtext/richtextbuffer.h"
+
+#include "bench.h"
+
+// The number of paragraphs in the buffer used by the benchmarks below is given
+// by the numeric parameter and is 50000 by default.
+static int GetParagraphsCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 50000;
+}
+
+// The number of lookups done by each benchmark run.
+static const int LOOKUPS_COUNT = 10000;
+
+static wxRichTextBuffer* gs_buffer = NULL;
+
+static bool InitBuffer()
+{
+    gs_buffer = new wxRichTextBuffer;
+
+    wxString text;
+    const int count = GetParagraphsCount();
+    for ( int n = 0; n < count; n++ )
+    {
+        if ( n )
+            text += '\n';
+        text += wxString::Format("This is paragraph number %d.", n);
+    }
+
+    gs_buffer->AddParagraphs(text);
+
+    wxBitmap bmp(100, 100);
+    wxMemoryDC dc(bmp);
+    wxRichTextDrawingContext context(gs_buffer);
+    const wxRect rect(0, 0, 600, 400);
+    return gs_buffer->Layout(dc, context, rect, rect, wxRICHTEXT_FIXED_WIDTH);
+}
+
+static void DoneBuffer()
+{
+    delete gs_buffer;
+    gs_buffer = NULL;
+}
+
+// Spread the lookups over the entire buffer.
+static long GetLookupPosition(int n)
+{
+    return gs_buffer->GetOwnRange().GetEnd() / LOOKUPS_COUNT * n;
+}
+
+BENCHMARK_FUNC_WITH_INIT(RichTextParagraphAtPosition, InitBuffer, DoneBuffer)
+{
+    for ( int n = 0; n < LOOKUPS_COUNT; n++ )
+    {
+        if ( !gs_buffer->GetParagraphAtPosition(GetLookupPosition(n)) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(RichTextLineAtPosition, InitBuffer, DoneBuffer)
+{
+    for ( int n = 0; n < LOOKUPS_COUNT; n++ )
+    {
+        if ( !gs_buffer->GetLineAtPosition(GetLookupPosition(n)) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(RichTextLeafObjectAtPosition, InitBuffer, DoneBuffer)
+{
+    for ( int n = 0; n < LOOKUPS_COUNT; n++ )
+    {
+        if ( !gs_buffer->GetLeafObjectAtPosition(GetLookupPosition(n)) )
+            return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_RICHTEXT
@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sizer.cpp
+// Purpose:     wxSizer layout benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_STATTEXT && wxUSE_TEXTCTRL && wxUSE_STATBOX
+
+#include "wx/frame.h"
+#include "wx/panel.h"
+#include "wx/sizer.h"
+#include "wx/statbox.h"
+#include "wx/stattext.h"
+#include "wx/textctrl.h"
+
+#include "bench.h"
+
+// The number of controls in the form used by the benchmarks below is given by
+// the numeric parameter and is 1000 by default.
+static int GetControlsCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 1000;
+}
+
+// The controls are organized in groups of this many label/text pairs.
+static const int FIELDS_PER_GROUP = 10;
+
+static wxFrame* gs_frame = NULL;
+static wxPanel* gs_panel = NULL;
+static wxStaticText* gs_label = NULL;
+
+// Create a typical dense form: a column of static boxes containing a two
+// column grid of labels and text controls each.
+static bool InitForm()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxSizer benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_panel = new wxPanel(gs_frame);
+
+    wxSizer* const sizerTop = new wxBoxSizer(wxVERTICAL);
+
+    const int count = GetControlsCount() / 2;
+    for ( int n = 0; n < count; n += FIELDS_PER_GROUP )
+    {
+        wxStaticBoxSizer* const
+            sizerBox = new wxStaticBoxSizer(wxVERTICAL, gs_panel,
+                                            wxString::Format("Group %d", n));
+        wxWindow* const box = sizerBox->GetStaticBox();
+
+        wxFlexGridSizer* const sizerGrid = new wxFlexGridSizer(2, wxSize(5, 5));
+        sizerGrid->AddGrowableCol(1);
+
+        for ( int i = n; i < n + FIELDS_PER_GROUP && i < count; i++ )
+        {
+            wxStaticText* const
+                label = new wxStaticText(box, wxID_ANY,
+                                         wxString::Format("Field #%d:", i));
+            if ( !gs_label )
+                gs_label = label;
+
+            sizerGrid->Add(label, wxSizerFlags().CentreVertical());
+            sizerGrid->Add(new wxTextCtrl(box, wxID_ANY), wxSizerFlags().Expand());
+        }
+
+        sizerBox->Add(sizerGrid, wxSizerFlags().Expand().Border());
+        sizerTop->Add(sizerBox, wxSizerFlags().Expand().Border());
+    }
+
+    gs_panel->SetSizer(sizerTop);
+
+    return gs_label != NULL;
+}
+
+static void DoneForm()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_panel = NULL;
+    gs_label = NULL;
+}
+
+// Lay out the form at a different width every time, as happens when the
+// window is being resized interactively.
+BENCHMARK_FUNC_WITH_INIT(SizerLayout, InitForm, DoneForm)
+{
+    static int s_width = 0;
+
+    Bench::SetWorkAmount(1, "layouts");
+
+    s_width = s_width == 600 ? 800 : 600;
+    gs_panel->GetSizer()->SetDimension(wxPoint(0, 0), wxSize(s_width, 600));
+
+    return gs_label->GetSize().x > 0;
+}
+
+// Change a single label in the form and lay it out again.
+BENCHMARK_FUNC_WITH_INIT(SizerLayoutAfterLabelChange, InitForm, DoneForm)
+{
+    static int s_counter = 0;
+
+    Bench::SetWorkAmount(1, "layouts");
+
+    gs_label->SetLabel(s_counter++ % 2 ? "Short:" : "Much longer label:");
+    gs_panel->Layout();
+
+    return gs_label->GetSize().x > 0;
+}
+
+#endif // wxUSE_STATTEXT && wxUSE_TEXTCTRL && wxUSE_STATBOX
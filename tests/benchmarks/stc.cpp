@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/stc.cpp
+// Purpose:     wxStyledTextCtrl benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_STC
+
+#include "wx/frame.h"
+#include "wx/stc/stc.h"
+
+#include "bench.h"
+
+// The number of lines in the control used by the benchmarks below is given by
+// the numeric parameter and is 100000 by default.
+static int GetLinesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 100000;
+}
+
+static wxFrame* gs_frame = NULL;
+static wxStyledTextCtrl* gs_stc = NULL;
+
+static bool InitControl(wxFontFamily family)
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxStyledTextCtrl benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_stc = new wxStyledTextCtrl(gs_frame, wxID_ANY);
+
+    const wxFont font(wxFontInfo(10).Family(family));
+    for ( int style = 0; style < wxSTC_STYLE_LASTPREDEFINED; style++ )
+        gs_stc->StyleSetFont(style, font);
+
+    gs_stc->SetLexer(wxSTC_LEX_CPP);
+    gs_stc->SetKeyWords(0, "int return for if else while static const");
+    gs_stc->StyleSetForeground(wxSTC_C_WORD, *wxBLUE);
+    gs_stc->StyleSetForeground(wxSTC_C_NUMBER, *wxRED);
+    gs_stc->StyleSetForeground(wxSTC_C_STRING, wxColour(0, 128, 0));
+    gs_stc->StyleSetForeground(wxSTC_C_COMMENTLINE, wxColour(128, 128, 128));
+
+    wxString text;
+    const int count = GetLinesCount();
+    for ( int n = 0; n < count; n++ )
+    {
+        text += wxString::Format
+                (
+                    "    if ( value%d > %d ) return Compute(\"item %d\", %d); "
+                    "// line %d\n",
+                    n % 17, n, n, n % 101, n
+                );
+    }
+
+    gs_stc->SetText(text);
+
+    gs_frame->Show();
+    gs_frame->Update();
+
+    return true;
+}
+
+static bool InitMonospace()
+{
+    return InitControl(wxFONTFAMILY_TELETYPE);
+}
+
+static bool InitProportional()
+{
+    return InitControl(wxFONTFAMILY_SWISS);
+}
+
+static void DoneControl()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_stc = NULL;
+}
+
+// Scroll the control by one page, wrapping around at the end, and redraw it
+// immediately: the time of each run is the time of a single frame.
+static bool ScrollOnePage()
+{
+    Bench::SetWorkAmount(1, "frames");
+
+    const int page = gs_stc->LinesOnScreen();
+    int line = gs_stc->GetFirstVisibleLine() + page;
+    if ( line + page >= gs_stc->GetLineCount() )
+        line = 0;
+
+    gs_stc->SetFirstVisibleLine(line);
+    gs_stc->Refresh();
+    gs_stc->Update();
+
+    return gs_stc->GetFirstVisibleLine() == line;
+}
+
+BENCHMARK_FUNC_WITH_INIT(STCScrollMonospace, InitMonospace, DoneControl)
+{
+    return ScrollOnePage();
+}
+
+BENCHMARK_FUNC_WITH_INIT(STCScrollProportional, InitProportional, DoneControl)
+{
+    return ScrollOnePage();
+}
+
+#endif // wxUSE_STC
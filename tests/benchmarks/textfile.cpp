@@ -0,0 +1,200 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/textfile.cpp
+// Purpose:     wxTextFile benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_TEXTFILE
+
+#include "wx/ffile.h"
+#include "wx/filefn.h"
+#include "wx/filename.h"
+#include "wx/textfile.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+
+// The size of the file used by the benchmarks below in MB is given by the
+// numeric parameter and is 20 by default.
+static size_t GetFileSize()
+{
+    const long size = Bench::GetNumericParameter();
+
+    return (size ? size : 20)*1024*1024;
+}
+
+static wxString gs_filename;
+static size_t gs_linesCount = 0;
+
+// The maximal amount of memory used by the opened file, only available under
+// Linux where it's computed as the growth of the process private memory.
+static size_t gs_memoryUsed = 0;
+
+static size_t GetPrivateMemory()
+{
+#ifdef __LINUX__
+    wxFFile statm("/proc/self/statm", "r");
+    if ( !statm.IsOpened() )
+        return 0;
+
+    unsigned long total, resident, shared;
+    if ( fscanf(statm.fp(), "%lu %lu %lu", &total, &resident, &shared) != 3 )
+        return 0;
+
+    return (resident - shared)*getpagesize();
+#else
+    return 0;
+#endif
+}
+
+static void UpdateMemoryUsed(size_t memoryBefore)
+{
+    const size_t memoryAfter = GetPrivateMemory();
+    if ( memoryAfter > memoryBefore && memoryAfter - memoryBefore > gs_memoryUsed )
+        gs_memoryUsed = memoryAfter - memoryBefore;
+}
+
+// Generate a log-like file, mostly ASCII but with some other characters too.
+static bool InitTextFile()
+{
+    gs_filename = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_filename.empty() )
+        return false;
+
+    wxFFile file(gs_filename, "wb");
+    if ( !file.IsOpened() )
+        return false;
+
+    const size_t size = GetFileSize();
+    size_t written = 0;
+    for ( gs_linesCount = 0; written < size; gs_linesCount++ )
+    {
+        const int rc = fprintf
+                       (
+                        file.fp(),
+                        "2026-10-18 12:%02d:%02d [thread %d] Processing item #%d "
+                        "(%s) completed successfully.\n",
+                        int(gs_linesCount / 60 % 60), int(gs_linesCount % 60),
+                        int(gs_linesCount % 8), int(gs_linesCount),
+                        gs_linesCount % 10 ? "ok" : "\xc3\xa9t\xc3\xa9"
+                       );
+        if ( rc < 0 )
+            return false;
+
+        written += rc;
+    }
+
+    gs_memoryUsed = 0;
+
+    return file.Close();
+}
+
+static void DoneTextFile()
+{
+    if ( gs_memoryUsed )
+    {
+        wxPrintf("Memory used by the file: %luKB\n",
+                 (unsigned long)(gs_memoryUsed / 1024));
+    }
+
+    wxRemoveFile(gs_filename);
+    gs_filename.clear();
+}
+
+static void SetFileWorkAmount()
+{
+    Bench::SetWorkAmount(GetFileSize() / (1024.*1024.), "MB");
+}
+
+// Open the file and get its first line.
+static bool DoOpen(bool mapped)
+{
+    const size_t memoryBefore = GetPrivateMemory();
+
+    wxTextFile file;
+    if ( !(mapped ? file.OpenMapped(gs_filename) : file.Open(gs_filename)) )
+        return false;
+
+    if ( !file.GetFirstLine().StartsWith("2026-10-18 12:00:00") )
+        return false;
+
+    UpdateMemoryUsed(memoryBefore);
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileOpen, InitTextFile, DoneTextFile)
+{
+    return DoOpen(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileOpenMapped, InitTextFile, DoneTextFile)
+{
+    return DoOpen(true);
+}
+
+// Open the file and count its lines without accessing them.
+static bool DoCount(bool mapped)
+{
+    SetFileWorkAmount();
+
+    wxTextFile file;
+    if ( !(mapped ? file.OpenMapped(gs_filename) : file.Open(gs_filename)) )
+        return false;
+
+    return file.GetLineCount() == gs_linesCount;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileCount, InitTextFile, DoneTextFile)
+{
+    return DoCount(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileCountMapped, InitTextFile, DoneTextFile)
+{
+    return DoCount(true);
+}
+
+// Open the file and iterate over all of its lines.
+static bool DoIterate(bool mapped)
+{
+    SetFileWorkAmount();
+
+    const size_t memoryBefore = GetPrivateMemory();
+
+    wxTextFile file;
+    if ( !(mapped ? file.OpenMapped(gs_filename) : file.Open(gs_filename)) )
+        return false;
+
+    size_t count = 0,
+           length = 0;
+    for ( wxString str = file.GetFirstLine();
+          !file.Eof();
+          str = file.GetNextLine() )
+    {
+        count++;
+        length += str.length();
+    }
+
+    UpdateMemoryUsed(memoryBefore);
+
+    return count == gs_linesCount && length > count;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileIterate, InitTextFile, DoneTextFile)
+{
+    return DoIterate(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextFileIterateMapped, InitTextFile, DoneTextFile)
+{
+    return DoIterate(true);
+}
+
+#endif // wxUSE_TEXTFILE
@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timer.cpp
+// Purpose:     wxTimer benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_TIMER
+
+#include "wx/evtloop.h"
+#include "wx/stopwatch.h"
+#include "wx/timer.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+// The number of timers used by the benchmark below in thousands is given by
+// the numeric parameter and is 100 by default.
+static size_t GetTimersCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return (count ? count : 100)*1000;
+}
+
+namespace
+{
+
+// Timer just counting the number of times it expired.
+class CountingTimer : public wxTimer
+{
+public:
+    explicit CountingTimer(size_t& count) : m_count(count) { }
+
+    virtual void Notify() wxOVERRIDE { m_count++; }
+
+private:
+    size_t& m_count;
+};
+
+} // anonymous namespace
+
+// Start many one-shot timers with intervals spread over 100ms, stop half of
+// them, restart a quarter of all timers and wait until the others expire.
+BENCHMARK_FUNC(TimerChurn)
+{
+    const size_t count = GetTimersCount();
+    Bench::SetWorkAmount(count / 1000., "thousands of timers");
+
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    size_t expired = 0;
+
+    wxVector<CountingTimer*> timers;
+    timers.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        CountingTimer* const timer = new CountingTimer(expired);
+        timer->StartOnce(1 + (n*7919) % 100);
+        timers.push_back(timer);
+    }
+
+    for ( size_t n = 0; n < count; n += 2 )
+        timers[n]->Stop();
+
+    for ( size_t n = 0; n < count; n += 4 )
+        timers[n]->StartOnce(1 + (n*104729) % 100);
+
+    const size_t expected = count / 2 + (count + 3) / 4;
+    // all timers expire in 100ms, so waiting for longer means they're lost
+    wxStopWatch sw;
+    while ( expired < expected && sw.Time() < 10000 )
+        loop.DispatchTimeout(100);
+
+    for ( size_t n = 0; n < count; n++ )
+        delete timers[n];
+
+    return expired == expected;
+}
+
+#endif // wxUSE_TIMER
@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/translations.cpp
+// Purpose:     wxMsgCatalog loading benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_INTL
+
+#include "wx/buffer.h"
+#include "wx/file.h"
+#include "wx/filefn.h"
+#include "wx/filename.h"
+#include "wx/scopedptr.h"
+#include "wx/translation.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+// The number of messages in the catalog used by the benchmarks below is given
+// by the numeric parameter and is 20000 by default.
+static int GetMessagesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 20000;
+}
+
+// The number of messages looked up after loading the catalog, this is
+// supposed to correspond to the number of strings translated when starting
+// the application.
+static const int LOOKUPS_COUNT = 200;
+
+static void FormatMsgId(char* buf, int n)
+{
+    sprintf(buf, "Message number %d", n);
+}
+
+// Hash function used by the .mo files hash table.
+static wxUint32 GetMsgIdHash(const char* str)
+{
+    wxUint32 hval = 0;
+    for ( ; *str; ++str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str);
+
+        const wxUint32 g = hval & (static_cast<wxUint32>(0xf) << 28);
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+static bool IsPrime(wxUint32 n)
+{
+    for ( wxUint32 d = 2; d*d <= n; d++ )
+    {
+        if ( n % d == 0 )
+            return false;
+    }
+
+    return true;
+}
+
+static void AppendUint32(wxMemoryBuffer& buf, wxUint32 value)
+{
+    buf.AppendData(&value, sizeof(value));
+}
+
+// Compare the indices of the msgids by the msgids themselves.
+class MsgIdLess
+{
+public:
+    explicit MsgIdLess(const wxVector<wxCharBuffer>& msgids)
+        : m_msgids(msgids)
+    {
+    }
+
+    bool operator()(wxUint32 n1, wxUint32 n2) const
+    {
+        return strcmp(m_msgids[n1], m_msgids[n2]) < 0;
+    }
+
+private:
+    const wxVector<wxCharBuffer>& m_msgids;
+};
+
+static wxString gs_catalogFile;
+
+// Create a catalog file similar to the ones produced by msgfmt, i.e. with the
+// sorted messages and the hash table.
+static bool InitCatalog()
+{
+    const wxUint32 count = GetMessagesCount();
+
+    // Notice that the header entry, with the empty msgid, comes first.
+    wxVector<wxCharBuffer> origs, trans;
+    origs.push_back(wxCharBuffer(""));
+    trans.push_back(wxCharBuffer("Content-Type: text/plain; charset=UTF-8\n"));
+
+    wxVector<wxCharBuffer> msgids;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        char buf[64];
+        FormatMsgId(buf, n);
+        msgids.push_back(wxCharBuffer(buf));
+    }
+
+    // The messages in the catalog must be sorted by their msgids.
+    wxVector<wxUint32> order;
+    order.reserve(count);
+    for ( wxUint32 n = 0; n < count; n++ )
+        order.push_back(n);
+
+    std::sort(order.begin(), order.end(), MsgIdLess(msgids));
+
+    for ( wxUint32 i = 0; i < count; i++ )
+    {
+        const wxUint32 n = order[i];
+        char buf[64];
+        sprintf(buf, "Traduction du message num\xc3\xa9ro %u", n);
+
+        origs.push_back(msgids[n]);
+        trans.push_back(wxCharBuffer(buf));
+    }
+
+    const wxUint32 numStrings = origs.size();
+
+    wxUint32 hashSize = numStrings * 4 / 3;
+    while ( !IsPrime(hashSize) )
+        hashSize++;
+
+    wxVector<wxUint32> hashTable(hashSize, 0);
+    for ( wxUint32 n = 0; n < numStrings; n++ )
+    {
+        const wxUint32 hval = GetMsgIdHash(origs[n]);
+        const wxUint32 incr = 1 + hval % (hashSize - 2);
+        wxUint32 idx = hval % hashSize;
+        while ( hashTable[idx] )
+        {
+            if ( idx >= hashSize - incr )
+                idx -= hashSize - incr;
+            else
+                idx += incr;
+        }
+
+        hashTable[idx] = n + 1;
+    }
+
+    const wxUint32 ofsOrigTable = 28;
+    const wxUint32 ofsTransTable = ofsOrigTable + 8*numStrings;
+    const wxUint32 ofsHashTable = ofsTransTable + 8*numStrings;
+    const wxUint32 ofsStrings = ofsHashTable + 4*hashSize;
+
+    wxMemoryBuffer buf;
+    AppendUint32(buf, 0x950412de);
+    AppendUint32(buf, 0);
+    AppendUint32(buf, numStrings);
+    AppendUint32(buf, ofsOrigTable);
+    AppendUint32(buf, ofsTransTable);
+    AppendUint32(buf, hashSize);
+    AppendUint32(buf, ofsHashTable);
+
+    wxMemoryBuffer strings;
+    for ( int table = 0; table < 2; table++ )
+    {
+        const wxVector<wxCharBuffer>& v = table ? trans : origs;
+        for ( wxUint32 n = 0; n < numStrings; n++ )
+        {
+            const size_t len = strlen(v[n]);
+            AppendUint32(buf, len);
+            AppendUint32(buf, ofsStrings + strings.GetDataLen());
+
+            strings.AppendData(v[n].data(), len + 1);
+        }
+    }
+
+    for ( wxUint32 n = 0; n < hashSize; n++ )
+        AppendUint32(buf, hashTable[n]);
+
+    buf.AppendData(strings.GetData(), strings.GetDataLen());
+
+    gs_catalogFile = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_catalogFile.empty() )
+        return false;
+
+    wxFile file(gs_catalogFile, wxFile::write);
+    return file.IsOpened() && file.Write(buf.GetData(), buf.GetDataLen());
+}
+
+static void DoneCatalog()
+{
+    if ( !gs_catalogFile.empty() )
+    {
+        wxRemoveFile(gs_catalogFile);
+        gs_catalogFile.clear();
+    }
+}
+
+// Load the catalog and translate a few strings from it, as it happens during
+// the application startup.
+static bool LoadAndTranslate(int flags)
+{
+    wxScopedPtr<wxMsgCatalog>
+        cat(wxMsgCatalog::CreateFromFile(gs_catalogFile, "bench", flags));
+    if ( !cat )
+        return false;
+
+    const int count = GetMessagesCount();
+    for ( int n = 0; n < LOOKUPS_COUNT; n++ )
+    {
+        char buf[64];
+        FormatMsgId(buf, n * (count / LOOKUPS_COUNT));
+        if ( !cat->GetString(buf) )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(MsgCatalogLoad, InitCatalog, DoneCatalog)
+{
+    return LoadAndTranslate(wxMSGCATALOG_DEFAULT);
+}
+
+BENCHMARK_FUNC_WITH_INIT(MsgCatalogLoadLazy, InitCatalog, DoneCatalog)
+{
+    return LoadAndTranslate(wxMSGCATALOG_LAZY);
+}
+
+#endif // wxUSE_INTL
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/treectrl.cpp
+// Purpose:     wxGenericTreeCtrl benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_TREECTRL
+
+#include "wx/frame.h"
+#include "wx/treectrl.h"
+#include "wx/generic/treectlg.h"
+
+#include "bench.h"
+
+// The number of items in the tree used by the benchmarks below is given by
+// the numeric parameter and is 1000 by default, use 1000000 to check that
+// the time taken by painting doesn't depend on it.
+static long GetItemsCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 1000;
+}
+
+// The items are organized in branches of this many items each.
+static const long ITEMS_PER_BRANCH = 100;
+
+static wxFrame* gs_frame = NULL;
+static wxGenericTreeCtrl* gs_tree = NULL;
+static wxTreeItemId gs_branchMiddle;
+
+static bool InitTree()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxGenericTreeCtrl benchmark",
+                           wxDefaultPosition, wxSize(400, 600));
+    gs_tree = new wxGenericTreeCtrl(gs_frame, wxID_ANY,
+                                    wxDefaultPosition, wxDefaultSize,
+                                    wxTR_DEFAULT_STYLE | wxTR_HIDE_ROOT);
+
+    gs_tree->Freeze();
+
+    const wxTreeItemId root = gs_tree->AddRoot("Root");
+    wxTreeItemId branch;
+    const long count = GetItemsCount();
+    for ( long n = 0; n < count; n++ )
+    {
+        if ( n % ITEMS_PER_BRANCH == 0 )
+        {
+            branch = gs_tree->AppendItem(root, wxString::Format("Branch %ld", n));
+            if ( n <= count / 2 )
+                gs_branchMiddle = branch;
+        }
+        else
+            gs_tree->AppendItem(branch, wxString::Format("Item %ld", n));
+    }
+
+    gs_tree->ExpandAll();
+
+    gs_tree->Thaw();
+
+    gs_frame->Show();
+    gs_frame->Update();
+
+    return true;
+}
+
+static void DoneTree()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_tree = NULL;
+    gs_branchMiddle = wxTreeItemId();
+}
+
+// Scroll the tree by one page, wrapping around at the end, and redraw it
+// immediately: the time of each run is the time of a single frame.
+BENCHMARK_FUNC_WITH_INIT(TreeCtrlScroll, InitTree, DoneTree)
+{
+    Bench::SetWorkAmount(1, "frames");
+
+    int x, y;
+    gs_tree->GetViewStart(&x, &y);
+
+    const int page = gs_tree->GetClientSize().y / 10;
+    y += page;
+    if ( y + page >= gs_tree->GetScrollRange(wxVERTICAL) )
+        y = 0;
+
+    gs_tree->Scroll(x, y);
+    gs_tree->Refresh();
+    gs_tree->Update();
+
+    return gs_tree->GetScrollPos(wxVERTICAL) == y;
+}
+
+// Find the item under a point in the middle of the window.
+BENCHMARK_FUNC_WITH_INIT(TreeCtrlHitTest, InitTree, DoneTree)
+{
+    Bench::SetWorkAmount(1, "hit tests");
+
+    const wxSize size = gs_tree->GetClientSize();
+
+    int flags = 0;
+    return gs_tree->HitTest(wxPoint(size.x / 4, size.y / 2), flags).IsOk();
+}
+
+// Expand and collapse a branch in the middle of the tree.
+BENCHMARK_FUNC_WITH_INIT(TreeCtrlToggle, InitTree, DoneTree)
+{
+    Bench::SetWorkAmount(1, "toggles");
+
+    gs_tree->Collapse(gs_branchMiddle);
+    gs_tree->Expand(gs_branchMiddle);
+    gs_tree->Update();
+
+    return gs_tree->IsExpanded(gs_branchMiddle);
+}
+
+#endif // wxUSE_TREECTRL
@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/txtstrm.cpp
+// Purpose:     wxTextInputStream benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_STREAMS && wxUSE_UNICODE
+
+#include "wx/mstream.h"
+#include "wx/strconv.h"
+#include "wx/txtstrm.h"
+
+#include "bench.h"
+
+// The size of the text used by the benchmarks below in MB is given by the
+// numeric parameter and is 10 by default.
+static size_t GetTextSize()
+{
+    const long size = Bench::GetNumericParameter();
+
+    return (size ? size : 10)*1024*1024;
+}
+
+static wxCharBuffer gs_textUTF8;
+static wxCharBuffer gs_textUTF16;
+static int gs_linesCount = 0;
+
+// Generate a log-like text, mostly ASCII but with some other characters too.
+static wxString GenerateText()
+{
+    wxString text;
+    const size_t size = GetTextSize();
+    for ( gs_linesCount = 0; text.length() < size; gs_linesCount++ )
+    {
+        text += wxString::Format
+                (
+                    "2026-10-18 12:%02d:%02d [thread %d] Processing item #%d "
+                    "(%s) completed successfully.\n",
+                    gs_linesCount / 60 % 60, gs_linesCount % 60,
+                    gs_linesCount % 8, gs_linesCount,
+                    gs_linesCount % 10 ? wxString("ok")
+                                       : wxString::FromUTF8("\xc3\xa9t\xc3\xa9")
+                );
+    }
+
+    return text;
+}
+
+static bool InitTextUTF8()
+{
+    gs_textUTF8 = GenerateText().utf8_str();
+
+    return gs_textUTF8.length() != 0;
+}
+
+static void DoneTextUTF8()
+{
+    gs_textUTF8.reset();
+}
+
+static bool InitTextUTF16()
+{
+    gs_textUTF16 = GenerateText().mb_str(wxMBConvUTF16LE());
+
+    return gs_textUTF16.length() != 0;
+}
+
+static void DoneTextUTF16()
+{
+    gs_textUTF16.reset();
+}
+
+// Read all the lines using either the traditional ReadLine() overload,
+// decoding the text one character at a time, or the one decoding it in
+// blocks.
+static bool ReadAllLines(const wxCharBuffer& buf, const wxMBConv& conv,
+                         bool bulk)
+{
+    Bench::SetWorkAmount(buf.length() / (1024.*1024.), "MB");
+
+    wxMemoryInputStream mis(buf.data(), buf.length());
+    wxTextInputStream tis(mis, " \t", conv);
+
+    int count = 0;
+    if ( bulk )
+    {
+        wxString line;
+        while ( tis.ReadLine(line) )
+            count++;
+    }
+    else
+    {
+        for ( ;; )
+        {
+            const wxString line = tis.ReadLine();
+            if ( mis.Eof() && line.empty() )
+                break;
+
+            count++;
+        }
+    }
+
+    return count == gs_linesCount;
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextStreamReadLineUTF8, InitTextUTF8, DoneTextUTF8)
+{
+    return ReadAllLines(gs_textUTF8, wxConvUTF8, false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextStreamReadLineBulkUTF8, InitTextUTF8, DoneTextUTF8)
+{
+    return ReadAllLines(gs_textUTF8, wxConvUTF8, true);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextStreamReadLineUTF16, InitTextUTF16, DoneTextUTF16)
+{
+    return ReadAllLines(gs_textUTF16, wxMBConvUTF16LE(), false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TextStreamReadLineBulkUTF16, InitTextUTF16, DoneTextUTF16)
+{
+    return ReadAllLines(gs_textUTF16, wxMBConvUTF16LE(), true);
+}
+
+#endif // wxUSE_STREAMS && wxUSE_UNICODE
@@ -0,0 +1,225 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/xml.cpp
+// Purpose:     wxXmlDocument and wxXmlReader benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_XML
+
+#include "wx/buffer.h"
+#include "wx/stream.h"
+#include "wx/utils.h"
+#include "wx/xml/xml.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// The size of the documents used by the benchmarks below in MB is given by
+// the numeric parameter and is 10 by default.
+static size_t GetDocumentSize()
+{
+    const long size = Bench::GetNumericParameter();
+
+    return (size ? size : 10)*1024*1024;
+}
+
+// Stream generating a document of the given size on the fly, so that the
+// documents much bigger than the available memory can be used too:
+//
+//  <catalog>
+//    <items>
+//      <item id="0" type="book"><name>Item 0</name><price>...</price></item>
+//      ...
+//    </items>
+//  </catalog>
+class XmlGeneratorStream : public wxInputStream
+{
+public:
+    explicit XmlGeneratorStream(size_t size)
+        : m_size(size)
+    {
+        m_generated = 0;
+        m_itemsCount = 0;
+        m_pos = 0;
+        m_done = false;
+
+        Append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<catalog>\n"
+               "  <items>\n");
+    }
+
+    int GetItemsCount() const { return m_itemsCount; }
+
+protected:
+    virtual size_t OnSysRead(void *buffer, size_t size) wxOVERRIDE
+    {
+        char *p = static_cast<char *>(buffer);
+        size_t read = 0;
+        while ( read < size )
+        {
+            if ( m_pos == m_buf.GetDataLen() )
+            {
+                if ( !GenerateMore() )
+                    break;
+            }
+
+            const size_t len = wxMin(size - read, m_buf.GetDataLen() - m_pos);
+            memcpy(p + read, static_cast<char *>(m_buf.GetData()) + m_pos, len);
+            m_pos += len;
+            read += len;
+        }
+
+        if ( !read )
+            m_lasterror = wxSTREAM_EOF;
+
+        return read;
+    }
+
+private:
+    void Append(const char *s)
+    {
+        m_buf.AppendData(s, strlen(s));
+    }
+
+    bool GenerateMore()
+    {
+        if ( m_done )
+            return false;
+
+        m_generated += m_buf.GetDataLen();
+        m_buf.SetDataLen(0);
+        m_pos = 0;
+
+        if ( m_generated >= m_size )
+        {
+            Append("  </items>\n"
+                   "</catalog>\n");
+            m_done = true;
+            return true;
+        }
+
+        // generate several items at once to avoid doing it for every read and
+        // don't use wxString here as this would take longer than parsing them
+        for ( int n = 0; n < 100; n++, m_itemsCount++ )
+        {
+            char item[256];
+            const int len = sprintf
+                            (
+                                item,
+                                "    <item id=\"%d\" type=\"%s\">"
+                                "<name>Item %d</name>"
+                                "<price currency=\"EUR\">%d.99</price>"
+                                "</item>\n",
+                                m_itemsCount,
+                                m_itemsCount % 10 ? "book" : "record",
+                                m_itemsCount,
+                                m_itemsCount % 100
+                            );
+            m_buf.AppendData(item, len);
+        }
+
+        return true;
+    }
+
+    const size_t m_size;
+
+    wxMemoryBuffer m_buf;
+    size_t m_pos;
+    size_t m_generated;
+    int m_itemsCount;
+    bool m_done;
+
+    wxDECLARE_NO_COPY_CLASS(XmlGeneratorStream);
+};
+
+static void SetDocumentWorkAmount()
+{
+    Bench::SetWorkAmount(GetDocumentSize() / (1024.*1024.), "MB");
+}
+
+// Load the entire document in memory: notice that this requires several
+// times more memory than the size of the document.
+BENCHMARK_FUNC(XmlDocumentLoad)
+{
+    SetDocumentWorkAmount();
+
+    XmlGeneratorStream stream(GetDocumentSize());
+    wxXmlDocument doc;
+    if ( !doc.Load(stream) )
+        return false;
+
+    int count = 0;
+    for ( wxXmlNode* node = doc.GetRoot()->GetChildren()->GetChildren();
+          node;
+          node = node->GetNext() )
+    {
+        count++;
+    }
+
+    return count == stream.GetItemsCount();
+}
+
+// Iterate over all the items in the document, using a constant amount of
+// memory independently of its size.
+BENCHMARK_FUNC(XmlReaderNext)
+{
+    SetDocumentWorkAmount();
+
+    XmlGeneratorStream stream(GetDocumentSize());
+    wxXmlReader reader(stream);
+
+    int count = 0;
+    while ( reader.Next() != wxXML_EVENT_EOF )
+    {
+        if ( reader.GetEvent() == wxXML_EVENT_START_ELEMENT &&
+                reader.GetDepth() == 3 )
+            count++;
+    }
+
+    return !reader.HasError() && count == stream.GetItemsCount();
+}
+
+// Load only some of the elements as wxXmlNode objects.
+BENCHMARK_FUNC(XmlReaderFindElement)
+{
+    SetDocumentWorkAmount();
+
+    XmlGeneratorStream stream(GetDocumentSize());
+    wxXmlReader reader(stream);
+
+    int count = 0;
+    while ( reader.FindElement("catalog/items/item") )
+    {
+        if ( reader.GetAttribute("type") == "record" )
+        {
+            wxXmlNode* const node = reader.ReadElement();
+            if ( !node )
+                return false;
+
+            delete node;
+            count++;
+        }
+    }
+
+    return !reader.HasError() && count == (stream.GetItemsCount() + 9) / 10;
+}
+
+// Skip all the elements without creating any items for them at all.
+BENCHMARK_FUNC(XmlReaderSkipElement)
+{
+    SetDocumentWorkAmount();
+
+    XmlGeneratorStream stream(GetDocumentSize());
+    wxXmlReader reader(stream);
+
+    return !reader.FindElement("catalog/nosuchelement") && !reader.HasError();
+}
+
+#endif // wxUSE_XML
@@ -0,0 +1,209 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/zip.cpp
+// Purpose:     Zip archives benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
+#include "wx/filename.h"
+#include "wx/filesys.h"
+#include "wx/fs_arc.h"
+#include "wx/mstream.h"
+#include "wx/scopedptr.h"
+#include "wx/wfstream.h"
+#include "wx/zipstrm.h"
+
+#include "bench.h"
+
+static wxString gs_zipFile;
+static wxString gs_zipURL;
+static wxArchiveFSHandler* gs_handler = NULL;
+static wxFileSystem* gs_fs = NULL;
+
+// The archive contains this many entries by default, the numeric parameter
+// can be used to change it.
+static long GetEntriesCount()
+{
+    const long count = Bench::GetNumericParameter();
+
+    return count ? count : 10000;
+}
+
+static wxString GetEntryName(long n)
+{
+    return wxString::Format("dir%ld/entry%ld.txt", n % 100, n);
+}
+
+static bool InitZip()
+{
+    gs_zipFile = wxFileName::CreateTempFileName("wxbench");
+    if ( gs_zipFile.empty() )
+        return false;
+
+    {
+        wxFFileOutputStream out(gs_zipFile);
+        wxZipOutputStream zip(out);
+
+        const long count = GetEntriesCount();
+        for ( long n = 0; n < count; n++ )
+        {
+            zip.PutNextEntry(GetEntryName(n));
+
+            for ( int line = 0; line < 20; line++ )
+            {
+                const wxScopedCharBuffer
+                    buf = wxString::Format("Line %d of entry %ld\n", line, n)
+                            .ToAscii();
+                zip.Write(buf.data(), buf.length());
+            }
+        }
+
+        if ( !zip.Close() )
+            return false;
+    }
+
+    gs_zipURL = wxFileSystem::FileNameToURL(wxFileName(gs_zipFile)) + "#zip:";
+
+    gs_handler = new wxArchiveFSHandler;
+    wxFileSystem::AddHandler(gs_handler);
+
+    gs_fs = new wxFileSystem;
+
+    return true;
+}
+
+static void DoneZip()
+{
+    wxDELETE(gs_fs);
+
+    if ( gs_handler )
+    {
+        wxFileSystem::RemoveHandler(gs_handler);
+        delete gs_handler;
+        gs_handler = NULL;
+    }
+
+    if ( !gs_zipFile.empty() )
+    {
+        wxRemoveFile(gs_zipFile);
+        gs_zipFile.clear();
+    }
+}
+
+// Read the entire stream and return the number of bytes read.
+static size_t ReadAll(wxInputStream& stream)
+{
+    char buf[4096];
+    size_t total = 0;
+    while ( stream.Read(buf, sizeof(buf)).LastRead() )
+        total += stream.LastRead();
+
+    return total;
+}
+
+static bool OpenEntryFS(wxFileSystem& fs, long n)
+{
+    wxScopedPtr<wxFSFile> file(fs.OpenFile(gs_zipURL + GetEntryName(n)));
+
+    return file && ReadAll(*file->GetStream()) != 0;
+}
+
+// Open the last entry of the archive using a new wxFileSystem object, which
+// doesn't have the archive catalog cached yet, as it happens when a program
+// opens a help file or a resource archive for the first time.
+BENCHMARK_FUNC_WITH_INIT(ZipFSOpenArchive, InitZip, DoneZip)
+{
+    Bench::SetWorkAmount(1, "archives");
+
+    wxFileSystem fs;
+    return OpenEntryFS(fs, GetEntriesCount() - 1);
+}
+
+// Open many different entries of the same archive using the same wxFileSystem
+// and so reusing the catalog cached by wxArchiveFSHandler.
+BENCHMARK_FUNC_WITH_INIT(ZipFSOpenEntries, InitZip, DoneZip)
+{
+    const long count = GetEntriesCount();
+    const long step = count > 1000 ? count / 1000 : 1;
+
+    Bench::SetWorkAmount(count / step, "entries");
+
+    for ( long n = 0; n < count; n += step )
+    {
+        if ( !OpenEntryFS(*gs_fs, n) )
+            return false;
+    }
+
+    return true;
+}
+
+// The same as ZipFSOpenArchive but using wxZipInputStream directly, which is
+// what wxArchiveFSHandler does for the archives which are not local files.
+BENCHMARK_FUNC_WITH_INIT(ZipStreamOpenArchive, InitZip, DoneZip)
+{
+    Bench::SetWorkAmount(1, "archives");
+
+    wxFFileInputStream in(gs_zipFile);
+    wxZipInputStream zip(in);
+
+    const wxString name = GetEntryName(GetEntriesCount() - 1);
+    wxZipEntry* entry;
+    while ( (entry = zip.GetNextEntry()) != NULL )
+    {
+        const bool found = entry->GetName(wxPATH_UNIX) == name;
+        delete entry;
+
+        if ( found )
+            return ReadAll(zip) != 0;
+    }
+
+    return false;
+}
+
+// Create an archive with the same entries as the one used above in memory.
+static bool CreateZip(bool parallel)
+{
+    const long count = GetEntriesCount();
+
+    Bench::SetWorkAmount(count, "entries");
+
+    wxMemoryOutputStream mem;
+    wxZipOutputStream zip(mem);
+    if ( parallel && !zip.EnableParallelCompression() )
+        return false;
+
+    for ( long n = 0; n < count; n++ )
+    {
+        zip.PutNextEntry(GetEntryName(n));
+
+        for ( int line = 0; line < 20; line++ )
+        {
+            const wxScopedCharBuffer
+                buf = wxString::Format("Line %d of entry %ld\n", line, n)
+                        .ToAscii();
+            zip.Write(buf.data(), buf.length());
+        }
+    }
+
+    return zip.Close();
+}
+
+BENCHMARK_FUNC(ZipCreate)
+{
+    return CreateZip(false);
+}
+
+// The same as above but compressing the entries in the threads of the shared
+// wxThreadPool.
+BENCHMARK_FUNC(ZipCreateParallel)
+{
+    return CreateZip(true);
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
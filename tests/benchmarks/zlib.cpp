@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/zlib.cpp
+// Purpose:     wxZlibOutputStream benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_ZLIB && wxUSE_STREAMS
+
+#include "wx/buffer.h"
+#include "wx/mstream.h"
+#include "wx/zstream.h"
+
+#include "bench.h"
+
+static wxMemoryBuffer gs_zlibData;
+
+// Generate text-like data of the size given by the numeric parameter, in MiB,
+// or 16MiB by default.
+static bool InitZlibData()
+{
+    const long size = Bench::GetNumericParameter();
+
+    const size_t len = (size ? size : 16) * 1024 * 1024;
+    while ( gs_zlibData.GetDataLen() < len )
+    {
+        const size_t n = gs_zlibData.GetDataLen();
+        const wxScopedCharBuffer
+            buf = wxString::Format("%lu: value %lu, checksum %lx\n",
+                                   static_cast<unsigned long>(n),
+                                   static_cast<unsigned long>(n * 7919 % 10007),
+                                   static_cast<unsigned long>(n * 2654435761u))
+                    .ToAscii();
+        gs_zlibData.AppendData(buf.data(), buf.length());
+    }
+
+    return true;
+}
+
+static void DoneZlibData()
+{
+    gs_zlibData.Clear();
+}
+
+static bool CompressData(bool parallel)
+{
+    Bench::SetWorkAmount(gs_zlibData.GetDataLen() / 1024, "KiB");
+
+    wxMemoryOutputStream mem;
+    wxZlibOutputStream zout(mem);
+    if ( parallel && !zout.EnableParallelCompression() )
+        return false;
+
+    zout.Write(gs_zlibData.GetData(), gs_zlibData.GetDataLen());
+
+    return zout.Close() && mem.GetSize() != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(ZlibCompress, InitZlibData, DoneZlibData)
+{
+    return CompressData(false);
+}
+
+// The same as above but compressing the blocks in the threads of the shared
+// wxThreadPool.
+BENCHMARK_FUNC_WITH_INIT(ZlibCompressParallel, InitZlibData, DoneZlibData)
+{
+    return CompressData(true);
+}
+
+#endif // wxUSE_ZLIB && wxUSE_STREAMS
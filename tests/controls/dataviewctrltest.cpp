@@ -412,4 +412,114 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+namespace
+{
+
+// Values used by the model below, notice that some of them are duplicated.
+const char* const gs_sortValues[] = { "b", "a", "c", "a", "b" };
+
+// Simple list model with a single string column.
+class SortTestModel : public wxDataViewIndexListModel
+{
+public:
+    explicit SortTestModel(bool sortByValue)
+        : wxDataViewIndexListModel(WXSIZEOF(gs_sortValues)),
+          m_sortByValue(sortByValue)
+    {
+    }
+
+    virtual unsigned int GetColumnCount() const wxOVERRIDE { return 1; }
+
+    virtual wxString GetColumnType(unsigned int WXUNUSED(col)) const wxOVERRIDE
+    {
+        return "string";
+    }
+
+    virtual void GetValueByRow(wxVariant& variant,
+                               unsigned int row,
+                               unsigned int WXUNUSED(col)) const wxOVERRIDE
+    {
+        variant = gs_sortValues[row];
+    }
+
+    virtual bool SetValueByRow(const wxVariant& WXUNUSED(variant),
+                               unsigned int WXUNUSED(row),
+                               unsigned int WXUNUSED(col)) wxOVERRIDE
+    {
+        return false;
+    }
+
+    virtual bool CanSortByValue() const wxOVERRIDE { return m_sortByValue; }
+
+private:
+    const bool m_sortByValue;
+};
+
+// Return the indices of the model rows in the order in which they are shown.
+wxString GetDisplayedRows(wxDataViewCtrl* dvc, SortTestModel* model)
+{
+    const unsigned count = model->GetCount();
+
+    wxVector<int> positions;
+    for ( unsigned n = 0; n < count; n++ )
+        positions.push_back(dvc->GetItemRect(model->GetItem(n)).y);
+
+    wxVector<unsigned> rowsByPosition(count);
+    for ( unsigned n = 0; n < count; n++ )
+    {
+        unsigned above = 0;
+        for ( unsigned m = 0; m < count; m++ )
+        {
+            if ( positions[m] < positions[n] )
+                above++;
+        }
+
+        rowsByPosition[above] = n;
+    }
+
+    wxString rows;
+    for ( unsigned n = 0; n < count; n++ )
+    {
+        if ( n )
+            rows += ' ';
+        rows << rowsByPosition[n];
+    }
+
+    return rows;
+}
+
+void CheckSort(bool sortByValue)
+{
+    wxDataViewCtrl* const dvc = new wxDataViewCtrl(wxTheApp->GetTopWindow(),
+                                                   wxID_ANY,
+                                                   wxDefaultPosition,
+                                                   wxSize(400, 200));
+
+    wxObjectDataPtr<SortTestModel> model(new SortTestModel(sortByValue));
+    dvc->AssociateModel(model.get());
+
+    wxDataViewColumn* const col = dvc->AppendTextColumn("Value", 0);
+    col->SetSortable(true);
+    dvc->Layout();
+
+    // Items with the same value are ordered by their IDs.
+    col->SetSortOrder(true);
+    model->Resort();
+    CHECK( GetDisplayedRows(dvc, model.get()) == "1 3 0 4 2" );
+
+    col->SetSortOrder(false);
+    model->Resort();
+    CHECK( GetDisplayedRows(dvc, model.get()) == "2 4 0 3 1" );
+
+    delete dvc;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxDVC::Sort", "[wxDataViewCtrl][sort]")
+{
+    SECTION("Compare") { CheckSort(false); }
+    SECTION("Value") { CheckSort(true); }
+}
+
 #endif //wxUSE_DATAVIEWCTRL
@@ -1751,6 +1751,62 @@ TEST_CASE_METHOD(GridTestCase, "Grid::CellAttribute", "[attr][cell][grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AttrCache", "[attr][cell][grid]")
+{
+    const wxColour defColour = m_grid->GetDefaultCellBackgroundColour();
+
+    // Looking up the same cell again must use the cached attribute.
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == defColour );
+
+    size_t hits = 0;
+    m_grid->GetAttrCacheStatistics(&hits, NULL);
+
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == defColour );
+
+    size_t hitsNew = 0;
+    m_grid->GetAttrCacheStatistics(&hitsNew, NULL);
+    CHECK( hitsNew > hits );
+
+    // But changing the row, column or cell attribute must invalidate it.
+    wxGridCellAttr* attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxRED);
+    m_grid->SetRowAttr(0, attr);
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxRED );
+    CHECK( m_grid->GetCellBackgroundColour(1, 0) == defColour );
+
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxBLUE);
+    m_grid->SetColAttr(1, attr);
+    CHECK( m_grid->GetCellBackgroundColour(1, 1) == *wxBLUE );
+
+    m_grid->SetCellBackgroundColour(0, 0, *wxGREEN);
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxGREEN );
+
+    m_grid->SetAttr(0, 0, NULL);
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == *wxRED );
+
+    // Inserting a row shifts the row attribute down.
+    m_grid->InsertRows(0);
+    CHECK( m_grid->GetCellBackgroundColour(0, 0) == defColour );
+    CHECK( m_grid->GetCellBackgroundColour(1, 0) == *wxRED );
+
+    // Changing the attributes behind the grid's back requires refreshing them,
+    // notably because the absence of an attribute is cached too.
+    CHECK( m_grid->GetCellBackgroundColour(2, 2) == defColour );
+
+    wxGridTableBase* const table = m_grid->GetTable();
+    attr = new wxGridCellAttr;
+    attr->SetBackgroundColour(*wxGREEN);
+    table->GetAttrProvider()->SetAttr(attr, 2, 2);
+    m_grid->RefreshAttrs();
+    CHECK( m_grid->GetCellBackgroundColour(2, 2) == *wxGREEN );
+
+    // And replacing the provider must not use the old attributes.
+    table->SetAttrProvider(new wxGridCellAttrProvider);
+    CHECK( m_grid->GetCellBackgroundColour(1, 0) == defColour );
+    CHECK( m_grid->GetCellBackgroundColour(2, 2) == defColour );
+}
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
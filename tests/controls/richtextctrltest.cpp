@@ -60,6 +60,9 @@ private:
         CPPUNIT_TEST( Delete );
         CPPUNIT_TEST( Url );
         CPPUNIT_TEST( Table );
+        CPPUNIT_TEST( PositionLookup );
+        CPPUNIT_TEST( StyleUndoRedo );
+        CPPUNIT_TEST( ReplaceChild );
     CPPUNIT_TEST_SUITE_END();
 
     void IsModified();
@@ -91,6 +94,9 @@ private:
     void Delete();
     void Url();
     void Table();
+    void PositionLookup();
+    void StyleUndoRedo();
+    void ReplaceChild();
 
     wxRichTextCtrl* m_rich;
 
@@ -878,4 +884,142 @@ void RichTextCtrlTestCase::Table()
     m_rich->SetFocusObject(NULL);
 }
 
+// Check that the position lookup functions return the same results as
+// iterating over all paragraphs.
+static void CheckPositionLookup(wxRichTextParagraphLayoutBox& box)
+{
+    const long last = box.GetOwnRange().GetEnd() + 1;
+    for ( long pos = 0; pos <= last; pos += 3 )
+    {
+        wxRichTextParagraph* expected = NULL;
+        wxRichTextObjectList::compatibility_iterator node;
+        for ( node = box.GetChildren().GetFirst(); node; node = node->GetNext() )
+        {
+            if ( node->GetData()->GetRange().Contains(pos) )
+            {
+                expected = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+                break;
+            }
+        }
+
+        wxRichTextParagraph* const para = box.GetParagraphAtPosition(pos);
+        CPPUNIT_ASSERT( para == expected );
+
+        wxRichTextObject* const leaf = box.GetLeafObjectAtPosition(pos);
+        if ( para )
+        {
+            CPPUNIT_ASSERT( leaf );
+            CPPUNIT_ASSERT( leaf->GetParent() == para );
+
+            wxRichTextLine* const line = box.GetLineAtPosition(pos);
+            CPPUNIT_ASSERT( line );
+            CPPUNIT_ASSERT( line->GetParent() == para );
+        }
+    }
+}
+
+void RichTextCtrlTestCase::PositionLookup()
+{
+    wxString text;
+    for ( int n = 0; n < 1000; n++ )
+        text += wxString::Format("Paragraph %d\n", n);
+
+    m_rich->BeginSuppressUndo();
+    m_rich->GetBuffer().AddParagraphs(text);
+    m_rich->EndSuppressUndo();
+
+    m_rich->LayoutContent();
+    CheckPositionLookup(m_rich->GetBuffer());
+
+    // The last line is returned for positions past the end.
+    wxRichTextLine* const line = m_rich->GetBuffer().GetLineAtPosition(100000);
+    CPPUNIT_ASSERT( line );
+    CPPUNIT_ASSERT( line->GetParent() == m_rich->GetBuffer().GetChildren().GetLast()->GetData() );
+
+    // Check that the lookups still work after adding or removing paragraphs.
+    m_rich->Delete(wxRichTextRange(100, 250));
+    m_rich->LayoutContent();
+    CheckPositionLookup(m_rich->GetBuffer());
+
+    m_rich->SetInsertionPoint(500);
+    m_rich->WriteText("several\nnew\nparagraphs");
+    m_rich->LayoutContent();
+    CheckPositionLookup(m_rich->GetBuffer());
+
+    m_rich->Undo();
+    m_rich->LayoutContent();
+    CheckPositionLookup(m_rich->GetBuffer());
+}
+
+// Applying styles to several paragraphs replaces them with their modified
+// copies, check that the lookups don't use the deleted paragraphs then.
+void RichTextCtrlTestCase::StyleUndoRedo()
+{
+    for ( int n = 0; n < 10; n++ )
+        m_rich->WriteText(wxString::Format("Paragraph %d\n", n));
+
+    m_rich->LayoutContent();
+    CheckPositionLookup(m_rich->GetBuffer());
+
+    // This spans 5 paragraphs.
+    const wxRichTextRange range(15, 70);
+
+    wxRichTextAttr attr;
+    attr.SetFontWeight(wxFONTWEIGHT_BOLD);
+    CPPUNIT_ASSERT( m_rich->SetStyle(range, attr) );
+    CheckPositionLookup(m_rich->GetBuffer());
+    CPPUNIT_ASSERT( m_rich->HasCharacterAttributes(range, attr) );
+
+    wxRichTextAttr paraAttr;
+    paraAttr.SetAlignment(wxTEXT_ALIGNMENT_CENTRE);
+    CPPUNIT_ASSERT( m_rich->SetStyle(range, paraAttr) );
+    CPPUNIT_ASSERT( m_rich->HasParagraphAttributes(range, paraAttr) );
+    CheckPositionLookup(m_rich->GetBuffer());
+
+    for ( int n = 0; n < 2; n++ )
+    {
+        m_rich->Undo();
+        CheckPositionLookup(m_rich->GetBuffer());
+        m_rich->LayoutContent();
+    }
+
+    CPPUNIT_ASSERT( !m_rich->HasCharacterAttributes(range, attr) );
+    CPPUNIT_ASSERT( !m_rich->HasParagraphAttributes(range, paraAttr) );
+
+    for ( int n = 0; n < 2; n++ )
+    {
+        m_rich->Redo();
+        CheckPositionLookup(m_rich->GetBuffer());
+        m_rich->LayoutContent();
+    }
+
+    CPPUNIT_ASSERT( m_rich->HasCharacterAttributes(range, attr) );
+    CPPUNIT_ASSERT( m_rich->HasParagraphAttributes(range, paraAttr) );
+}
+
+// Removing a paragraph and inserting another one doesn't change the number of
+// paragraphs, check that the lookups don't use the deleted paragraph anyhow.
+void RichTextCtrlTestCase::ReplaceChild()
+{
+    for ( int n = 0; n < 10; n++ )
+        m_rich->WriteText(wxString::Format("Paragraph %d\n", n));
+
+    m_rich->LayoutContent();
+
+    wxRichTextParagraphLayoutBox& buffer = m_rich->GetBuffer();
+    CheckPositionLookup(buffer);
+
+    const size_t count = buffer.GetChildCount();
+    wxRichTextObject* const old = buffer.GetChild(3);
+    CPPUNIT_ASSERT( buffer.RemoveChild(old, true) );
+
+    wxRichTextParagraph* const para = new wxRichTextParagraph("Replacement");
+    buffer.InsertChild(para, buffer.GetChild(3));
+    CPPUNIT_ASSERT_EQUAL( count, buffer.GetChildCount() );
+
+    buffer.UpdateRanges();
+    m_rich->LayoutContent();
+    CheckPositionLookup(buffer);
+}
+
 #endif //wxUSE_RICHTEXT
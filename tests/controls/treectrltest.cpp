@@ -58,6 +58,7 @@ private:
         CPPUNIT_TEST( Bold );
         CPPUNIT_TEST( Visible );
         CPPUNIT_TEST( Sort );
+        CPPUNIT_TEST( HitTest );
         WXUISIM_TEST( KeyNavigation );
         CPPUNIT_TEST( HasChildren );
         CPPUNIT_TEST( SelectItemSingle );
@@ -86,6 +87,7 @@ private:
     void Bold();
     void Visible();
     void Sort();
+    void HitTest();
     void KeyNavigation();
     void HasChildren();
     void GetCount();
@@ -611,6 +613,40 @@ void TreeCtrlTestCase::Sort()
     CPPUNIT_ASSERT_EQUAL(zitem, m_tree->GetNextChild(m_root, cookie));
 }
 
+// check that HitTest() finds the item in the middle of its label
+static void CheckHitTest(wxTreeCtrl* tree, const wxTreeItemId& item)
+{
+    wxRect rect;
+    CPPUNIT_ASSERT( tree->GetBoundingRect(item, rect, true) );
+
+    int flags = 0;
+    CPPUNIT_ASSERT_EQUAL( item, tree->HitTest(rect.GetPosition() +
+                                              rect.GetSize() / 2, flags) );
+    CPPUNIT_ASSERT( flags & wxTREE_HITTEST_ONITEMLABEL );
+}
+
+void TreeCtrlTestCase::HitTest()
+{
+    CheckHitTest(m_tree, m_child1);
+    CheckHitTest(m_tree, m_grandchild);
+    CheckHitTest(m_tree, m_child2);
+
+    m_tree->Collapse(m_child1);
+    CheckHitTest(m_tree, m_child2);
+
+    const wxTreeItemId item = m_tree->InsertItem(m_root, 0, "first");
+    CheckHitTest(m_tree, item);
+    CheckHitTest(m_tree, m_child2);
+
+    m_tree->Expand(m_child1);
+    CheckHitTest(m_tree, m_grandchild);
+    CheckHitTest(m_tree, m_child2);
+
+    m_tree->Delete(item);
+    CheckHitTest(m_tree, m_child1);
+    CheckHitTest(m_tree, m_child2);
+}
+
 void TreeCtrlTestCase::KeyNavigation()
 {
 #if wxUSE_UIACTIONSIMULATOR
@@ -14,6 +14,7 @@
 
 
 #include "wx/event.h"
+#include "wx/app.h"
 
 // ----------------------------------------------------------------------------
 // test events and their handlers
@@ -507,6 +508,170 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+namespace
+{
+
+// Handler giving access to the size of its dynamic event table.
+class TableSizeHandler : public wxEvtHandler
+{
+public:
+    // Return the index of the last bound entry in the table, which includes
+    // the unbound entries that haven't been pruned yet.
+    size_t GetLastEntryIndex() const
+    {
+        size_t cookie;
+        return GetFirstDynamicEntry(cookie) ? cookie : static_cast<size_t>(-1);
+    }
+};
+
+// Unbinds all the idle handlers and itself when it gets an event.
+class UnbindAll
+{
+public:
+    UnbindAll(wxEvtHandler& handler, int count)
+        : m_handler(handler), m_count(count)
+    {
+    }
+
+    void OnMyEvent(MyEvent& event)
+    {
+        for ( int n = 0; n < m_count; n++ )
+            CHECK( m_handler.Unbind(wxEVT_IDLE, GlobalOnIdle) );
+
+        CHECK( m_handler.Unbind(MyEventType, &UnbindAll::OnMyEvent, this) );
+
+        // Let the other handler process the event too.
+        event.Skip();
+    }
+
+private:
+    wxEvtHandler& m_handler;
+    const int m_count;
+
+    wxDECLARE_NO_COPY_CLASS(UnbindAll);
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::BindUnbindRepeatedly", "[event][bind][unbind]")
+{
+    TableSizeHandler handler;
+    MyHandler sink;
+    handler.Bind(MyEventType, &MyHandler::OnMyEvent, &sink);
+
+    // Idle events are never sent to this handler, but the unbound entries
+    // must still be removed from the table.
+    for ( int n = 0; n < 1000; n++ )
+    {
+        handler.Bind(wxEVT_IDLE, GlobalOnIdle);
+        CHECK( handler.Unbind(wxEVT_IDLE, GlobalOnIdle) );
+    }
+
+    handler.Bind(wxEVT_IDLE, GlobalOnIdle);
+    CHECK( handler.GetLastEntryIndex() < 10 );
+
+    g_called.Reset();
+    MyEvent e;
+    handler.ProcessEvent(e);
+    CHECK( g_called.method );
+}
+
+TEST_CASE("Event::UnbindDuringDispatch", "[event][bind][unbind]")
+{
+    TableSizeHandler handler;
+    MyHandler sink;
+    handler.Bind(MyEventType, &MyHandler::OnMyEvent, &sink);
+
+    const int count = 10;
+    for ( int n = 0; n < count; n++ )
+        handler.Bind(wxEVT_IDLE, GlobalOnIdle);
+
+    // This handler is called first and unbinds most of the table while the
+    // event is being dispatched, which must not prevent the handler bound
+    // before it from being called.
+    UnbindAll unbinder(handler, count);
+    handler.Bind(MyEventType, &UnbindAll::OnMyEvent, &unbinder);
+
+    g_called.Reset();
+    MyEvent e;
+    handler.ProcessEvent(e);
+    CHECK( g_called.method );
+
+    // The unbound entries are removed once the dispatch is over.
+    CHECK( handler.GetLastEntryIndex() == 0 );
+
+    g_called.Reset();
+    handler.ProcessEvent(e);
+    CHECK( g_called.method );
+
+    wxIdleEvent idle;
+    handler.ProcessEvent(idle);
+    CHECK( !g_called.function );
+}
+
+namespace
+{
+
+// Handler counting the events it gets and optionally deleting itself.
+class QueueHandler : public wxEvtHandler
+{
+public:
+    QueueHandler(int& count, bool deleteSelf = false)
+        : m_count(count),
+          m_deleteSelf(deleteSelf)
+    {
+        Bind(MyEventType, &QueueHandler::OnMyEvent, this);
+    }
+
+private:
+    void OnMyEvent(MyEvent&)
+    {
+        m_count++;
+
+        if ( m_deleteSelf )
+            delete this;
+    }
+
+    int& m_count;
+    const bool m_deleteSelf;
+
+    wxDECLARE_NO_COPY_CLASS(QueueHandler);
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::QueueEvent", "[event][queue]")
+{
+    int count = 0;
+
+    SECTION("All")
+    {
+        QueueHandler handler(count);
+
+        // Queue enough events to require growing the queue a few times.
+        for ( int n = 0; n < 100; n++ )
+            handler.QueueEvent(new MyEvent);
+
+        CHECK( count == 0 );
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( count == 100 );
+    }
+
+    SECTION("DeleteSelf")
+    {
+        QueueHandler* const handler = new QueueHandler(count, true);
+
+        for ( int n = 0; n < 10; n++ )
+            handler->QueueEvent(new MyEvent);
+
+        // The handler is destroyed after processing the first event and the
+        // remaining events must be just discarded.
+        wxTheApp->ProcessPendingEvents();
+        CHECK( count == 1 );
+    }
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
@@ -36,12 +36,14 @@ private:
     CPPUNIT_TEST_SUITE( DirTestCase );
         CPPUNIT_TEST( DirExists );
         CPPUNIT_TEST( Traverse );
+        CPPUNIT_TEST( TraverseParallel );
         CPPUNIT_TEST( Enum );
         CPPUNIT_TEST( GetName );
     CPPUNIT_TEST_SUITE_END();
 
     void DirExists();
     void Traverse();
+    void TraverseParallel();
     void Enum();
     void GetName();
 
@@ -172,6 +174,108 @@ void DirTestCase::Traverse()
     CPPUNIT_ASSERT_EQUAL(6, traverser.dirs.size());
 }
 
+// Records all the items in the order in which they are found, ignoring the
+// directories with the given name.
+class RecordingDirTraverser : public wxDirTraverser
+{
+public:
+    explicit RecordingDirTraverser(const wxString& ignore = wxString())
+        : m_ignore(ignore)
+    {
+    }
+
+    wxArrayString items;
+
+    virtual wxDirTraverseResult OnFile(const wxString& filename) wxOVERRIDE
+    {
+        items.push_back("file " + filename);
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
+    {
+        items.push_back("dir " + dirname);
+        return wxFileName(dirname).GetFullName() == m_ignore ? wxDIR_IGNORE
+                                                             : wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnOpenError(const wxString& dirname) wxOVERRIDE
+    {
+        items.push_back("error " + dirname);
+        return wxDIR_IGNORE;
+    }
+
+private:
+    const wxString m_ignore;
+};
+
+void DirTestCase::TraverseParallel()
+{
+    // add more directories to make the test more meaningful
+    for ( int n = 0; n < 20; n++ )
+    {
+        const wxString subdir = wxString::Format("%s%cfolder2%csub%d",
+                                                 DIRTEST_FOLDER, SEP, SEP, n);
+        wxDir::Make(subdir + SEP + "subsub", wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+        CreateTempFile(subdir + SEP + "dummy");
+        CreateTempFile(subdir + SEP + "subsub" + SEP + "dummy.foo");
+    }
+
+    wxDir dir(DIRTEST_FOLDER);
+
+    const wxString ignores[] = { wxString(), "folder3", "sub7" };
+    for ( size_t n = 0; n < WXSIZEOF(ignores); n++ )
+    {
+        RecordingDirTraverser sequential(ignores[n]);
+        const size_t count = dir.Traverse(sequential);
+
+        // the order of the items must be the same
+        RecordingDirTraverser parallel(ignores[n]);
+        CPPUNIT_ASSERT_EQUAL( count,
+                              dir.Traverse(parallel, wxEmptyString,
+                                           wxDIR_DEFAULT | wxDIR_PARALLEL) );
+        CPPUNIT_ASSERT( sequential.items == parallel.items );
+
+        // but may be different for the unordered traversal
+        RecordingDirTraverser unordered(ignores[n]);
+        CPPUNIT_ASSERT_EQUAL( count,
+                              dir.Traverse(unordered, wxEmptyString,
+                                           wxDIR_DEFAULT | wxDIR_PARALLEL |
+                                           wxDIR_UNORDERED) );
+        sequential.items.Sort();
+        unordered.items.Sort();
+        CPPUNIT_ASSERT( sequential.items == unordered.items );
+    }
+
+    wxArrayString files;
+    CPPUNIT_ASSERT_EQUAL( 21, wxDir::GetAllFiles(DIRTEST_FOLDER, &files, "*.foo",
+                                                 wxDIR_DEFAULT | wxDIR_PARALLEL) );
+
+#ifdef __UNIX__
+    // the directory remains opened after being removed, but can't be read
+    // again by the parallel traversal, check that the error is reported in
+    // the same way in both cases
+    const wxString removed = DIRTEST_FOLDER + SEP + "removed";
+    CPPUNIT_ASSERT( wxDir::Make(removed) );
+
+    wxDir dirRemoved(removed);
+    CPPUNIT_ASSERT( wxDir::Remove(removed) );
+
+    RecordingDirTraverser ordered;
+    CPPUNIT_ASSERT_EQUAL( 0, dirRemoved.Traverse(ordered, wxEmptyString,
+                                                 wxDIR_DEFAULT | wxDIR_PARALLEL) );
+
+    RecordingDirTraverser unordered;
+    CPPUNIT_ASSERT_EQUAL( 0, dirRemoved.Traverse(unordered, wxEmptyString,
+                                                 wxDIR_DEFAULT | wxDIR_PARALLEL |
+                                                 wxDIR_UNORDERED) );
+
+    CPPUNIT_ASSERT_EQUAL( 1, ordered.items.size() );
+    CPPUNIT_ASSERT_EQUAL( "error " + removed, ordered.items[0] );
+    CPPUNIT_ASSERT( ordered.items == unordered.items );
+#endif // __UNIX__
+}
+
 void DirTestCase::DirExists()
 {
     struct
@@ -21,8 +21,17 @@
 
 #if wxUSE_FILESYSTEM
 
+#include "wx/fs_arc.h"
 #include "wx/fs_mem.h"
+#include "wx/file.h"
+#include "wx/mstream.h"
 #include "wx/scopedptr.h"
+#include "wx/wfstream.h"
+#include "wx/zipstrm.h"
+
+#include "testfile.h"
+
+#include <algorithm>
 
 // ----------------------------------------------------------------------------
 // helpers
@@ -224,4 +233,174 @@ TEST_CASE("wxFileSystem::MemoryFSHandler", "[filesys][memoryfshandler][find]")
     CHECK( fs.FindNext() == "" );
 }
 
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
+// Read the entire contents of the given URL into a string.
+static wxString ReadURL(wxFileSystem& fs, const wxString& url)
+{
+    wxScopedPtr<wxFSFile> file(fs.OpenFile(url));
+    if ( !file )
+        return "<missing>";
+
+    wxMemoryOutputStream mos;
+    mos.Write(*file->GetStream());
+
+    const size_t len = mos.GetLength();
+    wxCharBuffer buf(len);
+    mos.CopyTo(buf.data(), len);
+
+    return wxString::FromAscii(buf.data(), len);
+}
+
+TEST_CASE("wxFileSystem::ArchiveFSHandler", "[filesys][archivefshandler]")
+{
+    class AutoArchiveFSHandler
+    {
+    public:
+        AutoArchiveFSHandler()
+            : m_handler(new wxArchiveFSHandler())
+        {
+            wxFileSystem::AddHandler(m_handler.get());
+        }
+
+        ~AutoArchiveFSHandler()
+        {
+            wxFileSystem::RemoveHandler(m_handler.get());
+        }
+
+    private:
+        wxScopedPtr<wxArchiveFSHandler> const m_handler;
+    } autoArchiveFSHandler;
+
+    TempFile zipFile(wxFileName::CreateTempFileName("wxtest"));
+
+    wxString deflated;
+    for ( int n = 0; n < 1000; n++ )
+        deflated += wxString::Format("Line %d of the deflated entry\n", n);
+
+    {
+        wxFFileOutputStream out(zipFile.GetName());
+        wxZipOutputStream zip(out);
+
+        zip.PutNextDirEntry("dir");
+
+        wxZipEntry* const stored = new wxZipEntry("dir/stored.txt");
+        stored->SetMethod(wxZIP_METHOD_STORE);
+        zip.PutNextEntry(stored);
+        zip.Write("stored contents", 15);
+
+        zip.PutNextEntry("deflated.txt");
+        const wxScopedCharBuffer buf = deflated.ToAscii();
+        zip.Write(buf.data(), buf.length());
+
+        REQUIRE( zip.Close() );
+    }
+
+    const wxString
+        url = wxFileSystem::FileNameToURL(wxFileName(zipFile.GetName()));
+
+    wxFileSystem fs;
+
+    CHECK( ReadURL(fs, url + "#zip:dir/stored.txt") == "stored contents" );
+    CHECK( ReadURL(fs, url + "#zip:deflated.txt") == deflated );
+    CHECK( !fs.OpenFile(url + "#zip:missing.txt") );
+
+    wxScopedPtr<wxFSFile> file(fs.OpenFile(url + "#zip:deflated.txt"));
+    REQUIRE( file );
+    CHECK( file->GetStream()->GetLength() ==
+            static_cast<wxFileOffset>(deflated.length()) );
+
+    wxString found;
+    for ( wxString f = fs.FindFirst(url + "#zip:*");
+          !f.empty();
+          f = fs.FindNext() )
+    {
+        found << f.AfterLast(':') << ";";
+    }
+    CHECK( found == "/dir;deflated.txt;" );
+
+    CHECK( fs.FindFirst(url + "#zip:dir/*", wxFILE).AfterLast(':') ==
+            "dir/stored.txt" );
+
+    // Check that the checksum of the stored entries is verified.
+    {
+        TempFile badFile(wxFileName::CreateTempFileName("wxtest"));
+        {
+            wxFFileOutputStream out(badFile.GetName());
+            wxZipOutputStream zip(out);
+
+            wxZipEntry* const stored = new wxZipEntry("bad.txt");
+            stored->SetMethod(wxZIP_METHOD_STORE);
+            zip.PutNextEntry(stored);
+            zip.Write("stored contents", 15);
+
+            REQUIRE( zip.Close() );
+        }
+
+        // Corrupt the entry data without changing its size.
+        {
+            wxFile f(badFile.GetName(), wxFile::read_write);
+            const size_t len = static_cast<size_t>(f.Length());
+            wxCharBuffer buf(len);
+            REQUIRE( f.Read(buf.data(), len) == static_cast<ssize_t>(len) );
+
+            const char* const
+                data = std::search(buf.data(), buf.data() + len,
+                                   "stored", "stored" + 6);
+            REQUIRE( data != buf.data() + len );
+
+            REQUIRE( f.Seek(data - buf.data()) != wxInvalidOffset );
+            REQUIRE( f.Write("S", 1) == 1 );
+        }
+
+        char buf[64];
+
+        wxScopedPtr<wxFSFile> good(fs.OpenFile(url + "#zip:dir/stored.txt"));
+        REQUIRE( good );
+        good->GetStream()->Read(buf, sizeof(buf));
+        CHECK( good->GetStream()->LastRead() == 15 );
+        CHECK( good->GetStream()->GetLastError() != wxSTREAM_READ_ERROR );
+
+        const wxString badURL =
+            wxFileSystem::FileNameToURL(wxFileName(badFile.GetName()));
+
+        wxScopedPtr<wxFSFile> bad(fs.OpenFile(badURL + "#zip:bad.txt"));
+        REQUIRE( bad );
+        bad->GetStream()->Read(buf, sizeof(buf));
+        CHECK( bad->GetStream()->LastRead() == 15 );
+        CHECK( bad->GetStream()->GetLastError() == wxSTREAM_READ_ERROR );
+    }
+
+#ifndef __WINDOWS__
+    // Check that replacing the archive is detected, while the streams opened
+    // before still read the old one. This can't be done under MSW where the
+    // mapped file can't be replaced.
+    {
+        TempFile newFile(wxFileName::CreateTempFileName("wxtest"));
+        {
+            wxFFileOutputStream out(newFile.GetName());
+            wxZipOutputStream zip(out);
+
+            zip.PutNextEntry("new.txt");
+            zip.Write("new contents", 12);
+
+            REQUIRE( zip.Close() );
+        }
+
+        REQUIRE( wxRenameFile(newFile.GetName(), zipFile.GetName()) );
+        newFile.Assign(wxString());
+    }
+
+    CHECK( ReadURL(fs, url + "#zip:new.txt") == "new contents" );
+    CHECK( ReadURL(fs, url + "#zip:deflated.txt") == "<missing>" );
+    CHECK( fs.FindFirst(url + "#zip:*").AfterLast(':') == "new.txt" );
+
+    wxMemoryOutputStream mos;
+    mos.Write(*file->GetStream());
+    CHECK( mos.GetLength() == static_cast<wxFileOffset>(deflated.length()) );
+#endif // !__WINDOWS__
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
 #endif // wxUSE_FILESYSTEM
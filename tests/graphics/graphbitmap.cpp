@@ -21,6 +21,10 @@
 
 #include "testimage.h"
 
+#if wxUSE_CAIRO && defined(__WXGTK__)
+    #include <cairo.h>
+#endif
+
 #ifdef __WXMSW__
 // Support for iteration over 32 bpp 0RGB bitmaps
 typedef wxPixelFormat<unsigned char, 32, 2, 1, 0> wxNative32PixelFormat;
@@ -1150,6 +1154,102 @@ TEST_CASE("GraphicsBitmapTestCase::CreateFromImage", "[graphbitmap][create][from
 #endif // wxUSE_GRAPHICS_CAIRO
     }
 }
+
+namespace
+{
+void CheckDrawOnImage(wxGraphicsRenderer* gr)
+{
+    wxImage image(10, 10);
+
+    wxGraphicsContext* gc = gr->CreateContextFromImage(image);
+    REQUIRE(gc != NULL);
+
+    gc->SetPen(*wxTRANSPARENT_PEN);
+    gc->SetBrush(*wxRED_BRUSH);
+    gc->DrawRectangle(2, 2, 3, 3);
+    gc->Flush();
+
+    CHECK(image.GetRed(3, 3) == 255);
+    CHECK(image.GetRed(6, 6) == 0);
+
+    // Drawing after flushing must update the image too, without losing the
+    // previously drawn pixels.
+    gc->DrawRectangle(6, 6, 2, 2);
+    gc->Flush();
+
+    CHECK(image.GetRed(6, 6) == 255);
+    CHECK(image.GetRed(3, 3) == 255);
+    CHECK(image.GetRed(9, 9) == 0);
+
+    // The copies of the image made before flushing must not be affected.
+    const wxImage copy = image;
+    gc->SetBrush(*wxBLUE_BRUSH);
+    gc->DrawRectangle(0, 0, 1, 1);
+    delete gc;
+
+    CHECK(image.GetBlue(0, 0) == 255);
+    CHECK(copy.GetBlue(0, 0) == 0);
+}
+} // anonymous namespace
+
+TEST_CASE("GraphicsBitmapTestCase::DrawOnImage", "[graphbitmap][image][draw]")
+{
+    SECTION("Default GC")
+    {
+        wxGraphicsRenderer* gr = wxGraphicsRenderer::GetDefaultRenderer();
+        REQUIRE(gr != NULL);
+        CheckDrawOnImage(gr);
+    }
+
+#if wxUSE_CAIRO
+    SECTION("Cairo GC")
+    {
+        wxGraphicsRenderer* gr = wxGraphicsRenderer::GetCairoRenderer();
+        REQUIRE(gr != NULL);
+        CheckDrawOnImage(gr);
+    }
+
+#ifdef __WXGTK__
+    SECTION("Cairo native context")
+    {
+        wxGraphicsRenderer* gr = wxGraphicsRenderer::GetCairoRenderer();
+        REQUIRE(gr != NULL);
+
+        wxImage image(10, 10);
+        wxGraphicsContext* gc = gr->CreateContextFromImage(image);
+        REQUIRE(gc != NULL);
+
+        // Draw something using wxGraphicsContext first to check that the
+        // pixels drawn directly on the native context are not lost even if
+        // only the changed area was updated before.
+        gc->SetPen(*wxTRANSPARENT_PEN);
+        gc->SetBrush(*wxRED_BRUSH);
+        gc->DrawRectangle(0, 0, 2, 2);
+        gc->Flush();
+        CHECK(image.GetRed(0, 0) == 255);
+
+        cairo_t* const cr = static_cast<cairo_t*>(gc->GetNativeContext());
+        REQUIRE(cr != NULL);
+
+        cairo_set_source_rgb(cr, 0, 0, 1);
+        cairo_rectangle(cr, 6, 6, 2, 2);
+        cairo_fill(cr);
+        gc->Flush();
+
+        CHECK(image.GetBlue(7, 7) == 255);
+        CHECK(image.GetRed(0, 0) == 255);
+
+        // Drawing on it again after flushing must work too.
+        cairo_rectangle(cr, 3, 3, 2, 2);
+        cairo_fill(cr);
+        delete gc;
+
+        CHECK(image.GetBlue(4, 4) == 255);
+        CHECK(image.GetBlue(9, 9) == 0);
+    }
+#endif // __WXGTK__
+#endif // wxUSE_CAIRO
+}
 #endif // wxUSE_GRAPHICS_CONTEXT
 
 #endif // wxHAS_RAW_BITMAP
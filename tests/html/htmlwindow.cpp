@@ -44,6 +44,7 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( AppendToPageIncremental );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +52,7 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void AppendToPageIncremental();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +168,44 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::AppendToPageIncremental()
+{
+#if wxUSE_CLIPBOARD
+    m_win->SetPage(TEST_MARKUP_LINK);
+    m_win->EnableIncrementalAppend();
+    m_win->AppendToPage("First");
+    m_win->AppendToPage("Second");
+
+    wxString text = m_win->ToText();
+    CPPUNIT_ASSERT( text.StartsWith("link") );
+    CPPUNIT_ASSERT( text.Contains("First") );
+    CPPUNIT_ASSERT( text.Contains("Second") );
+    CPPUNIT_ASSERT( text.Find("First") < text.Find("Second") );
+
+    // Only the last appended fragments must be kept after setting the limit.
+    m_win->SetMaxAppendedFragments(2);
+    m_win->AppendToPage("Third");
+
+    text = m_win->ToText();
+    CPPUNIT_ASSERT( text.StartsWith("link") );
+    CPPUNIT_ASSERT( !text.Contains("First") );
+    CPPUNIT_ASSERT( text.Contains("Second") );
+    CPPUNIT_ASSERT( text.Contains("Third") );
+
+    // Changing the fonts parses the page again, but must preserve it.
+    m_win->SetStandardFonts(12);
+    CPPUNIT_ASSERT_EQUAL( text, m_win->ToText() );
+
+    // And setting a new page forgets about the appended fragments.
+    m_win->SetPage(TEST_MARKUP_LINK);
+    CPPUNIT_ASSERT( !m_win->ToText().Contains("Third") );
+
+    // Appending a fragment without any contents must not lose the page when
+    // it's parsed again neither.
+    m_win->AppendToPage("<!-- nothing -->");
+    m_win->SetStandardFonts(14);
+    CPPUNIT_ASSERT_EQUAL( "link", m_win->ToText() );
+#endif // wxUSE_CLIPBOARD
+}
+
 #endif //wxUSE_HTML
@@ -2108,6 +2108,56 @@ TEST_CASE("wxImage::InitAlpha", "[image][initalpha]")
     }
 }
 
+TEST_CASE("wxImage::Blur", "[image][blur]")
+{
+    // Image with a single white pixel in the middle of a black one.
+    wxImage img(21, 11);
+    img.SetAlpha();
+    memset(img.GetAlpha(), 0, 21*11);
+    img.SetRGB(10, 5, 255, 255, 255);
+    img.SetAlpha(10, 5, 255);
+
+    SECTION("Box")
+    {
+        const wxImage blurred = img.Blur(2);
+        REQUIRE( blurred.IsOk() );
+        REQUIRE( blurred.HasAlpha() );
+
+        // The pixel is spread over the 5*5 square around it.
+        CHECK( blurred.GetRed(10, 5) == 255/25 );
+        CHECK( blurred.GetGreen(8, 3) == 255/25 );
+        CHECK( blurred.GetAlpha(12, 7) == 255/25 );
+        CHECK( blurred.GetBlue(7, 5) == 0 );
+        CHECK( blurred.GetAlpha(10, 2) == 0 );
+
+        // Pixels beyond the edges are the same as the edge ones.
+        img.SetRGB(0, 0, 250, 250, 250);
+        CHECK( img.BlurHorizontal(1).GetRed(0, 0) == 500/3 );
+        CHECK( img.BlurVertical(1).GetRed(0, 0) == 500/3 );
+
+        // Blur with the radius bigger than the image size works too.
+        CHECK( img.Blur(100).IsOk() );
+    }
+
+    SECTION("Gaussian")
+    {
+        const wxImage blurred = img.BlurGaussian(1.5);
+        REQUIRE( blurred.IsOk() );
+
+        // The result is symmetric and decreases away from the centre.
+        CHECK( blurred.GetRed(9, 5) == blurred.GetRed(11, 5) );
+        CHECK( blurred.GetRed(10, 4) == blurred.GetRed(10, 6) );
+        CHECK( blurred.GetRed(10, 5) > blurred.GetRed(11, 5) );
+        CHECK( blurred.GetRed(11, 5) > blurred.GetRed(12, 5) );
+        CHECK( blurred.GetRed(12, 5) > blurred.GetRed(13, 5) );
+        CHECK( blurred.GetRed(0, 0) == 0 );
+
+        // Zero deviation results in the copy of the image.
+        const wxImage copy = img.BlurGaussian(0);
+        CHECK( memcmp(copy.GetData(), img.GetData(), 21*11*3) == 0 );
+    }
+}
+
 /*
     TODO: add lots of more tests to wxImage functions
 */
@@ -18,6 +18,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/intl.h"
+#include "wx/scopedptr.h"
 
 #if wxUSE_INTL
 
@@ -226,4 +227,162 @@ void IntlTestCase::IsAvailable()
     CPPUNIT_ASSERT_EQUAL( origLocale, setlocale(LC_ALL, NULL) );
 }
 
+// ----------------------------------------------------------------------------
+// wxMsgCatalog tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Entry of the catalog created by CreateCatalogData().
+struct CatalogEntry
+{
+    const char* orig;
+    size_t origLen;
+    const char* trans;
+    size_t transLen;
+};
+
+// This macro allows to use strings with embedded NULs as used for the plurals.
+#define CATALOG_ENTRY(orig, trans) { orig, sizeof(orig) - 1, trans, sizeof(trans) - 1 }
+
+void AppendUint32(wxMemoryBuffer& buf, wxUint32 value)
+{
+    buf.AppendData(&value, sizeof(value));
+}
+
+// Return the data of a .mo file, without the hash table, with the given
+// entries, which must be sorted.
+wxScopedCharBuffer CreateCatalogData(const CatalogEntry* entries, size_t count)
+{
+    const wxUint32 n = count;
+    const wxUint32 ofsOrigTable = 28;
+    const wxUint32 ofsTransTable = ofsOrigTable + 8*n;
+    const wxUint32 ofsStrings = ofsTransTable + 8*n;
+
+    wxMemoryBuffer buf;
+    AppendUint32(buf, 0x950412de);      // magic
+    AppendUint32(buf, 0);               // revision
+    AppendUint32(buf, n);
+    AppendUint32(buf, ofsOrigTable);
+    AppendUint32(buf, ofsTransTable);
+    AppendUint32(buf, 0);               // hash table size
+    AppendUint32(buf, ofsStrings);      // hash table offset
+
+    wxMemoryBuffer strings;
+    for ( int table = 0; table < 2; table++ )
+    {
+        for ( size_t i = 0; i < count; i++ )
+        {
+            const char* const str = table ? entries[i].trans : entries[i].orig;
+            const size_t len = table ? entries[i].transLen : entries[i].origLen;
+
+            AppendUint32(buf, len);
+            AppendUint32(buf, ofsStrings + strings.GetDataLen());
+
+            strings.AppendData(str, len);
+            strings.AppendByte('\0');
+        }
+    }
+
+    buf.AppendData(strings.GetData(), strings.GetDataLen());
+
+    const size_t len = buf.GetDataLen();
+    return wxScopedCharBuffer::CreateOwned(static_cast<char*>(buf.release()), len);
+}
+
+// Check that both catalogs return the same translation.
+void CheckSameString(const wxMsgCatalog& cat1,
+                     const wxMsgCatalog& cat2,
+                     const wxString& str,
+                     unsigned n = UINT_MAX,
+                     const wxString& context = wxString())
+{
+    INFO( "String \"" << str << "\", n=" << n << ", context=" << context );
+
+    const wxString* const s1 = cat1.GetString(str, n, context);
+    const wxString* const s2 = cat2.GetString(str, n, context);
+    if ( !s1 )
+    {
+        CHECK( !s2 );
+        return;
+    }
+
+    REQUIRE( s2 );
+    CHECK( *s1 == *s2 );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxMsgCatalog::Lazy", "[translations]")
+{
+    SECTION("File")
+    {
+        wxScopedPtr<wxMsgCatalog>
+            cat(wxMsgCatalog::CreateFromFile("./intl/fr/internat.mo", "internat"));
+        REQUIRE( cat );
+
+        wxScopedPtr<wxMsgCatalog>
+            lazy(wxMsgCatalog::CreateFromFile("./intl/fr/internat.mo", "internat",
+                                              wxMSGCATALOG_LAZY));
+        REQUIRE( lazy );
+
+        const wxString* const s = lazy->GetString("&Open bogus file");
+        REQUIRE( s );
+        CHECK( *s == "&Ouvrir un fichier" );
+
+        // The same string must be returned by the subsequent calls.
+        CHECK( lazy->GetString("&Open bogus file") == s );
+
+        const wxString* const s2 = lazy->GetString("Enter your number:");
+        REQUIRE( s2 );
+        CHECK( *s2 == wxString::FromUTF8("Entrez votre num\xc3\xa9ro:") );
+
+        CheckSameString(*cat, *lazy, wxString());
+        CheckSameString(*cat, *lazy, "International wxWindows App");
+        CheckSameString(*cat, *lazy, "About Internat");
+        CheckSameString(*cat, *lazy, "Try to guess my number!");
+        CheckSameString(*cat, *lazy, "Not in the catalog");
+        CheckSameString(*cat, *lazy, "&Open bogus file", UINT_MAX, "Bogus");
+    }
+
+    SECTION("Data")
+    {
+        static const CatalogEntry entries[] =
+        {
+            CATALOG_ENTRY("",
+                          "Content-Type: text/plain; charset=UTF-8\n"
+                          "Plural-Forms: nplurals=2; plural=(n != 1);\n"),
+            CATALOG_ENTRY("Open", "Ouvrir"),
+            CATALOG_ENTRY("ctx\x04Open", "Ouvrir dans ce contexte"),
+            CATALOG_ENTRY("file\0files", "fichier\0fichiers"),
+            CATALOG_ENTRY("untranslated", ""),
+        };
+
+        const wxScopedCharBuffer
+            data = CreateCatalogData(entries, WXSIZEOF(entries));
+
+        wxScopedPtr<wxMsgCatalog> cat(wxMsgCatalog::CreateFromData(data, "test"));
+        REQUIRE( cat );
+
+        wxScopedPtr<wxMsgCatalog>
+            lazy(wxMsgCatalog::CreateFromData(data, "test", wxMSGCATALOG_LAZY));
+        REQUIRE( lazy );
+
+        const wxString* const s = lazy->GetString("file", 2);
+        REQUIRE( s );
+        CHECK( *s == "fichiers" );
+
+        CheckSameString(*cat, *lazy, "Open");
+        CheckSameString(*cat, *lazy, "Open", UINT_MAX, "ctx");
+        CheckSameString(*cat, *lazy, "Open", UINT_MAX, "other");
+        CheckSameString(*cat, *lazy, "file");
+        CheckSameString(*cat, *lazy, "file", 1);
+        CheckSameString(*cat, *lazy, "file", 2);
+        CheckSameString(*cat, *lazy, "untranslated");
+        CheckSameString(*cat, *lazy, "nonexistent");
+        CheckSameString(*cat, *lazy, "zzz");
+    }
+}
+
 #endif // wxUSE_INTL
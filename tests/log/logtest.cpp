@@ -18,6 +18,10 @@
     #include "wx/filefn.h"
 #endif // WX_PRECOMP
 
+#include "wx/crt.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+#include "wx/logasync.h"
 #include "wx/scopeguard.h"
 
 #if wxUSE_LOG
@@ -454,6 +458,284 @@ void macroCompilabilityTest()
         wxLogDebug("hello debug %d", 42);
 }
 
+#if wxUSE_THREADS
+
+// Thread logging the given number of messages.
+class LogAsyncThread : public wxThread
+{
+public:
+    LogAsyncThread(int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual void* Entry() wxOVERRIDE
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("thread %d message %d", m_id, n);
+
+        return NULL;
+    }
+
+private:
+    const int m_id;
+    const int m_count;
+
+    wxDECLARE_NO_COPY_CLASS(LogAsyncThread);
+};
+
+// Formatter prefixing the messages with their raw time stamp.
+class LogAsyncFormatter : public wxLogFormatter
+{
+protected:
+    virtual wxString FormatTimeMS(wxLongLong_t msec) const wxOVERRIDE
+    {
+        return wxString::Format("%" wxLongLongFmtSpec "d ", msec);
+    }
+};
+
+// Return the lines of the given file.
+static wxArrayString ReadLogLines(const wxString& filename)
+{
+    wxString contents;
+    wxFFile file(filename);
+    REQUIRE( file.ReadAll(&contents) );
+
+    return wxSplit(contents.BeforeLast('\n'), '\n', '\0');
+}
+
+TEST_CASE("wxLogAsync", "[log][async]")
+{
+    const wxString filename = wxFileName::CreateTempFileName("logasync");
+    REQUIRE( !filename.empty() );
+    wxON_BLOCK_EXIT1(wxRemoveFile, filename);
+
+    wxLogAsync* const log = new wxLogAsync(filename);
+    REQUIRE( log->IsOk() );
+
+    delete log->SetFormatter(new LogAsyncFormatter);
+
+    wxLog* const logOld = wxLog::SetActiveTarget(log);
+    wxON_BLOCK_EXIT1(wxLog::SetActiveTarget, logOld);
+
+    const bool loggingWasEnabled = wxLog::EnableLogging();
+    wxON_BLOCK_EXIT1(wxLog::EnableLogging, loggingWasEnabled);
+
+    SECTION("Threads")
+    {
+        // Use a small buffer to check that blocking works too.
+        log->SetBufferCapacity(16);
+
+        const int numThreads = 4;
+        const int count = 500;
+
+        wxVector<LogAsyncThread*> threads;
+        for ( int n = 0; n < numThreads; n++ )
+        {
+            threads.push_back(new LogAsyncThread(n, count));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        wxLogMessage("main thread message");
+
+        for ( int n = 0; n < numThreads; n++ )
+        {
+            threads[n]->Wait();
+            delete threads[n];
+        }
+
+        log->Flush();
+
+        const wxArrayString lines = ReadLogLines(filename);
+        REQUIRE( lines.size() == numThreads*count + 1 );
+        CHECK( log->GetDroppedCount() == 0 );
+
+        // The messages of each thread must have been written in order.
+        wxVector<int> next(numThreads, 0);
+        for ( size_t n = 0; n < lines.size(); n++ )
+        {
+            int id, num;
+            const wxString msg = lines[n].AfterFirst(' ');
+            if ( msg == "main thread message" )
+                continue;
+
+            INFO( "Line " << n << ": " << lines[n] );
+            REQUIRE( wxSscanf(msg, "thread %d message %d", &id, &num) == 2 );
+            REQUIRE( id >= 0 );
+            REQUIRE( id < numThreads );
+            CHECK( num == next[id]++ );
+        }
+    }
+
+    SECTION("DropNew")
+    {
+        log->SetBufferCapacity(4);
+        log->SetOverflowPolicy(wxLOG_OVERFLOW_DROP_NEW);
+
+        for ( int n = 0; n < 100; n++ )
+            wxLogMessage("message %d", n);
+
+        log->Flush();
+
+        CHECK( ReadLogLines(filename).size() + log->GetDroppedCount() == 100 );
+    }
+
+    SECTION("ThreadExit")
+    {
+        log->SetFlushInterval(5);
+        CHECK( log->GetFlushInterval() == 5 );
+
+        log->SetBufferCapacity(4);
+        log->SetOverflowPolicy(wxLOG_OVERFLOW_DROP_NEW);
+
+        // The buffers of the threads which exited are freed after a while,
+        // but this must not lose neither the messages nor the count of the
+        // dropped ones.
+        const int numThreads = 4;
+        const int count = 50;
+        for ( int round = 0; round < 2; round++ )
+        {
+            for ( int n = 0; n < numThreads; n++ )
+            {
+                LogAsyncThread thread(n, count);
+                REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+                thread.Wait();
+            }
+
+            wxMilliSleep(300);
+        }
+
+        log->Flush();
+
+        CHECK( ReadLogLines(filename).size() + log->GetDroppedCount() ==
+                    2*numThreads*count );
+    }
+
+    SECTION("Timestamp")
+    {
+        const wxLongLong_t before = wxGetUTCTimeMillis().GetValue();
+        wxLogMessage("message");
+        wxMilliSleep(200);
+        log->Flush();
+
+        // The time stamp must correspond to the time when the message was
+        // logged, not when it was written.
+        const wxArrayString lines = ReadLogLines(filename);
+        REQUIRE( lines.size() == 1 );
+        CHECK( lines[0].AfterFirst(' ') == "message" );
+
+        wxLongLong_t timestamp;
+        REQUIRE( lines[0].BeforeFirst(' ').ToLongLong(&timestamp) );
+        CHECK( timestamp >= before );
+        CHECK( timestamp < before + 200 );
+    }
+
+    // Restore the active target before deleting it.
+    wxLog::SetActiveTarget(logOld);
+    delete log;
+}
+
+// Thread-safe log target checking that it's not used after being replaced.
+class ThreadSafeTestLog : public wxLog
+{
+public:
+    ThreadSafeTestLog()
+    {
+        m_replaced = false;
+        m_usedAfterReplace = false;
+    }
+
+    void SetReplaced(bool replaced)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        m_replaced = replaced;
+    }
+
+    bool WasUsedAfterReplace() const
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        return m_usedAfterReplace;
+    }
+
+protected:
+    virtual bool IsThreadSafe() const wxOVERRIDE { return true; }
+
+    virtual void DoLogRecord(wxLogLevel WXUNUSED(level),
+                             const wxString& WXUNUSED(msg),
+                             const wxLogRecordInfo& WXUNUSED(info)) wxOVERRIDE
+    {
+        CheckNotReplaced();
+
+        // Give the main thread a chance to replace us while we're being used.
+        wxMilliSleep(1);
+
+        CheckNotReplaced();
+    }
+
+private:
+    void CheckNotReplaced()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        if ( m_replaced )
+            m_usedAfterReplace = true;
+    }
+
+    mutable wxCriticalSection m_cs;
+    bool m_replaced;
+    bool m_usedAfterReplace;
+};
+
+TEST_CASE("wxLog::ReplaceThreadSafe", "[log]")
+{
+    ThreadSafeTestLog log1,
+                      log2;
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&log1);
+    wxON_BLOCK_EXIT1(wxLog::SetActiveTarget, logOld);
+
+    const bool loggingWasEnabled = wxLog::EnableLogging();
+    wxON_BLOCK_EXIT1(wxLog::EnableLogging, loggingWasEnabled);
+
+    const int numThreads = 4;
+
+    wxVector<LogAsyncThread*> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads.push_back(new LogAsyncThread(n, 200));
+        REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+    }
+
+    // Once SetActiveTarget() returns, the old target must not be used any
+    // more, as it could have been deleted.
+    ThreadSafeTestLog* current = &log1;
+    ThreadSafeTestLog* next = &log2;
+    for ( int n = 0; n < 100; n++ )
+    {
+        next->SetReplaced(false);
+        CHECK( wxLog::SetActiveTarget(next) == current );
+        current->SetReplaced(true);
+
+        wxSwap(current, next);
+        wxMilliSleep(1);
+    }
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    CHECK( !log1.WasUsedAfterReplace() );
+    CHECK( !log2.WasUsedAfterReplace() );
+
+    wxLog::SetActiveTarget(logOld);
+}
+
+#endif // wxUSE_THREADS
+
 // This allows to check wxLogTrace() interactively by running this test with
 // WXTRACE=logtest.
 TEST_CASE("wxLog::Trace", "[log][.]")
@@ -199,11 +199,13 @@ private:
     CPPUNIT_TEST_SUITE( IPCTestCase );
         CPPUNIT_TEST( Connect );
         CPPUNIT_TEST( Execute );
+        CPPUNIT_TEST( Compress );
         CPPUNIT_TEST( Disconnect );
     CPPUNIT_TEST_SUITE_END();
 
     void Connect();
     void Execute();
+    void Compress();
     void Disconnect();
 
     wxDECLARE_NO_COPY_CLASS(IPCTestCase);
@@ -240,6 +242,27 @@ void IPCTestCase::Execute()
     CPPUNIT_ASSERT( conn.Execute(bytes, WXSIZEOF(bytes)) );
 }
 
+void IPCTestCase::Compress()
+{
+#if wxUSE_SOCKETS_FOR_IPC
+    wxConnection& conn = static_cast<wxConnection&>(gs_client->GetConn());
+
+    CPPUNIT_ASSERT( conn.Compress(true) );
+
+    // small data is not compressed but should still work
+    const wxString s("Date");
+    CPPUNIT_ASSERT( conn.Execute(s) );
+
+    // while this is big enough to be compressed
+    wxCharBuffer bytes(4096);
+    memset(bytes.data(), 'x', bytes.length());
+    CPPUNIT_ASSERT( conn.Execute(bytes, bytes.length()) );
+
+    CPPUNIT_ASSERT( conn.Compress(false) );
+    CPPUNIT_ASSERT( conn.Execute(s) );
+#endif // wxUSE_SOCKETS_FOR_IPC
+}
+
 void IPCTestCase::Disconnect()
 {
     if ( gs_client )
@@ -340,4 +340,123 @@ TEST_CASE("wxRegEx::QuoteMeta", "[regex][meta]")
     CHECK( wxRegEx::QuoteMeta(":foo.*bar") == ":foo\\.\\*bar" );
 }
 
+TEST_CASE("wxRegEx::Literal", "[regex][literal]")
+{
+    // check that the matches are not affected by the literal prefilter, i.e.
+    // that optional parts of the pattern are not required to be present
+    static const struct
+    {
+        const char* pattern;
+        const char* text;
+        bool matches;
+        int flags;
+    } data[] =
+    {
+        { "foobar",           "xfoobarx",     true,   wxRE_EXTENDED },
+        { "foobar",           "xfoobax",      false,  wxRE_EXTENDED },
+        { "ab?c",             "ac",           true,   wxRE_EXTENDED },
+        { "abc*",             "ab",           true,   wxRE_EXTENDED },
+        { "abc+d",            "abccd",        true,   wxRE_EXTENDED },
+        { "abc{0,2}d",        "abd",          true,   wxRE_EXTENDED },
+        { "(foo)?bar",        "bar",          true,   wxRE_EXTENDED },
+        { "foo|bar",          "bar",          true,   wxRE_EXTENDED },
+        { "x(foo|bar)y",      "xbary",        true,   wxRE_EXTENDED },
+        { "[[:alpha:]]xyz",   "axyz",         true,   wxRE_EXTENDED },
+        { "[]x]yz",           "]yz",          true,   wxRE_EXTENDED },
+        { "a\\.b",            "a.b",          true,   wxRE_EXTENDED },
+        { "a\\.b",            "axb",          false,  wxRE_EXTENDED },
+        { "FooBar",           "foobar",       true,   wxRE_ICASE },
+        { "ab\\{0,1\\}c",     "ac",           true,   wxRE_BASIC },
+        { "a+b",              "a+b",          true,   wxRE_BASIC },
+        { "a+b",              "aab",          false,  wxRE_BASIC },
+        { "x\\(ab\\)*y",      "xy",           true,   wxRE_BASIC },
+#ifdef wxHAS_REGEX_ADVANCED
+        { "ab\\d*cd",         "abcd",         true,   wxRE_ADVANCED },
+        { "(?:ab)?cd",        "cd",           true,   wxRE_ADVANCED },
+        { "***=a*b",          "a*b",          true,   wxRE_ADVANCED },
+#endif // wxHAS_REGEX_ADVANCED
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(data); n++ )
+    {
+        INFO( "Pattern \"" << data[n].pattern << "\" "
+              "matched against \"" << data[n].text << "\"" );
+
+        wxRegEx re(data[n].pattern, data[n].flags);
+        REQUIRE( re.IsValid() );
+        CHECK( re.Matches(data[n].text) == data[n].matches );
+
+        wxString text(data[n].text);
+        CHECK( re.Replace(&text, "!") == (data[n].matches ? 1 : 0) );
+    }
+}
+
+TEST_CASE("wxRegEx::NoMatch", "[regex][literal]")
+{
+    wxRegEx re("x(ab)y");
+    REQUIRE( re.IsValid() );
+    REQUIRE( re.Matches("xaby") );
+
+    size_t start, len;
+    CHECK( re.GetMatch(&start, &len, 1) );
+    CHECK( start == 1 );
+    CHECK( len == 2 );
+
+    // the previous match must be forgotten after a failed match, whether the
+    // text was rejected by the literal prefilter or by the regex engine
+    CHECK( !re.Matches("nothing") );
+    CHECK( !re.GetMatch(&start, &len, 1) );
+    CHECK( re.GetMatch("nothing", 1).empty() );
+
+    REQUIRE( re.Matches("xaby") );
+    CHECK( !re.Matches("xab") );
+    CHECK( !re.GetMatch(&start, &len) );
+}
+
+TEST_CASE("wxRegEx::Reuse", "[regex][cache]")
+{
+    // compiling the same pattern again may reuse the previously compiled
+    // program, check that it still works as expected
+    for ( int n = 0; n < 3; n++ )
+    {
+        wxRegEx re("([a-z]+)=([0-9]+)");
+        REQUIRE( re.IsValid() );
+        CHECK( re.GetMatchCount() == 3 );
+
+        REQUIRE( re.Matches("width=120") );
+        CHECK( re.GetMatch("width=120", 1) == "width" );
+        CHECK( re.GetMatch("width=120", 2) == "120" );
+        CHECK( !re.Matches("=120") );
+    }
+
+    // the same pattern may be used by several objects at once
+    wxRegEx re1("b+"),
+            re2("b+");
+    REQUIRE( re1.Matches("abbc") );
+    REQUIRE( re2.Matches("bbbb") );
+
+    size_t start, len;
+    CHECK( re1.GetMatch(&start, &len) );
+    CHECK( start == 1 );
+    CHECK( len == 2 );
+    CHECK( re2.GetMatch(&start, &len) );
+    CHECK( start == 0 );
+    CHECK( len == 4 );
+
+    // while the same pattern with different flags is a different one
+    wxRegEx reICase("b+", wxRE_ICASE);
+    CHECK( reICase.Matches("BB") );
+    CHECK( !re1.Matches("BB") );
+
+    // and an invalid pattern is never cached
+    {
+        wxLogNull noLog;
+        wxRegEx reBad("a(b");
+        CHECK( !reBad.IsValid() );
+    }
+    wxLogNull noLog;
+    wxRegEx reBad("a(b");
+    CHECK( !reBad.IsValid() );
+}
+
 #endif // wxUSE_REGEX
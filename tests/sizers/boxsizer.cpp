@@ -286,6 +286,106 @@ TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::SetMinSize", "[sizer]")
     CHECK(m_sizer->GetMinSize().x == 100);
 }
 
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::CachedMinSize", "[sizer]")
+{
+    wxWindow* const child1 = new wxWindow(m_win, wxID_ANY);
+    child1->SetMinSize(wxSize(10, 10));
+    wxWindow* const child2 = new wxWindow(m_win, wxID_ANY);
+    child2->SetMinSize(wxSize(20, 10));
+
+    wxSizer* const nested = new wxBoxSizer(wxVERTICAL);
+    nested->Add(child2);
+    m_sizer->Add(child1);
+    m_sizer->Add(nested);
+
+    m_win->Layout();
+    CHECK( m_sizer->GetMinSize() == wxSize(30, 10) );
+
+    // Changing the min size of a window must be taken into account by all
+    // the sizers containing it.
+    child2->SetMinSize(wxSize(40, 20));
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 20) );
+
+    // And so must be changing any of the nested sizer items.
+    nested->GetItem(child2)->SetBorder(5);
+    nested->GetItem(child2)->SetFlag(wxALL);
+    CHECK( m_sizer->GetMinSize() == wxSize(60, 30) );
+
+    // Hiding a window, directly or using the sizer, changes the min size too.
+    child1->Hide();
+    CHECK( m_sizer->GetMinSize() == wxSize(50, 30) );
+
+    nested->Hide(child2);
+    CHECK( m_sizer->GetMinSize() == wxSize(0, 0) );
+
+    child1->Show();
+    nested->Show(child2);
+    CHECK( m_sizer->GetMinSize() == wxSize(60, 30) );
+
+    // As well as adding or removing items to the nested sizer.
+    nested->Add(30, 5);
+    CHECK( m_sizer->GetMinSize() == wxSize(60, 35) );
+
+    nested->Detach(child2);
+    CHECK( m_sizer->GetMinSize() == wxSize(40, 10) );
+
+    // Changing the contents of a window with its own sizer must update the
+    // min size of the sizer containing this window.
+    wxWindow* const panel = new wxWindow(m_win, wxID_ANY);
+    wxWindow* const child3 = new wxWindow(panel, wxID_ANY);
+    child3->SetMinSize(wxSize(20, 20));
+    wxSizer* const panelSizer = new wxBoxSizer(wxVERTICAL);
+    panelSizer->Add(child3);
+    panel->SetSizer(panelSizer);
+    m_sizer->Add(panel);
+    m_win->Layout();
+    CHECK( m_sizer->GetMinSize() == wxSize(60, 20) );
+
+    panelSizer->Add(50, 30);
+    CHECK( m_sizer->GetMinSize() == wxSize(90, 50) );
+
+    child3->SetMinSize(wxSize(70, 20));
+    CHECK( m_sizer->GetMinSize() == wxSize(110, 50) );
+}
+
+namespace
+{
+
+// Sizer with the min size depending on the external state, which can't be
+// cached, as this class doesn't override CanCacheMinSize() to allow it.
+class ExternalMinSizeSizer : public wxBoxSizer
+{
+public:
+    explicit ExternalMinSizeSizer(const wxSize& size)
+        : wxBoxSizer(wxHORIZONTAL),
+          m_size(size)
+    {
+    }
+
+    virtual wxSize CalcMin() wxOVERRIDE { return m_size; }
+
+private:
+    const wxSize& m_size;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::DerivedMinSize", "[sizer]")
+{
+    wxSize size(10, 10);
+    wxSizer* const nested = new ExternalMinSizeSizer(size);
+    m_sizer->Add(nested);
+
+    m_win->Layout();
+    CHECK( m_sizer->GetMinSize() == wxSize(10, 10) );
+
+    // Neither the derived class nor the sizer containing it must use the
+    // cached min size.
+    size = wxSize(20, 30);
+    CHECK( nested->GetMinSize() == wxSize(20, 30) );
+    CHECK( m_sizer->GetMinSize() == wxSize(20, 30) );
+}
+
 #if wxUSE_LISTBOX
 TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::BestSizeRespectsMaxSize", "[sizer]")
 {
@@ -26,6 +26,7 @@
 
 #if wxUSE_UNICODE
     #include "wx/mstream.h"
+    #include "wx/tokenzr.h"
 #endif // wxUSE_UNICODE
 
 #include "testfile.h"
@@ -363,4 +364,107 @@ TEST_CASE("wxTextInputStream::GetChar", "[text][input][stream][char]")
     }
 }
 
+TEST_CASE("wxTextInputStream::ReadLine", "[text][input][stream][line]")
+{
+    wxString line;
+
+    SECTION("EOL")
+    {
+        const char buf[] = "one\ntwo\r\nthree\rfour\r\n\nlast";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis);
+
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "one" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "two" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "three" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "four" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "last" );
+        CHECK( !tis.ReadLine(line) );
+        CHECK( line.empty() );
+        CHECK( mis.Eof() );
+    }
+
+    // Check that characters split between blocks are decoded correctly.
+    SECTION("Blocks")
+    {
+        wxString text;
+        for ( int n = 0; n < 10000; n++ )
+        {
+            text += wxString::Format("%d: ", n);
+            text += wxString::FromUTF8("\xc4\x80\xd0\x96\xe2\x82\xac\xf0\x9d\x84\x9e");
+            text += '\n';
+        }
+
+        const wxMBConvUTF16BE convUTF16BE;
+        const wxMBConv* const convs[] = { &wxConvUTF8, &convUTF16BE };
+        for ( size_t i = 0; i < WXSIZEOF(convs); i++ )
+        {
+            INFO("conversion #" << i);
+
+            const wxCharBuffer buf = text.mb_str(*convs[i]);
+            wxMemoryInputStream mis(buf.data(), buf.length());
+            wxTextInputStream tis(mis, " \t", *convs[i]);
+
+            wxStringTokenizer tk(text, "\n");
+            while ( tk.HasMoreTokens() )
+            {
+                REQUIRE( tis.ReadLine(line) );
+                REQUIRE( line == tk.GetNextToken() );
+            }
+
+            CHECK( !tis.ReadLine(line) );
+        }
+    }
+
+    SECTION("BOM")
+    {
+        const char buf[] = "\xef\xbb\xbfone\n\xc4\x80\n";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis);
+
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "one" );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == wxString::FromUTF8("\xc4\x80") );
+        CHECK( !tis.ReadLine(line) );
+    }
+
+    // Check that the other functions can still be used after ReadLine().
+    SECTION("Mixed")
+    {
+        const char buf[] = "first line\nword 17\r\nsecond line\nlast";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis);
+
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "first line" );
+        CHECK( tis.ReadWord() == "word" );
+        CHECK( tis.Read32() == 17 );
+        CHECK( tis.ReadLine() == "second line" );
+        CHECK( tis.GetChar() == 'l' );
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "ast" );
+        CHECK( !tis.ReadLine(line) );
+    }
+
+    SECTION("Invalid")
+    {
+        const char buf[] = "valid\ninvalid \xff and some more text\n";
+        wxMemoryInputStream mis(buf, strlen(buf));
+        wxTextInputStream tis(mis, " \t", wxConvUTF8);
+
+        REQUIRE( tis.ReadLine(line) );
+        CHECK( line == "valid" );
+        CHECK( !tis.ReadLine(line) );
+        CHECK( mis.GetLastError() == wxSTREAM_READ_ERROR );
+    }
+}
+
 #endif // wxUSE_UNICODE
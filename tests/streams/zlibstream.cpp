@@ -548,3 +548,58 @@ void zlibStream::genExtTestData(wxTextOutputStream &out, const char *buf, int fl
 // Note: Don't forget to connect it to the base suite (See: bstream.cpp => StreamCase::suite())
 STREAM_TEST_SUBSUITE_NAMED_REGISTRATION(zlibStream)
 
+#if wxUSE_THREADS
+
+TEST_CASE("wxZlibOutputStream::Parallel", "[stream][zlib][thread]")
+{
+    // Use enough data to have several blocks and make it not too
+    // compressible to have the blocks of different sizes.
+    string data;
+    for ( int n = 0; n < 50000; n++ )
+        data += wxString::Format("%d:%d\n", n, (n * 7919) % 1009).ToStdString();
+
+    const int flags[] = { wxZLIB_NO_HEADER, wxZLIB_ZLIB, wxZLIB_GZIP };
+    for ( size_t i = 0; i < WXSIZEOF(flags); i++ )
+    {
+        INFO("Flags: " << flags[i]);
+
+        wxMemoryOutputStream mem;
+        {
+            wxZlibOutputStream zout(mem, wxZ_DEFAULT_COMPRESSION, flags[i]);
+            REQUIRE( zout.EnableParallelCompression(2) );
+            CHECK( zout.IsParallelCompressionEnabled() );
+
+            // Write the data in chunks not aligned with the blocks and flush
+            // it once in the middle.
+            for ( size_t pos = 0; pos < data.size(); pos += 10007 )
+            {
+                zout.Write(data.data() + pos, wxMin(10007, data.size() - pos));
+                if ( pos == 200140 )
+                    zout.Sync();
+            }
+
+            REQUIRE( zout.Close() );
+        }
+
+        CHECK( mem.GetSize() < data.size() / 2 );
+
+        wxMemoryInputStream min(mem);
+        wxZlibInputStream zin(min, flags[i]);
+        string result;
+        char buf[4096];
+        while ( zin.Read(buf, sizeof(buf)).LastRead() )
+            result.append(buf, zin.LastRead());
+
+        CHECK( zin.Eof() );
+        CHECK( result == data );
+    }
+
+    // Enabling parallel compression after writing is not allowed.
+    wxMemoryOutputStream mem;
+    wxZlibOutputStream zout(mem);
+    zout.Write("x", 1);
+    WX_ASSERT_FAILS_WITH_ASSERT( zout.EnableParallelCompression() );
+}
+
+#endif // wxUSE_THREADS
+
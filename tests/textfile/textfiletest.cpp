@@ -335,6 +335,161 @@ void TextFileTestCase::ReadBig()
                           f[NUM_LINES - 1] );
 }
 
+// Check that OpenMapped() gives the same results as Open() for the file with
+// the given contents.
+static void CheckOpenMapped(size_t len,
+                            const char *contents,
+                            const wxMBConv& conv = wxConvAuto())
+{
+    static const char* const filename = "textfiletest-mapped.txt";
+
+    {
+        wxFFile file(filename, "wb");
+        REQUIRE( file.Write(contents, len) == len );
+    }
+
+    wxTextFile f;
+    REQUIRE( f.Open(filename, conv) );
+
+    wxTextFile fm;
+    REQUIRE( fm.OpenMapped(filename, conv) );
+
+    // Iterate over the lines before getting their count as GetLineCount()
+    // indexes the entire file.
+    size_t n = 0;
+    for ( wxString str = fm.GetFirstLine(); !fm.Eof(); str = fm.GetNextLine() )
+    {
+        INFO( "Line " << n );
+        REQUIRE( n < f.GetLineCount() );
+        CHECK( str == f[n] );
+        CHECK( fm.GetLineType(n) == f.GetLineType(n) );
+        n++;
+    }
+
+    CHECK( n == f.GetLineCount() );
+    CHECK( fm.GetLineCount() == f.GetLineCount() );
+
+    fm.Close();
+    unlink(filename);
+}
+
+TEST_CASE("wxTextFile::OpenMapped", "[textfile]")
+{
+    SECTION("Mixed")
+    {
+        CheckOpenMapped(16, "foo\rbar\r\nbaz\n\n\r");
+        CheckOpenMapped(19, "foo\r\r\nbar\r\r\r\nbaz");
+    }
+
+    SECTION("Fuzzing")
+    {
+        static const char CHOICES[] = {'\r', '\n', 'X'};
+
+        char data[100];
+        for ( int iteration = 0; iteration < 100; iteration++ )
+        {
+            for ( size_t i = 0; i < WXSIZEOF(data); i++ )
+                data[i] = CHOICES[rand() % WXSIZEOF(CHOICES)];
+
+            CheckOpenMapped(WXSIZEOF(data), data);
+        }
+    }
+
+#if wxUSE_UNICODE
+    SECTION("UTF-8")
+    {
+        CheckOpenMapped(14, "\xd0\x9f\n"
+                            "\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82\n");
+
+        // With BOM.
+        CheckOpenMapped(10, "\xef\xbb\xbf" "foo\nbar");
+        CheckOpenMapped(10, "\xef\xbb\xbf" "foo\nbar", wxConvUTF8);
+    }
+
+    SECTION("UTF-16")
+    {
+        static const char utf16[] =
+            "\xff\xfe"
+            "\x1f\x04\x0d\x00\x0a\x00"
+            "\x40\x04\x38\x04\x0a\x00\x0d\x00";
+
+        CheckOpenMapped(WXSIZEOF(utf16) - 1, utf16);
+        CheckOpenMapped(WXSIZEOF(utf16) - 3, utf16 + 2, wxMBConvUTF16LE());
+    }
+#endif // wxUSE_UNICODE
+
+    SECTION("Modify")
+    {
+        static const char* const filename = "textfiletest-mapped.txt";
+
+        {
+            wxFFile file(filename, "w");
+            for ( size_t n = 0; n < 10000; n++ )
+                fprintf(file.fp(), "Line %lu\n", (unsigned long)n + 1);
+        }
+
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        CHECK( f[999] == "Line 1000" );
+
+        f[0] = "First line";
+        f.InsertLine("Inserted line", 1);
+        CHECK( f.GetLineCount() == 10001 );
+        CHECK( f[0] == "First line" );
+        CHECK( f[1] == "Inserted line" );
+        CHECK( f[1000] == "Line 1000" );
+
+        CHECK( f.Write() );
+        f.Close();
+
+        REQUIRE( f.Open(filename) );
+        CHECK( f.GetLineCount() == 10001 );
+        CHECK( f[0] == "First line" );
+        CHECK( f[10000] == "Line 10000" );
+        f.Close();
+
+        unlink(filename);
+    }
+
+    SECTION("ModifyMany")
+    {
+        static const char* const filename = "textfiletest-mapped.txt";
+
+        {
+            wxFFile file(filename, "w");
+            for ( size_t n = 0; n < 10000; n++ )
+                fprintf(file.fp(), "Line %lu\n", (unsigned long)n + 1);
+        }
+
+        // Modify more lines than can be cached when accessing them lazily.
+        wxTextFile f;
+        REQUIRE( f.OpenMapped(filename) );
+        for ( size_t n = 0; n < 1000; n++ )
+            f[n] = wxString::Format("Modified %lu", (unsigned long)n + 1);
+
+        // The changes must be preserved even after accessing all the other
+        // lines, both for reading and for modifying them.
+        const wxTextFile& cf = f;
+        CHECK( cf[9999] == "Line 10000" );
+        for ( wxString str = f.GetFirstLine(); !f.Eof(); str = f.GetNextLine() )
+            ;
+        CHECK( cf[0] == "Modified 1" );
+        CHECK( f[999] == "Modified 1000" );
+
+        CHECK( f.Write() );
+        f.Close();
+
+        REQUIRE( f.Open(filename) );
+        CHECK( f.GetLineCount() == 10000 );
+        CHECK( f[0] == "Modified 1" );
+        CHECK( f[999] == "Modified 1000" );
+        CHECK( f[1000] == "Line 1001" );
+        f.Close();
+
+        unlink(filename);
+    }
+}
+
 #ifdef __LINUX__
 
 // Check if using wxTextFile with special files, whose reported size doesn't
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     wxThreadPool unit test
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/stopwatch.h"
+#include "wx/threadpool.h"
+
+// ----------------------------------------------------------------------------
+// helper functors
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Increments the given counter.
+class Increment
+{
+public:
+    explicit Increment(wxAtomicInt& counter) : m_counter(counter) { }
+
+    void operator()() { wxAtomicInc(m_counter); }
+
+private:
+    wxAtomicInt& m_counter;
+};
+
+// Submits the given number of Increment tasks from inside the pool.
+class SubmitIncrements
+{
+public:
+    SubmitIncrements(wxThreadPool& pool, wxAtomicInt& counter, int count)
+        : m_pool(pool), m_counter(counter), m_count(count)
+    {
+    }
+
+    void operator()()
+    {
+        for ( int n = 0; n < m_count; n++ )
+            m_pool.Submit(Increment(m_counter));
+    }
+
+private:
+    wxThreadPool& m_pool;
+    wxAtomicInt& m_counter;
+    const int m_count;
+};
+
+// Returns the sum of the numbers from 1 to the given one.
+class Sum
+{
+public:
+    explicit Sum(int last) : m_last(last) { }
+
+    int operator()() const
+    {
+        int sum = 0;
+        for ( int n = 1; n <= m_last; n++ )
+            sum += n;
+
+        return sum;
+    }
+
+private:
+    const int m_last;
+};
+
+// Stores the value it's called with.
+class StoreValue
+{
+public:
+    explicit StoreValue(int& value) : m_value(value) { }
+
+    void operator()(const int& value) const { m_value = value; }
+
+private:
+    int& m_value;
+};
+
+// Waits until the given semaphore is posted and returns 1.
+class WaitForSemaphore
+{
+public:
+    explicit WaitForSemaphore(wxSemaphore& sem) : m_sem(sem) { }
+
+    int operator()() const { m_sem.Wait(); return 1; }
+
+private:
+    wxSemaphore& m_sem;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxThreadPool::Submit", "[thread][threadpool]")
+{
+    wxThreadPool pool(4);
+    CHECK( pool.GetThreadCount() == 4 );
+    CHECK( !pool.IsPoolThread() );
+
+    wxAtomicInt counter(0);
+
+    SECTION("Simple")
+    {
+        for ( int n = 0; n < 1000; n++ )
+            CHECK( pool.Submit(Increment(counter)) );
+
+        pool.WaitIdle();
+        CHECK( counter == 1000 );
+    }
+
+    SECTION("Nested")
+    {
+        for ( int n = 0; n < 10; n++ )
+            pool.Submit(SubmitIncrements(pool, counter, 100));
+
+        pool.WaitIdle();
+        CHECK( counter == 1000 );
+    }
+
+    SECTION("Dtor")
+    {
+        {
+            wxThreadPool pool2(2);
+            for ( int n = 0; n < 100; n++ )
+                pool2.Submit(Increment(counter));
+        }
+
+        CHECK( counter == 100 );
+    }
+}
+
+TEST_CASE("wxThreadPool::Future", "[thread][threadpool]")
+{
+    wxThreadPool pool(2);
+
+    wxFuture<int> future;
+    CHECK( !future.IsOk() );
+
+    future = pool.Async<int>(Sum(100));
+    REQUIRE( future.IsOk() );
+    CHECK( future.Get() == 5050 );
+    CHECK( future.IsReady() );
+    CHECK( future.WaitTimeout(0) );
+
+    int value = 0;
+
+    SECTION("Then")
+    {
+        wxFuture<int> future2 = pool.Async<int>(Sum(10));
+        future2.Then(StoreValue(value));
+
+        pool.WaitIdle();
+        CHECK( value == 55 );
+
+        // Continuations added to an already ready future are still executed.
+        future.Then(StoreValue(value));
+
+        pool.WaitIdle();
+        CHECK( value == 5050 );
+    }
+
+    SECTION("WaitTimeout")
+    {
+        wxSemaphore sem;
+        wxFuture<int> future2 = pool.Async<int>(WaitForSemaphore(sem));
+
+        // Waiting must not return before the timeout expires, allow for a
+        // small difference due to the clocks resolution.
+        wxStopWatch sw;
+        CHECK( !future2.WaitTimeout(100) );
+        CHECK( sw.Time() >= 90 );
+
+        sem.Post();
+        CHECK( future2.Get() == 1 );
+    }
+
+#ifdef wxHAS_CALL_AFTER
+    SECTION("CallAfter")
+    {
+        future.CallAfter(wxTheApp, StoreValue(value));
+
+        pool.WaitIdle();
+        CHECK( value == 0 );
+
+        wxTheApp->ProcessPendingEvents();
+        CHECK( value == 5050 );
+    }
+#endif // wxHAS_CALL_AFTER
+}
@@ -610,3 +610,183 @@ void XmlTestCase::Doctype()
     dt = wxXmlDoctype( "root", "O'Reilly (\"editor\")", "Public-ID" );
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
+
+TEST_CASE("wxXmlReader::Next", "[xml][reader]")
+{
+    const char *xmlText =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<root a=\"1\" b=\"two\">\n"
+        "  <!--comment-->\n"
+        "  <item>text &amp; more</item>\n"
+        "  <?pi data?>\n"
+        "  <data><![CDATA[<cdata>]]></data>\n"
+        "  <empty/>\n"
+        "</root>\n"
+    ;
+
+    wxStringInputStream sis(xmlText);
+    wxXmlReader reader(sis);
+
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    CHECK( reader.GetName() == "root" );
+    CHECK( reader.GetDepth() == 1 );
+    CHECK( reader.GetLineNumber() == 2 );
+    REQUIRE( reader.GetAttributesCount() == 2 );
+    CHECK( reader.GetAttributeName(0) == "a" );
+    CHECK( reader.GetAttributeValue(0) == "1" );
+    CHECK( reader.GetAttribute("b") == "two" );
+    CHECK( !reader.HasAttribute("c") );
+    CHECK( reader.GetAttribute("c", "def") == "def" );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_COMMENT );
+    CHECK( reader.GetContent() == "comment" );
+    CHECK( reader.GetDepth() == 1 );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    CHECK( reader.GetName() == "item" );
+    CHECK( reader.GetDepth() == 2 );
+    CHECK( reader.GetAttributesCount() == 0 );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_TEXT );
+    CHECK( reader.GetContent() == "text & more" );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+    CHECK( reader.GetName() == "item" );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_PI );
+    CHECK( reader.GetName() == "pi" );
+    CHECK( reader.GetContent() == "data" );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    REQUIRE( reader.Next() == wxXML_EVENT_CDATA );
+    CHECK( reader.GetContent() == "<cdata>" );
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    CHECK( reader.GetName() == "empty" );
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+    CHECK( reader.GetName() == "empty" );
+
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+    CHECK( reader.GetName() == "root" );
+    CHECK( reader.GetDepth() == 1 );
+
+    CHECK( reader.Next() == wxXML_EVENT_EOF );
+    CHECK( reader.Next() == wxXML_EVENT_EOF );
+    CHECK( !reader.HasError() );
+}
+
+TEST_CASE("wxXmlReader::Whitespace", "[xml][reader]")
+{
+    const char *xmlText = "<root> <a/> x </root>";
+
+    wxStringInputStream sis(xmlText);
+    wxXmlReader reader(sis, wxXMLDOC_KEEP_WHITESPACE_NODES);
+
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    REQUIRE( reader.Next() == wxXML_EVENT_TEXT );
+    CHECK( reader.GetContent() == " " );
+    REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+    REQUIRE( reader.Next() == wxXML_EVENT_TEXT );
+    CHECK( reader.GetContent() == " x " );
+    REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+    CHECK( reader.Next() == wxXML_EVENT_EOF );
+}
+
+TEST_CASE("wxXmlReader::Error", "[xml][reader]")
+{
+    wxStringInputStream sis("<root><a></b></root>");
+    wxXmlReader reader(sis);
+
+    wxLogNull noLog;
+
+    CHECK( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    CHECK( reader.Next() == wxXML_EVENT_START_ELEMENT );
+    CHECK( reader.Next() == wxXML_EVENT_EOF );
+    CHECK( reader.HasError() );
+}
+
+TEST_CASE("wxXmlReader::Subtree", "[xml][reader]")
+{
+    // Use a document big enough to be parsed in several chunks.
+    wxString xmlText("<catalog>\n<header><item id=\"no\"/></header>\n<items>\n");
+    for ( int n = 0; n < 2000; n++ )
+    {
+        xmlText += wxString::Format
+                   (
+                    "  <item id=\"%d\"><name>Item %d</name><!--c--></item>\n",
+                    n, n
+                   );
+    }
+    xmlText += "</items>\n<footer/>\n</catalog>\n";
+
+    SECTION("SkipElement")
+    {
+        wxStringInputStream sis(xmlText);
+        wxXmlReader reader(sis);
+
+        REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+        REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+        CHECK( reader.GetName() == "header" );
+        REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+        CHECK( reader.GetName() == "item" );
+
+        REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+        REQUIRE( reader.Next() == wxXML_EVENT_END_ELEMENT );
+        REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+        CHECK( reader.GetName() == "items" );
+
+        REQUIRE( reader.SkipElement() );
+        CHECK( reader.GetEvent() == wxXML_EVENT_END_ELEMENT );
+        CHECK( reader.GetName() == "items" );
+        CHECK( reader.GetDepth() == 2 );
+
+        REQUIRE( reader.Next() == wxXML_EVENT_START_ELEMENT );
+        CHECK( reader.GetName() == "footer" );
+    }
+
+    SECTION("FindElement")
+    {
+        wxStringInputStream sis(xmlText);
+        wxXmlReader reader(sis);
+
+        int count = 0;
+        while ( reader.FindElement("catalog/items/item") )
+        {
+            CHECK( reader.GetAttribute("id") == wxString::Format("%d", count) );
+
+            wxScopedPtr<wxXmlNode> node(reader.ReadElement());
+            REQUIRE( node );
+            CHECK( node->GetName() == "item" );
+
+            wxXmlNode* const child = node->GetChildren();
+            REQUIRE( child );
+            CHECK( child->GetName() == "name" );
+            CHECK( child->GetNodeContent() == wxString::Format("Item %d", count) );
+            REQUIRE( child->GetNext() );
+            CHECK( child->GetNext()->GetType() == wxXML_COMMENT_NODE );
+
+            CHECK( reader.GetEvent() == wxXML_EVENT_END_ELEMENT );
+            CHECK( reader.GetName() == "item" );
+
+            count++;
+        }
+
+        CHECK( count == 2000 );
+        CHECK( !reader.HasError() );
+    }
+
+    SECTION("Wildcard")
+    {
+        wxStringInputStream sis(xmlText);
+        wxXmlReader reader(sis);
+
+        REQUIRE( reader.FindElement("/*/*/item") );
+        CHECK( reader.GetAttribute("id") == "no" );
+        REQUIRE( reader.FindElement("*/footer") );
+        CHECK( !reader.FindElement("*/footer") );
+    }
+}